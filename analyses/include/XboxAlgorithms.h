@@ -37,6 +37,17 @@ inline std::vector<T> linspace(T a, T b, size_t N) {
     return xs;
 }
 
+// same as above but fills an existing buffer
+template <typename T>
+inline void linspace(std::vector<T> &xs, T a, T b, size_t N) {
+    T h = (b - a) / static_cast<T>(N-1);
+    xs.resize(N);
+    typename std::vector<T>::iterator x;
+    T val;
+    for (x = xs.begin(), val = a; x != xs.end(); ++x, val += h)
+        *x = val;
+}
+
 inline Double_t wrap_phase(Double_t phase)
 {
 	phase = fmod(phase + M_PI, 2*M_PI);
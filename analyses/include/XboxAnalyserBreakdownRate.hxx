@@ -2,6 +2,7 @@
 #define _XBOSANALYSERBREAKDOWNRATE_HXX_
 
 #include <iostream>
+#include <vector>
 
 // root
 #include "Rtypes.h"
@@ -33,6 +34,12 @@ private:
 	Double_t              fSigma;
 	Int_t                 fNSigma;
 
+	std::vector<Double_t> fKernel;                    ///<Tabulated weighting function (per unit sigma).
+	Int_t                 fKernelRes;                 ///<Number of table points per sigma.
+
+	void                  tabulateKernel();
+	Double_t              kernel(Double_t x) const;
+
 public:
 
 	XboxAnalyserBreakdownRate(std::vector<ULong64_t> vPCnt);
@@ -0,0 +1,116 @@
+/*
+ * XboxAnalyserBreakdownRateOnline.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef _XBOXANALYSERBREAKDOWNRATEONLINE_HXX_
+#define _XBOXANALYSERBREAKDOWNRATEONLINE_HXX_
+
+#include <iostream>
+#include <vector>
+#include <string>
+
+// root
+#include "Rtypes.h"
+#include "TObject.h"
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Online breakdown rate.
+/// Incremental counterpart of XBOX::XboxAnalyserBreakdownRate for live
+/// monitoring. Breakdown events are added one at a time in ascending
+/// order of the pulse count and three rates are maintained:
+///   - equidistant step: nstep / (pulses over the last nstep events),
+///   - equidistant pulse count: events per pulse count interval,
+///   - gaussian: events per pulse in bins of fixed width, smoothed by a
+///     gaussian weighting the past bins (as fromMovingWindow() only
+///     weights past events).
+/// The last two are anchored at the first event. Since the whole
+/// history is not known in advance, the interval, the bin width and
+/// sigma are given in pulses rather than relative to the history.
+/// Each update costs O(1) amortised (the gaussian rate is evaluated
+/// once per bin over nsig*sigma/width bins), and only the recent events
+/// and bins are kept. The state can be checkpointed to a ROOT file and
+/// restored (or copied) to continue the evaluation later on.
+class XboxAnalyserBreakdownRateOnline : public TObject {
+
+private:
+	// configuration
+	Int_t                 fNStep;                     ///<Number of events per step.
+	ULong64_t             fPCntStep;                  ///<Pulse count interval.
+	ULong64_t             fBinWidth;                  ///<Bin width of the gaussian rate (pulses).
+	Double_t              fSigma;                     ///<Sigma of the gaussian (pulses).
+	Int_t                 fNSigma;                    ///<Number of sigma up to which the gaussian is truncated.
+	std::vector<Double_t> fWeights;                   ///<Weights of the past bins.
+
+	// state
+	ULong64_t             fNEvents;                   ///<Number of events added.
+	ULong64_t             fPCntLast;                  ///<Pulse count of the last event.
+
+	std::vector<ULong64_t> fRecent;                   ///<Pulse counts of the last nstep+1 events (ring).
+	UInt_t                fRecentHead;                ///<Position of the last event in the ring.
+	Double_t              fRateStep;                  ///<Rate over the last nstep events.
+
+	ULong64_t             fIntervalBegin;             ///<Pulse count of the first event of the open interval.
+	ULong64_t             fIntervalCount;             ///<Number of events in the open interval.
+	Double_t              fRatePCnt;                  ///<Rate of the last closed interval.
+	ULong64_t             fPCntPCnt;                  ///<Pulse count at which the last interval closed.
+
+	std::vector<ULong64_t> fBins;                     ///<Events of the recent bins (ring).
+	UInt_t                fBinHead;                   ///<Position of the open bin in the ring.
+	ULong64_t             fBinBegin;                  ///<Pulse count at the begin of the open bin.
+	ULong64_t             fNBins;                     ///<Number of closed bins.
+	Double_t              fRateGauss;                 ///<Gaussian rate of the last closed bin.
+	ULong64_t             fPCntGauss;                 ///<Pulse count at the end of the last closed bin.
+
+	void                  closeBin();
+	ULong64_t             closeBins(ULong64_t pcnt);
+
+public:
+	XboxAnalyserBreakdownRateOnline();
+	XboxAnalyserBreakdownRateOnline(Int_t nstep, ULong64_t pcntStep,
+			ULong64_t width, Double_t sigma, Int_t nsig);
+	virtual ~XboxAnalyserBreakdownRateOnline();
+
+	void                  init();
+	void                  clear();
+	void                  reset();
+
+	// setter (the state is cleared)
+	void                  configStep(Int_t nstep);
+	void                  configPCnt(ULong64_t pcntStep);
+	void                  configGaussian(ULong64_t width, Double_t sigma, Int_t nsig);
+
+	// update
+	Int_t                 add(ULong64_t pcnt);
+	Int_t                 advance(ULong64_t pcnt);
+
+	// getter
+	ULong64_t             getNEvents() const { return fNEvents; }
+	ULong64_t             getPCntLast() const { return fPCntLast; }
+	Double_t              getRateStep() const { return fRateStep; }
+	Double_t              getRatePCnt() const { return fRatePCnt; }
+	ULong64_t             getPCntPCnt() const { return fPCntPCnt; }
+	Double_t              getRateGauss() const { return fRateGauss; }
+	ULong64_t             getPCntGauss() const { return fPCntGauss; }
+	ULong64_t             getNBins() const { return fNBins; }
+
+	// checkpoint
+	Int_t                 checkpoint(const std::string &filepath, const std::string &key) const;
+	Int_t                 restore(const std::string &filepath, const std::string &key);
+
+	ClassDef(XboxAnalyserBreakdownRateOnline,1);	// Incremental breakdown rate
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* _XBOXANALYSERBREAKDOWNRATEONLINE_HXX_ */
@@ -1,6 +1,8 @@
 #ifndef _XBOXANALYSEREVALBASE_HXX_
 #define _XBOXANALYSEREVALBASE_HXX_
 
+#include <mutex>
+
 #include "Rtypes.h"
 #include "XboxDAQChannel.hxx"
 
@@ -10,6 +12,9 @@ namespace XBOX {
 
 class XboxDAQChannel;
 
+// serialises the reports of all evaluators (ROOT graphics are not re-entrant)
+std::mutex& getReportMutex();
+
 class XboxAnalyserEvalBase {
 
 
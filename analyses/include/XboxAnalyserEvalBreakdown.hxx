@@ -2,46 +2,70 @@
 #define _XBOXANALYSEREVALBREAKDOWN_HXX_
 
 #include <iostream>
+#include <vector>
 
 #include "Rtypes.h"
 #include "XboxDAQChannel.hxx"
-#include "XboxAnalyserEntry.hxx"
 #include "XboxAnalyserResult.hxx"
+#include "XboxAnalyserEvalPulseShape.hxx"
+#include "XboxAnalyserEvalJitter.hxx"
+#include "XboxAnalyserEvalRisingEdge.hxx"
+#include "XboxAnalyserEvalDeviation.hxx"
+#include "XboxSignalTrace.hxx"
+#include "XboxWorkspace.hxx"
 
 #ifndef XBOX_NO_NAMESPACE
 namespace XBOX {
 #endif
 
 class XboxDAQChannel;
-class XboxAnalyserEntry;
 class XboxAnalyserResult;
 
+////////////////////////////////////////////////////////////////////////
+/// Breakdown analysis of the structure signals.
+/// Fused version of the pulse shape, jitter, rising edge and deviation
+/// evaluators, used by analyseBreakdown (test_AnalysisDefault).
+/// The incident (PSI), transmitted (PEI) and reflected (PSR) signals of
+/// the breakdown pulse (B0) and of the previous pulse (B1) are decoded
+/// once per event, limited to the time windows read by the stages. The
+/// stages sharing a signal filter share the smoothed traces. All stages
+/// re-sample the smoothed traces on their own grids, and the deviations
+/// share the reference traces aligned by the jitter, rather than
+/// reading and filtering the channels again for each stage. The
+/// configuration, the analysis and the reports of each stage are those
+/// of the individual evaluators.
 class XboxAnalyserEvalBreakdown {
 
 private:
-	Double_t              fPulseWMin;                 ///<Lower limit in relative coordinates.
-	Double_t              fPulseWMax;                 ///<Upper limit on the considered time axis.
-	Double_t              fPulseTh;                   ///<Threshold to evaluate the pulse width and height.
-
-	Double_t              fJitterWMin;                ///<Time window lower limit for jitter evaluation (relative coordinates).
-	Double_t              fJitterWMax;                ///<Time window upper limit for jitter evaluation (relative coordinates).
-	Double_t              fJitterTh;                  ///<Threshold to evaluate the jitter. Relative to maximum.
-	Double_t              fJitterMax;                 ///<Maximum acceptable jitter (relative to maximum time window).
-
-	Double_t              fRiseWMin;                  ///<Lower limit in relative coordinates.
-	Double_t              fRiseWMax;                  ///<Upper limit on the considered time axis.
-	Double_t              fRiseProx;                  ///<Threshold to evaluate the pulse width and height.
-	Double_t              fRiseTh;                    ///<Threshold to evaluate the pulse width and height.
-
-	Double_t              fDeflWMin;                  ///<Lower limit in relative coordinates.
-	Double_t              fDeflWMax;                  ///<Upper limit on the considered time axis.
-	Double_t              fDeflProx;                  ///<Proximity to refine the deflection time.
-	Double_t              fDeflThC;                   ///<Threshold for estimating the deviation time.
-	Double_t              fDeflThF;                   ///<Threshold for refined evaluation of the deviation time.
-
-	Double_t evalJitter(XBOX::XboxDAQChannel &ch0, XBOX::XboxDAQChannel &ch1);
-	Double_t evalRisingEdge(XBOX::XboxDAQChannel &ch);
-	Double_t evalDeviation(XBOX::XboxDAQChannel &ch0, XBOX::XboxDAQChannel &ch1);
+	enum EChannel {
+		kPSI,
+		kPEI,
+		kPSR,
+		kNChannels
+	};                                                ///<Structure signals.
+
+	XBOX::XboxAnalyserEvalPulseShape fEvalPulse;      ///!Pulse shape of the incident signals.
+	XBOX::XboxAnalyserEvalJitter fEvalJitter;         ///!Jitter between the incident signals.
+	XBOX::XboxAnalyserEvalRisingEdge fEvalRise;       ///!Start of the rising edges of the previous pulse.
+	XBOX::XboxAnalyserEvalDeviation fEvalDev;         ///!Deviation of the breakdown pulse from the previous one.
+
+	struct Scratch_t {
+		XBOX::XboxSignalTrace fTraceB0[kNChannels];   ///<Decoded signals of the breakdown pulse.
+		XBOX::XboxSignalTrace fTraceB1[kNChannels];   ///<Decoded signals of the previous pulse.
+		std::vector<Double_t> fTime;                  ///<Time axis of the current stage.
+		std::vector<Double_t> fSignal1;               ///<Re-sampled signal of the breakdown pulse.
+		std::vector<Double_t> fSignal2;               ///<Re-sampled signal of the previous pulse.
+		std::vector<std::vector<Double_t>> fDerivatives; ///<First and second derivative.
+		XBOX::XboxWorkspace   fWorkspace;             ///<Temporary buffers (reset for each event).
+	};                                                ///<Buffers of a single evaluation.
+
+	mutable std::vector<Scratch_t> fScratch;          ///!Buffers of the processing slots.
+
+	XBOX::XboxAnalyserResult evalBreakdown(
+			const XBOX::XboxDAQChannel &b0psi, const XBOX::XboxDAQChannel &b1psi,
+			const XBOX::XboxDAQChannel &b0pei, const XBOX::XboxDAQChannel &b1pei,
+			const XBOX::XboxDAQChannel &b0psr, const XBOX::XboxDAQChannel &b1psr,
+			Scratch_t &scratch) const;
 
 public:
 	XboxAnalyserEvalBreakdown();
@@ -57,17 +81,27 @@ public:
 	void setRiseConfig(Double_t wmin, Double_t wmax, Double_t th, Double_t prox);
 	void setDeflConfig(Double_t wmin,
 			Double_t wmax, Double_t thc, Double_t thf, Double_t prox);
+	std::string getConfig() const;
+	void setNSlots(UInt_t nslots);
+	UInt_t getNSlots() const { return fScratch.size(); }
+	ULong64_t getNAllocations() const;
 
-	// evaluation of pulse parameters and breakdown location
-	XBOX::XboxAnalyserEntry operator_old (
-			XBOX::XboxDAQChannel &b0psi, XBOX::XboxDAQChannel &b1psi,
-			XBOX::XboxDAQChannel &b0pei, XBOX::XboxDAQChannel &b1pei,
-			XBOX::XboxDAQChannel &b0psr, XBOX::XboxDAQChannel &b1psr);
-
+	// evaluation of pulse parameters and breakdown location (re-entrant,
+	// the channels are not modified)
 	XBOX::XboxAnalyserResult operator () (
-			XBOX::XboxDAQChannel &chMagn, XBOX::XboxDAQChannel &chMagnRef,
-			XBOX::XboxDAQChannel &chJitter, XBOX::XboxDAQChannel &chJitterRef);
-
+			const XBOX::XboxDAQChannel &b0psi, const XBOX::XboxDAQChannel &b1psi,
+			const XBOX::XboxDAQChannel &b0pei, const XBOX::XboxDAQChannel &b1pei,
+			const XBOX::XboxDAQChannel &b0psr, const XBOX::XboxDAQChannel &b1psr) const;
+	XBOX::XboxAnalyserResult evalSlot(UInt_t slot,
+			const XBOX::XboxDAQChannel &b0psi, const XBOX::XboxDAQChannel &b1psi,
+			const XBOX::XboxDAQChannel &b0pei, const XBOX::XboxDAQChannel &b1pei,
+			const XBOX::XboxDAQChannel &b0psr, const XBOX::XboxDAQChannel &b1psr) const;
+
+	// reporting (forwarded to the stages)
+	void setReportDir(const std::string &sval);
+	void setReport(const Bool_t val);
+	void setReportSampling(XBOX::XboxReportPolicy::ESampling val, ULong64_t nth=1);
+	void setReportAsync(const Bool_t val);
 };
 
 
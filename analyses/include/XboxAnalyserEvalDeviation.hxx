@@ -6,7 +6,9 @@
 #include "Rtypes.h"
 #include "XboxAnalyserEvalBase.hxx"
 #include "XboxDAQChannel.hxx"
+#include "XboxReportQueue.hxx"
 #include "XboxSignalFilter.hxx"
+#include "XboxSignalTrace.hxx"
 
 #ifndef XBOX_NO_NAMESPACE
 namespace XBOX {
@@ -26,6 +28,7 @@ private:
 
 	XBOX::XboxSignalFilter fFilterSig;           ///!Filter applied on the signal of each channel.
 	XBOX::XboxSignalFilter fFilterDev;           ///!Filter applied on the difference between the signals of ch1 and ch2.
+	XBOX::XboxDAQChannel::EPrecision fPrecision; ///!Evaluation precision.
 
 	size_t                fSamplesCoarse;        ///!Number of interpolation points for coarse evaluation.
 	size_t                fSamplesRefine;        ///!Number of interpolation points for refined evaluation.
@@ -34,20 +37,37 @@ private:
 	
 	Double_t              fReportFlag;           ///!Enabled or disable report.
 	std::string           fReportDir;            ///!Directory to export report.
-
-
-	Double_t              absTh(std::vector<Double_t> &y, Double_t th);
-	Double_t              absThCoarse(std::vector<Double_t> &y);
-	Double_t              absThRefine(std::vector<Double_t> &y);
-	Double_t              argTh(std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th);
-	Double_t              argThCoarse(std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th);
-	Double_t              argThRefine(std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th);
-
-	Double_t              magn(std::vector<Double_t> &y);
-	std::vector<Double_t> diff(std::vector<Double_t> &y1, std::vector<Double_t> &y2);
-
-	Double_t evalDeviation(XBOX::XboxDAQChannel &ch0, XBOX::XboxDAQChannel &ch1);
-	void report(XBOX::XboxDAQChannel ch1, XBOX::XboxDAQChannel ch2, Double_t jitter);
+	XBOX::XboxReportPolicy fReportPolicy;        ///!Selection and dispatch of the reports.
+
+	struct Scratch_t {
+		std::vector<Double_t> fTimeCoarse;            ///<Time axis of the coarse evaluation.
+		std::vector<Double_t> fTimeRefine;            ///<Time axis of the refined evaluation.
+		std::vector<Double_t> fTimeShifted;           ///<Time axis of the reference shifted by the jitter.
+		std::vector<std::vector<Double_t>> fSignal1;  ///<Filtered signal.
+		std::vector<std::vector<Double_t>> fSignal2;  ///<Filtered reference signal.
+		XBOX::XboxWorkspace   fWorkspace;             ///<Temporary buffers (reset for each event).
+	};                                           ///<Buffers of a single evaluation.
+
+	mutable std::vector<Scratch_t> fScratch;     ///!Buffers of the processing slots.
+
+	Double_t              absTh(std::vector<Double_t> &y, Double_t th) const;
+	Double_t              absThCoarse(std::vector<Double_t> &y) const;
+	Double_t              absThRefine(std::vector<Double_t> &y) const;
+	Double_t              argTh(std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th) const;
+	Double_t              argThCoarse(std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th) const;
+	Double_t              argThRefine(std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th) const;
+
+	Double_t              magn(std::vector<Double_t> &y) const;
+	void                  diff(std::vector<Double_t> &y, const std::vector<Double_t> &y1,
+			const std::vector<Double_t> &y2) const;
+	void                  shift(std::vector<Double_t> &ts, const std::vector<Double_t> &t,
+			Double_t offset) const;
+
+	Double_t evalDeviation(const XBOX::XboxDAQChannel &ch1, const XBOX::XboxDAQChannel &ch2,
+			Double_t jitter, Scratch_t &scratch) const;
+	void report(XBOX::XboxDAQChannel ch1, XBOX::XboxDAQChannel ch2, Double_t jitter) const;
+	void submitReport(const XBOX::XboxDAQChannel &ch1, const XBOX::XboxDAQChannel &ch2,
+			Double_t jitter, Double_t tdev) const;
 
 public:
 	XboxAnalyserEvalDeviation();
@@ -62,14 +82,33 @@ public:
 	//setter
 	void config(Double_t wmin,
 			Double_t wmax, Double_t thc, Double_t thf, Double_t prox);
-
-	// evaluation
-	Double_t operator () (
-			XBOX::XboxDAQChannel &ch, XBOX::XboxDAQChannel &chref, Double_t jitter);
+	std::string getConfig() const;
+	void setPrecision(XBOX::XboxDAQChannel::EPrecision val);
+	void setNSlots(UInt_t nslots);
+	UInt_t getNSlots() const { return fScratch.size(); }
+	ULong64_t getNAllocations() const;
+
+	// evaluation (re-entrant, the channels are not modified)
+	Double_t operator () (const XBOX::XboxDAQChannel &ch,
+			const XBOX::XboxDAQChannel &chref, Double_t jitter) const;
+	Double_t evalSlot(UInt_t slot, const XBOX::XboxDAQChannel &ch,
+			const XBOX::XboxDAQChannel &chref, Double_t jitter) const;
+
+	// stage of the fused evaluation (see XBOX::XboxAnalyserEvalBreakdown)
+	void getWindow(Double_t &wmin, Double_t &wmax, Int_t &margin) const;
+	Double_t evalTraces(XBOX::XboxSignalTrace &trace1, XBOX::XboxSignalTrace &trace2,
+			std::vector<Double_t> &t, std::vector<Double_t> &y1, std::vector<Double_t> &y2,
+			XBOX::XboxWorkspace &ws) const;
 
 	// reporting
 	void setReportDir(const std::string &sval) { fReportDir = sval; }
 	void setReport(const Bool_t val) { fReportFlag = val; }
+	void setReportSampling(XBOX::XboxReportPolicy::ESampling val, ULong64_t nth=1) {
+		fReportPolicy.setSampling(val, nth); }
+	void setReportOutliers(Double_t min, Double_t max) { fReportPolicy.setOutlierRange(min, max); }
+	void setReportAsync(const Bool_t val) { fReportPolicy.setAsync(val); }
+	void requestReport(const XBOX::XboxDAQChannel &ch1, const XBOX::XboxDAQChannel &ch2,
+			Double_t jitter, Double_t tdev) const;
 };
 
 
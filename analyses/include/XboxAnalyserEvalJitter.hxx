@@ -4,10 +4,12 @@
 #include <iostream>
 
 #include "Rtypes.h"
-//#include "XboxAnalyserEvalBase.hxx"
+#include "XboxAnalyserEvalBase.hxx"
 #include "XboxDAQChannel.hxx"
+#include "XboxReportQueue.hxx"
 
 #include "XboxSignalFilter.hxx"
+#include "XboxSignalTrace.hxx"
 
 #ifndef XBOX_NO_NAMESPACE
 namespace XBOX {
@@ -24,16 +26,32 @@ private:
 	Double_t              fTol;                  ///<Maximum acceptable jitter (relative to maximum time window).
 
 	XBOX::XboxSignalFilter fFilter;              ///!Signal filter.
+	XBOX::XboxDAQChannel::EPrecision fPrecision; ///!Evaluation precision.
 
 	size_t                fSamples;              ///!Number of interpolation points.
 
 	Double_t              fReportFlag;           ///!Enabled or disable report.
 	std::string           fReportDir;            ///!Directory to export report.
-
-	Double_t absTh(std::vector<Double_t> &y);
-	Double_t argTh(std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th);
-	Double_t evalJitter(XBOX::XboxDAQChannel &ch1, XBOX::XboxDAQChannel &ch2);
-	void report(XBOX::XboxDAQChannel ch1, XBOX::XboxDAQChannel ch2);
+	XBOX::XboxReportPolicy fReportPolicy;        ///!Selection and dispatch of the reports.
+
+	struct Scratch_t {
+		std::vector<Double_t> fTime;                  ///<Interpolated time axis.
+		std::vector<std::vector<Double_t>> fSignal1;  ///<Filtered first signal.
+		std::vector<std::vector<Double_t>> fSignal2;  ///<Filtered second signal.
+		XBOX::XboxWorkspace   fWorkspace;             ///<Temporary buffers (reset for each event).
+	};                                           ///<Buffers of a single evaluation.
+
+	mutable std::vector<Scratch_t> fScratch;     ///!Buffers of the processing slots.
+
+	Double_t absTh(std::vector<Double_t> &y) const;
+	Double_t argTh(std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th) const;
+	Double_t delay(std::vector<Double_t> &t, std::vector<Double_t> &y1,
+			std::vector<Double_t> &y2, Double_t span) const;
+	Double_t evalJitter(const XBOX::XboxDAQChannel &ch1, const XBOX::XboxDAQChannel &ch2,
+			Scratch_t &scratch) const;
+	void report(XBOX::XboxDAQChannel ch1, XBOX::XboxDAQChannel ch2) const;
+	void submitReport(const XBOX::XboxDAQChannel &ch1, const XBOX::XboxDAQChannel &ch2,
+			Double_t jitter) const;
 
 public:
 	XboxAnalyserEvalJitter();
@@ -46,13 +64,33 @@ public:
 
 	//setter
 	void config(Double_t wmin, Double_t wmax, Double_t th, Double_t max);
-
-	// evaluation of pulse parameters and breakdown location
-	Double_t operator () (XBOX::XboxDAQChannel &ch1, XBOX::XboxDAQChannel &ch2);
+	std::string getConfig() const;
+	void setPrecision(XBOX::XboxDAQChannel::EPrecision val);
+	void setNSlots(UInt_t nslots);
+	UInt_t getNSlots() const { return fScratch.size(); }
+	ULong64_t getNAllocations() const;
+
+	// evaluation of pulse parameters and breakdown location (re-entrant,
+	// the channels are not modified)
+	Double_t operator () (const XBOX::XboxDAQChannel &ch1, const XBOX::XboxDAQChannel &ch2) const;
+	Double_t evalSlot(UInt_t slot, const XBOX::XboxDAQChannel &ch1,
+			const XBOX::XboxDAQChannel &ch2) const;
+
+	// stage of the fused evaluation (see XBOX::XboxAnalyserEvalBreakdown)
+	void getWindow(Double_t &wmin, Double_t &wmax, Int_t &margin) const;
+	Double_t evalTraces(XBOX::XboxSignalTrace &trace1, XBOX::XboxSignalTrace &trace2,
+			std::vector<Double_t> &t, std::vector<Double_t> &y1, std::vector<Double_t> &y2,
+			XBOX::XboxWorkspace &ws) const;
 
 	// reporting
 	void setReportDir(const std::string &sval) { fReportDir = sval; }
 	void setReport(const Bool_t val) { fReportFlag = val; }
+	void setReportSampling(XBOX::XboxReportPolicy::ESampling val, ULong64_t nth=1) {
+		fReportPolicy.setSampling(val, nth); }
+	void setReportOutliers(Double_t min, Double_t max) { fReportPolicy.setOutlierRange(min, max); }
+	void setReportAsync(const Bool_t val) { fReportPolicy.setAsync(val); }
+	void requestReport(const XBOX::XboxDAQChannel &ch1, const XBOX::XboxDAQChannel &ch2,
+			Double_t jitter) const;
 };
 
 
@@ -5,6 +5,8 @@
 
 #include "XboxAnalyserEvalBase.hxx"
 #include "XboxDAQChannel.hxx"
+#include "XboxReportQueue.hxx"
+#include "XboxSignalTrace.hxx"
 
 #ifndef XBOX_NO_NAMESPACE
 namespace XBOX {
@@ -19,10 +21,14 @@ private:
 	Double_t              fPulseWmax;                 ///<Upper limit on the considered time axis.
 	Double_t              fPulseTh;                   ///<Threshold to evaluate the pulse width and height.
 
+	XBOX::XboxDAQChannel::EPrecision fPrecision;      ///!Precision of the edge detection.
+
 	Double_t              fReportFlag;                ///!Enabled/ disabled reporting.
 	std::string           fReportDir;                 ///!Directory to create
+	XBOX::XboxReportPolicy fReportPolicy;             ///!Selection and dispatch of the reports.
 
-	void report(XBOX::XboxDAQChannel &ch);
+	void report(XBOX::XboxDAQChannel &ch) const;
+	void submitReport(const XBOX::XboxDAQChannel &ch) const;
 
 public:
 	XboxAnalyserEvalPulseShape();
@@ -35,13 +41,26 @@ public:
 
 	//setter
 	void configPulse(Double_t wmin, Double_t wmax, Double_t th);
+	void setPrecision(XBOX::XboxDAQChannel::EPrecision val) { fPrecision = val; }
+	std::string getConfig() const;
+
+	// evaluation (re-entrant, the channel is not modified)
+	XBOX::XboxDAQChannel operator () (const XBOX::XboxDAQChannel &ch) const;
 
-	// evaluation
-	XBOX::XboxDAQChannel operator () (XBOX::XboxDAQChannel &ch);
+	// stage of the fused evaluation (see XBOX::XboxAnalyserEvalBreakdown)
+	void getWindow(Double_t &wmin, Double_t &wmax, Int_t &margin) const;
+	void evalTrace(const XBOX::XboxSignalTrace &trace, Double_t &tr, Double_t &tf,
+			XBOX::XboxDAQChannel::Stats_t &ptop, Double_t &pspan) const;
 
 	// reporting
 	void setReportDir(const std::string &sval) { fReportDir = sval; }
 	void setReport(const Bool_t val) { fReportFlag = val; }
+	void setReportSampling(XBOX::XboxReportPolicy::ESampling val, ULong64_t nth=1) {
+		fReportPolicy.setSampling(val, nth); }
+	void setReportOutliers(Double_t min, Double_t max) { fReportPolicy.setOutlierRange(min, max); }
+	void setReportAsync(const Bool_t val) { fReportPolicy.setAsync(val); }
+	void requestReport(const XBOX::XboxDAQChannel &ch, Double_t tr, Double_t tf,
+			const XBOX::XboxDAQChannel::Stats_t &ptop, Double_t pspan) const;
 
 };
 
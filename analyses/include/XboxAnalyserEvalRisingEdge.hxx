@@ -4,9 +4,11 @@
 #include <iostream>
 
 #include "Rtypes.h"
-//#include "XboxAnalyserEvalBase.hxx"
+#include "XboxAnalyserEvalBase.hxx"
 #include "XboxDAQChannel.hxx"
+#include "XboxReportQueue.hxx"
 #include "XboxSignalFilter.hxx"
+#include "XboxSignalTrace.hxx"
 
 #ifndef XBOX_NO_NAMESPACE
 namespace XBOX {
@@ -29,17 +31,41 @@ private:
 	size_t                fSamplesRefine;        ///!Number of interpolation points for refined evaluation.
 	size_t                fWindowSize;
 
+	XBOX::XboxDAQChannel::EPrecision fPrecision; ///!Evaluation precision.
+
 
 	Double_t              fReportFlag;           ///!Enabled or disable report.
 	std::string           fReportDir;            ///!Directory to export report.
-
-	size_t                argMax(std::vector<Double_t> &y, size_t imin, size_t imax);
-	size_t                argLeftRoot(std::vector<Double_t> &y, size_t istart);
-	size_t                argRightRoot(std::vector<Double_t> &y, size_t istart);
-	Double_t              evalRisingEdge(XBOX::XboxDAQChannel &ch);
-	void                  report(XBOX::XboxDAQChannel ch);
-
-	std::vector<Double_t> rescale(std::vector<Double_t> &y, Double_t ysmin, Double_t ysmax);
+	XBOX::XboxReportPolicy fReportPolicy;        ///!Selection and dispatch of the reports.
+
+	struct Scratch_t {
+		std::vector<Double_t> fTime;                  ///<Refined time axis.
+		std::vector<std::vector<Double_t>> fSignals;  ///<Filtered signal and its derivatives.
+		XBOX::XboxWorkspace   fWorkspace;             ///<Temporary buffers (reset for each event).
+	};                                           ///<Buffers of a single evaluation.
+
+	mutable std::vector<Scratch_t> fScratch;     ///!Buffers of the processing slots.
+
+	struct Rise_t {
+		size_t                fIdxMax;                ///<Closest maximum to the right.
+		size_t                fIdxInfl;               ///<Inflection point of the rising edge.
+		size_t                fIdxShift;              ///<Distance of the zero crossing of the tangent.
+		size_t                fIdxZero;               ///<Zero crossing of the tangent.
+		size_t                fIdxCurv;               ///<Point of maximum curvature.
+		Double_t              fSlope;                 ///<Slope in the inflection point.
+	};                                           ///<Intermediate points of the evaluation (see report).
+
+	size_t                argMax(std::vector<Double_t> &y, size_t imin, size_t imax) const;
+	size_t                argLeftRoot(std::vector<Double_t> &y, size_t istart) const;
+	size_t                argRightRoot(std::vector<Double_t> &y, size_t istart) const;
+	Double_t              argRise(std::vector<Double_t> &tf, std::vector<Double_t> &yf,
+			std::vector<Double_t> &y1f, std::vector<Double_t> &y2f, Double_t dt,
+			Rise_t *rise=nullptr) const;
+	Double_t              evalRisingEdge(const XBOX::XboxDAQChannel &ch, Scratch_t &scratch) const;
+	void                  report(XBOX::XboxDAQChannel ch) const;
+	void                  submitReport(const XBOX::XboxDAQChannel &ch, Double_t tr) const;
+
+	std::vector<Double_t> rescale(std::vector<Double_t> &y, Double_t ysmin, Double_t ysmax) const;
 public:
 	XboxAnalyserEvalRisingEdge();
 	XboxAnalyserEvalRisingEdge(Double_t wmin, Double_t wmax, Double_t th, Double_t prox);
@@ -51,13 +77,30 @@ public:
 
 	//setter
 	void config(Double_t wmin, Double_t wmax, Double_t th, Double_t prox);
-
-	// evaluation
-	Double_t operator () (XBOX::XboxDAQChannel &ch);
+	void setPrecision(XBOX::XboxDAQChannel::EPrecision val);
+	std::string getConfig() const;
+	void setNSlots(UInt_t nslots);
+	UInt_t getNSlots() const { return fScratch.size(); }
+	ULong64_t getNAllocations() const;
+
+	// evaluation (re-entrant, the channel is not modified)
+	Double_t operator () (const XBOX::XboxDAQChannel &ch) const;
+	Double_t evalSlot(UInt_t slot, const XBOX::XboxDAQChannel &ch) const;
+
+	// stage of the fused evaluation (see XBOX::XboxAnalyserEvalBreakdown)
+	void getWindow(Double_t &wmin, Double_t &wmax, Int_t &margin) const;
+	Double_t evalTrace(XBOX::XboxSignalTrace &trace, std::vector<Double_t> &t,
+			std::vector<Double_t> &y, std::vector<std::vector<Double_t>> &res,
+			XBOX::XboxWorkspace &ws) const;
 
 	// reporting
 	void setReportDir(const std::string &sval) { fReportDir = sval; }
 	void setReport(const Bool_t val) { fReportFlag = val; }
+	void setReportSampling(XBOX::XboxReportPolicy::ESampling val, ULong64_t nth=1) {
+		fReportPolicy.setSampling(val, nth); }
+	void setReportOutliers(Double_t min, Double_t max) { fReportPolicy.setOutlierRange(min, max); }
+	void setReportAsync(const Bool_t val) { fReportPolicy.setAsync(val); }
+	void requestReport(const XBOX::XboxDAQChannel &ch, Double_t tr) const;
 
 };
 
@@ -11,9 +11,11 @@
 #ifndef XBOX_NO_NAMESPACE
 #pragma link C++ class XBOX::XboxAnalyserEntry+;
 #pragma link C++ class XBOX::XboxAnalyserResult+;
+#pragma link C++ class XBOX::XboxAnalyserBreakdownRateOnline+;
 #else
 #pragma link C++ class XboxAnalyserEntry+;
 #pragma link C++ class XboxAnalyserResult+;
+#pragma link C++ class XboxAnalyserBreakdownRateOnline+;
 #endif
 
 #endif
@@ -9,6 +9,7 @@
 #define _XBOXANALYSERRESULT_HXX_
 
 #include <iostream>
+#include <vector>
 #include "Rtypes.h"
 #include "TObject.h"
 #include "TTimeStamp.h"
@@ -50,6 +51,13 @@ protected:
 
 	Double_t              fJitter;                    ///<Jitter between reference and main signal
 	Double_t              fXdev;                   ///<The time at with main signal starts to differ from the reference.
+	Double_t              fXref;                      ///<The time at which the rising edge of the reference signal starts.
+
+	Double_t              fTranXref;                  ///<Start of the rising edge of the transmitted reference signal.
+	Double_t              fTranXdev;                  ///<The time at which the transmitted signal starts to differ from the reference.
+	Double_t              fReflXref;                  ///<Start of the rising edge of the reflected reference signal.
+	Double_t              fReflXdev;                  ///<The time at which the reflected signal starts to differ from the reference.
+	Double_t              fBDTime;                    ///<Time related to the breakdown location.
 
 	std::vector<Double_t> fTestingBuffer1;            ///<Testing: Visual inspection of fTranRisingEdge
 	std::vector<Double_t> fTestingBuffer2;            ///<Testing: Visual inspection of fTranBreakdownTime
@@ -98,6 +106,13 @@ public:
 
 	Double_t              getJitter() const { return fJitter; }
 	Double_t              getXdev() const { return fXdev; }
+	Double_t              getXref() const { return fXref; }
+
+	Double_t              getTranXref() const { return fTranXref; }
+	Double_t              getTranXdev() const { return fTranXdev; }
+	Double_t              getReflXref() const { return fReflXref; }
+	Double_t              getReflXdev() const { return fReflXdev; }
+	Double_t              getBDTime() const { return fBDTime; }
 
 	std::vector<Double_t> getTestingBuffer1() const { return fTestingBuffer1; }
 	std::vector<Double_t> getTestingBuffer2() const { return fTestingBuffer2; }
@@ -129,12 +144,19 @@ public:
 
 	void                  setJitter(Double_t val) { fJitter = val; }
 	void                  setXdev(Double_t val) { fXdev = val; }
+	void                  setXref(Double_t val) { fXref = val; }
+
+	void                  setTranXref(Double_t val) { fTranXref = val; }
+	void                  setTranXdev(Double_t val) { fTranXdev = val; }
+	void                  setReflXref(Double_t val) { fReflXref = val; }
+	void                  setReflXdev(Double_t val) { fReflXdev = val; }
+	void                  setBDTime(Double_t val) { fBDTime = val; }
 
 	void                  setTestingBuffer1(std::vector<Double_t> vec) { fTestingBuffer1 = vec; }
 	void                  setTestingBuffer2(std::vector<Double_t> vec) { fTestingBuffer2 = vec; }
 
 
-	ClassDef(XboxAnalyserResult,1);	// Class to define data structure of pulse parameters
+	ClassDef(XboxAnalyserResult,2);	// Class to define data structure of pulse parameters
 
 };
 
@@ -21,6 +21,8 @@
 
 // xbox
 #include "XboxDAQChannel.hxx"
+#include "XboxAnalyserViewIndex.hxx"
+#include "XboxAnalyserViewColumn.hxx"
 
 
 #ifndef XBOX_NO_NAMESPACE
@@ -69,10 +71,11 @@ private:
 
 	std::vector<std::string> fFilePaths;              ///!Input files.
 
-	std::map<std::string, std::vector<XBOX::XboxDAQChannel>> fCategoryChannel; // Map to access the trees of the source file
+	std::map<std::string, XBOX::XboxAnalyserViewColumn> fCategoryChannel; // Meta data of the channel columns of the source files
 	std::map<std::string, std::vector<Double_t>> fCategoryTuple;
 	std::map<std::string, std::vector<TTimeStamp>> fCategoryTimeStamp;
 	std::map<std::string, std::vector<ULong64_t>> fCategoryPulseCount;
+	std::map<std::string, XBOX::XboxAnalyserViewIndex> fCategoryIndex; // Sorted index of the channel columns and of the tuples of a tree
 
 //	std::map<std::string, int> fCategory;
 //	std::vector<XBOX::XboxAnalyserResult> fPulseResults; ///!Vector containing the results of normal pulses
@@ -99,6 +102,8 @@ private:
 
 //	std::vector<ULong64_t> convertToPulseCnt(std::vector<TTimeStamp> &time);
 
+	std::vector<size_t>   selectEvents(const std::string &sKey);
+
 	std::vector<std::string> getTreeNames();
 	std::vector<std::string> getColNames(
 			const std::string &treeName,
@@ -127,6 +132,10 @@ public:
 	Int_t                 getXboxVersion(const std::string &sKey);
 	void                  getPeriodBounds(const std::string &sKey,
 							TTimeStamp &lbnd, TTimeStamp &ubnd);
+	Int_t                 getChannel(const std::string &sKey, size_t idx,
+							XBOX::XboxDAQChannel &ch);
+	Long64_t              findEventTime(const std::string &sKey, const TTimeStamp &ts);
+	Long64_t              findEventPCnt(const std::string &sKey, ULong64_t pcnt);
 
 	// setter
 	void                  setLimitsTime(TTimeStamp begin, TTimeStamp end);
@@ -0,0 +1,75 @@
+/*
+ * XboxAnalyserViewColumn.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef _XBOXANALYSERVIEWCOLUMN_HXX_
+#define _XBOXANALYSERVIEWCOLUMN_HXX_
+
+#include <iostream>
+#include <vector>
+#include <string>
+
+// root
+#include "Rtypes.h"
+#include "TTimeStamp.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Meta data of a channel column.
+/// Compact projection of a column of XBOX::XboxDAQChannel objects onto
+/// the quantities used by the history plots of XBOX::XboxAnalyserView.
+/// Only the corresponding sub-branches of split channel branches are
+/// read, the waveforms are left on disk. Single channels, raw data
+/// included, are read on demand (see readChannel()) by their file and
+/// their entry in the file, so that only the file of the channel is
+/// opened.
+class XboxAnalyserViewColumn {
+
+public:
+	std::vector<std::string> fFilePaths;              ///<Input files (wildcards resolved).
+	std::string           fTreeName;                  ///<Name of the tree.
+	std::string           fColName;                   ///<Name of the channel column.
+	Int_t                 fXboxVersion;               ///<Version of Xbox.
+
+	std::vector<Int_t>    fFile;                      ///<Files (index of fFilePaths).
+	std::vector<Long64_t> fEntry;                     ///<Entries in the files.
+	std::vector<TTimeStamp> fTimeStamp;               ///<Time stamps.
+	std::vector<ULong64_t> fPulseCount;               ///<Pulse counts.
+	std::vector<Double_t> fYmean;                     ///<Average power over the pulse length.
+	std::vector<Double_t> fXmin;                      ///<Rising edges.
+	std::vector<Double_t> fXmax;                      ///<Falling edges.
+	std::vector<Bool_t>   fBreakdownFlag;             ///<Breakdown flags.
+
+	XboxAnalyserViewColumn();
+	~XboxAnalyserViewColumn();
+
+	void                  clear();
+	void                  reserve(size_t n);
+	void                  push_back(const XBOX::XboxDAQChannel &ch, Int_t file, Long64_t entry);
+	void                  permute(const std::vector<size_t> &order);
+
+	size_t                size() const { return fEntry.size(); }
+	Bool_t                empty() const { return fEntry.empty(); }
+
+	// io methods
+	Int_t                 read(const std::vector<std::string> &filePaths,
+			                const std::string &treeName, const std::string &colName);
+	Int_t                 readChannel(size_t idx, XBOX::XboxDAQChannel &ch) const;
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* _XBOXANALYSERVIEWCOLUMN_HXX_ */
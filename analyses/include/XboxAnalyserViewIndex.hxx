@@ -0,0 +1,85 @@
+/*
+ * XboxAnalyserViewIndex.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef _XBOXANALYSERVIEWINDEX_HXX_
+#define _XBOXANALYSERVIEWINDEX_HXX_
+
+#include <iostream>
+#include <vector>
+
+// root
+#include "Rtypes.h"
+#include "TTimeStamp.h"
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Event index of a category.
+/// Sorted permutations of the events of a category (channel column or
+/// tuple) on time stamp and pulse count. The events themselves are left
+/// in place. Range queries return the selected events in O(log n + k)
+/// and nearest neighbour queries take O(log n) by binary search on the
+/// sorted keys. Positions refer to the sorted order, events to the
+/// order of the category.
+class XboxAnalyserViewIndex {
+
+private:
+	std::vector<size_t>     fOrderTime;               ///<Events in order of the time stamp.
+	std::vector<size_t>     fOrderPCnt;               ///<Events in order of the pulse count.
+	std::vector<TTimeStamp> fTime;                    ///<Sorted time stamps.
+	std::vector<ULong64_t>  fPCnt;                    ///<Sorted pulse counts.
+
+	static Long64_t       diffTime(const TTimeStamp &t1, const TTimeStamp &t0);
+
+public:
+	XboxAnalyserViewIndex();
+	XboxAnalyserViewIndex(const std::vector<TTimeStamp> &time,
+			const std::vector<ULong64_t> &pcnt);
+	~XboxAnalyserViewIndex();
+
+	void                  build(const std::vector<TTimeStamp> &time,
+			                const std::vector<ULong64_t> &pcnt);
+	void                  clear();
+
+	// getter
+	size_t                size() const { return fTime.size(); }
+	Bool_t                empty() const { return fTime.empty(); }
+	size_t                getEventByTime(size_t pos) const { return fOrderTime[pos]; }
+	size_t                getEventByPCnt(size_t pos) const { return fOrderPCnt[pos]; }
+	const TTimeStamp&     getTime(size_t pos) const { return fTime[pos]; }
+	ULong64_t             getPCnt(size_t pos) const { return fPCnt[pos]; }
+	const std::vector<TTimeStamp>& getTimeSorted() const { return fTime; }
+	const std::vector<ULong64_t>& getPCntSorted() const { return fPCnt; }
+
+	// binary search on the sorted keys
+	size_t                lowerBoundTime(const TTimeStamp &t) const;
+	size_t                upperBoundTime(const TTimeStamp &t) const;
+	size_t                lowerBoundPCnt(ULong64_t pcnt) const;
+	size_t                upperBoundPCnt(ULong64_t pcnt) const;
+
+	// range queries (bounds included)
+	void                  rangeTime(const TTimeStamp &begin, const TTimeStamp &end,
+			                size_t &first, size_t &last) const;
+	void                  rangePCnt(ULong64_t min, ULong64_t max,
+			                size_t &first, size_t &last) const;
+	std::vector<size_t>   selectTime(const TTimeStamp &begin, const TTimeStamp &end) const;
+	std::vector<size_t>   selectPCnt(ULong64_t min, ULong64_t max) const;
+
+	// nearest neighbour queries
+	Long64_t              nearestTime(const TTimeStamp &t) const;
+	Long64_t              nearestPCnt(ULong64_t pcnt) const;
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* _XBOXANALYSERVIEWINDEX_HXX_ */
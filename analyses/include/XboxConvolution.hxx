@@ -0,0 +1,108 @@
+/*
+ * XboxConvolution.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef _XBOXCONVOLUTION_HXX_
+#define _XBOXCONVOLUTION_HXX_
+
+#include <vector>
+#include <complex>
+
+#include "Rtypes.h"
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+class XboxWorkspace;
+
+////////////////////////////////////////////////////////////////////////
+/// Convolution engine.
+/// Convolves signals with a fixed kernel. The first nl and the last nr
+/// points of the full convolution are dropped, i.e. for nl + nr equal
+/// to the kernel length minus one the result is aligned with the signal
+/// ("same" mode). Short kernels are applied directly in a branch free
+/// loop over contiguous memory which the compiler vectorises. Long
+/// kernels are applied by overlap-save FFT convolution with the kernel
+/// spectrum computed once. By default the method is selected from the
+/// estimated number of operations.
+/// Outside the signal the samples are either zero or continued by the
+/// nearest sample. The latter avoids the artificial edges which zero
+/// padding introduces for signals with an offset.
+/// The engine is immutable after setKernel(), so a single instance can
+/// be applied concurrently from several threads.
+class XboxConvolution {
+
+public:
+	enum EMethod {
+		kAuto,                                        ///<Select by the estimated cost.
+		kDirect,                                      ///<Direct summation.
+		kFFT                                          ///<Overlap-save FFT convolution.
+	};                                                ///<Convolution methods.
+
+	enum EBoundary {
+		kZero,                                        ///<Zero padding.
+		kNearest                                      ///<Continuation by the nearest sample.
+	};                                                ///<Signal extension beyond the bounds.
+
+private:
+	std::vector<Double_t> fKernel;                    ///<Kernel.
+	std::vector<Float_t>  fKernelF;                   ///<Kernel in single precision.
+	Int_t                 fNl;                        ///<Number of points to drop at the beginning.
+	Int_t                 fNr;                        ///<Number of points to drop at the end.
+
+	EMethod               fMethod;                    ///<Convolution method.
+	EBoundary             fBoundary;                  ///<Signal extension beyond the bounds.
+
+	Int_t                 fFFTSize;                   ///<Block size of the FFT convolution (0: not prepared).
+	std::vector<std::complex<Double_t>> fSpectrum;    ///<Spectrum of the kernel.
+	std::vector<std::complex<Double_t>> fTwiddle;     ///<Twiddle factors of the FFT.
+
+	void                  prepareFFT();
+	void                  fft(std::complex<Double_t> *x, Bool_t inverse) const;
+	Bool_t                useFFT(Int_t nout) const;
+
+	template <typename T>
+	void                  extend(std::vector<T> &p, const std::vector<T> &f, Int_t nout) const;
+	template <typename T>
+	void                  direct(T *out, const std::vector<T> &p, const std::vector<T> &kernel,
+			Int_t nout) const;
+	template <typename T>
+	void                  overlapSave(T *out, const std::vector<T> &p, Int_t nout,
+			std::vector<std::complex<Double_t>> &x) const;
+	template <typename T>
+	Int_t                 convolve(std::vector<T> &out, const std::vector<T> &f,
+			const std::vector<T> &kernel, XboxWorkspace *ws) const;
+
+public:
+	XboxConvolution();
+	XboxConvolution(const std::vector<Double_t> &kernel, Int_t nl, Int_t nr,
+			EBoundary boundary=kNearest, EMethod method=kAuto);
+	~XboxConvolution();
+
+	void                  setKernel(const std::vector<Double_t> &kernel, Int_t nl, Int_t nr,
+			EBoundary boundary=kNearest, EMethod method=kAuto);
+
+	Bool_t                isEmpty() const { return fKernel.empty(); }
+	const std::vector<Double_t>& getKernel() const { return fKernel; }
+	Int_t                 getNl() const { return fNl; }
+	Int_t                 getNr() const { return fNr; }
+	EMethod               getMethod() const { return fMethod; }
+	EBoundary             getBoundary() const { return fBoundary; }
+
+	Int_t                 apply(std::vector<Double_t> &out, const std::vector<Double_t> &f,
+			XboxWorkspace *ws=NULL) const;
+	Int_t                 apply(std::vector<Float_t> &out, const std::vector<Float_t> &f,
+			XboxWorkspace *ws=NULL) const;
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* _XBOXCONVOLUTION_HXX_ */
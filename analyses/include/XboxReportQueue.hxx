@@ -0,0 +1,156 @@
+/*
+ * XboxReportQueue.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef _XBOXREPORTQUEUE_HXX_
+#define _XBOXREPORTQUEUE_HXX_
+
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+
+#include "Rtypes.h"
+#include "XboxDAQChannel.hxx"
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Report request.
+/// Captures what is needed to render the report of a single evaluation
+/// later on: copies of the evaluated channels (raw data and meta data
+/// only, the decoded samples are dropped), the results of the evaluation
+/// and the function which renders the report from them.
+class XboxReportRecord {
+
+public:
+	std::vector<XBOX::XboxDAQChannel> fChannels;      ///<Evaluated channels.
+	std::vector<Double_t> fResults;                   ///<Results of the evaluation.
+	std::function<void(XboxReportRecord &rec)> fRender; ///<Renders the report.
+
+	void                  addChannel(const XBOX::XboxDAQChannel &ch);
+};
+
+
+////////////////////////////////////////////////////////////////////////
+/// Background rendering of reports.
+/// Report records are queued by the evaluators and rendered one after
+/// another by a single worker thread, so that the creation of canvases
+/// and image files does not block the event loop. The queue is bounded:
+/// if the worker falls behind, new records are dropped (and counted)
+/// rather than stalling the evaluation. The rendering holds the report
+/// mutex (see getReportMutex()) like the synchronous reports. As for any
+/// ROOT graphics outside of the main thread, batch mode and
+/// ROOT::EnableThreadSafety() are expected.
+/// The queue is shared by all evaluators (see instance()). Pending
+/// records are rendered on flush() and stop(), which the program has to
+/// call before it ends: records still pending when the queue is
+/// destroyed are discarded, as the graphics may already be torn down.
+/// Dropped and discarded records are reported as warnings.
+class XboxReportQueue {
+
+private:
+	std::deque<XboxReportRecord> fQueue;              ///<Pending records.
+	size_t                fCapacity;                  ///<Maximum number of pending records.
+	Bool_t                fBusy;                      ///<Worker is rendering a record.
+	Bool_t                fStop;                      ///<Worker is requested to terminate.
+
+	ULong64_t             fNSubmitted;                ///<Number of queued records.
+	ULong64_t             fNRendered;                 ///<Number of rendered records.
+	ULong64_t             fNDropped;                  ///<Number of records dropped as the queue was full.
+	ULong64_t             fNDroppedReported;          ///<Number of dropped records already reported.
+
+	std::mutex            fMutex;                     ///<Protects the queue and the counters.
+	std::condition_variable fCondPending;             ///<Signals new records to the worker.
+	std::condition_variable fCondIdle;                ///<Signals an empty queue to flush().
+	std::thread           fWorker;                    ///<Worker thread (started on demand).
+
+	void                  run();
+	void                  reportDropped();
+
+public:
+	XboxReportQueue(size_t capacity=64);
+	~XboxReportQueue();
+
+	XboxReportQueue(const XboxReportQueue&) = delete;
+	XboxReportQueue& operator=(const XboxReportQueue&) = delete;
+
+	static XboxReportQueue& instance();
+
+	void                  setCapacity(size_t n);
+	size_t                getCapacity();
+
+	Bool_t                push(XboxReportRecord &&rec);
+	void                  flush();
+	void                  stop();
+
+	ULong64_t             getNSubmitted();
+	ULong64_t             getNRendered();
+	ULong64_t             getNDropped();
+};
+
+
+////////////////////////////////////////////////////////////////////////
+/// Report policy of an evaluator.
+/// Selects the evaluations to be reported and passes their records on,
+/// either directly to the rendering (synchronous, default) or to the
+/// report queue (asynchronous, see setAsync()). Asynchronous reports
+/// need XboxReportQueue::flush() before the end of the program. The
+/// selection is based on the result of the evaluation:
+///   - kSampleAll: every evaluation.
+///   - kSampleEveryNth: every Nth evaluation (the first one included).
+///   - kSampleFailures: evaluations which failed (result -1).
+///   - kSampleOutliers: failures and results outside a given range.
+/// The count of evaluations is shared by the threads.
+class XboxReportPolicy {
+
+public:
+	enum ESampling {
+		kSampleAll,
+		kSampleEveryNth,
+		kSampleFailures,
+		kSampleOutliers
+	};                                                ///<Selection of the reported evaluations.
+
+private:
+	ESampling             fSampling;                  ///<Selection of the reported evaluations.
+	ULong64_t             fNth;                       ///<Report every Nth evaluation.
+	Double_t              fOutlierMin;                ///<Lower bound of regular results.
+	Double_t              fOutlierMax;                ///<Upper bound of regular results.
+	Bool_t                fAsync;                     ///<Render in the background.
+
+	mutable std::atomic<ULong64_t> fNEvaluations;     ///<Number of evaluations so far.
+
+public:
+	XboxReportPolicy();
+	XboxReportPolicy(const XboxReportPolicy &other);
+	XboxReportPolicy& operator=(const XboxReportPolicy &other);
+	~XboxReportPolicy();
+
+	void                  setSampling(ESampling val, ULong64_t nth=1);
+	void                  setOutlierRange(Double_t min, Double_t max);
+	void                  setAsync(Bool_t val) { fAsync = val; }
+
+	ESampling             getSampling() const { return fSampling; }
+	Bool_t                isAsync() const { return fAsync; }
+
+	Bool_t                accept(Double_t result) const;
+	void                  submit(XboxReportRecord &&rec) const;
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* _XBOXREPORTQUEUE_HXX_ */
@@ -0,0 +1,85 @@
+/*
+ * XboxResampler.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef _XBOXRESAMPLER_HXX_
+#define _XBOXRESAMPLER_HXX_
+
+#include <vector>
+
+#include "Rtypes.h"
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+class XboxWorkspace;
+
+////////////////////////////////////////////////////////////////////////
+/// Re-sampling engine for uniformly sampled signals.
+/// Interpolates signals by natural cubic splines (as XBOX::CubicSpline)
+/// and evaluates them at a predefined set of points. The engine exploits
+/// that the nodes are equidistant:
+/// - The interval and the offset of each re-sampling point are computed
+///   once by setGrid() rather than searched for each signal.
+/// - The tridiagonal system of the spline has constant coefficients, so
+///   its pivots are independent of the signal and tabulated once for
+///   the whole process.
+/// - Only the curvature at the nodes is solved for. The polynomial
+///   coefficients are formed at the re-sampling points only.
+/// A grid is therefore set up once and applied to any number of signals
+/// with the same timing, e.g. a signal and its derivatives or several
+/// channels of an event. The engine is immutable after setGrid(), so a
+/// single instance can be applied concurrently from several threads.
+/// Points outside the nodes take the value of the nearest node.
+class XboxResampler {
+
+	Double_t              fX0;                        ///<Position of the first node.
+	Double_t              fH;                         ///<Distance of the nodes.
+	Int_t                 fNNodes;                    ///<Number of nodes.
+
+	std::vector<Int_t>    fIndex;                     ///<Interval of each re-sampling point.
+	std::vector<Double_t> fOffset;                    ///<Offset of each re-sampling point within its interval.
+
+	void                  evaluate(Double_t *ys, const std::vector<Double_t> &y,
+			const std::vector<Double_t> &b) const;
+
+public:
+	XboxResampler();
+	XboxResampler(Double_t x0, Double_t h, Int_t nnodes, const std::vector<Double_t> &xs);
+	XboxResampler(Double_t x0, Double_t h, Int_t nnodes, Double_t xmin, Double_t xmax,
+			Int_t nsamples);
+	~XboxResampler();
+
+	void                  setGrid(Double_t x0, Double_t h, Int_t nnodes,
+			const std::vector<Double_t> &xs);
+	void                  setGrid(Double_t x0, Double_t h, Int_t nnodes,
+			Double_t xmin, Double_t xmax, Int_t nsamples);
+
+	Bool_t                isEmpty() const { return fNNodes == 0; }
+	Double_t              getX0() const { return fX0; }
+	Double_t              getH() const { return fH; }
+	Int_t                 getNNodes() const { return fNNodes; }
+	Int_t                 getNSamples() const { return fIndex.size(); }
+
+	Int_t                 apply(std::vector<Double_t> &ys, const std::vector<Double_t> &y,
+			XboxWorkspace *ws=NULL) const;
+	Int_t                 apply(std::vector<std::vector<Double_t>> &ys,
+			const std::vector<std::vector<Double_t>> &y, XboxWorkspace *ws=NULL) const;
+
+	// signals re-sampled on several grids (curvature solved once)
+	void                  curvature(std::vector<Double_t> &b, const std::vector<Double_t> &y) const;
+	Int_t                 apply(std::vector<Double_t> &ys, const std::vector<Double_t> &y,
+			const std::vector<Double_t> &b) const;
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* _XBOXRESAMPLER_HXX_ */
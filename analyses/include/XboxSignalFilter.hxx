@@ -9,19 +9,26 @@
 #define _XBOXSIGNALFILTER_HXX_
 
 #include <iostream>
+#include <memory>
+#include <initializer_list>
 
 #include "Rtypes.h"
 #include "XboxDAQChannel.hxx"
+#include "XboxConvolution.hxx"
+#include "XboxWorkspace.hxx"
 
 
 #ifndef XBOX_NO_NAMESPACE
 namespace XBOX {
 #endif
 
+class XboxSignalTrace;
 
 
 class XboxSignalFilter {
 
+	friend class XboxSignalTrace;
+
 public:
 
 	enum EFilterType {
@@ -39,18 +46,43 @@ protected:
 
 	Int_t                 fDerivative;     ///<Degree of derivative.
 
+	XboxDAQChannel::EPrecision fPrecision; ///<Precision of the channel signal and the convolution.
+	XboxConvolution::EBoundary fBoundary;  ///<Signal extension beyond the bounds.
+
+	struct Plan_t {
+		XboxConvolution   fConv;               ///<Convolution with the filter kernel (empty for the identity).
+	};                                     ///<Filter plan.
+
+	std::shared_ptr<const Plan_t> fPlan;   ///<Filter plan of the configuration (unit time resolution).
+
 	std::vector<Double_t> savgol(Int_t m, Int_t nl, Int_t nr, Int_t ld=0) const;
-	std::vector<Double_t> conv(const std::vector<Double_t> &f,
-			const std::vector<Double_t> &kernel, Int_t nl=0, Int_t nr=0) const;
 
-	std::vector<Double_t> filter (std::vector<Double_t> &vec) const;
-	std::vector<Double_t> filterP1 (std::vector<Double_t> &vec, Double_t dt) const; // first derivative
-	std::vector<Double_t> filterP2 (std::vector<Double_t> &vec, Double_t dt) const; // second derivative
+	Int_t                 getKernel(std::vector<Double_t> &kernel, Int_t &nl, Int_t &nr,
+			Int_t derivative, Double_t dt) const;
+	void                  resolvePlan();
+	void                  scale(std::vector<Double_t> &res, Double_t dt) const;
+
+	Int_t                 filter (std::vector<Double_t> &res, const std::vector<Double_t> &vec,
+			Double_t dt, XboxWorkspace *ws=NULL) const;
+	Int_t                 filterF (std::vector<Double_t> &res, const std::vector<Float_t> &vec,
+			Double_t dt, XboxWorkspace *ws=NULL) const; // single precision
+
+	std::vector<Double_t> apply (const XBOX::XboxDAQChannel &ch, Double_t tmin, Double_t tmax) const;
 
 	std::vector<Double_t> resample (std::vector<Double_t> &x, std::vector<Double_t> &y,
 			Double_t lowerlimit, Double_t upperlimit, Int_t nsamples) const;
 	std::vector<Double_t> resample (std::vector<Double_t> &x, std::vector<Double_t> &y,
-			std::vector<Double_t> &xs) const;
+			const std::vector<Double_t> &xs) const;
+
+	static void           getSupport (const XboxSignalFilter * const *filters, size_t nfilters,
+			Int_t &nl, Int_t &nr, Bool_t &bdouble, Bool_t &bfloat);
+	static Int_t          filterAndResample (Double_t t0, Double_t h, Double_t dt,
+			const std::vector<Double_t> &y, const std::vector<Float_t> &yF,
+			const std::vector<Double_t> &ts, const XboxSignalFilter * const *filters,
+			size_t nfilters, std::vector<std::vector<Double_t>> &res, XboxWorkspace &ws);
+	static Int_t          evaluate (const XBOX::XboxDAQChannel &ch, const std::vector<Double_t> &ts,
+			const XboxSignalFilter * const *filters, size_t nfilters,
+			std::vector<std::vector<Double_t>> &res, XboxWorkspace &ws);
 
 
 public:
@@ -61,21 +93,42 @@ public:
 
 	void config(const EFilterType &filtertype, Int_t order, Int_t nl, Int_t nr);
 	void setDerivative(Int_t val);
+	void setPrecision(XboxDAQChannel::EPrecision val) { fPrecision = val; }
+	void setBoundary(XboxConvolution::EBoundary val) { fBoundary = val; resolvePlan(); }
+	std::string getConfig() const;
+	Int_t getMargin() const;
+
+	Bool_t operator == (const XboxSignalFilter &other) const;
+	Bool_t operator != (const XboxSignalFilter &other) const { return !(*this == other); }
 
+	// the filter is immutable during evaluation and can be shared by threads
 	std::vector<Double_t> operator ()
-					(std::vector<Double_t> y);
+					(std::vector<Double_t> y) const;
+
+	Int_t                 operator ()
+					(std::vector<Double_t> &res, const std::vector<Double_t> &y,
+					XboxWorkspace *ws=NULL) const;
 
 	std::vector<Double_t> operator ()
-					(XBOX::XboxDAQChannel &ch);
+					(const XBOX::XboxDAQChannel &ch) const;
 
 	std::vector<Double_t> operator ()
-				(XBOX::XboxDAQChannel &ch, Double_t lowerlimit, Double_t upperlimit);
+				(const XBOX::XboxDAQChannel &ch, Double_t lowerlimit, Double_t upperlimit) const;
 
 	std::vector<Double_t> operator ()
-			(XBOX::XboxDAQChannel &ch, Double_t lowerlimit, Double_t upperlimit, Int_t nsamples);
+			(const XBOX::XboxDAQChannel &ch, Double_t lowerlimit, Double_t upperlimit,
+			Int_t nsamples) const;
 
 	std::vector<Double_t> operator ()
-				(XBOX::XboxDAQChannel &ch, std::vector<Double_t> &t);
+				(const XBOX::XboxDAQChannel &ch, const std::vector<Double_t> &t) const;
+
+	static Int_t          evaluate (const XBOX::XboxDAQChannel &ch, const std::vector<Double_t> &ts,
+			const std::vector<const XboxSignalFilter*> &filters,
+			std::vector<std::vector<Double_t>> &res, XboxWorkspace *ws=NULL);
+
+	static Int_t          evaluate (const XBOX::XboxDAQChannel &ch, const std::vector<Double_t> &ts,
+			std::initializer_list<const XboxSignalFilter*> filters,
+			std::vector<std::vector<Double_t>> &res, XboxWorkspace *ws=NULL);
 
 };
 
@@ -0,0 +1,102 @@
+/*
+ * XboxSignalTrace.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef _XBOXSIGNALTRACE_HXX_
+#define _XBOXSIGNALTRACE_HXX_
+
+#include <vector>
+#include <initializer_list>
+
+#include "Rtypes.h"
+#include "XboxDAQChannel.hxx"
+#include "XboxDataSpan.hxx"
+#include "XboxResampler.hxx"
+#include "XboxSignalFilter.hxx"
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+////////////////////////////////////////////////////////////////////////
+/// Decoded signal of a channel.
+/// Holds the calibrated samples of a time window of a channel together
+/// with the samples smoothed by a filter and the curvature of their
+/// interpolating spline. The window is decoded once per event and
+/// smoothed once per filter, while any number of evaluations re-sample
+/// the smoothed signal on their own grids, detect edges or take window
+/// statistics without reading the channel again. Edges and statistics
+/// of windows not covered by the decoded samples, or in a precision
+/// other than double, are taken from the channel, which must therefore
+/// outlive the evaluation of the trace. The time axis can be shifted
+/// (e.g. by the jitter) without touching the samples. The time windows
+/// follow the conventions of XBOX::XboxDAQChannel and refer to the whole
+/// record of the channel.
+class XboxSignalTrace {
+
+private:
+	const XboxDAQChannel *fChannel;                   ///<Channel of the samples.
+	Double_t              fStartOffset;               ///<Time of the first sample of the record.
+	Double_t              fIncrement;                 ///<Sample increment.
+	Int_t                 fNSamples;                  ///<Number of samples of the record.
+	Int_t                 fFirst;                     ///<Index of the first decoded sample.
+
+	std::vector<Double_t> fSignal;                    ///<Calibrated samples.
+	std::vector<Double_t> fSmooth;                    ///<Smoothed samples.
+	std::vector<Double_t> fCurvature;                 ///<Spline curvature of the smoothed samples.
+	XboxSignalFilter      fFilter;                    ///<Filter of the smoothed samples.
+
+	XboxResampler         fResampler;                 ///<Grid of the last re-sampling.
+
+	Bool_t                covers(Int_t i0, Int_t i1) const;
+	Double_t              toChannel(Double_t t) const;
+	XboxTimeAxis          viewDecoded() const;
+
+public:
+	XboxSignalTrace();
+	~XboxSignalTrace();
+
+	void                  clear();
+
+	Int_t                 load(const XboxDAQChannel &ch, Double_t t0=-1, Double_t t1=-1);
+	Int_t                 smooth(const XboxSignalFilter &filter, XboxWorkspace &ws);
+	Bool_t                covers(Double_t t0, Double_t t1) const;
+
+	// time axis
+	void                  setStartOffset(Double_t val) { fStartOffset = val; }
+	Double_t              getStartOffset() const { return fStartOffset; }
+	Double_t              getIncrement() const { return fIncrement; }
+	Int_t                 getSamples() const { return fNSamples; }
+	void                  getTimeAxisBounds(Double_t &t0, Double_t &t1) const;
+	Int_t                 getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1) const;
+	XboxTimeAxis          viewTimeAxis(Double_t t0=-1, Double_t t1=-1) const;
+
+	// decoded samples (starting at the sample getFirst() of the record)
+	Int_t                 getFirst() const { return fFirst; }
+	const std::vector<Double_t>& getSignal() const { return fSignal; }
+	const std::vector<Double_t>& getSmooth() const { return fSmooth; }
+
+	XboxDAQChannel::Stats_t stats(Double_t t0=-1, Double_t t1=-1,
+			UInt_t mask=XboxDAQChannel::kStatAll) const;
+	Double_t              risingEdge(Double_t threshold=0.9, Double_t t0=-1, Double_t t1=-1,
+			XboxDAQChannel::EPrecision prec=XboxDAQChannel::kPrecDouble) const;
+	Double_t              fallingEdge(Double_t threshold=0.9, Double_t t0=-1, Double_t t1=-1,
+			XboxDAQChannel::EPrecision prec=XboxDAQChannel::kPrecDouble) const;
+
+	// re-sampling
+	Int_t                 resample(std::vector<Double_t> &ys, const std::vector<Double_t> &ts);
+	Int_t                 evaluate(const std::vector<Double_t> &ts,
+			std::initializer_list<const XboxSignalFilter*> filters,
+			std::vector<std::vector<Double_t>> &res, XboxWorkspace &ws) const;
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* _XBOXSIGNALTRACE_HXX_ */
@@ -0,0 +1,106 @@
+/*
+ * XboxWorkspace.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef _XBOXWORKSPACE_HXX_
+#define _XBOXWORKSPACE_HXX_
+
+#include <vector>
+#include <deque>
+#include <complex>
+
+#include "Rtypes.h"
+#include "XboxResampler.hxx"
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Scratch memory of the signal evaluation.
+/// Hands out temporary buffers for the filters, the convolution and the
+/// re-sampling. The buffers are taken one after another from a pool and
+/// are all returned at once by reset() at the beginning of an event
+/// (arena). Since the buffers keep their capacity, the evaluation of
+/// events of similar size does not allocate any memory after the first
+/// few events. The number of allocations (new buffers and buffers which
+/// had to grow) is counted to verify this.
+/// A workspace must not be shared by threads. The evaluators hold one
+/// per processing slot (or per thread).
+class XboxWorkspace {
+
+private:
+	template <typename T>
+	struct Pool_t {
+		std::deque<std::vector<T>> fBuffers;              ///<Buffers (stable addresses).
+		std::deque<size_t>    fCapacity;              ///<Capacity of the buffers when handed out.
+		size_t                fNUsed;                 ///<Number of buffers handed out since the reset.
+		Pool_t() : fNUsed{0} {}
+	};                                                ///<Pool of buffers of the same type.
+
+	Pool_t<Double_t>      fPoolD;                     ///<Pool of double buffers.
+	Pool_t<Float_t>       fPoolF;                     ///<Pool of float buffers.
+	Pool_t<std::complex<Double_t>> fPoolC;            ///<Pool of complex buffers.
+
+	XboxResampler         fResampler;                 ///<Re-sampling engine re-used for each grid.
+	ULong64_t             fNAllocations;              ///<Number of allocations.
+
+	Pool_t<Double_t>&     pool(Double_t*) { return fPoolD; }
+	Pool_t<Float_t>&      pool(Float_t*) { return fPoolF; }
+	Pool_t<std::complex<Double_t>>& pool(std::complex<Double_t>*) { return fPoolC; }
+
+	template <typename T>
+	ULong64_t             countGrowth(const Pool_t<T> &pool) const;
+	template <typename T>
+	void                  release(Pool_t<T> &pool);
+
+public:
+	XboxWorkspace();
+	~XboxWorkspace();
+
+	void                  reset();
+
+	template <typename T>
+	std::vector<T>&       get(size_t n);
+
+	XboxResampler&        getResampler() { return fResampler; }
+	ULong64_t             getNAllocations() const;
+	size_t                getNBuffers() const;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+/// Buffer.
+/// Takes the next buffer of the pool and resizes it. The content is
+/// undefined. The buffer is valid until the next reset().
+/// \param[in] n The size of the buffer.
+/// \return The buffer.
+template <typename T>
+std::vector<T>& XboxWorkspace::get(size_t n) {
+
+	Pool_t<T> &p = pool(static_cast<T*>(0));
+	if (p.fNUsed == p.fBuffers.size()) {
+		p.fBuffers.emplace_back();
+		p.fCapacity.push_back(0);
+		fNAllocations++;
+	}
+
+	std::vector<T> &buffer = p.fBuffers[p.fNUsed];
+	p.fCapacity[p.fNUsed] = buffer.capacity();
+	p.fNUsed++;
+
+	buffer.resize(n);
+	return buffer;
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* _XBOXWORKSPACE_HXX_ */
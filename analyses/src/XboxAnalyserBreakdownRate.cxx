@@ -1,5 +1,8 @@
 #include "XboxAnalyserBreakdownRate.hxx"
 
+#include <algorithm>
+#include <cmath>
+
 // root
 #include "TMath.h"
 
@@ -29,6 +32,7 @@ void XboxAnalyserBreakdownRate::init() {
 	fWeightType = kGaussian;
 	fSigma = 0.1;
 	fNSigma = 3;
+	fKernelRes = 1024;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -122,139 +126,121 @@ void XboxAnalyserBreakdownRate::fromEquidistantPCnt(std::vector<ULong64_t> &pcnt
 
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Tabulation of the weighting function.
+/// Samples the gaussian per unit sigma up to one sigma beyond the cut,
+/// which covers the distances occurring in fromMovingWindow().
+void XboxAnalyserBreakdownRate::tabulateKernel() {
+
+	size_t n = (fNSigma + 1) * fKernelRes + 2;
+	if (fKernel.size() == n)
+		return;
+
+	fKernel.resize(n);
+	for (size_t k=0; k<n; k++) {
+		Double_t x = (Double_t)k / fKernelRes;
+		fKernel[k] = exp(-0.5 * x * x);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Weighting function.
+/// Linear interpolation of the tabulated gaussian (relative error below
+/// 1e-6 for the default resolution). Distances beyond the table are
+/// evaluated directly.
+/// \param[in] x The distance in units of sigma.
+/// \return The weight.
+Double_t XboxAnalyserBreakdownRate::kernel(Double_t x) const {
+
+	Double_t u = x * fKernelRes;
+	size_t k = (size_t)u;
+	if (k + 1 >= fKernel.size())
+		return exp(-0.5 * x * x);
+
+	return fKernel[k] + (u - k) * (fKernel[k+1] - fKernel[k]);
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Evaluation of the breakdown rate.
 /// The breakdown rate is evaluated by the difference of pulse counts between
 /// subsequent events. A moving gaussian weighting function is used to smooth
-/// the resulting breakdown rate over pulse count.
+/// the resulting breakdown rate over pulse count. Only past events are
+/// weighted: for each sampling point the events within the cut before its
+/// nearest neighbour contribute.
+/// The events are expected in ascending order of the pulse count (a sorted
+/// copy is used otherwise). Since the sampling points ascend as well, the
+/// nearest neighbour and the lower end of the window are tracked by two
+/// pointers, so that the cost is linear in the number of events plus the
+/// total size of the windows, without any allocation per sampling point.
+/// The weights are taken from a table of the gaussian.
 /// \param[out] pcnt the vector of pulse counts.
 /// \param[out] rate the vector of breakdown rates.
 void XboxAnalyserBreakdownRate::fromMovingWindow(std::vector<ULong64_t> &pcnt,
 		std::vector<Double_t> &rate) {
 
-	size_t n = fPCnt.size();
-	pcnt.resize(fNSamples);
-	rate.resize(fNSamples);
+	pcnt.assign(fNSamples, 0);
+	rate.assign(fNSamples, 0.);
+	if (fPCnt.empty() || fNSamples <= 0)
+		return;
 
-	ULong64_t pcntMin = *std::min_element(fPCnt.begin(), fPCnt.end());
-	ULong64_t pcntMax = *std::max_element(fPCnt.begin(), fPCnt.end());
+	std::vector<ULong64_t> sorted;
+	if (!std::is_sorted(fPCnt.begin(), fPCnt.end())) {
+		sorted = fPCnt;
+		std::sort(sorted.begin(), sorted.end());
+	}
+	const std::vector<ULong64_t> &v = sorted.empty() ? fPCnt : sorted;
+	size_t n = v.size();
+
+	ULong64_t pcntMin = v.front();
+	ULong64_t pcntMax = v.back();
 	ULong64_t pcntInc = (pcntMax - pcntMin) / fNSamples;
 	ULong64_t pcntSig = (pcntMax - pcntMin) * fSigma;
 	ULong64_t pcntCut = (pcntMax - pcntMin) * fSigma * fNSigma;
 	ULong64_t pcntVal = pcntMin;
 
-	for (size_t ipnt=0; ipnt<fNSamples; ipnt++) {
+	tabulateKernel();
 
-		// search for nearest neighbour index
-		size_t idxNN=0;
-		Bool_t bUpperNN = false;
-		ULong64_t pcntDist = 0;
-
-		if (fPCnt.back() < pcntVal) {
-			idxNN = n-1;
-			pcntDist = pcntVal - fPCnt[idxNN];
-			bUpperNN = false;
-		}
-		else {
-			for (size_t i=1; i < n; i++) {
-				if (pcntVal < fPCnt[i]) {
-					if ((fPCnt[i]-pcntVal) < (pcntVal-fPCnt[i-1])) {
-						idxNN = i;
-						pcntDist = fPCnt[i] - pcntVal;
-						bUpperNN = true;
-					}
-					else
-						idxNN = i-1;
-						pcntDist = pcntVal - fPCnt[i];
-						bUpperNN = false;
-					break;
-				}
-			}
-		}
+	size_t iu = 1; // first event beyond the sampling point
+	size_t il = 0; // first event within the cut
+	for (Int_t ipnt=0; ipnt<fNSamples; ipnt++) {
 
-		// disable weighting by future points. The nearest neighbour must not
-		// be on the upper side.
-		if (bUpperNN) {
-			idxNN--;
-			pcntDist = pcntVal - fPCnt[idxNN];
-			bUpperNN = false;
-		}
+		// nearest neighbour. The weights are measured from the first
+		// event beyond the sampling point (the last event if there is none)
+		while (iu < n && v[iu] <= pcntVal)
+			iu++;
 
-		// search index of lower bound to span a window over past samples
-		size_t nl=0;
-		ULong64_t lbnd = (fPCnt.front()+pcntCut < pcntVal) ? pcntVal-pcntCut : fPCnt.front();
-		while(nl+1 < idxNN && fPCnt[idxNN-nl-1] >= lbnd)
-			nl++;
-
-		// search index of upper bound to span a window over future samples (disabled)
-		size_t nu=0;
-//		ULong64_t ubnd = (pcntVal+pcntCut < fPCnt.back()) ? pcntVal+pcntCut : fPCnt.back();
-//		while(nu+1 < (fPCnt.size()-idxNN-1) && fPCnt[idxNN+nu+1] <= ubnd)
-//			nu++;
-
-        // breakdown rate and weighting function for each sample
-		std::vector<Double_t> f(nl+nu+1, 0.);
-		std::vector<Double_t> w(nl+nu+1, 1.);
-
-		// breakdown rate and weighting function for nearest neighbour event
-		if (bUpperNN) {
-
-			if (fPCnt[idxNN] > pcntVal) {
-				w[0] = 1.;
-				f[0] = 1. / (fPCnt[idxNN] - pcntVal);
-			}
-			else {
-				w[0] = 0.;
-				f[0] = 0.;
-			}
+		size_t idxNN = 0;
+		ULong64_t pcntRef = pcntVal;
+		if (v.back() < pcntVal) {
+			idxNN = n-1;
+			pcntRef = v[idxNN];
 		}
-		else {
-			if (pcntVal > fPCnt[idxNN]) {
-				w[0] = 1.;
-				f[0] = 1. / (pcntVal-fPCnt[idxNN]);
-			}
-			else {
-				w[0] = 0.;
-				f[0] = 0.;
-			}
+		else if (iu < n) {
+			idxNN = (v[iu] - pcntVal < pcntVal - v[iu-1]) ? iu : iu-1;
+			pcntRef = v[iu];
 		}
 
-		// breakdown rate and weighting function for events after nearest neighbour event
-		for (size_t i=1; i<=nu; i++) {
-			if (fPCnt[idxNN+i] > pcntVal) {
-				Int_t nevents = (bUpperNN) ? i+1 : i; // extra event if NN is after pcnt
-				w[i] = exp(-pow(fPCnt[idxNN+i]-pcntVal+pcntDist, 2.) /
-					(2 * pow(pcntSig, 2)));
-				f[i] = 1. / (fPCnt[idxNN+i]-pcntVal) * nevents;
-			}
-			else {
-				f[i] = 0.;
-				w[i] = 0.;
-			}
+		// window over past events (the first event only serves as neighbour)
+		ULong64_t lbnd = (v.front() + pcntCut < pcntVal) ? pcntVal - pcntCut : v.front();
+		while (il < n && v[il] < lbnd)
+			il++;
+		size_t ilow = (il > 1) ? il : 1;
+
+		// weighted breakdown rate of the nearest neighbour and the past events
+		Double_t rateVal = 0.;
+		Double_t sum = 0.;
+		if (pcntVal > v[idxNN]) {
+			rateVal += 1. / (pcntVal - v[idxNN]);
+			sum += 1.;
 		}
-
-		// breakdown rate and weighting function for events before nearest neighbour event
-		for (size_t i=1; i<=nl; i++) {
-			if (pcntVal > fPCnt[idxNN-i]) {
-				Int_t nevents = (!bUpperNN) ? i : i+1; // extra event if NN is before pcnt
-				w[i+nu] = exp(-pow(pcntVal-pcntDist-fPCnt[idxNN-i], 2.) /
-						(2 * pow(pcntSig, 2)));
-				f[i+nu] = 1. / (pcntVal - fPCnt[idxNN-i]) * nevents;
+		for (size_t j=idxNN; j-- > ilow; ) {
+			if (pcntVal > v[j]) {
+				Double_t w = (pcntSig > 0) ? kernel((Double_t)(pcntRef - v[j]) / pcntSig)
+						: exp(-pow(pcntRef - v[j], 2.) / (2 * pow(pcntSig, 2)));
+				Double_t f = 1. / (pcntVal - v[j]) * (idxNN - j);
+				sum += w;
+				rateVal += w * f;
 			}
-			else {
-				f[i] = 0.;
-				w[i] = 0.;
-			}
-		}
-
-		// weight breakdown rate
-		Double_t rateVal=0.;
-		Double_t sum=0.;
-		for (size_t i=0; i<w.size(); i++) {
-			if (f[i] == 0.)
-				w[i] = 0.;
-			sum += w[i];
-			rateVal += w[i] * f[i];
 		}
 		rateVal /= sum; // normalisation
 
@@ -262,7 +248,6 @@ void XboxAnalyserBreakdownRate::fromMovingWindow(std::vector<ULong64_t> &pcnt,
 		rate[ipnt] = rateVal;
 		pcntVal += pcntInc;
 	}
-
 }
 
 
@@ -0,0 +1,304 @@
+#include "XboxAnalyserBreakdownRateOnline.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+// root
+#include "TFile.h"
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxAnalyserBreakdownRateOnline::XboxAnalyserBreakdownRateOnline() {
+	init();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+/// \param[in] nstep    The number of events per step.
+/// \param[in] pcntStep The pulse count interval.
+/// \param[in] width    The bin width of the gaussian rate (pulses).
+/// \param[in] sigma    The sigma of the gaussian (pulses).
+/// \param[in] nsig     The number of sigma up to the gaussian is truncated.
+XboxAnalyserBreakdownRateOnline::XboxAnalyserBreakdownRateOnline(Int_t nstep,
+		ULong64_t pcntStep, ULong64_t width, Double_t sigma, Int_t nsig) {
+
+	init();
+	configStep(nstep);
+	configPCnt(pcntStep);
+	configGaussian(width, sigma, nsig);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxAnalyserBreakdownRateOnline::~XboxAnalyserBreakdownRateOnline() {
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Default Settings.
+void XboxAnalyserBreakdownRateOnline::init() {
+
+	fNStep = 10;
+	fPCntStep = 100000;
+	fBinWidth = 10000;
+	fSigma = 50000.;
+	fNSigma = 3;
+
+	configGaussian(fBinWidth, fSigma, fNSigma);
+	configStep(fNStep);
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Clear.
+/// Drops all events while keeping the configuration.
+void XboxAnalyserBreakdownRateOnline::clear() {
+
+	fNEvents = 0;
+	fPCntLast = 0;
+
+	std::fill(fRecent.begin(), fRecent.end(), 0);
+	fRecentHead = 0;
+	fRateStep = 0.;
+
+	fIntervalBegin = 0;
+	fIntervalCount = 0;
+	fRatePCnt = 0.;
+	fPCntPCnt = 0;
+
+	std::fill(fBins.begin(), fBins.end(), 0);
+	fBinHead = 0;
+	fBinBegin = 0;
+	fNBins = 0;
+	fRateGauss = 0.;
+	fPCntGauss = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reset.
+void XboxAnalyserBreakdownRateOnline::reset() {
+	init();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Configures the equidistant step rate. The state is cleared.
+/// \param[in] nstep The number of events per step.
+void XboxAnalyserBreakdownRateOnline::configStep(Int_t nstep) {
+
+	fNStep = nstep > 0 ? nstep : 1;
+	fRecent.assign(fNStep + 1, 0);
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Configures the equidistant pulse count rate. The state is cleared.
+/// \param[in] pcntStep The pulse count interval.
+void XboxAnalyserBreakdownRateOnline::configPCnt(ULong64_t pcntStep) {
+
+	fPCntStep = pcntStep > 0 ? pcntStep : 1;
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Configures the gaussian rate. The weights of the past bins are
+/// tabulated up to nsig*sigma. The state is cleared.
+/// \param[in] width The bin width (pulses).
+/// \param[in] sigma The sigma of the gaussian (pulses).
+/// \param[in] nsig  The number of sigma up to the gaussian is truncated.
+void XboxAnalyserBreakdownRateOnline::configGaussian(ULong64_t width,
+		Double_t sigma, Int_t nsig) {
+
+	fBinWidth = width > 0 ? width : 1;
+	fSigma = sigma > 0. ? sigma : fBinWidth;
+	fNSigma = nsig > 0 ? nsig : 1;
+
+	size_t nbins = std::max(1., std::ceil(fNSigma * fSigma / fBinWidth));
+	fWeights.resize(nbins);
+	for (size_t k=0; k<nbins; k++) {
+		Double_t x = (k + 0.5) * fBinWidth / fSigma; // center of the k-th past bin
+		fWeights[k] = exp(-0.5 * x * x);
+	}
+	fBins.assign(nbins, 0);
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Close the open bin.
+/// Evaluates the gaussian rate at the end of the open bin from the
+/// events of the recent bins and opens the next bin.
+void XboxAnalyserBreakdownRateOnline::closeBin() {
+
+	size_t nbins = fBins.size();
+
+	Double_t sum = 0.;
+	Double_t wsum = 0.;
+	for (size_t k=0; k<nbins; k++) {
+		sum += fWeights[k] * fBins[(fBinHead + nbins - k) % nbins];
+		wsum += fWeights[k];
+	}
+	fRateGauss = sum / (wsum * fBinWidth);
+	fPCntGauss = fBinBegin + fBinWidth;
+
+	fBinHead = (fBinHead + 1) % nbins;
+	fBins[fBinHead] = 0;
+	fBinBegin += fBinWidth;
+	fNBins++;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Close the bins up to a pulse count.
+/// Once all recent bins are empty, the remaining bins are skipped at
+/// once as their rate vanishes.
+/// \param[in] pcnt The pulse count.
+/// \return The number of closed bins.
+ULong64_t XboxAnalyserBreakdownRateOnline::closeBins(ULong64_t pcnt) {
+
+	if (!fNEvents || pcnt < fBinBegin + fBinWidth)
+		return 0;
+
+	ULong64_t nclose = (pcnt - fBinBegin) / fBinWidth;
+	ULong64_t nexplicit = std::min<ULong64_t>(nclose, fBins.size());
+
+	for (ULong64_t i=0; i<nexplicit; i++)
+		closeBin();
+
+	if (nclose > nexplicit) {
+		ULong64_t nskip = nclose - nexplicit;
+		fBinBegin += nskip * fBinWidth;
+		fNBins += nskip;
+		fRateGauss = 0.;
+		fPCntGauss = fBinBegin;
+	}
+	return nclose;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Add an event.
+/// Events must be added in ascending order of the pulse count.
+/// The pulse count interval closes with the first event beyond it; this
+/// event opens the next interval.
+/// \param[in] pcnt The pulse count of the breakdown event.
+/// \return The number of gaussian bins closed by the event (at most
+/// kMaxInt, see getNBins() for the total) or -1 if the event is out of
+/// order.
+Int_t XboxAnalyserBreakdownRateOnline::add(ULong64_t pcnt) {
+
+	if (fNEvents && pcnt < fPCntLast) {
+		printf("ERROR: Breakdown event at %llu precedes the last event at %llu\n",
+				(unsigned long long) pcnt, (unsigned long long) fPCntLast);
+		return -1;
+	}
+
+	// gaussian rate
+	if (!fNEvents)
+		fBinBegin = pcnt;
+	ULong64_t nclosed = closeBins(pcnt);
+	fBins[fBinHead]++;
+
+	// equidistant step
+	UInt_t nrecent = fRecent.size();
+	fRecentHead = (fRecentHead + 1) % nrecent;
+	fRecent[fRecentHead] = pcnt;
+	if (fNEvents + 1 >= nrecent) {
+		ULong64_t diff = pcnt - fRecent[(fRecentHead + 1) % nrecent];
+		fRateStep = diff > 0 ? (Double_t) fNStep / diff : 0.;
+	}
+
+	// equidistant pulse count
+	if (!fNEvents) {
+		fIntervalBegin = pcnt;
+		fIntervalCount = 1;
+	}
+	else if (pcnt >= fIntervalBegin + fPCntStep) {
+		fRatePCnt = (Double_t) fIntervalCount / (pcnt - fIntervalBegin);
+		fPCntPCnt = pcnt;
+		fIntervalBegin = pcnt;
+		fIntervalCount = 1;
+	}
+	else
+		fIntervalCount++;
+
+	fPCntLast = pcnt;
+	fNEvents++;
+
+	return std::min<ULong64_t>(nclosed, kMaxInt);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Advance without event.
+/// Closes the gaussian bins up to a pulse count, e.g. to let the rate
+/// decay while the structure runs without breakdowns.
+/// \param[in] pcnt The current pulse count.
+/// \return The number of closed bins (at most kMaxInt, see getNBins()
+/// for the total) or -1 if pcnt is out of order.
+Int_t XboxAnalyserBreakdownRateOnline::advance(ULong64_t pcnt) {
+
+	if (fNEvents && pcnt < fPCntLast) {
+		printf("ERROR: Pulse count %llu precedes the last event at %llu\n",
+				(unsigned long long) pcnt, (unsigned long long) fPCntLast);
+		return -1;
+	}
+	return std::min<ULong64_t>(closeBins(pcnt), kMaxInt);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Checkpoint.
+/// Writes the configuration and the state to a ROOT file. An existing
+/// object with the same key is overwritten.
+/// \param[in] filepath The path of the ROOT file.
+/// \param[in] key The key of the object in the file.
+/// \return 0 on success or -1 if the file could not be opened.
+Int_t XboxAnalyserBreakdownRateOnline::checkpoint(const std::string &filepath,
+		const std::string &key) const {
+
+	TFile file(filepath.c_str(), "UPDATE");
+	if (file.IsZombie()) {
+		printf("ERROR: Cannot open file %s\n", filepath.c_str());
+		return -1;
+	}
+	Write(key.c_str(), TObject::kOverwrite);
+	file.Close();
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Restore.
+/// Reads the configuration and the state from a ROOT file.
+/// \param[in] filepath The path of the ROOT file.
+/// \param[in] key The key of the object in the file.
+/// \return 0 on success or -1 if the object could not be read.
+Int_t XboxAnalyserBreakdownRateOnline::restore(const std::string &filepath,
+		const std::string &key) {
+
+	TFile file(filepath.c_str(), "READ");
+	if (file.IsZombie()) {
+		printf("ERROR: Cannot open file %s\n", filepath.c_str());
+		return -1;
+	}
+
+	XboxAnalyserBreakdownRateOnline *ptr = nullptr;
+	file.GetObject(key.c_str(), ptr);
+	if (!ptr) {
+		printf("ERROR: No breakdown rate %s in file %s\n", key.c_str(), filepath.c_str());
+		return -1;
+	}
+	*this = *ptr;
+	delete ptr;
+	file.Close();
+
+	return 0;
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
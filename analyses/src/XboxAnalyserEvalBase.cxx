@@ -11,6 +11,17 @@ namespace XBOX {
 #endif
 
 
+////////////////////////////////////////////////////////////////////////
+/// Report lock.
+/// The evaluators may run on several threads, whereas the reports create
+/// canvases and write files. Reports are therefore created one at a time.
+/// \return The mutex shared by the reports of all evaluators.
+std::mutex& getReportMutex() {
+
+	static std::mutex mutex;
+	return mutex;
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Constructor.
 XboxAnalyserEvalBase::XboxAnalyserEvalBase() {
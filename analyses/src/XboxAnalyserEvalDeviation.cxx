@@ -5,6 +5,7 @@
 
 // root
 #include "TTimeStamp.h"
+#include "TString.h"
 #include "TH1D.h"
 #include "TMatrixD.h"
 #include "TVectorD.h"
@@ -23,6 +24,7 @@
 
 // xbox
 #include "XboxSignalFilter.hxx"
+#include "XboxSignalKernels.hxx"
 #include "XboxAlgorithms.h"
 
 
@@ -71,6 +73,8 @@ void XboxAnalyserEvalDeviation::init() {
 	fWindowCoarse = 32;
 	fWindowRefine = 8;
 
+	setPrecision(XBOX::XboxDAQChannel::kPrecDouble);
+
 	fReportFlag = false;
 	fReportDir = "";
 }
@@ -109,6 +113,53 @@ void XboxAnalyserEvalDeviation::config(Double_t wmin,
 	fProximity = prox;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The configuration of the evaluator (e.g. part of a cache key).
+std::string XboxAnalyserEvalDeviation::getConfig() const {
+
+	return TString::Format("Deviation(%.17g,%.17g,%.17g,%.17g,%.17g;n=%zu,%zu;w=%zu,%zu;p=%d;",
+			fWmin, fWmax, fThCoarse, fThRefine, fProximity, fSamplesCoarse, fSamplesRefine,
+			fWindowCoarse, fWindowRefine, fPrecision).Data()
+			+ fFilterSig.getConfig() + fFilterDev.getConfig() + ")";
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Set the precision of the evaluation. The single precision modes read,
+/// calibrate and filter the signals of both channels in float. The
+/// difference of the signals is formed and filtered in double, such that
+/// the threshold scans see the same resolution in all modes.
+/// \param[in] val The precision.
+void XboxAnalyserEvalDeviation::setPrecision(XBOX::XboxDAQChannel::EPrecision val) {
+
+	fPrecision = val;
+	fFilterSig.setPrecision(val);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Allocates the buffers for the given number of processing slots (e.g.
+/// the slots of a multi-threaded RDataFrame). Must not be called while
+/// an evaluation is running.
+/// \param[in] nslots The number of slots.
+void XboxAnalyserEvalDeviation::setNSlots(UInt_t nslots) {
+
+	fScratch.assign(nslots, Scratch_t());
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The number of allocations of the workspaces of all slots
+/// (constant once all buffers reached their size).
+ULong64_t XboxAnalyserEvalDeviation::getNAllocations() const {
+
+	ULong64_t n = 0;
+	for (const Scratch_t &scratch: fScratch)
+		n += scratch.fWorkspace.getNAllocations();
+	return n;
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Absolute threshold.
 /// Calculates the absolute threshold based on the relative value th
@@ -116,7 +167,7 @@ void XboxAnalyserEvalDeviation::config(Double_t wmin,
 /// \param[in] y The reference signal.
 /// \param[in] th The relative threshold.
 /// \return    The absolute threshold.
-Double_t XboxAnalyserEvalDeviation::absTh(std::vector<Double_t> &y, Double_t th){
+Double_t XboxAnalyserEvalDeviation::absTh(std::vector<Double_t> &y, Double_t th) const {
 
 	if (y.size() < 3)
 		return -1.;
@@ -132,7 +183,7 @@ Double_t XboxAnalyserEvalDeviation::absTh(std::vector<Double_t> &y, Double_t th)
 /// for the coarse threshold fThCoarse and a refererence signal y
 /// \param[in] y The reference signal.
 /// \return    The absolute threshold.
-Double_t XboxAnalyserEvalDeviation::absThCoarse(std::vector<Double_t> &y){
+Double_t XboxAnalyserEvalDeviation::absThCoarse(std::vector<Double_t> &y) const {
 
 	return absTh(y, fThCoarse);
 }
@@ -143,7 +194,7 @@ Double_t XboxAnalyserEvalDeviation::absThCoarse(std::vector<Double_t> &y){
 /// for the coarse threshold fThCoarse and a refererence signal y
 /// \param[in] y The reference signal.
 /// \return    The absolute threshold.
-Double_t XboxAnalyserEvalDeviation::absThRefine(std::vector<Double_t> &y){
+Double_t XboxAnalyserEvalDeviation::absThRefine(std::vector<Double_t> &y) const {
 
 	return absTh(y, fThRefine);
 }
@@ -157,107 +208,73 @@ Double_t XboxAnalyserEvalDeviation::absThRefine(std::vector<Double_t> &y){
 /// \param[in] th The absolute threshold.
 /// \return    The argument where the threshold is crossed for the first time.
 Double_t XboxAnalyserEvalDeviation::argTh(
-		std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th){
+		std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th) const {
 
 	if (t.size() < 3 || t.size() != y.size())
 		return -1.;
 
-	size_t n = t.size();
-	Double_t tcross = -1.;
-
-	if (y[0] < th) {
+	Int_t i = XBOX::firstCrossing(y.data(), 0, y.size(), th);
+	if (i < 0)
+		return -1.;
 
-		for(UInt_t i=1; i<n; i++){
-			if(y[i] > th){
-				tcross = t[i] - Double_t((y[i] - th) / (y[i] - y[i-1])) * (t[i] - t[i-1]);
-				break;
-			}
-		}
-	}
-	else {
-
-		for(UInt_t i=1; i<n; i++){
-			if(y[i] < th){
-				tcross = t[i] - Double_t((y[i] - th) / (y[i] - y[i-1])) * (t[i] - t[i-1]);
-				break;
-			}
-		}
-	}
-	return tcross;
+	return t[i] - Double_t((y[i] - th) / (y[i] - y[i-1])) * (t[i] - t[i-1]);
 
 }
 
 ////////////////////////////////////////////////////////////////////////
 /// Argument of threshold crossing.
-/// Calculates argument (time) at which the threshold th is exceeded or
-/// or undershoot the first time by the signal y.
+/// Calculates argument (time) at which the magnitude of the signal y
+/// exceeds the threshold th for fWindowCoarse consecutive samples the
+/// first time.
 /// \param[in] t The time axis or argument axis of the signal.
 /// \param[in] y The signal.
 /// \param[in] th The absolute threshold.
 /// \return    The argument where the threshold is crossed for the first time.
 Double_t XboxAnalyserEvalDeviation::argThCoarse(
-		std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th){
+		std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th) const {
 
 	if (t.size() < 3 || t.size() != y.size())
 		return -1.;
 
-	size_t n = t.size();
-	Double_t tcross = -1.;
-
-	for(size_t i=0; i<n-fWindowCoarse; i++){
-		size_t nw = 0;
-		for (size_t j=0; j<fWindowCoarse; j++){
-			if(fabs(y[i+j]) > th)
-				nw++;
-		}
-		if(nw == fWindowCoarse){
-			tcross = t[i] - Double_t((y[i] - th) / (y[i] - y[i-1])) * (t[i] - t[i-1]);
-			break;
-		}
-	}
+	Int_t i = XBOX::firstRun(y.data(), 0, y.size() - 1, th, fWindowCoarse, true, true);
+	if (i < 0)
+		return -1.;
+	if (i == 0)
+		return t[0];
 
-	return tcross;
+	return t[i] - Double_t((y[i] - th) / (y[i] - y[i-1])) * (t[i] - t[i-1]);
 
 }
 
 ////////////////////////////////////////////////////////////////////////
 /// Argument of threshold crossing.
-/// Calculates argument (time) at which the threshold th is exceeded or
-/// or undershoot the first time by the signal y.
+/// Calculates argument (time) at which the magnitude of the signal y
+/// rises above the threshold th after fWindowRefine consecutive samples
+/// below. The search starts from the first sample above the threshold
+/// in the second half of the signal and proceeds to the left.
 /// \param[in] t The time axis or argument axis of the signal.
 /// \param[in] y The signal.
 /// \param[in] th The absolute threshold.
 /// \return    The argument where the threshold is crossed for the first time.
 Double_t XboxAnalyserEvalDeviation::argThRefine(
-		std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th){
+		std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th) const {
 
 	if (t.size() < 3 || t.size() != y.size())
 		return -1.;
 
-	size_t n = t.size();
-	Double_t tcross = -1.;
-
-	size_t istart = n / 2;
-	while (fabs(y[istart]) < th && istart < n)
+	Int_t n = t.size();
+	Int_t istart = n / 2;
+	while (istart < n && fabs(y[istart]) < th)
 		istart++;
 
 	if (istart == n)
-		return -1;
+		return -1.;
 
-	for(size_t i=istart; i>fWindowRefine; i--){
-		size_t nw = 0;
-		for (size_t j=0; j<fWindowRefine; j++){
-			if(fabs(y[i-j]) < th) // use y[i], abs, mean, or stdev
-				nw++;
-		}
-		if(nw == fWindowRefine){
-			tcross = t[i+1] - Double_t((fabs(y[i+1]) - th) / fabs(y[i+1] - y[i])) * (t[i+1] - t[i]);
-			return tcross;
-			break;
-		}
-	}
+	Int_t i = XBOX::lastRun(y.data(), 2, istart + 1, th, fWindowRefine, false, true);
+	if (i < 0)
+		return -1.;
 
-	return tcross;
+	return t[i+1] - Double_t((fabs(y[i+1]) - th) / fabs(y[i+1] - y[i])) * (t[i+1] - t[i]);
 
 }
 
@@ -265,7 +282,7 @@ Double_t XboxAnalyserEvalDeviation::argThRefine(
 /// Maximum absolute value of signal.
 /// \param[in] y The input signal.
 /// \return    The maximum absolute value .
-Double_t XboxAnalyserEvalDeviation::magn(std::vector<Double_t> &y) {
+Double_t XboxAnalyserEvalDeviation::magn(std::vector<Double_t> &y) const {
 
 	size_t n = y.size();
 	Double_t maxval = 0;
@@ -280,31 +297,52 @@ Double_t XboxAnalyserEvalDeviation::magn(std::vector<Double_t> &y) {
 
 ////////////////////////////////////////////////////////////////////////
 /// Difference of two signals
+/// \param[out] y The difference signal (empty if the sizes differ).
 /// \param[in] y1 The first input signal.
 /// \param[in] y2 The first input signal.
-/// \return    The difference signal.
-std::vector<Double_t> XboxAnalyserEvalDeviation::diff(
-		std::vector<Double_t> &y1, std::vector<Double_t> &y2) {
+void XboxAnalyserEvalDeviation::diff(std::vector<Double_t> &y,
+		const std::vector<Double_t> &y1, const std::vector<Double_t> &y2) const {
 
+	y.clear();
 	if (y1.empty() || y1.size() != y2.size())
-		return std::vector<Double_t>{};
+		return;
 
 	size_t n = y1.size();
-	std::vector<Double_t> y(n, 0.);
+	y.resize(n);
 	for(size_t i=0; i<n; i++)
 		y[i] = y1[i] - y2[i];
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Shifted time axis.
+/// \param[out] ts The time axis shifted by the offset.
+/// \param[in] t The time axis.
+/// \param[in] offset The offset.
+void XboxAnalyserEvalDeviation::shift(std::vector<Double_t> &ts,
+		const std::vector<Double_t> &t, Double_t offset) const {
 
-	return y;
+	size_t n = t.size();
+	ts.resize(n);
+	for(size_t i=0; i<n; i++)
+		ts[i] = t[i] + offset;
 }
 
 ////////////////////////////////////////////////////////////////////////
 /// Deviation between two signals.
 /// Precise evaluation of moment when both signals start to deviate.
-/// Assumes that both signals are of same type.
-/// \param[in] ch0 the Xbox DAQ channel containing the current signal.
+/// Assumes that both signals are of same type. The reference signal is
+/// shifted by the negative jitter, i.e. it is evaluated on the time axis
+/// shifted by the jitter instead of copying the channel.
+/// \param[in] ch1 the Xbox DAQ channel containing the current signal.
+/// \param[in] ch2 the Xbox DAQ channel containing the reference signal.
+/// \param[in] jitter the jitter between both signals.
+/// \param[in] scratch the buffers of the evaluation.
 /// \return    time at the start of the rising edge.
-Double_t XboxAnalyserEvalDeviation::evalDeviation(
-		XBOX::XboxDAQChannel &ch1, XBOX::XboxDAQChannel &ch2) {
+Double_t XboxAnalyserEvalDeviation::evalDeviation(const XBOX::XboxDAQChannel &ch1,
+		const XBOX::XboxDAQChannel &ch2, Double_t jitter, Scratch_t &scratch) const {
+
+	XBOX::XboxWorkspace &ws = scratch.fWorkspace;
+	ws.reset();
 
 	// get the signal and apply filters (chose carefully the filter
 	// parameters according to the signal distortion) ..................
@@ -314,19 +352,18 @@ Double_t XboxAnalyserEvalDeviation::evalDeviation(
 	Double_t tmin = fWmin * (ubnd - lbnd) + lbnd; ///<Lower limit.
 	Double_t tmax = fWmax * (ubnd - lbnd) + lbnd; ///<Upper limit.
 
-	std::vector<Double_t> t1 = ch1.getTimeAxis(tmin, tmax);
-	std::vector<Double_t> y1 = ch1.getSignal(tmin, tmax);
-	std::vector<Double_t> t2 = ch2.getTimeAxis(tmin, tmax);
-	std::vector<Double_t> y2 = ch2.getSignal(tmin, tmax);
-
-	std::vector<Double_t> tc = XBOX::linspace(tmin, tmax, fSamplesCoarse);
-	std::vector<Double_t> y1c = fFilterSig(ch1, tc);
-	std::vector<Double_t> y2c = fFilterSig(ch2, tc);
-	std::vector<Double_t> yc = diff(y1c, y2c);
+	std::vector<Double_t> &tc = scratch.fTimeCoarse;
+	std::vector<Double_t> &ts = scratch.fTimeShifted;
+	XBOX::linspace(tc, tmin, tmax, fSamplesCoarse);
+	shift(ts, tc, jitter);
+	XBOX::XboxSignalFilter::evaluate(ch1, tc, {&fFilterSig}, scratch.fSignal1, &ws);
+	XBOX::XboxSignalFilter::evaluate(ch2, ts, {&fFilterSig}, scratch.fSignal2, &ws);
+	std::vector<Double_t> &yc = ws.get<Double_t>(0);
+	diff(yc, scratch.fSignal1[0], scratch.fSignal2[0]);
 
 	// derive absolute threshold from maximum span of both signals .....
-	Double_t y1pp = ch1.span(tmin, tmax);
-	Double_t y2pp = ch2.span(tmin, tmax);
+	Double_t y1pp = ch1.stats(tmin, tmax, XBOX::XboxDAQChannel::kStatSpan).fSpan;
+	Double_t y2pp = ch2.stats(tmin + jitter, tmax + jitter, XBOX::XboxDAQChannel::kStatSpan).fSpan;
 	Double_t thc = fThCoarse * max(y1pp, y2pp);
 
 	// return if differential signal is within noise level .............
@@ -347,11 +384,15 @@ Double_t XboxAnalyserEvalDeviation::evalDeviation(
 	if (tmax > ubnd)
 		tmax = ubnd;
 
-	std::vector<Double_t> tf = XBOX::linspace(tmin, tmax, fSamplesRefine);
-	std::vector<Double_t> y1f = fFilterSig(ch1, tf);
-	std::vector<Double_t> y2f = fFilterSig(ch2, tf);
-	std::vector<Double_t> yf = diff(y1f, y2f);
-	yf = fFilterDev(yf); // Additional filter for the difference.
+	std::vector<Double_t> &tf = scratch.fTimeRefine;
+	XBOX::linspace(tf, tmin, tmax, fSamplesRefine);
+	shift(ts, tf, jitter);
+	XBOX::XboxSignalFilter::evaluate(ch1, tf, {&fFilterSig}, scratch.fSignal1, &ws);
+	XBOX::XboxSignalFilter::evaluate(ch2, ts, {&fFilterSig}, scratch.fSignal2, &ws);
+	std::vector<Double_t> &yd = ws.get<Double_t>(0);
+	std::vector<Double_t> &yf = ws.get<Double_t>(0);
+	diff(yd, scratch.fSignal1[0], scratch.fSignal2[0]);
+	fFilterDev(yf, yd, &ws); // Additional filter for the difference.
 
 	// refine the deviation point .....................................
 	Double_t thf = fThRefine * max(y1pp, y2pp);
@@ -363,51 +404,187 @@ Double_t XboxAnalyserEvalDeviation::evalDeviation(
 	return tdev;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// The refined evaluation reads up to half the proximity beyond the
+/// window of the coarse evaluation.
+/// \param[out] wmin The lower limit of the samples read (relative).
+/// \param[out] wmax The upper limit of the samples read (relative).
+/// \param[out] margin The number of samples read beyond the limits.
+void XboxAnalyserEvalDeviation::getWindow(Double_t &wmin, Double_t &wmax,
+		Int_t &margin) const {
+
+	wmin = fWmin - 0.5 * fProximity;
+	wmax = fWmax + 0.5 * fProximity;
+	margin = fFilterSig.getMargin();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Deviation between two signals.
+/// Same as evalDeviation() but on decoded signals, which are smoothed by
+/// the signal filter of the evaluator unless they are already. The
+/// reference is expected to be aligned by the jitter already (see
+/// XBOX::XboxSignalTrace::setStartOffset()).
+/// \param[in] trace1 The decoded signal of the breakdown pulse.
+/// \param[in] trace2 The decoded signal of the previous pulse.
+/// \param[out] t The time axis of the last evaluation.
+/// \param[out] y1 The re-sampled signal of the breakdown pulse.
+/// \param[out] y2 The re-sampled signal of the previous pulse.
+/// \param[in] ws The workspace for temporary buffers.
+/// \return The time where both signals start to deviate (-1 if the
+/// difference is within the noise level).
+Double_t XboxAnalyserEvalDeviation::evalTraces(XBOX::XboxSignalTrace &trace1,
+		XBOX::XboxSignalTrace &trace2, std::vector<Double_t> &t,
+		std::vector<Double_t> &y1, std::vector<Double_t> &y2,
+		XBOX::XboxWorkspace &ws) const {
+
+	trace1.smooth(fFilterSig, ws);
+	trace2.smooth(fFilterSig, ws);
+
+	Double_t lbnd=0.; ///<Lower time axis bound.
+	Double_t ubnd=0.; ///<Upper time axis bound.
+	trace1.getTimeAxisBounds(lbnd, ubnd);
+	Double_t tmin = fWmin * (ubnd - lbnd) + lbnd; ///<Lower limit.
+	Double_t tmax = fWmax * (ubnd - lbnd) + lbnd; ///<Upper limit.
+
+	XBOX::linspace(t, tmin, tmax, fSamplesCoarse);
+	trace1.resample(y1, t);
+	trace2.resample(y2, t);
+	std::vector<Double_t> &yc = ws.get<Double_t>(0);
+	diff(yc, y1, y2);
+
+	// derive absolute threshold from maximum span of both signals .....
+	Double_t y1pp = trace1.stats(tmin, tmax, XBOX::XboxDAQChannel::kStatSpan).fSpan;
+	Double_t y2pp = trace2.stats(tmin, tmax, XBOX::XboxDAQChannel::kStatSpan).fSpan;
+	Double_t thc = fThCoarse * max(y1pp, y2pp);
+
+	// return if differential signal is within noise level .............
+	if (thc > magn(yc))
+		return -1.;
+
+	Double_t tref = argThCoarse(t, yc, thc);
+
+	// refine resolution around the deviation starting point ...........
+	tmin = tref - 0.5 * fProximity * (ubnd - lbnd);
+	tmax = tref + 0.5 * fProximity * (ubnd - lbnd);
+	if (tmin < lbnd)
+		tmin = lbnd;
+	if (tmax > ubnd)
+		tmax = ubnd;
+
+	XBOX::linspace(t, tmin, tmax, fSamplesRefine);
+	trace1.resample(y1, t);
+	trace2.resample(y2, t);
+	std::vector<Double_t> &yd = ws.get<Double_t>(0);
+	std::vector<Double_t> &yf = ws.get<Double_t>(0);
+	diff(yd, y1, y2);
+	fFilterDev(yf, yd, &ws); // Additional filter for the difference.
+
+	Double_t thf = fThRefine * max(y1pp, y2pp);
+	return argThRefine(t, yf, thf);
+}
+
 
 /////////////////////////////////////////////////////////////////////////
 /// Calling function.
-/// Evaluates pulse shape parameter from a channel signal.
+/// Evaluates pulse shape parameter from a channel signal. The evaluation
+/// uses the buffers of the calling thread and can be called concurrently.
 /// \param[in] ch1 The amplitude signal of the breakdown pulse.
 /// \param[in] ch2 The amplitude signal of the previous pulse.
+/// \param[in] jitter The jitter between both pulses.
 /// \return The time here ch1 start to deviate from ch2.
-Double_t XboxAnalyserEvalDeviation::operator () (
-			XBOX::XboxDAQChannel &ch1, XBOX::XboxDAQChannel &ch2, Double_t jitter) {
+Double_t XboxAnalyserEvalDeviation::operator () (const XBOX::XboxDAQChannel &ch1,
+		const XBOX::XboxDAQChannel &ch2, Double_t jitter) const {
 
 	if (jitter == -1)
 		return -1;
 
-	// avoid data re-interpretation
-	ch1.setAutoRefresh(false);
-	ch2.setAutoRefresh(false);
-	ch1.flushbuffer();
-	ch2.flushbuffer();
+	// time when current signal starts to deviate from previous one
+	static thread_local Scratch_t scratch;
+	Double_t tdev = evalDeviation(ch1, ch2, jitter, scratch);
 
-	// apply negative jitter to the previous pulse (reference) for evaluation
-	Double_t offset = ch2.getStartOffset();
-	ch2.setStartOffset(offset-jitter);
+	requestReport(ch1, ch2, jitter, tdev);
 
-	// time when current signal starts to deviate from previous one
-	Double_t tdev = evalDeviation(ch1, ch2);
+	return tdev;
+}
 
-	// reset auto interpretation
-	ch1.setAutoRefresh(true);
-	ch2.setAutoRefresh(true);
+/////////////////////////////////////////////////////////////////////////
+/// Calling function for processing slots.
+/// Same as above but re-uses the buffers of the given slot (see
+/// setNSlots()). Concurrent calls must refer to different slots, as
+/// provided by RDataFrame::DefineSlot.
+/// \param[in] slot The processing slot.
+/// \param[in] ch1 The amplitude signal of the breakdown pulse.
+/// \param[in] ch2 The amplitude signal of the previous pulse.
+/// \param[in] jitter The jitter between both pulses.
+/// \return The time here ch1 start to deviate from ch2.
+Double_t XboxAnalyserEvalDeviation::evalSlot(UInt_t slot, const XBOX::XboxDAQChannel &ch1,
+		const XBOX::XboxDAQChannel &ch2, Double_t jitter) const {
 
-	if (fReportFlag)
-		report(ch1, ch2, jitter);
+	if (slot >= fScratch.size())
+		return (*this)(ch1, ch2, jitter);
 
-	// reset offset of ch2 to the original value
-	ch2.setStartOffset(offset);
+	if (jitter == -1)
+		return -1;
+
+	Scratch_t &scratch = fScratch[slot];
+	Double_t tdev = evalDeviation(ch1, ch2, jitter, scratch);
+
+	requestReport(ch1, ch2, jitter, tdev);
 
 	return tdev;
 }
 
 
+////////////////////////////////////////////////////////////////////////
+/// Report request.
+/// Submits a report if reporting is enabled and the policy selects the
+/// deviation time (also used by XBOX::XboxAnalyserEvalBreakdown).
+/// \param[in] ch1 The amplitude signal of the breakdown pulse.
+/// \param[in] ch2 The amplitude signal of the previous pulse.
+/// \param[in] jitter The jitter between both pulses.
+/// \param[in] tdev The evaluated deviation time.
+void XboxAnalyserEvalDeviation::requestReport(const XBOX::XboxDAQChannel &ch1,
+		const XBOX::XboxDAQChannel &ch2, Double_t jitter, Double_t tdev) const {
+
+	if (fReportFlag && fReportPolicy.accept(tdev))
+		submitReport(ch1, ch2, jitter, tdev);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Report request.
+/// Records the channels, the jitter and the deviation time and passes
+/// the record on to the report policy (see XBOX::XboxAnalyserEvalJitter).
+/// The recorded copy of the previous pulse is shifted by the jitter.
+/// \param[in] ch1 The amplitude signal of the breakdown pulse.
+/// \param[in] ch2 The amplitude signal of the previous pulse.
+/// \param[in] jitter The jitter between both pulses.
+/// \param[in] tdev The evaluated deviation time.
+void XboxAnalyserEvalDeviation::submitReport(const XBOX::XboxDAQChannel &ch1,
+		const XBOX::XboxDAQChannel &ch2, Double_t jitter, Double_t tdev) const {
+
+	XBOX::XboxReportRecord rec;
+	rec.addChannel(ch1);
+	rec.addChannel(ch2);
+	rec.fChannels[1].setStartOffset(ch2.getStartOffset() - jitter);
+	rec.fResults.push_back(jitter);
+	rec.fResults.push_back(tdev);
+
+	XboxAnalyserEvalDeviation eval(fWmin, fWmax, fThCoarse, fThRefine, fProximity);
+	eval.setPrecision(fPrecision);
+	eval.setReportDir(fReportDir);
+	rec.fRender = [eval](XBOX::XboxReportRecord &rec) {
+		eval.report(rec.fChannels[0], rec.fChannels[1], rec.fResults[0]);
+	};
+
+	fReportPolicy.submit(std::move(rec));
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Report.
 /// \param[in] ch The evaluated Xbox channel.
 void XboxAnalyserEvalDeviation::report (XBOX::XboxDAQChannel ch1,
-		XBOX::XboxDAQChannel ch2, Double_t jitter) {
+		XBOX::XboxDAQChannel ch2, Double_t jitter) const {
 
 	// get the signal and apply filters (chose carefully the filter
 	// parameters according to the signal distortion) ..................
@@ -425,7 +602,8 @@ void XboxAnalyserEvalDeviation::report (XBOX::XboxDAQChannel ch1,
 	std::vector<Double_t> tc = XBOX::linspace(tmin, tmax, fSamplesCoarse);
 	std::vector<Double_t> y1c = fFilterSig(ch1, tc);
 	std::vector<Double_t> y2c = fFilterSig(ch2, tc);
-	std::vector<Double_t> yc = diff(y1c, y2c);
+	std::vector<Double_t> yc;
+	diff(yc, y1c, y2c);
 
 	// derive absolute threshold from maximum span of both signals .....
 	Double_t y1pp = ch1.span(tmin, tmax);
@@ -447,7 +625,8 @@ void XboxAnalyserEvalDeviation::report (XBOX::XboxDAQChannel ch1,
 	std::vector<Double_t> tf = XBOX::linspace(tmin, tmax, fSamplesRefine);
 	std::vector<Double_t> y1f = fFilterSig(ch1, tf);
 	std::vector<Double_t> y2f = fFilterSig(ch2, tf);
-	std::vector<Double_t> yf = diff(y1f, y2f);
+	std::vector<Double_t> yf;
+	diff(yf, y1f, y2f);
 	yf = fFilterDev(yf); // Additional filter for the difference.
 
 	// refine the deviation point .....................................
@@ -5,6 +5,7 @@
 
 // root
 #include "TTimeStamp.h"
+#include "TString.h"
 #include "TH1D.h"
 #include "TMatrixD.h"
 #include "TVectorD.h"
@@ -23,6 +24,7 @@
 
 // xbox
 #include "XboxSignalFilter.hxx"
+#include "XboxSignalKernels.hxx"
 #include "XboxAlgorithms.h"
 
 
@@ -66,6 +68,8 @@ void XboxAnalyserEvalJitter::init() {
 	// samples for interpolation
 	fSamples = 10001;
 
+	setPrecision(XBOX::XboxDAQChannel::kPrecDouble);
+
 	fReportFlag = false;
 	fReportDir = "";
 }
@@ -101,13 +105,57 @@ void XboxAnalyserEvalJitter::config(
 	fTol = max;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The configuration of the evaluator (e.g. part of a cache key).
+std::string XboxAnalyserEvalJitter::getConfig() const {
+
+	return TString::Format("Jitter(%.17g,%.17g,%.17g,%.17g;n=%zu;p=%d;",
+			fWmin, fWmax, fTh, fTol, fSamples, fPrecision).Data() + fFilter.getConfig() + ")";
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Set the precision of the evaluation. The single precision modes read,
+/// calibrate and filter the signals in float. The threshold scans run on
+/// the filtered signals and are not affected.
+/// \param[in] val The precision.
+void XboxAnalyserEvalJitter::setPrecision(XBOX::XboxDAQChannel::EPrecision val) {
+
+	fPrecision = val;
+	fFilter.setPrecision(val);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Allocates the buffers for the given number of processing slots (e.g.
+/// the slots of a multi-threaded RDataFrame). Must not be called while
+/// an evaluation is running.
+/// \param[in] nslots The number of slots.
+void XboxAnalyserEvalJitter::setNSlots(UInt_t nslots) {
+
+	fScratch.assign(nslots, Scratch_t());
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The number of allocations of the workspaces of all slots
+/// (constant once all buffers reached their size).
+ULong64_t XboxAnalyserEvalJitter::getNAllocations() const {
+
+	ULong64_t n = 0;
+	for (const Scratch_t &scratch: fScratch)
+		n += scratch.fWorkspace.getNAllocations();
+	return n;
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Absolute threshold.
 /// Calculates the absolute threshold based on the relative value fTh
 /// and a refererence signal y
 /// \param[in] y The reference signal.
 /// \return    The absolute threshold.
-Double_t XboxAnalyserEvalJitter::absTh(std::vector<Double_t> &y){
+Double_t XboxAnalyserEvalJitter::absTh(std::vector<Double_t> &y) const {
 
 	if (y.size() < 3)
 		return -1.;
@@ -126,33 +174,46 @@ Double_t XboxAnalyserEvalJitter::absTh(std::vector<Double_t> &y){
 /// \param[in] th The absolute threshold.
 /// \return    The argument where the threshold is crossed for the first time.
 Double_t XboxAnalyserEvalJitter::argTh(
-		std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th){
+		std::vector<Double_t> &t, std::vector<Double_t> &y, Double_t th) const {
 
 	if (t.size() < 3 || t.size() != y.size())
 		return -1.;
 
-	Double_t tcross = -1.;
+	Int_t i = XBOX::firstCrossing(y.data(), 0, y.size(), th);
+	if (i < 0)
+		return -1.;
+
+	return t[i] - Double_t((y[i] - th) / (y[i] - y[i-1])) * (t[i] - t[i-1]);
+
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Delay between two filtered signals.
+/// \param[in] t The common time axis of the signals.
+/// \param[in] y1 The first signal.
+/// \param[in] y2 The second signal.
+/// \param[in] span The length of the time axis of the channels.
+/// \return The time delay between the two signals or -1 if it exceeds
+///         the maximum acceptable jitter.
+Double_t XboxAnalyserEvalJitter::delay(std::vector<Double_t> &t,
+		std::vector<Double_t> &y1, std::vector<Double_t> &y2, Double_t span) const {
 
-	if (y[0] < th) {
+	// determine the delay between the signals based on threshold ......
+	Double_t th = absTh(y1);
+	Double_t t1cross = argTh(t, y1, th);
+	Double_t t2cross = argTh(t, y2, th);
+	Double_t delay = t2cross - t1cross;
 
-		for(UInt_t i=1; i<fSamples; i++){
-			if(y[i] > th){
-				tcross = t[i] - Double_t((y[i] - th) / (y[i] - y[i-1])) * (t[i] - t[i-1]);
-				break;
-			}
-		}
-	}
-	else {
+	// debug
+//	printf("xmin: %e | xmax: %e | th: %f\n", fJitterWMin, fJitterWMax, fJitterTh);
+//	printf("th: %f\n", th);
+//	printf("delay: %e\n", delay);
 
-		for(UInt_t i=1; i<fSamples; i++){
-			if(y[i] < th){
-				tcross = t[i] - Double_t((y[i] - th) / (y[i] - y[i-1])) * (t[i] - t[i-1]);
-				break;
-			}
-		}
-	}
-	return tcross;
+	// check whether delay is below a maximum acceptable value ........
+	if (fabs(delay) > fTol * span)
+		delay = -1.;
 
+	return delay;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -160,79 +221,165 @@ Double_t XboxAnalyserEvalJitter::argTh(
 /// Evaluates the jitter between two measurements based on a threshold.
 /// \param[in] ch1 the Xbox DAQ channel containing the first signal.
 /// \param[in] ch2 the Xbox DAQ channel containing the second signal.
+/// \param[in] scratch the buffers of the evaluation.
 /// \return The time delay between the two signals.
-Double_t XboxAnalyserEvalJitter::evalJitter(
-		XBOX::XboxDAQChannel &ch1, XBOX::XboxDAQChannel &ch2){
+Double_t XboxAnalyserEvalJitter::evalJitter(const XBOX::XboxDAQChannel &ch1,
+		const XBOX::XboxDAQChannel &ch2, Scratch_t &scratch) const {
 
 	Double_t lbnd=0.; ///<Lower time axis bound.
 	Double_t ubnd=0.; ///<Upper time axis bound.
 	Double_t tmin; ///<Lower time axis limit.
 	Double_t tmax; ///<Upper time axis limit.
 
+	scratch.fWorkspace.reset();
+
 	// get the signal and apply filters (chose carefully the filter
 	// parameters according to the signal distortion) ..................
 	ch1.getTimeAxisBounds(lbnd, ubnd);
 	tmin = fWmin * (ubnd - lbnd) + lbnd;
 	tmax = fWmax * (ubnd - lbnd) + lbnd;
 
-	std::vector<Double_t> t = XBOX::linspace(tmin, tmax, fSamples);
-	std::vector<Double_t> y1 = fFilter(ch1, t);
-	std::vector<Double_t> y2 = fFilter(ch2, t);
+	std::vector<Double_t> &t = scratch.fTime;
+	XBOX::linspace(t, tmin, tmax, fSamples);
+	XBOX::XboxSignalFilter::evaluate(ch1, t, {&fFilter}, scratch.fSignal1, &scratch.fWorkspace);
+	XBOX::XboxSignalFilter::evaluate(ch2, t, {&fFilter}, scratch.fSignal2, &scratch.fWorkspace);
+	std::vector<Double_t> &y1 = scratch.fSignal1[0];
+	std::vector<Double_t> &y2 = scratch.fSignal2[0];
 
-	// determine the delay between the signals based on threshold ......
-	Double_t th = absTh(y1);
-	Double_t t1cross = argTh(t, y1, th);
-	Double_t t2cross = argTh(t, y2, th);
-	Double_t delay = t2cross - t1cross;
+	return delay(t, y1, y2, ubnd - lbnd);
+}
 
-	// debug
-//	printf("ubnd: %e | lbnd: %e\n", lbnd, ubnd);
-//	printf("xmin: %e | xmax: %e | th: %f\n", fJitterWMin, fJitterWMax, fJitterTh);
-//	printf("tmin: %e | tmax: %e | th: %f\n", tmin, tmax, th);
-//	printf("t0: %e | t1: %e\n", t[idx0], t[idx1]);
-//	printf("delay: %e\n", delay);
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \param[out] wmin The lower limit of the samples read (relative).
+/// \param[out] wmax The upper limit of the samples read (relative).
+/// \param[out] margin The number of samples read beyond the limits.
+void XboxAnalyserEvalJitter::getWindow(Double_t &wmin, Double_t &wmax,
+		Int_t &margin) const {
+
+	wmin = fWmin;
+	wmax = fWmax;
+	margin = fFilter.getMargin();
+}
 
-	// check whether delay is below a maximum acceptable value ........
-	if (fabs(delay) > fTol * (ubnd - lbnd))
-		delay = -1.;
+////////////////////////////////////////////////////////////////////////
+/// Signal jitter evaluation.
+/// Same as evalJitter() but on decoded signals, which are smoothed by
+/// the filter of the evaluator unless they are already.
+/// \param[in] trace1 The decoded first signal.
+/// \param[in] trace2 The decoded second signal.
+/// \param[out] t The interpolated time axis.
+/// \param[out] y1 The re-sampled first signal.
+/// \param[out] y2 The re-sampled second signal.
+/// \param[in] ws The workspace for temporary buffers.
+/// \return The time delay between the two signals (-1 if not acceptable).
+Double_t XboxAnalyserEvalJitter::evalTraces(XBOX::XboxSignalTrace &trace1,
+		XBOX::XboxSignalTrace &trace2, std::vector<Double_t> &t,
+		std::vector<Double_t> &y1, std::vector<Double_t> &y2,
+		XBOX::XboxWorkspace &ws) const {
+
+	trace1.smooth(fFilter, ws);
+	trace2.smooth(fFilter, ws);
 
-	return delay;
+	Double_t lbnd=0.; ///<Lower time axis bound.
+	Double_t ubnd=0.; ///<Upper time axis bound.
+	trace1.getTimeAxisBounds(lbnd, ubnd);
+	Double_t tmin = fWmin * (ubnd - lbnd) + lbnd; ///<Lower limit.
+	Double_t tmax = fWmax * (ubnd - lbnd) + lbnd; ///<Upper limit.
+
+	XBOX::linspace(t, tmin, tmax, fSamples);
+	trace1.resample(y1, t);
+	trace2.resample(y2, t);
+
+	return delay(t, y1, y2, ubnd - lbnd);
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Calling function.
-/// Evaluates jitter between two pulses.
+/// Evaluates jitter between two pulses. The evaluation uses the buffers
+/// of the calling thread and can be called concurrently.
 /// \param[in] ch1 The amplitude signal of the breakdown pulse.
 /// \param[in] ch2The amplitude signal of the previous pulse.
 /// \return The jitter.
 Double_t XboxAnalyserEvalJitter::operator () (
-			XBOX::XboxDAQChannel &ch1, XBOX::XboxDAQChannel &ch2) {
+			const XBOX::XboxDAQChannel &ch1, const XBOX::XboxDAQChannel &ch2) const {
 
-	ch1.flushbuffer();
-	ch2.flushbuffer();
+	static thread_local Scratch_t scratch;
+	Double_t jitter = evalJitter(ch1, ch2, scratch);
 
-	// avoid data re-interpretation
-	ch1.setAutoRefresh(false);
-	ch2.setAutoRefresh(false);
+	requestReport(ch1, ch2, jitter);
 
-	Double_t jitter =  evalJitter(ch1, ch2);
+	return jitter;
+}
 
-	// reset auto interpretation
-	ch1.setAutoRefresh(true);
-	ch2.setAutoRefresh(true);
+////////////////////////////////////////////////////////////////////////////////
+/// Calling function for processing slots.
+/// Same as above but re-uses the buffers of the given slot (see
+/// setNSlots()). Concurrent calls must refer to different slots, as
+/// provided by RDataFrame::DefineSlot.
+/// \param[in] slot The processing slot.
+/// \param[in] ch1 The amplitude signal of the breakdown pulse.
+/// \param[in] ch2 The amplitude signal of the previous pulse.
+/// \return The jitter.
+Double_t XboxAnalyserEvalJitter::evalSlot(UInt_t slot,
+		const XBOX::XboxDAQChannel &ch1, const XBOX::XboxDAQChannel &ch2) const {
+
+	if (slot >= fScratch.size())
+		return (*this)(ch1, ch2);
 
-	if (fReportFlag)
-		report(ch1, ch2);
+	Double_t jitter = evalJitter(ch1, ch2, fScratch[slot]);
+
+	requestReport(ch1, ch2, jitter);
 
 	return jitter;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Report request.
+/// Submits a report if reporting is enabled and the policy selects the
+/// jitter (also used by XBOX::XboxAnalyserEvalBreakdown).
+/// \param[in] ch1 The amplitude signal of the breakdown pulse.
+/// \param[in] ch2 The amplitude signal of the previous pulse.
+/// \param[in] jitter The evaluated jitter.
+void XboxAnalyserEvalJitter::requestReport(const XBOX::XboxDAQChannel &ch1,
+		const XBOX::XboxDAQChannel &ch2, Double_t jitter) const {
+
+	if (fReportFlag && fReportPolicy.accept(jitter))
+		submitReport(ch1, ch2, jitter);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Report request.
+/// Records the channels and the jitter and passes the record on to the
+/// report policy. The rendering keeps its own copy of the configuration
+/// since the evaluator may be gone by then.
+/// \param[in] ch1 The amplitude signal of the breakdown pulse.
+/// \param[in] ch2 The amplitude signal of the previous pulse.
+/// \param[in] jitter The evaluated jitter.
+void XboxAnalyserEvalJitter::submitReport(const XBOX::XboxDAQChannel &ch1,
+		const XBOX::XboxDAQChannel &ch2, Double_t jitter) const {
+
+	XBOX::XboxReportRecord rec;
+	rec.addChannel(ch1);
+	rec.addChannel(ch2);
+	rec.fResults.push_back(jitter);
+
+	XboxAnalyserEvalJitter eval(fWmin, fWmax, fTh, fTol);
+	eval.setPrecision(fPrecision);
+	eval.setReportDir(fReportDir);
+	rec.fRender = [eval](XBOX::XboxReportRecord &rec) {
+		eval.report(rec.fChannels[0], rec.fChannels[1]);
+	};
+
+	fReportPolicy.submit(std::move(rec));
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Report.
 /// \param[in] ch The evaluated Xbox channel.
 void XboxAnalyserEvalJitter::report (
-		XBOX::XboxDAQChannel ch1, XBOX::XboxDAQChannel ch2) {
+		XBOX::XboxDAQChannel ch1, XBOX::XboxDAQChannel ch2) const {
 
 	Double_t lbnd=0.; ///<Lower time axis bound.
 	Double_t ubnd=0.; ///<Upper time axis bound.
@@ -4,6 +4,7 @@
 
 // root
 #include "TTimeStamp.h"
+#include "TString.h"
 
 // root graphics
 #include "TStyle.h"
@@ -51,6 +52,8 @@ void XboxAnalyserEvalPulseShape::init() {
 	fPulseWmax = 0.99;
 	fPulseTh = 0.9;
 
+	fPrecision = XBOX::XboxDAQChannel::kPrecDouble;
+
 	fReportFlag = false;
 	fReportDir = "";
 }
@@ -84,19 +87,27 @@ void XboxAnalyserEvalPulseShape::configPulse(Double_t wmin, Double_t wmax, Doubl
 	fPulseTh = th;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The configuration of the evaluator (e.g. part of a cache key).
+std::string XboxAnalyserEvalPulseShape::getConfig() const {
+
+	return TString::Format("PulseShape(%.17g,%.17g,%.17g;p=%d)",
+			fPulseWmin, fPulseWmax, fPulseTh, fPrecision).Data();
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Calling function.
 /// Evaluates pulse shape parameter from a channel signal.
 /// \param[in] ch The Xbox channel.
+/// The signal is calibrated into local buffers, hence the channel is not
+/// modified and several threads may evaluate it at once.
 /// \return The pulse parameters (pulse length, average power, ...)
 XBOX::XboxDAQChannel XboxAnalyserEvalPulseShape::operator () (
-		XBOX::XboxDAQChannel &ch) {
+		const XBOX::XboxDAQChannel &ch) const {
 
-	ch.flushbuffer();
 	XBOX::XboxDAQChannel chnew = ch;
-
-	// avoid data re-interpretation
-	chnew.setAutoRefresh(false);
+	chnew.flushbuffer();
 
 	Double_t lbnd=0.;
 	Double_t ubnd=0.;
@@ -104,13 +115,18 @@ XBOX::XboxDAQChannel XboxAnalyserEvalPulseShape::operator () (
 
 	Double_t tmin = fPulseWmin * (ubnd - lbnd) + lbnd;
 	Double_t tmax = fPulseWmax * (ubnd - lbnd) + lbnd;
-	Double_t tr = chnew.risingEdge(fPulseTh, tmin, tmax);
-	Double_t tf = chnew.fallingEdge(fPulseTh, tmin, tmax);
-	Double_t pmin = chnew.min(tr, tf);
-	Double_t pmax = chnew.max(tr, tf);
-	Double_t pmean = chnew.mean(tr, tf);
-	Double_t pinteg = chnew.integ(tr, tf);
-	Double_t pspan = chnew.span();
+	Double_t tr = ch.risingEdge(fPulseTh, tmin, tmax, fPrecision);
+	Double_t tf = ch.fallingEdge(fPulseTh, tmin, tmax, fPrecision);
+
+	// pulse top statistics in a single pass
+	XBOX::XboxDAQChannel::Stats_t ptop = ch.stats(tr, tf,
+			XBOX::XboxDAQChannel::kStatMin | XBOX::XboxDAQChannel::kStatMax
+			| XBOX::XboxDAQChannel::kStatMean | XBOX::XboxDAQChannel::kStatInteg);
+	Double_t pmin = ptop.fMin;
+	Double_t pmax = ptop.fMax;
+	Double_t pmean = ptop.fMean;
+	Double_t pinteg = ptop.fInteg;
+	Double_t pspan = ch.stats(-1, -1, XBOX::XboxDAQChannel::kStatSpan).fSpan;
 
 	// update the results in channel
 	chnew.setXmin(tr);
@@ -121,21 +137,107 @@ XBOX::XboxDAQChannel XboxAnalyserEvalPulseShape::operator () (
 	chnew.setYinteg(pinteg);
 	chnew.setYspan(pspan);
 
-	// reset auto interpretation
-	ch.setAutoRefresh(true);
-	chnew.setAutoRefresh(true);
+	requestReport(ch, tr, tf, ptop, pspan);
+
+	return chnew;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// The span of the signal is taken over the whole record.
+/// \param[out] wmin The lower limit of the samples read (relative).
+/// \param[out] wmax The upper limit of the samples read (relative).
+/// \param[out] margin The number of samples read beyond the limits.
+void XboxAnalyserEvalPulseShape::getWindow(Double_t &wmin, Double_t &wmax,
+		Int_t &margin) const {
+
+	wmin = 0.;
+	wmax = 1.;
+	margin = 0;
+}
 
-	if (fReportFlag)
-		report(chnew);
+////////////////////////////////////////////////////////////////////////
+/// Pulse shape.
+/// Same as operator() but on a decoded signal.
+/// \param[in] trace The decoded signal.
+/// \param[out] tr The time of the rising edge.
+/// \param[out] tf The time of the falling edge.
+/// \param[out] ptop The statistics of the pulse top.
+/// \param[out] pspan The span of the signal.
+void XboxAnalyserEvalPulseShape::evalTrace(const XBOX::XboxSignalTrace &trace,
+		Double_t &tr, Double_t &tf, XBOX::XboxDAQChannel::Stats_t &ptop,
+		Double_t &pspan) const {
 
+	Double_t lbnd=0.;
+	Double_t ubnd=0.;
+	trace.getTimeAxisBounds(lbnd, ubnd);
 
-	return chnew;
+	Double_t tmin = fPulseWmin * (ubnd - lbnd) + lbnd;
+	Double_t tmax = fPulseWmax * (ubnd - lbnd) + lbnd;
+	tr = trace.risingEdge(fPulseTh, tmin, tmax, fPrecision);
+	tf = trace.fallingEdge(fPulseTh, tmin, tmax, fPrecision);
+
+	ptop = trace.stats(tr, tf,
+			XBOX::XboxDAQChannel::kStatMin | XBOX::XboxDAQChannel::kStatMax
+			| XBOX::XboxDAQChannel::kStatMean | XBOX::XboxDAQChannel::kStatInteg);
+	pspan = trace.stats(-1, -1, XBOX::XboxDAQChannel::kStatSpan).fSpan;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Report request.
+/// Submits a report if reporting is enabled and the policy selects the
+/// pulse width (also used by XBOX::XboxAnalyserEvalBreakdown). The
+/// reported channel carries the meta data and the pulse parameters.
+/// \param[in] ch The evaluated Xbox channel.
+/// \param[in] tr The time of the rising edge.
+/// \param[in] tf The time of the falling edge.
+/// \param[in] ptop The statistics of the pulse top.
+/// \param[in] pspan The span of the signal.
+void XboxAnalyserEvalPulseShape::requestReport(const XBOX::XboxDAQChannel &ch,
+		Double_t tr, Double_t tf, const XBOX::XboxDAQChannel::Stats_t &ptop,
+		Double_t pspan) const {
+
+	if (!fReportFlag || !fReportPolicy.accept((tr == 0 || tf == 0) ? -1. : tf - tr))
+		return;
+
+	XBOX::XboxDAQChannel chnew = ch;
+	chnew.flushbuffer();
+	chnew.setXmin(tr);
+	chnew.setXmax(tf);
+	chnew.setYmin(ptop.fMin);
+	chnew.setYmax(ptop.fMax);
+	chnew.setYmean(ptop.fMean);
+	chnew.setYinteg(ptop.fInteg);
+	chnew.setYspan(pspan);
+	submitReport(chnew);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Report request.
+/// Records the evaluated channel and passes the record on to the report
+/// policy (see XBOX::XboxAnalyserEvalJitter). The policy selects by the
+/// pulse width (-1 if an edge is missing).
+/// \param[in] ch The evaluated Xbox channel.
+void XboxAnalyserEvalPulseShape::submitReport(const XBOX::XboxDAQChannel &ch) const {
+
+	XBOX::XboxReportRecord rec;
+	rec.addChannel(ch);
+	rec.fResults.push_back(ch.getXmax() - ch.getXmin());
+
+	XboxAnalyserEvalPulseShape eval(fPulseWmin, fPulseWmax, fPulseTh);
+	eval.setPrecision(fPrecision);
+	eval.setReportDir(fReportDir);
+	rec.fRender = [eval](XBOX::XboxReportRecord &rec) {
+		eval.report(rec.fChannels[0]);
+	};
+
+	fReportPolicy.submit(std::move(rec));
 }
 
 ////////////////////////////////////////////////////////////////////////
 /// Report.
 /// \param[in] ch The evaluated Xbox channel.
-void XboxAnalyserEvalPulseShape::report (XBOX::XboxDAQChannel &ch) {
+void XboxAnalyserEvalPulseShape::report (XBOX::XboxDAQChannel &ch) const {
 
 	printf("----------------------------------------------------\n");
 	printf("Report EvalPulseShape\n");
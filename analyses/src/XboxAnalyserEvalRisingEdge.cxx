@@ -5,6 +5,7 @@
 
 // root
 #include "TTimeStamp.h"
+#include "TString.h"
 #include "TH1D.h"
 #include "TMatrixD.h"
 #include "TVectorD.h"
@@ -24,6 +25,7 @@
 
 // xbox
 #include "XboxSignalFilter.hxx"
+#include "XboxSignalKernels.hxx"
 #include "XboxAlgorithms.h"
 
 
@@ -71,6 +73,8 @@ void XboxAnalyserEvalRisingEdge::init() {
 	fSamplesRefine = 512;
 	fWindowSize = 8;
 
+	setPrecision(XBOX::XboxDAQChannel::kPrecDouble);
+
 	fReportFlag = false;
 	fReportDir = "";
 }
@@ -106,77 +110,103 @@ void XboxAnalyserEvalRisingEdge::config(
 	fProximity = prox;
 }
 
-size_t XboxAnalyserEvalRisingEdge::argMax(std::vector<Double_t> &y, size_t imin, size_t imax) {
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The configuration of the evaluator (e.g. part of a cache key).
+std::string XboxAnalyserEvalRisingEdge::getConfig() const {
 
-	Int_t idx = imin;
-	Double_t max = y[imin];
-	for(size_t i=imin; i<imax; i++) {
-		if (y[i] > max) {
-			max = y[i];
-			idx = i;
-		}
-	}
+	return TString::Format("RisingEdge(%.17g,%.17g,%.17g,%.17g;n=%zu;w=%zu;p=%d;",
+			fWmin, fWmax, fTh, fProximity, fSamplesRefine, fWindowSize, fPrecision).Data()
+			+ fFilterSig.getConfig() + fFilterD1.getConfig() + fFilterD2.getConfig() + ")";
+}
 
-	return idx;
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Set the precision of the evaluation. The single precision mode reads,
+/// calibrates and filters the signal in float. The raw mode additionally
+/// applies the coarse threshold to the raw integer samples (provided the
+/// calibration is monotonic).
+/// \param[in] val The precision.
+void XboxAnalyserEvalRisingEdge::setPrecision(XBOX::XboxDAQChannel::EPrecision val) {
+
+	fPrecision = val;
+	fFilterSig.setPrecision(val);
+	fFilterD1.setPrecision(val);
+	fFilterD2.setPrecision(val);
 }
 
-size_t XboxAnalyserEvalRisingEdge::argLeftRoot(std::vector<Double_t> &y, size_t istart) {
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Allocates the buffers for the given number of processing slots (e.g.
+/// the slots of a multi-threaded RDataFrame). Must not be called while
+/// an evaluation is running.
+/// \param[in] nslots The number of slots.
+void XboxAnalyserEvalRisingEdge::setNSlots(UInt_t nslots) {
+
+	fScratch.assign(nslots, Scratch_t());
+}
 
-	if (y.empty() || y.size() < istart)
-		return 0;
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The number of allocations of the workspaces of all slots
+/// (constant once all buffers reached their size).
+ULong64_t XboxAnalyserEvalRisingEdge::getNAllocations() const {
+
+	ULong64_t n = 0;
+	for (const Scratch_t &scratch: fScratch)
+		n += scratch.fWorkspace.getNAllocations();
+	return n;
+}
 
-	size_t idxRoot = 0;
-	if (y[istart] > 0) {
-		for(size_t i=istart; i>0; i--){
-			if (y[i-1] < 0 && y[i] > 0) {
-				idxRoot = i;
-				break;
-			}
-		}
-	}
-	else {
-
-		for(size_t i=istart; i<y.size(); i--){
-			if (y[i-1] > 0 && y[i] < 0) {
-				idxRoot = i;
-				break;
-			}
-		}
-	}
-	return idxRoot;
+////////////////////////////////////////////////////////////////////////
+/// Argument of the maximum.
+/// \param[in] y The signal.
+/// \param[in] imin The first sample of the range.
+/// \param[in] imax The sample behind the range.
+/// \return The index of the first maximum (imin if the range is empty).
+size_t XboxAnalyserEvalRisingEdge::argMax(std::vector<Double_t> &y, size_t imin, size_t imax) const {
+
+	Int_t idx = XBOX::argMax(y.data(), imin, std::min(imax, y.size()));
+	return (idx < 0) ? imin : idx;
 }
 
-size_t XboxAnalyserEvalRisingEdge::argRightRoot(std::vector<Double_t> &y, size_t istart) {
+////////////////////////////////////////////////////////////////////////
+/// Closest root to the left.
+/// Searches from the start point to the left for the sign change into
+/// the sign of the start point.
+/// \param[in] y The signal.
+/// \param[in] istart The start point.
+/// \return The index right of the root (0 if not found).
+size_t XboxAnalyserEvalRisingEdge::argLeftRoot(std::vector<Double_t> &y, size_t istart) const {
+
+	if (y.empty() || y.size() <= istart)
+		return 0;
+
+	Int_t idx = XBOX::prevRoot(y.data(), 0, istart + 1, y[istart] > 0);
+	return (idx < 0) ? 0 : idx;
+}
 
-	if (y.empty() || y.size() < istart)
+////////////////////////////////////////////////////////////////////////
+/// Closest root to the right.
+/// Searches from the start point to the right for the sign change out
+/// of the sign of the start point.
+/// \param[in] y The signal.
+/// \param[in] istart The start point.
+/// \return The index left of the root (0 if not found).
+size_t XboxAnalyserEvalRisingEdge::argRightRoot(std::vector<Double_t> &y, size_t istart) const {
+
+	if (y.empty() || y.size() <= istart)
 		return 0;
 
-	size_t idxRoot = 0;
-	if (y[istart] > 0) {
-		for(size_t i=istart; i<y.size(); i++){
-			if (y[i+1] < 0 && y[i] > 0) {
-				idxRoot = i;
-				break;
-			}
-		}
-	}
-	else {
-
-		for(size_t i=istart; i<y.size(); i++){
-			if (y[i+1] > 0 && y[i] < 0) {
-				idxRoot = i;
-				break;
-			}
-		}
-	}
-	return idxRoot;
+	Int_t idx = XBOX::nextRoot(y.data(), istart, y.size(), !(y[istart] > 0));
+	return (idx < 0) ? 0 : idx;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 /// Normalisation.
 /// Re-scale a data set to a predefined argument range.
 std::vector<Double_t> XboxAnalyserEvalRisingEdge::rescale(
-		std::vector<Double_t> &y, Double_t ysmin, Double_t ysmax) {
+		std::vector<Double_t> &y, Double_t ysmin, Double_t ysmax) const {
 
 	Double_t ymin = *std::min_element(y.begin(), y.end());
 	Double_t ymax = *std::max_element(y.begin(), y.end());
@@ -191,34 +221,17 @@ std::vector<Double_t> XboxAnalyserEvalRisingEdge::rescale(
 
 
 ////////////////////////////////////////////////////////////////////////
-/// Rising edge.
-/// Precise evaluation of moment when the rising edge of a pulse starts.
-/// \param[in] ch0 the Xbox DAQ channel containing the current signal.
+/// Start of the rising edge from the filtered signal.
+/// \param[in] tf The refined time axis around the rising edge.
+/// \param[in] yf The filtered signal.
+/// \param[in] y1f The first derivative of the signal.
+/// \param[in] y2f The second derivative of the signal.
+/// \param[in] dt The distance of the points of the time axis.
+/// \param[out] rise The intermediate points of the evaluation (optional).
 /// \return    time at the start of the rising edge.
-Double_t XboxAnalyserEvalRisingEdge::evalRisingEdge(XBOX::XboxDAQChannel &ch) {
-
-	// first rough calculation of the rising edge.......................
-	Double_t lbnd=0.; ///<Lower time axis bound.
-	Double_t ubnd=0.; ///<Upper time axis bound.
-	ch.getTimeAxisBounds(lbnd, ubnd);
-	Double_t tmin = fWmin * (ubnd - lbnd) + lbnd; ///<Lower limit.
-	Double_t tmax = fWmax * (ubnd - lbnd) + lbnd; ///<Upper limit.
-	Double_t tref = ch.risingEdge(fTh, tmin, tmax);
-
-	// refine resolution around the rising edge and apply filters ......
-	tmin = tref - 0.5 * fProximity * (ubnd - lbnd);
-	tmax = tref + 0.5 * fProximity * (ubnd - lbnd);
-	if (tmin < lbnd)
-		tmin = lbnd;
-	if (tmax > ubnd)
-		tmax = ubnd;
-
-	std::vector<Double_t> tf = XBOX::linspace(tmin, tmax, fSamplesRefine);
-	Double_t dt = (tmax - tmin) / (fSamplesRefine - 1);
-
-	std::vector<Double_t> yf = fFilterSig(ch, tf); // normal signal
-	std::vector<Double_t> y1f = fFilterD1(ch, tf); // first derivative
-	std::vector<Double_t> y2f = fFilterD2(ch, tf); // second derivative
+Double_t XboxAnalyserEvalRisingEdge::argRise(std::vector<Double_t> &tf,
+		std::vector<Double_t> &yf, std::vector<Double_t> &y1f,
+		std::vector<Double_t> &y2f, Double_t dt, Rise_t *rise) const {
 
 	// find closest maximum to the right ...............................
 	size_t idxMax = argRightRoot(y1f, fSamplesRefine/2);
@@ -244,13 +257,19 @@ Double_t XboxAnalyserEvalRisingEdge::evalRisingEdge(XBOX::XboxDAQChannel &ch) {
 //		}
 //	}
 
-	// cross the tangent in the inflection point with zero ground ......
-	Double_t slope = std::accumulate(y1f.begin() + idxInfl - fWindowSize,
-			y1f.begin() + idxInfl + fWindowSize, 0.) / (2*fWindowSize + 1);
-	size_t idxShift = yf[idxInfl] / (slope * dt);
+	// cross the tangent in the inflection point with zero ground (the
+	// window is clamped at the bounds of the refined trace) ...........
+	size_t idxLo = (idxInfl > fWindowSize) ? idxInfl - fWindowSize : 0;
+	size_t idxHi = std::min(idxInfl + fWindowSize, y1f.size());
+	Double_t slope = std::accumulate(y1f.begin() + idxLo,
+			y1f.begin() + idxHi, 0.) / (2*fWindowSize + 1);
+	size_t idxShift = 0;
 	size_t idxZero = 0;
-	if (idxInfl > idxShift)
-		idxZero = idxInfl - idxShift;
+	if (slope > 0.) {
+		idxShift = yf[idxInfl] / (slope * dt);
+		if (idxInfl > idxShift)
+			idxZero = idxInfl - idxShift;
+	}
 
 	// point of maximum curvature between zero crossing and inflection
 	// point consider interval with idxZero in the center and idxInfl
@@ -271,31 +290,147 @@ Double_t XboxAnalyserEvalRisingEdge::evalRisingEdge(XBOX::XboxDAQChannel &ch) {
 	// curvature seems to be the best option ...........................
 	Int_t idxRise = idxCurv;
 
+	if (rise)
+		*rise = {idxMax, idxInfl, idxShift, idxZero, idxCurv, slope};
+
 	return tf[idxRise];
 }
 
 
+////////////////////////////////////////////////////////////////////////
+/// Rising edge.
+/// Precise evaluation of moment when the rising edge of a pulse starts.
+/// \param[in] ch0 the Xbox DAQ channel containing the current signal.
+/// \param[in] scratch the buffers of the evaluation.
+/// \return    time at the start of the rising edge.
+Double_t XboxAnalyserEvalRisingEdge::evalRisingEdge(const XBOX::XboxDAQChannel &ch,
+		Scratch_t &scratch) const {
+
+	scratch.fWorkspace.reset();
+
+	// first rough calculation of the rising edge.......................
+	Double_t lbnd=0.; ///<Lower time axis bound.
+	Double_t ubnd=0.; ///<Upper time axis bound.
+	ch.getTimeAxisBounds(lbnd, ubnd);
+	Double_t tmin = fWmin * (ubnd - lbnd) + lbnd; ///<Lower limit.
+	Double_t tmax = fWmax * (ubnd - lbnd) + lbnd; ///<Upper limit.
+	Double_t tref = ch.risingEdge(fTh, tmin, tmax, fPrecision);
+
+	// refine resolution around the rising edge and apply filters ......
+	tmin = tref - 0.5 * fProximity * (ubnd - lbnd);
+	tmax = tref + 0.5 * fProximity * (ubnd - lbnd);
+	if (tmin < lbnd)
+		tmin = lbnd;
+	if (tmax > ubnd)
+		tmax = ubnd;
+
+	std::vector<Double_t> &tf = scratch.fTime;
+	XBOX::linspace(tf, tmin, tmax, fSamplesRefine);
+	Double_t dt = (tmax - tmin) / (fSamplesRefine - 1);
+
+	// signal, first and second derivative from a single read of the channel
+	std::vector<std::vector<Double_t>> &res = scratch.fSignals;
+	XBOX::XboxSignalFilter::evaluate(ch, tf, {&fFilterSig, &fFilterD1, &fFilterD2}, res,
+			&scratch.fWorkspace);
+	std::vector<Double_t> &yf = res[0]; // normal signal
+	std::vector<Double_t> &y1f = res[1]; // first derivative
+	std::vector<Double_t> &y2f = res[2]; // second derivative
+
+	return argRise(tf, yf, y1f, y2f, dt);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// The refined evaluation reads up to half the proximity beyond the
+/// window of the rough evaluation.
+/// \param[out] wmin The lower limit of the samples read (relative).
+/// \param[out] wmax The upper limit of the samples read (relative).
+/// \param[out] margin The number of samples read beyond the limits.
+void XboxAnalyserEvalRisingEdge::getWindow(Double_t &wmin, Double_t &wmax,
+		Int_t &margin) const {
+
+	wmin = fWmin - 0.5 * fProximity;
+	wmax = fWmax + 0.5 * fProximity;
+	margin = std::max(fFilterSig.getMargin(),
+			std::max(fFilterD1.getMargin(), fFilterD2.getMargin()));
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Rising edge.
+/// Same as evalRisingEdge() but on a decoded signal, which is smoothed by
+/// the signal filter of the evaluator unless it is already. The
+/// derivatives are filtered from the decoded samples of the window.
+/// \param[in] trace The decoded signal.
+/// \param[out] t The refined time axis.
+/// \param[out] y The re-sampled signal.
+/// \param[out] res The re-sampled first and second derivative.
+/// \param[in] ws The workspace for temporary buffers.
+/// \return The time at the start of the rising edge.
+Double_t XboxAnalyserEvalRisingEdge::evalTrace(XBOX::XboxSignalTrace &trace,
+		std::vector<Double_t> &t, std::vector<Double_t> &y,
+		std::vector<std::vector<Double_t>> &res, XBOX::XboxWorkspace &ws) const {
+
+	trace.smooth(fFilterSig, ws);
+
+	// first rough calculation of the rising edge.......................
+	Double_t lbnd=0.; ///<Lower time axis bound.
+	Double_t ubnd=0.; ///<Upper time axis bound.
+	trace.getTimeAxisBounds(lbnd, ubnd);
+	Double_t tmin = fWmin * (ubnd - lbnd) + lbnd; ///<Lower limit.
+	Double_t tmax = fWmax * (ubnd - lbnd) + lbnd; ///<Upper limit.
+	Double_t tref = trace.risingEdge(fTh, tmin, tmax, fPrecision);
+
+	// refine resolution around the rising edge and apply filters ......
+	tmin = tref - 0.5 * fProximity * (ubnd - lbnd);
+	tmax = tref + 0.5 * fProximity * (ubnd - lbnd);
+	if (tmin < lbnd)
+		tmin = lbnd;
+	if (tmax > ubnd)
+		tmax = ubnd;
+
+	XBOX::linspace(t, tmin, tmax, fSamplesRefine);
+	Double_t dt = (tmax - tmin) / (fSamplesRefine - 1);
+
+	trace.resample(y, t);
+	trace.evaluate(t, {&fFilterD1, &fFilterD2}, res, ws);
+
+	return argRise(t, y, res[0], res[1], dt);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calling function.
-/// Evaluates where the rising edge of a channel signal starts.
+/// Evaluates where the rising edge of a channel signal starts. The
+/// evaluation uses the buffers of the calling thread and can be called
+/// concurrently.
 /// \param[in] ch The input channel.
 /// \return The time when the signal starts.
-Double_t XboxAnalyserEvalRisingEdge::operator () (XBOX::XboxDAQChannel &ch) {
+Double_t XboxAnalyserEvalRisingEdge::operator () (const XBOX::XboxDAQChannel &ch) const {
+
+	static thread_local Scratch_t scratch;
+	Double_t tr = evalRisingEdge(ch, scratch);
+
+	requestReport(ch, tr);
 
-	ch.flushbuffer();
-	XBOX::XboxDAQChannel chnew = ch;
+	return tr;
+}
 
-	// avoid data re-interpretation
-	ch.setAutoRefresh(false);
+////////////////////////////////////////////////////////////////////////////////
+/// Calling function for processing slots.
+/// Same as above but re-uses the buffers of the given slot (see
+/// setNSlots()). Concurrent calls must refer to different slots, as
+/// provided by RDataFrame::DefineSlot.
+/// \param[in] slot The processing slot.
+/// \param[in] ch The input channel.
+/// \return The time when the signal starts.
+Double_t XboxAnalyserEvalRisingEdge::evalSlot(UInt_t slot, const XBOX::XboxDAQChannel &ch) const {
 
-	// precise evaluation of the rising edge
-	Double_t tr = evalRisingEdge(ch);
+	if (slot >= fScratch.size())
+		return (*this)(ch);
 
-	if (fReportFlag)
-		report(ch);
+	Double_t tr = evalRisingEdge(ch, fScratch[slot]);
 
-	// reset auto interpretation
-	ch.setAutoRefresh(true);
+	requestReport(ch, tr);
 
 	return tr;
 }
@@ -303,10 +438,46 @@ Double_t XboxAnalyserEvalRisingEdge::operator () (XBOX::XboxDAQChannel &ch) {
 
 
 
+////////////////////////////////////////////////////////////////////////
+/// Report request.
+/// Submits a report if reporting is enabled and the policy selects the
+/// time of the rising edge (also used by XBOX::XboxAnalyserEvalBreakdown).
+/// \param[in] ch The input channel.
+/// \param[in] tr The evaluated start of the rising edge.
+void XboxAnalyserEvalRisingEdge::requestReport(const XBOX::XboxDAQChannel &ch,
+		Double_t tr) const {
+
+	if (fReportFlag && fReportPolicy.accept(tr))
+		submitReport(ch, tr);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Report request.
+/// Records the channel and the time of the rising edge and passes the
+/// record on to the report policy (see XBOX::XboxAnalyserEvalJitter).
+/// \param[in] ch The input channel.
+/// \param[in] tr The time when the signal starts.
+void XboxAnalyserEvalRisingEdge::submitReport(const XBOX::XboxDAQChannel &ch,
+		Double_t tr) const {
+
+	XBOX::XboxReportRecord rec;
+	rec.addChannel(ch);
+	rec.fResults.push_back(tr);
+
+	XboxAnalyserEvalRisingEdge eval(fWmin, fWmax, fTh, fProximity);
+	eval.setPrecision(fPrecision);
+	eval.setReportDir(fReportDir);
+	rec.fRender = [eval](XBOX::XboxReportRecord &rec) {
+		eval.report(rec.fChannels[0]);
+	};
+
+	fReportPolicy.submit(std::move(rec));
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Report.
 /// \param[in] ch The evaluated Xbox channel.
-void XboxAnalyserEvalRisingEdge::report (XBOX::XboxDAQChannel ch) {
+void XboxAnalyserEvalRisingEdge::report (XBOX::XboxDAQChannel ch) const {
 
 	// first rough calculation of the rising edge......................
 	Double_t lbnd=0.; ///<Lower time axis bound.
@@ -314,7 +485,7 @@ void XboxAnalyserEvalRisingEdge::report (XBOX::XboxDAQChannel ch) {
 	ch.getTimeAxisBounds(lbnd, ubnd);
 	Double_t tmin = fWmin * (ubnd - lbnd) + lbnd; ///<Lower limit.
 	Double_t tmax = fWmax * (ubnd - lbnd) + lbnd; ///<Upper limit.
-	Double_t tref = ch.risingEdge(fTh, tmin, tmax);
+	Double_t tref = ch.risingEdge(fTh, tmin, tmax, fPrecision);
 
 	std::vector<Double_t> tc = ch.getTimeAxis(tmin, tmax);
 	std::vector<Double_t> yc = ch.getSignal(tmin, tmax);
@@ -330,28 +501,18 @@ void XboxAnalyserEvalRisingEdge::report (XBOX::XboxDAQChannel ch) {
 	std::vector<Double_t> tf = XBOX::linspace(tmin, tmax, fSamplesRefine);
 	Double_t dt = (tmax - tmin) / (fSamplesRefine - 1);
 
-	std::vector<Double_t> yf = fFilterSig(ch, tf); // normal signal
-	std::vector<Double_t> y1f = fFilterD1(ch, tf); // first derivative
-	std::vector<Double_t> y2f = fFilterD2(ch, tf); // second derivative
-
-	// find closest maximum to the right ..............................
-	size_t idxMax = argRightRoot(y1f, fSamplesRefine/2);
+	// signal, first and second derivative from a single read of the channel
+	std::vector<std::vector<Double_t>> res;
+	XBOX::XboxSignalFilter::evaluate(ch, tf, {&fFilterSig, &fFilterD1, &fFilterD2}, res);
+	std::vector<Double_t> &yf = res[0]; // normal signal
+	std::vector<Double_t> &y1f = res[1]; // first derivative
+	std::vector<Double_t> &y2f = res[2]; // second derivative
 
-	// find inflection point of the rising edge .......................
-	size_t idxInfl = argLeftRoot(y2f, idxMax);
-
-	// cross the tangent in the inflection point with zero ground ......
-	Double_t slope = std::accumulate(y1f.begin() + idxInfl - fWindowSize,
-			y1f.begin() + idxInfl + fWindowSize, 0.) / (2*fWindowSize + 1);
-
-	size_t idxShift = yf[idxInfl] / (slope * dt);
-	size_t idxZero = 0;
-	if (idxInfl > idxShift)
-		idxZero = idxInfl - idxShift;
-
-	// point of maximum curvature between zero crossing and inflection
-	size_t idxCurv = argMax(y2f, idxZero, idxInfl);
-	Double_t tr = tf[idxCurv];
+	// start of the rising edge with the intermediate points ..........
+	Rise_t rise;
+	Double_t tr = argRise(tf, yf, y1f, y2f, dt, &rise);
+	size_t idxMax = rise.fIdxMax;
+	size_t idxInfl = rise.fIdxInfl;
 
 	// printed report .................................................
 	printf("----------------------------------------------------\n");
@@ -369,14 +530,14 @@ void XboxAnalyserEvalRisingEdge::report (XBOX::XboxDAQChannel ch) {
 	printf("fNSamples              : %u\n", ch.getSamples());
 
 	printf("idxInfl                : %llu\n", idxInfl);
-	printf("idxShift               : %llu\n", idxShift);
-	printf("idxZero                : %llu\n", idxZero);
-	printf("idxCurv                : %llu\n", idxCurv);
+	printf("idxShift               : %llu\n", rise.fIdxShift);
+	printf("idxZero                : %llu\n", rise.fIdxZero);
+	printf("idxCurv                : %llu\n", rise.fIdxCurv);
 
 	printf("tref                   : %e\n", tref);
 	printf("tmax                   : %e\n", tf[idxMax]);
 	printf("tinfl                  : %e\n", tf[idxInfl]);
-	printf("slope                  : %e\n", slope);
+	printf("slope                  : %e\n", rise.fSlope);
 	printf("trise                  : %e\n", tr);
 	printf("----------------------------------------------------\n");
 
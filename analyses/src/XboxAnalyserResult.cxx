@@ -52,6 +52,13 @@ void XboxAnalyserResult::init() {
 
 	fJitter = -1.;
 	fXdev = -1.;
+	fXref = -1.;
+
+	fTranXref = -1.;
+	fTranXdev = -1.;
+	fReflXref = -1.;
+	fReflXdev = -1.;
+	fBDTime = -1.;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -91,6 +98,12 @@ void XboxAnalyserResult::print() {
 
 	printf("fJitter               : %e\n", fJitter);
 	printf("fDevTime              : %e\n", fXdev);
+	printf("fRefTime              : %e\n", fXref);
+	printf("fTranRefTime          : %e\n", fTranXref);
+	printf("fTranDevTime          : %e\n", fTranXdev);
+	printf("fReflRefTime          : %e\n", fReflXref);
+	printf("fReflDevTime          : %e\n", fReflXdev);
+	printf("fBDTime               : %e\n", fBDTime);
 	printf("----------------------------------------------------\n");
 }
 
@@ -151,7 +151,7 @@ Int_t XboxAnalyserView::getXboxVersion(const std::string &sKey) {
 	if (fCategoryChannel[sKey].empty())
 		return -1;
 	else
-		return fCategoryChannel[sKey].front().getXboxVersion();
+		return fCategoryChannel[sKey].fXboxVersion;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -166,11 +166,43 @@ void XboxAnalyserView::getPeriodBounds(
 		ubnd = 0;
 	}
 	else {
-		lbnd = fCategoryChannel[sKey].front().getTimeStamp();
-		ubnd = fCategoryChannel[sKey].back().getTimeStamp();
+		lbnd = fCategoryChannel[sKey].fTimeStamp.front();
+		ubnd = fCategoryChannel[sKey].fTimeStamp.back();
 	}
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Get channel.
+/// Reads a single channel, waveform included, from the input files.
+/// \param[in] sKey The category of channels.
+/// \param[in] idx The index of the event.
+/// \param[out] ch The channel.
+/// \return 0 on success or -1 if the channel could not be read.
+Int_t XboxAnalyserView::getChannel(const std::string &sKey, size_t idx,
+		XBOX::XboxDAQChannel &ch) {
+	return fCategoryChannel[sKey].readChannel(idx, ch);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Find event.
+/// \param[in] sKey The category of channels.
+/// \param[in] ts The time stamp.
+/// \return The index of the event closest in time or -1 if the category
+/// is empty.
+Long64_t XboxAnalyserView::findEventTime(const std::string &sKey, const TTimeStamp &ts) {
+	return fCategoryIndex[sKey].nearestTime(ts);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Find event.
+/// \param[in] sKey The category of channels.
+/// \param[in] pcnt The pulse count.
+/// \return The index of the event closest in pulse count or -1 if the
+/// category is empty.
+Long64_t XboxAnalyserView::findEventPCnt(const std::string &sKey, ULong64_t pcnt) {
+	return fCategoryIndex[sKey].nearestPCnt(pcnt);
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Set window dimensions.
 /// \param[in] ww The window width.
@@ -198,6 +230,8 @@ void XboxAnalyserView::setWindowSize(Int_t ww, Int_t wh) {
 
 ////////////////////////////////////////////////////////////////////////
 /// Set time period.
+/// The events within the period are selected by the index of each
+/// category when plotting over time.
 /// \param[in] begin The first date to be considered.
 /// \param[in] end The last date to be considered.
 void XboxAnalyserView::setLimitsTime(TTimeStamp begin, TTimeStamp end) {
@@ -252,6 +286,8 @@ void XboxAnalyserView::setLimitsPLen(
 
 ////////////////////////////////////////////////////////////////////////
 /// Set limits of pulse count.
+/// The events within the limits are selected by the index of each
+/// category when plotting over the pulse count.
 /// \param[in] min The minimum value to be plotted.
 /// \param[in] max The maximum value to be plotted.
 void XboxAnalyserView::setLimitsPCnt(
@@ -268,22 +304,52 @@ void XboxAnalyserView::setLimitsPCnt(
 /// Adjust the limits of the pulse count according to the time period.
 void XboxAnalyserView::autosetPCntLimits(const std::string &sKey) {
 
-	if (fCategoryChannel[sKey].empty())
+	std::vector<ULong64_t> &vPCnt = fCategoryChannel[sKey].fPulseCount;
+	const XBOX::XboxAnalyserViewIndex &index = fCategoryIndex[sKey];
+	size_t n = vPCnt.size();
+	if (!n || index.size() != n)
 		return;
 
-	fPCntMin = fCategoryChannel[sKey].front().getPulseCount();
-	fPCntMax = fCategoryChannel[sKey].back().getPulseCount();
-	for (size_t i=1; i<fCategoryChannel[sKey].size(); i++) {
-		if (fCategoryChannel[sKey][i].getTimeStamp() > fDateBegin) {
-			fPCntMin = fCategoryChannel[sKey][i-1].getPulseCount();
-			break;
-		}
+	fPCntMin = vPCnt.front();
+	fPCntMax = vPCnt.back();
+
+	// last event before the time period
+	size_t pos = index.upperBoundTime(fDateBegin);
+	if (pos < n)
+		fPCntMin = vPCnt[index.getEventByTime(pos > 0 ? pos-1 : 0)];
+
+	// first event after the time period
+	pos = index.upperBoundTime(fDateEnd);
+	if (pos + 1 < n)
+		fPCntMax = vPCnt[index.getEventByTime(pos)];
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Selection of events.
+/// Binary search of the events within the time period or the pulse count
+/// limits, depending on the horizontal axis. All events are selected if
+/// the limits are not set.
+/// \param[in] sKey The category of channels or the tree of a tuple.
+/// \return The selected events in order of the horizontal axis.
+std::vector<size_t> XboxAnalyserView::selectEvents(const std::string &sKey) {
+
+	const XBOX::XboxAnalyserViewIndex &index = fCategoryIndex[sKey];
+	if (index.empty())
+		return std::vector<size_t>();
+
+	size_t n = index.size();
+	if (fHorzAxis == kTime) {
+		if (fDateBegin < fDateEnd)
+			return index.selectTime(fDateBegin, fDateEnd);
+		else
+			return index.selectTime(index.getTime(0), index.getTime(n-1));
 	}
-	for (size_t i=0; i<fCategoryChannel[sKey].size()-1; i++) {
-		if (fCategoryChannel[sKey][i].getTimeStamp() > fDateEnd) {
-			fPCntMax = fCategoryChannel[sKey][i].getPulseCount();
-			break;
-		}
+	else {
+		if (fPCntMin < fPCntMax)
+			return index.selectPCnt(fPCntMin, fPCntMax);
+		else
+			return index.selectPCnt(index.getPCnt(0), index.getPCnt(n-1));
 	}
 }
 
@@ -509,10 +575,22 @@ void XboxAnalyserView::load(const std::string &filePathGlob, const std::string &
 		// channels are sorted in time
 		if (!colTypes[i].compare("XBOX::XboxDAQChannel")) {
 
-			std::vector<XBOX::XboxDAQChannel> v = *df.Take<XBOX::XboxDAQChannel>(colNames[i]);
-			std::sort (v.begin(), v.end()); // important if imt is enabled
-
-			fCategoryChannel.emplace(treeName + "." + colNames[i], v);
+			// meta data only, the waveforms are read on demand
+			XBOX::XboxAnalyserViewColumn col;
+			if (col.read(fFilePaths, treeName, colNames[i]))
+				continue;
+
+			// sort the keys rather than the events (important if the
+			// files are not in order) and reorder the columns once
+			XBOX::XboxAnalyserViewIndex index(col.fTimeStamp, col.fPulseCount);
+			std::vector<size_t> order(index.size());
+			for (size_t j=0; j<order.size(); j++)
+				order[j] = index.getEventByTime(j);
+			col.permute(order);
+			index.build(col.fTimeStamp, col.fPulseCount);
+
+			fCategoryChannel.emplace(treeName + "." + colNames[i], std::move(col));
+			fCategoryIndex.emplace(treeName + "." + colNames[i], std::move(index));
 			printf(" ... add column %s.%s\n", treeName.c_str(), colNames[i].c_str());
 		}
 		// tuples are unsorted
@@ -529,6 +607,7 @@ void XboxAnalyserView::load(const std::string &filePathGlob, const std::string &
 	std::vector<ULong64_t> vPulseCount = *df.Take<ULong64_t>("PulseCount");
 	fCategoryTimeStamp.emplace(treeName + ".TimeStamp", vTimeStamp);
 	fCategoryPulseCount.emplace(treeName + ".PulseCount", vPulseCount);
+	fCategoryIndex.emplace(treeName, XBOX::XboxAnalyserViewIndex(vTimeStamp, vPulseCount));
 
 }
 
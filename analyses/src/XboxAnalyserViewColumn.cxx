@@ -0,0 +1,235 @@
+#include "XboxAnalyserViewColumn.hxx"
+
+// root
+#include "TFile.h"
+#include "TTree.h"
+#include "TChain.h"
+#include "TObjArray.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Reorder a vector.
+/// \param[in,out] v The vector.
+/// \param[in] order The former positions of the elements in new order.
+template <typename T>
+static void reorder(std::vector<T> &v, const std::vector<size_t> &order) {
+
+	std::vector<T> tmp(order.size());
+	for (size_t i=0; i<order.size(); i++)
+		tmp[i] = v[order[i]];
+	v.swap(tmp);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxAnalyserViewColumn::XboxAnalyserViewColumn() {
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxAnalyserViewColumn::~XboxAnalyserViewColumn() {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Clear.
+void XboxAnalyserViewColumn::clear() {
+
+	fFilePaths.clear();
+	fTreeName.clear();
+	fColName.clear();
+	fXboxVersion = -1;
+
+	fFile.clear();
+	fEntry.clear();
+	fTimeStamp.clear();
+	fPulseCount.clear();
+	fYmean.clear();
+	fXmin.clear();
+	fXmax.clear();
+	fBreakdownFlag.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reserve memory.
+/// \param[in] n The number of events.
+void XboxAnalyserViewColumn::reserve(size_t n) {
+
+	fFile.reserve(n);
+	fEntry.reserve(n);
+	fTimeStamp.reserve(n);
+	fPulseCount.reserve(n);
+	fYmean.reserve(n);
+	fXmin.reserve(n);
+	fXmax.reserve(n);
+	fBreakdownFlag.reserve(n);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Add an event.
+/// Keeps the meta data of the channel only.
+/// \param[in] ch The channel.
+/// \param[in] file The file of the channel (index of fFilePaths).
+/// \param[in] entry The entry of the channel in the file.
+void XboxAnalyserViewColumn::push_back(const XBOX::XboxDAQChannel &ch, Int_t file,
+		Long64_t entry) {
+
+	if (fEntry.empty())
+		fXboxVersion = ch.getXboxVersion();
+
+	fFile.push_back(file);
+	fEntry.push_back(entry);
+	fTimeStamp.push_back(ch.getTimeStamp());
+	fPulseCount.push_back(ch.getPulseCount());
+	fYmean.push_back(ch.getYmean());
+	fXmin.push_back(ch.getXmin());
+	fXmax.push_back(ch.getXmax());
+	fBreakdownFlag.push_back(ch.getBreakdownFlag());
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reorder the events.
+/// \param[in] order The former positions of the events in new order.
+void XboxAnalyserViewColumn::permute(const std::vector<size_t> &order) {
+
+	if (order.size() != size()) {
+		printf("ERROR: Permutation of %zu events does not match %zu events\n",
+				order.size(), size());
+		return;
+	}
+
+	reorder(fFile, order);
+	reorder(fEntry, order);
+	reorder(fTimeStamp, order);
+	reorder(fPulseCount, order);
+	reorder(fYmean, order);
+	reorder(fXmin, order);
+	reorder(fXmax, order);
+	reorder(fBreakdownFlag, order);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Load method.
+/// Reads the meta data of a channel column from a chain of files. If the
+/// channel branch is split, only the sub-branches of the meta data are
+/// read. Otherwise the channels are read one after another and their
+/// waveforms are dropped. The events are kept in the order of the chain
+/// together with their file and their entry in the file.
+/// \param[in] filePaths The input files.
+/// \param[in] treeName The name of the tree.
+/// \param[in] colName The name of the channel column.
+/// \return 0 on success or -1 if the column could not be read.
+Int_t XboxAnalyserViewColumn::read(const std::vector<std::string> &filePaths,
+		const std::string &treeName, const std::string &colName) {
+
+	clear();
+
+	TChain chain(treeName.c_str());
+	for (auto &s: filePaths)
+		chain.Add(s.c_str());
+
+	std::string prefix = colName + ".";
+	Bool_t bSplit = chain.FindBranch((prefix + "fPulseCount").c_str()) != nullptr;
+
+	TTreeReader reader(&chain);
+	Int_t status = 0;
+
+	if (bSplit) {
+		TTreeReaderValue<Int_t> version(reader, (prefix + "fXboxVersion").c_str());
+		TTreeReaderValue<TTimeStamp> ts(reader, (prefix + "fTimeStamp").c_str());
+		TTreeReaderValue<ULong64_t> pcnt(reader, (prefix + "fPulseCount").c_str());
+		TTreeReaderValue<Double_t> ymean(reader, (prefix + "fYmean").c_str());
+		TTreeReaderValue<Double_t> xmin(reader, (prefix + "fXmin").c_str());
+		TTreeReaderValue<Double_t> xmax(reader, (prefix + "fXmax").c_str());
+		TTreeReaderValue<Bool_t> bdflag(reader, (prefix + "fBreakdownFlag").c_str());
+
+		reserve(chain.GetEntries());
+		while (reader.Next()) {
+			if (fEntry.empty())
+				fXboxVersion = *version;
+
+			fFile.push_back(chain.GetTreeNumber());
+			fEntry.push_back(chain.GetTree()->GetReadEntry());
+			fTimeStamp.push_back(*ts);
+			fPulseCount.push_back(*pcnt);
+			fYmean.push_back(*ymean);
+			fXmin.push_back(*xmin);
+			fXmax.push_back(*xmax);
+			fBreakdownFlag.push_back(*bdflag);
+		}
+		status = pcnt.GetSetupStatus();
+	}
+	else {
+		TTreeReaderValue<XBOX::XboxDAQChannel> ch(reader, colName.c_str());
+
+		reserve(chain.GetEntries());
+		while (reader.Next())
+			push_back(*ch, chain.GetTreeNumber(), chain.GetTree()->GetReadEntry());
+		status = ch.GetSetupStatus();
+	}
+
+	if (status < 0) {
+		printf("ERROR: Cannot read column %s.%s\n", treeName.c_str(), colName.c_str());
+		clear();
+		return -1;
+	}
+
+	// files of the chain (see fFile)
+	TObjArray *files = chain.GetListOfFiles();
+	for (Int_t i=0; i<files->GetEntriesFast(); i++)
+		fFilePaths.push_back(files->At(i)->GetTitle());
+	fTreeName = treeName;
+	fColName = colName;
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Load method.
+/// Reads a single channel, raw data included. Only the file of the
+/// channel is opened.
+/// \param[in] idx The index of the event.
+/// \param[out] ch The channel.
+/// \return 0 on success or -1 if the channel could not be read.
+Int_t XboxAnalyserViewColumn::readChannel(size_t idx, XBOX::XboxDAQChannel &ch) const {
+
+	if (idx >= size() || fFile[idx] < 0 || fFile[idx] >= (Int_t) fFilePaths.size())
+		return -1;
+
+	const std::string &filepath = fFilePaths[fFile[idx]];
+	TFile file(filepath.c_str(), "READ");
+	TTree *tree = nullptr;
+	if (!file.IsZombie())
+		file.GetObject(fTreeName.c_str(), tree);
+	if (!tree) {
+		printf("ERROR: Cannot read tree %s from file %s\n", fTreeName.c_str(),
+				filepath.c_str());
+		return -1;
+	}
+
+	TTreeReader reader(tree);
+	TTreeReaderValue<XBOX::XboxDAQChannel> val(reader, fColName.c_str());
+
+	if (reader.SetEntry(fEntry[idx]) != TTreeReader::kEntryValid || !val.Get()) {
+		printf("ERROR: Cannot read entry %lld of column %s.%s in file %s\n",
+				(long long) fEntry[idx], fTreeName.c_str(), fColName.c_str(),
+				filepath.c_str());
+		return -1;
+	}
+	ch = *val;
+
+	return 0;
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
@@ -0,0 +1,216 @@
+#include "XboxAnalyserViewIndex.hxx"
+
+#include <algorithm>
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxAnalyserViewIndex::XboxAnalyserViewIndex() {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+/// \param[in] time The time stamps of the events.
+/// \param[in] pcnt The pulse counts of the events.
+XboxAnalyserViewIndex::XboxAnalyserViewIndex(const std::vector<TTimeStamp> &time,
+		const std::vector<ULong64_t> &pcnt) {
+	build(time, pcnt);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxAnalyserViewIndex::~XboxAnalyserViewIndex() {
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Clear.
+void XboxAnalyserViewIndex::clear() {
+
+	fOrderTime.clear();
+	fOrderPCnt.clear();
+	fTime.clear();
+	fPCnt.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Build the index.
+/// Sorts the event numbers only (stable, i.e. events with equal keys
+/// keep their order). Both vectors must have the same length.
+/// \param[in] time The time stamps of the events.
+/// \param[in] pcnt The pulse counts of the events.
+void XboxAnalyserViewIndex::build(const std::vector<TTimeStamp> &time,
+		const std::vector<ULong64_t> &pcnt) {
+
+	clear();
+	if (time.size() != pcnt.size()) {
+		printf("ERROR: Number of time stamps (%zu) and pulse counts (%zu) differ\n",
+				time.size(), pcnt.size());
+		return;
+	}
+
+	size_t n = time.size();
+	fOrderTime.resize(n);
+	fOrderPCnt.resize(n);
+	for (size_t i=0; i<n; i++) {
+		fOrderTime[i] = i;
+		fOrderPCnt[i] = i;
+	}
+
+	// the data are mostly in order already
+	if (!std::is_sorted(time.begin(), time.end()))
+		std::stable_sort(fOrderTime.begin(), fOrderTime.end(),
+				[&time](size_t i, size_t j) { return time[i] < time[j]; });
+	if (!std::is_sorted(pcnt.begin(), pcnt.end()))
+		std::stable_sort(fOrderPCnt.begin(), fOrderPCnt.end(),
+				[&pcnt](size_t i, size_t j) { return pcnt[i] < pcnt[j]; });
+
+	fTime.resize(n);
+	fPCnt.resize(n);
+	for (size_t i=0; i<n; i++) {
+		fTime[i] = time[fOrderTime[i]];
+		fPCnt[i] = pcnt[fOrderPCnt[i]];
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Time difference.
+/// \return The difference t1 - t0 in nanoseconds.
+Long64_t XboxAnalyserViewIndex::diffTime(const TTimeStamp &t1, const TTimeStamp &t0) {
+
+	return ((Long64_t) t1.GetSec() - (Long64_t) t0.GetSec()) * 1000000000LL
+			+ (t1.GetNanoSec() - t0.GetNanoSec());
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Binary search.
+/// \param[in] t The time stamp.
+/// \return The first position with a time stamp not before t.
+size_t XboxAnalyserViewIndex::lowerBoundTime(const TTimeStamp &t) const {
+	return std::lower_bound(fTime.begin(), fTime.end(), t) - fTime.begin();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Binary search.
+/// \param[in] t The time stamp.
+/// \return The first position with a time stamp after t.
+size_t XboxAnalyserViewIndex::upperBoundTime(const TTimeStamp &t) const {
+	return std::upper_bound(fTime.begin(), fTime.end(), t) - fTime.begin();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Binary search.
+/// \param[in] pcnt The pulse count.
+/// \return The first position with a pulse count not below pcnt.
+size_t XboxAnalyserViewIndex::lowerBoundPCnt(ULong64_t pcnt) const {
+	return std::lower_bound(fPCnt.begin(), fPCnt.end(), pcnt) - fPCnt.begin();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Binary search.
+/// \param[in] pcnt The pulse count.
+/// \return The first position with a pulse count above pcnt.
+size_t XboxAnalyserViewIndex::upperBoundPCnt(ULong64_t pcnt) const {
+	return std::upper_bound(fPCnt.begin(), fPCnt.end(), pcnt) - fPCnt.begin();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Range query.
+/// \param[in] begin The first time stamp.
+/// \param[in] end The last time stamp.
+/// \param[out] first The first position in the range.
+/// \param[out] last The position past the range.
+void XboxAnalyserViewIndex::rangeTime(const TTimeStamp &begin, const TTimeStamp &end,
+		size_t &first, size_t &last) const {
+
+	first = lowerBoundTime(begin);
+	last = std::max(first, upperBoundTime(end));
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Range query.
+/// \param[in] min The smallest pulse count.
+/// \param[in] max The largest pulse count.
+/// \param[out] first The first position in the range.
+/// \param[out] last The position past the range.
+void XboxAnalyserViewIndex::rangePCnt(ULong64_t min, ULong64_t max,
+		size_t &first, size_t &last) const {
+
+	first = lowerBoundPCnt(min);
+	last = std::max(first, upperBoundPCnt(max));
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Selection.
+/// \param[in] begin The first time stamp.
+/// \param[in] end The last time stamp.
+/// \return The events within the time period in order of time.
+std::vector<size_t> XboxAnalyserViewIndex::selectTime(const TTimeStamp &begin,
+		const TTimeStamp &end) const {
+
+	size_t first, last;
+	rangeTime(begin, end, first, last);
+	return std::vector<size_t>(fOrderTime.begin() + first, fOrderTime.begin() + last);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Selection.
+/// \param[in] min The smallest pulse count.
+/// \param[in] max The largest pulse count.
+/// \return The events within the pulse count range in order of the
+/// pulse count.
+std::vector<size_t> XboxAnalyserViewIndex::selectPCnt(ULong64_t min,
+		ULong64_t max) const {
+
+	size_t first, last;
+	rangePCnt(min, max, first, last);
+	return std::vector<size_t>(fOrderPCnt.begin() + first, fOrderPCnt.begin() + last);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Nearest neighbour.
+/// \param[in] t The time stamp.
+/// \return The event closest in time (the earlier one if equally
+/// distant) or -1 if the index is empty.
+Long64_t XboxAnalyserViewIndex::nearestTime(const TTimeStamp &t) const {
+
+	if (fTime.empty())
+		return -1;
+
+	size_t pos = lowerBoundTime(t);
+	if (pos == fTime.size())
+		pos--;
+	else if (pos > 0 && diffTime(t, fTime[pos-1]) <= diffTime(fTime[pos], t))
+		pos--;
+
+	return fOrderTime[pos];
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Nearest neighbour.
+/// \param[in] pcnt The pulse count.
+/// \return The event closest in pulse count (the lower one if equally
+/// distant) or -1 if the index is empty.
+Long64_t XboxAnalyserViewIndex::nearestPCnt(ULong64_t pcnt) const {
+
+	if (fPCnt.empty())
+		return -1;
+
+	size_t pos = lowerBoundPCnt(pcnt);
+	if (pos == fPCnt.size())
+		pos--;
+	else if (pos > 0 && pcnt - fPCnt[pos-1] <= fPCnt[pos] - pcnt)
+		pos--;
+
+	return fOrderPCnt[pos];
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
@@ -18,6 +18,7 @@
 // xbox
 #include "XboxAlgorithms.h"
 #include "XboxSignalFilter.hxx"
+#include "XboxDAQChannelPyramid.hxx"
 #include "XboxAnalyserBreakdownRate.hxx"
 
 #ifndef XBOX_NO_NAMESPACE
@@ -410,8 +411,9 @@ void XboxAnalyserView::drawAxisRate(Int_t iColor, const std::string &sOpt, Int_t
 void XboxAnalyserView::plotPAvg(const std::string &sKey, Int_t iColor,
 		const std::string &sOpt, Style_t iMarkerStyle, size_t iMarkerSize) {
 
-	fCategoryChannel[sKey].size();
-	size_t nEvents = fCategoryChannel[sKey].size();
+	XBOX::XboxAnalyserViewColumn &col = fCategoryChannel[sKey];
+	std::vector<size_t> vEvents = selectEvents(sKey);
+	size_t nEvents = vEvents.size();
 
 	std::vector<Double_t> vPAvg(nEvents);
 	std::vector<Double_t> vQtyX(nEvents);
@@ -436,13 +438,13 @@ void XboxAnalyserView::plotPAvg(const std::string &sKey, Int_t iColor,
 		xmin = (Double_t)fDateBegin;
 		xmax = (Double_t)fDateEnd;
 		for (size_t i=0; i<nEvents; i++)
-			vQtyX[i] = (Double_t)fCategoryChannel[sKey][i].getTimeStamp();
+			vQtyX[i] = (Double_t)col.fTimeStamp[vEvents[i]];
 	}
 	else {
 		xmin = (Double_t)fPCntMin / fPCntScale;
 		xmax = (Double_t)fPCntMax / fPCntScale;
 		for (size_t i=0; i<nEvents; i++)
-			vQtyX[i] = (Double_t)fCategoryChannel[sKey][i].getPulseCount() / fPCntScale;
+			vQtyX[i] = (Double_t)col.fPulseCount[vEvents[i]] / fPCntScale;
 	}
 
 	// limits and values of the vertical axis (vQtyY)
@@ -456,7 +458,7 @@ void XboxAnalyserView::plotPAvg(const std::string &sKey, Int_t iColor,
 	}
 
 	for (size_t i=0; i<nEvents; i++)
-		vPAvg[i] = fCategoryChannel[sKey][i].getYmean();
+		vPAvg[i] = col.fYmean[vEvents[i]];
 	vQtyY = rescale(vPAvg, fPAvgMin, fPAvgMax, false, ymin, ymax);
 
 	// fill histogram
@@ -486,8 +488,9 @@ void XboxAnalyserView::plotPAvg(const std::string &sKey, Int_t iColor,
 void XboxAnalyserView::plotPLen(const std::string &sKey, Int_t iColor,
 		const std::string &sOpt, Style_t iMarkerStyle, size_t iMarkerSize) {
 
-	fCategoryChannel[sKey].size();
-	size_t nEvents = fCategoryChannel[sKey].size();
+	XBOX::XboxAnalyserViewColumn &col = fCategoryChannel[sKey];
+	std::vector<size_t> vEvents = selectEvents(sKey);
+	size_t nEvents = vEvents.size();
 
 	std::vector<Double_t> vPLen(nEvents);
 	std::vector<Double_t> vQtyX(nEvents);
@@ -515,16 +518,16 @@ void XboxAnalyserView::plotPLen(const std::string &sKey, Int_t iColor,
 		xmin = (Double_t)fDateBegin;
 		xmax = (Double_t)fDateEnd;
 		for (size_t i=0; i<nEvents; i++)
-			vQtyX[i] = (Double_t)fCategoryChannel[sKey][i].getTimeStamp();
+			vQtyX[i] = (Double_t)col.fTimeStamp[vEvents[i]];
 
-		printf("begin: %s\n", fCategoryChannel[sKey].front().getTimeStamp().AsString());
-		printf("end: %s\n", fCategoryChannel[sKey].back().getTimeStamp().AsString());
+		printf("begin: %s\n", col.fTimeStamp.front().AsString());
+		printf("end: %s\n", col.fTimeStamp.back().AsString());
 	}
 	else {
 		xmin = (Double_t)fPCntMin / fPCntScale;
 		xmax = (Double_t)fPCntMax / fPCntScale;
 		for (size_t i=0; i<nEvents; i++)
-			vQtyX[i] = (Double_t)fCategoryChannel[sKey][i].getPulseCount() / fPCntScale;
+			vQtyX[i] = (Double_t)col.fPulseCount[vEvents[i]] / fPCntScale;
 	}
 
 	// limits and values of the vertical axis (vQtyY)
@@ -538,7 +541,7 @@ void XboxAnalyserView::plotPLen(const std::string &sKey, Int_t iColor,
 	}
 
 	for (size_t i=0; i<nEvents; i++)
-		vPLen[i] = fCategoryChannel[sKey][i].getXmax() - fCategoryChannel[sKey][i].getXmin();
+		vPLen[i] = col.fXmax[vEvents[i]] - col.fXmin[vEvents[i]];
 	vQtyY = rescale(vPLen, fPLenMin, fPLenMax, false, ymin, ymax);
 
 	// fill histogram
@@ -568,8 +571,9 @@ void XboxAnalyserView::plotPLen(const std::string &sKey, Int_t iColor,
 void XboxAnalyserView::plotPCnt(const std::string &sKey, Int_t iColor,
 		const std::string &sOpt, Style_t iMarkerStyle, size_t iMarkerSize) {
 
-	fCategoryChannel[sKey].size();
-	size_t nEvents = fCategoryChannel[sKey].size();
+	XBOX::XboxAnalyserViewColumn &col = fCategoryChannel[sKey];
+	std::vector<size_t> vEvents = selectEvents(sKey);
+	size_t nEvents = vEvents.size();
 
 	std::vector<ULong64_t> vPCnt(nEvents);
 	std::vector<Double_t> vQtyX(nEvents);
@@ -594,13 +598,13 @@ void XboxAnalyserView::plotPCnt(const std::string &sKey, Int_t iColor,
 		xmin = (Double_t)fDateBegin;
 		xmax = (Double_t)fDateEnd;
 		for (size_t i=0; i<nEvents; i++)
-			vQtyX[i] = (Double_t)fCategoryChannel[sKey][i].getTimeStamp();
+			vQtyX[i] = (Double_t)col.fTimeStamp[vEvents[i]];
 	}
 	else {
 		xmin = (Double_t)fPCntMin / fPCntScale;
 		xmax = (Double_t)fPCntMax / fPCntScale;
 		for (size_t i=0; i<nEvents; i++)
-			vQtyX[i] = (Double_t)fCategoryChannel[sKey][i].getPulseCount() / fPCntScale;
+			vQtyX[i] = (Double_t)col.fPulseCount[vEvents[i]] / fPCntScale;
 	}
 
 	// limits and values of the vertical axis (vQtyY)
@@ -613,7 +617,7 @@ void XboxAnalyserView::plotPCnt(const std::string &sKey, Int_t iColor,
 		ymax = fPCntMax / fPCntScale;
 	}
 	for (size_t i=0; i<nEvents; i++)
-		vPCnt[i] = fCategoryChannel[sKey][i].getPulseCount();
+		vPCnt[i] = col.fPulseCount[vEvents[i]];
 	vQtyY = rescale(vPCnt, fPCntMin, fPCntMax, false, ymin, ymax);
 
 	// fill histogram
@@ -642,11 +646,9 @@ void XboxAnalyserView::plotPCnt(const std::string &sKey, Int_t iColor,
 void XboxAnalyserView::plotRate(const std::string &sKey, Int_t iColor,
 		const std::string &sOpt, Style_t iMarkerStyle, size_t iMarkerSize) {
 
-	fCategoryChannel[sKey].size();
-	size_t nEvents = fCategoryChannel[sKey].size();
-
-	std::vector<TTimeStamp> vTime(nEvents, 0.);
-	std::vector<ULong64_t> vPCnt(nEvents, 0.);
+	XBOX::XboxAnalyserViewColumn &col = fCategoryChannel[sKey];
+	const XBOX::XboxAnalyserViewIndex &index = fCategoryIndex[sKey];
+	size_t nEvents = index.size();
 
 	std::vector<TTimeStamp> vTimeS(fNSamples, 0.); // resampled time axis
 	std::vector<ULong64_t> vPCntS(fNSamples, 0.); // resampled pulse count axis
@@ -674,25 +676,18 @@ void XboxAnalyserView::plotRate(const std::string &sKey, Int_t iColor,
 	opt.erase(std::remove(opt.begin(), opt.end(), 'a'), opt.end());
 	opt.erase(std::remove(opt.begin(), opt.end(), 'A'), opt.end());
 
-	// evaluate breakdown rate
-	for (size_t i=0; i<nEvents; i++) {
-		vTime[i] = fCategoryChannel[sKey][i].getTimeStamp();
-		vPCnt[i] = fCategoryChannel[sKey][i].getPulseCount();
-	}
-	XBOX::XboxAnalyserBreakdownRate bdr(vPCnt);
+	// evaluate breakdown rate over the entire history
+	XBOX::XboxAnalyserBreakdownRate bdr(index.getPCntSorted());
 	bdr.setWeightFunction(XBOX::XboxAnalyserBreakdownRate::kGaussian, 0.02, 3);
 	bdr.setSamples(fNSamples);
 	bdr.fromMovingWindow(vPCntS, vRateS);
 
-	// search for nearest time
+	// time of the first event at or after each sample (binary search)
 	for(size_t i=0; i<fNSamples; i++) {
 
-		for (size_t j=1; j<nEvents; j++) {
-			if (vPCnt[j-1] < vPCntS[i] && vPCnt[j] >= vPCntS[i]) {
-				vTimeS[i] = vTime[j];
-				break;
-			}
-		}
+		size_t pos = index.lowerBoundPCnt(vPCntS[i]);
+		if (pos > 0 && pos < nEvents)
+			vTimeS[i] = col.fTimeStamp[index.getEventByPCnt(pos)];
 	}
 
 	// limits and values of the horizontal axis (vQtyX)
@@ -781,7 +776,9 @@ void XboxAnalyserView::plotRate(const std::string &sKey, Int_t iColor,
 void XboxAnalyserView::plotBDPosTime(const std::string &sKey,
 		Int_t iColor, const std::string &sOpt, Style_t iMarkerStyle, size_t iMarkerSize) {
 
-	size_t nEvents = fCategoryTuple[sKey].size();
+	std::string tree = sKey.substr(0, sKey.find("."));
+	std::vector<size_t> vEvents = selectEvents(tree);
+	size_t nEvents = vEvents.size();
 
 	std::vector<Double_t> vBDPosTime(nEvents);
 	std::vector<Double_t> vQtyX(nEvents);
@@ -805,16 +802,16 @@ void XboxAnalyserView::plotBDPosTime(const std::string &sKey,
 	if (fHorzAxis == kTime) {
 		xmin = (Double_t)fDateBegin;
 		xmax = (Double_t)fDateEnd;
-		std::string category = sKey.substr(0, sKey.find(".")) + ".TimeStamp";
+		std::vector<TTimeStamp> &vTimeStamp = fCategoryTimeStamp[tree + ".TimeStamp"];
 		for (size_t i=0; i<nEvents; i++)
-			vQtyX[i] = (Double_t)fCategoryTimeStamp[category][i];
+			vQtyX[i] = (Double_t)vTimeStamp[vEvents[i]];
 	}
 	else {
 		xmin = (Double_t)fPCntMin / fPCntScale;
 		xmax = (Double_t)fPCntMax / fPCntScale;
-		std::string category = sKey.substr(0, sKey.find(".")) + ".PulseCount";
+		std::vector<ULong64_t> &vPulseCount = fCategoryPulseCount[tree + ".PulseCount"];
 		for (size_t i=0; i<nEvents; i++)
-			vQtyX[i] = (Double_t)fCategoryPulseCount[category][i] / fPCntScale;
+			vQtyX[i] = (Double_t)vPulseCount[vEvents[i]] / fPCntScale;
 	}
 
 	// limits and values of the vertical axis (vQtyY)
@@ -828,7 +825,9 @@ void XboxAnalyserView::plotBDPosTime(const std::string &sKey,
 	}
 
 	// get the breakdown position time
-	vBDPosTime = fCategoryTuple[sKey];
+	std::vector<Double_t> &vTuple = fCategoryTuple[sKey];
+	for (size_t i=0; i<nEvents; i++)
+		vBDPosTime[i] = vTuple[vEvents[i]];
 	vQtyY = rescale(vBDPosTime, fBDPosTimeMin, fBDPosTimeMax, false, ymin, ymax);
 
 	// fill histogram
@@ -891,11 +890,10 @@ void XboxAnalyserView::plotSignal(const std::string &sKey, Int_t idx,
 		Style_t iMarkerStyle, size_t iMarkerSize,
 		Double_t xmin, Double_t xmax, Double_t ymin, Double_t ymax) {
 
-	size_t n = fCategoryChannel[sKey].size();
-	if (idx >= n)
+	// read the waveform on demand
+	XBOX::XboxDAQChannel ch;
+	if (idx < 0 || getChannel(sKey, idx, ch))
 		return;
-
-	XBOX::XboxDAQChannel ch = fCategoryChannel[sKey][idx];
 	Double_t jitter = ch .getStartOffset();
 	if (jitter == -1)
 		ch.setStartOffset(0);
@@ -918,9 +916,18 @@ void XboxAnalyserView::plotSignal(const std::string &sKey, Int_t idx,
 	}
 
 	// read data over the entire argument range of the channels
-	XBOX::XboxSignalFilter filter;
-	std::vector<Double_t> x = XBOX::linspace(xmin, xmax, fNSamples);
-	std::vector<Double_t> y = filter(ch, x);
+	std::vector<Double_t> x;
+	std::vector<Double_t> y;
+	if (ch.getIncrement() > 0 && (xmax - xmin) / ch.getIncrement() > fNSamples) {
+		// decimated min/max envelope (keeps the peaks)
+		XBOX::XboxDAQChannelPyramid pyramid(ch);
+		pyramid.getPolyline(x, y, xmin, xmax, fNSamples);
+	}
+	else {
+		XBOX::XboxSignalFilter filter;
+		x = XBOX::linspace(xmin, xmax, fNSamples);
+		y = filter(ch, x);
+	}
 
 //	printf("%e, %e\n", xmin, xmax);
 //	printf("%e, %e\n", y.front(), y.back());
@@ -982,13 +989,11 @@ void XboxAnalyserView::plotSignal(const std::string &sKey1, const std::string &s
 		Style_t iMarkerStyle, size_t iMarkerSize,
 		Double_t xmin, Double_t xmax, Double_t ymin, Double_t ymax) {
 
-	size_t n1 = fCategoryChannel[sKey1].size();
-	size_t n2 = fCategoryChannel[sKey2].size();
-	if (idx >= n1 || idx >= n2)
+	// read the waveforms on demand
+	XBOX::XboxDAQChannel ch1;
+	XBOX::XboxDAQChannel ch2;
+	if (idx < 0 || getChannel(sKey1, idx, ch1) || getChannel(sKey2, idx, ch2))
 		return;
-
-	XBOX::XboxDAQChannel ch1 = fCategoryChannel[sKey1][idx];
-	XBOX::XboxDAQChannel ch2 = fCategoryChannel[sKey2][idx];
 	Double_t jitter1 = ch1 .getStartOffset();
 	Double_t jitter2 = ch2 .getStartOffset();
 	if (jitter1 == -1)
@@ -1014,10 +1019,24 @@ void XboxAnalyserView::plotSignal(const std::string &sKey1, const std::string &s
 	}
 
 	// read data over the entire argument range of the channels
-	XBOX::XboxSignalFilter filter;
-	std::vector<Double_t> x = XBOX::linspace(xmin, xmax, fNSamples);
-	std::vector<Double_t> y1 = filter(ch1, x);
-	std::vector<Double_t> y2 = filter(ch2, x);
+	std::vector<Double_t> x1;
+	std::vector<Double_t> x2;
+	std::vector<Double_t> y1;
+	std::vector<Double_t> y2;
+	if (ch1.getIncrement() > 0 && (xmax - xmin) / ch1.getIncrement() > fNSamples) {
+		// decimated min/max envelope (keeps the peaks)
+		XBOX::XboxDAQChannelPyramid pyramid1(ch1);
+		XBOX::XboxDAQChannelPyramid pyramid2(ch2);
+		pyramid1.getPolyline(x1, y1, xmin, xmax, fNSamples);
+		pyramid2.getPolyline(x2, y2, xmin, xmax, fNSamples);
+	}
+	else {
+		XBOX::XboxSignalFilter filter;
+		x1 = XBOX::linspace(xmin, xmax, fNSamples);
+		x2 = x1;
+		y1 = filter(ch1, x1);
+		y2 = filter(ch2, x2);
+	}
 
 //	printf("%e, %e\n", xmin, xmax);
 //	printf("%e, %e\n", y1.front(), y1.back());
@@ -1031,8 +1050,8 @@ void XboxAnalyserView::plotSignal(const std::string &sKey1, const std::string &s
 	snprintf (stitle, 200, "%s %s PulseCount: %llu",
 			name.c_str(), ts.AsString(), count);
 
-	TGraph *gr1 = new TGraph(x.size(), &x[0], &y1[0]);
-	TGraph *gr2 = new TGraph(x.size(), &x[0], &y2[0]);
+	TGraph *gr1 = new TGraph(x1.size(), &x1[0], &y1[0]);
+	TGraph *gr2 = new TGraph(x2.size(), &x2[0], &y2[0]);
 
 	gr1->SetMarkerStyle(iMarkerStyle);
 	gr1->SetMarkerSize(iMarkerSize);
@@ -1246,7 +1265,8 @@ void XboxAnalyserView::plotTest(const std::string &filepath) {
 
 	fXBins = 1000;
 
-	size_t nEvents = fCategoryChannel["B0Events"].size();
+	XBOX::XboxAnalyserViewColumn &col = fCategoryChannel["B0Events"];
+	size_t nEvents = col.size();
 
 	std::vector<TTimeStamp> vTime(nEvents);
 	std::vector<ULong64_t> vPCnt(nEvents);
@@ -1265,10 +1285,10 @@ void XboxAnalyserView::plotTest(const std::string &filepath) {
 
 
 	for (size_t i=0; i<nEvents; i++) {
-		vTime[i] = fCategoryChannel["B0Events"][i].getTimeStamp();
-		vPCnt[i] = fCategoryChannel["B0Events"][i].getPulseCount();
-		vPAvg[i] = fCategoryChannel["B0Events"][i].getYmean();
-		vPLen[i] = fCategoryChannel["B0Events"][i].getXmax() - fCategoryChannel["B0Events"][i].getXmin();
+		vTime[i] = col.fTimeStamp[i];
+		vPCnt[i] = col.fPulseCount[i];
+		vPAvg[i] = col.fYmean[i];
+		vPLen[i] = col.fXmax[i] - col.fXmin[i];
 	}
 
 	std::vector<Double_t> vPCntN = rescale(vPCnt, fPCntMin, fPCntMax, false);
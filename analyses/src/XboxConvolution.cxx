@@ -0,0 +1,334 @@
+/*
+ * XboxConvolution.cxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#include "XboxConvolution.hxx"
+#include "XboxWorkspace.hxx"
+
+#include <cmath>
+#include <algorithm>
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+static const Int_t kMinFFTKernel = 16;               // shorter kernels are always applied directly
+static const Int_t kFFTBlockFactor = 4;              // FFT block size relative to the kernel length
+static const Double_t kPi = 3.14159265358979323846;
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxConvolution::XboxConvolution() :
+	fNl{0},
+	fNr{0},
+	fMethod{kAuto},
+	fBoundary{kNearest},
+	fFFTSize{0} {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+/// \param[in] kernel The kernel.
+/// \param[in] nl The number of points to drop at the beginning.
+/// \param[in] nr The number of points to drop at the end.
+/// \param[in] boundary The signal extension beyond the bounds.
+/// \param[in] method The convolution method.
+XboxConvolution::XboxConvolution(const std::vector<Double_t> &kernel, Int_t nl, Int_t nr,
+		EBoundary boundary, EMethod method) {
+
+	setKernel(kernel, nl, nr, boundary, method);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxConvolution::~XboxConvolution() {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Sets the kernel and prepares the kernel spectrum if the kernel is
+/// long enough to be applied by FFT.
+/// \param[in] kernel The kernel.
+/// \param[in] nl The number of points to drop at the beginning.
+/// \param[in] nr The number of points to drop at the end.
+/// \param[in] boundary The signal extension beyond the bounds.
+/// \param[in] method The convolution method.
+void XboxConvolution::setKernel(const std::vector<Double_t> &kernel, Int_t nl, Int_t nr,
+		EBoundary boundary, EMethod method) {
+
+	fKernel = kernel;
+	fKernelF.assign(kernel.begin(), kernel.end());
+	fNl = nl;
+	fNr = nr;
+	fBoundary = boundary;
+	fMethod = method;
+
+	fFFTSize = 0;
+	fSpectrum.clear();
+	fTwiddle.clear();
+	if (method == kFFT || (method == kAuto && (Int_t)kernel.size() >= kMinFFTKernel))
+		prepareFFT();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// FFT preparation.
+/// Chooses the block size of the overlap-save convolution as the power
+/// of two above kFFTBlockFactor times the kernel length and computes
+/// the twiddle factors and the spectrum of the kernel.
+void XboxConvolution::prepareFFT() {
+
+	Int_t nk = fKernel.size();
+	if (nk == 0)
+		return;
+
+	fFFTSize = 8;
+	while (fFFTSize < kFFTBlockFactor * nk)
+		fFFTSize <<= 1;
+
+	fTwiddle.resize(fFFTSize / 2);
+	for (Int_t k=0; k<fFFTSize/2; k++)
+		fTwiddle[k] = std::polar(1., -2. * kPi * k / fFFTSize);
+
+	fSpectrum.assign(fFFTSize, 0.);
+	for (Int_t j=0; j<nk; j++)
+		fSpectrum[j] = fKernel[j];
+	fft(fSpectrum.data(), false);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Fast Fourier transform.
+/// In-place iterative radix-2 transform of the block size.
+/// \param[in,out] x The data (fFFTSize points).
+/// \param[in] inverse Inverse transform (including the 1/N scaling).
+void XboxConvolution::fft(std::complex<Double_t> *x, Bool_t inverse) const {
+
+	const Int_t n = fFFTSize;
+
+	// bit reversal permutation
+	for (Int_t i=1, j=0; i<n; i++) {
+		Int_t bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j)
+			std::swap(x[i], x[j]);
+	}
+
+	// butterflies
+	for (Int_t len=2; len<=n; len<<=1) {
+		Int_t half = len >> 1;
+		Int_t step = n / len;
+		for (Int_t i=0; i<n; i+=len) {
+			for (Int_t k=0; k<half; k++) {
+				Double_t wr = fTwiddle[k*step].real();
+				Double_t wi = inverse ? -fTwiddle[k*step].imag() : fTwiddle[k*step].imag();
+				Double_t ur = x[i+k].real();
+				Double_t ui = x[i+k].imag();
+				Double_t vr = x[i+k+half].real() * wr - x[i+k+half].imag() * wi;
+				Double_t vi = x[i+k+half].real() * wi + x[i+k+half].imag() * wr;
+				x[i+k] = std::complex<Double_t>(ur + vr, ui + vi);
+				x[i+k+half] = std::complex<Double_t>(ur - vr, ui - vi);
+			}
+		}
+	}
+
+	if (inverse) {
+		Double_t scale = 1. / n;
+		for (Int_t i=0; i<n; i++)
+			x[i] *= scale;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Method selection.
+/// Compares the estimated number of operations of the direct and the
+/// FFT convolution. The FFT convolution transforms two real blocks at
+/// once.
+/// \param[in] nout The number of output points.
+/// \return True if the FFT convolution is used.
+Bool_t XboxConvolution::useFFT(Int_t nout) const {
+
+	if (fFFTSize == 0 || fMethod == kDirect)
+		return false;
+	if (fMethod == kFFT)
+		return true;
+
+	Int_t nk = fKernel.size();
+	Int_t step = fFFTSize - nk + 1;
+	Int_t npairs = ((nout + step - 1) / step + 1) / 2;
+	Double_t costDirect = (Double_t)nout * nk;
+	Double_t costFFT = npairs * (2. * fFFTSize * log2(fFFTSize) * 3. + 4. * fFFTSize);
+	return costFFT < costDirect;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Signal extension.
+/// Copies the signal into a buffer which is extended beyond the bounds
+/// so that the convolution runs without range checks.
+/// \param[out] p The extended signal (nout + nk - 1 points).
+/// \param[in] f The signal.
+/// \param[in] nout The number of output points.
+template <typename T>
+void XboxConvolution::extend(std::vector<T> &p, const std::vector<T> &f, Int_t nout) const {
+
+	Int_t nf = f.size();
+	Int_t nk = fKernel.size();
+	Int_t np = nout + nk - 1;
+	Int_t offset = nk - 1 - fNl; // position of the first sample in the buffer
+
+	T left = fBoundary == kNearest ? f.front() : T(0);
+	T right = fBoundary == kNearest ? f.back() : T(0);
+
+	p.resize(np);
+	Int_t m0 = std::min(std::max(offset, 0), np);
+	Int_t m1 = std::min(std::max(offset + nf, 0), np);
+	std::fill(p.begin(), p.begin() + m0, left);
+	for (Int_t m=m0; m<m1; m++)
+		p[m] = f[m - offset];
+	std::fill(p.begin() + m1, p.end(), right);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Direct convolution.
+/// Blocks of kBlock output points are accumulated in independent
+/// registers over the kernel, so the block is evaluated with vector
+/// instructions while the terms of each output point are summed in the
+/// order of the kernel.
+template <typename T>
+void XboxConvolution::direct(T *out, const std::vector<T> &p, const std::vector<T> &kernel,
+		Int_t nout) const {
+
+	const Int_t kBlock = 8;
+	const Int_t nk = kernel.size();
+	const T *pk = kernel.data();
+
+	Int_t i = 0;
+	for (; i + kBlock <= nout; i += kBlock) {
+		T s[kBlock] = {};
+		const T *pi = p.data() + i + nk - 1;
+		for (Int_t j=0; j<nk; j++) {
+			const T kj = pk[j];
+			const T *q = pi - j;
+			for (Int_t b=0; b<kBlock; b++)
+				s[b] += kj * q[b];
+		}
+		for (Int_t b=0; b<kBlock; b++)
+			out[i + b] = s[b];
+	}
+	for (; i < nout; i++) {
+		T s = 0;
+		const T *pi = p.data() + i + nk - 1;
+		for (Int_t j=0; j<nk; j++)
+			s += pk[j] * pi[-j];
+		out[i] = s;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Overlap-save FFT convolution.
+/// The extended signal is cut into overlapping blocks of the FFT size.
+/// Two real blocks are transformed at once as the real and imaginary
+/// part of a complex block, which is possible since the kernel is real.
+/// The block buffer x is resized to the FFT size.
+template <typename T>
+void XboxConvolution::overlapSave(T *out, const std::vector<T> &p, Int_t nout,
+		std::vector<std::complex<Double_t>> &x) const {
+
+	const Int_t n = fFFTSize;
+	const Int_t nk = fKernel.size();
+	const Int_t np = p.size();
+	const Int_t step = n - nk + 1; // number of valid points per block
+
+	x.resize(n);
+	for (Int_t i0=0; i0<nout; i0+=2*step) {
+		Int_t i1 = i0 + step;
+
+		for (Int_t m=0; m<n; m++) {
+			Double_t re = (i0 + m < np) ? Double_t(p[i0 + m]) : 0.;
+			Double_t im = (i1 + m < np) ? Double_t(p[i1 + m]) : 0.;
+			x[m] = std::complex<Double_t>(re, im);
+		}
+
+		fft(x.data(), false);
+		for (Int_t m=0; m<n; m++) {
+			Double_t re = x[m].real() * fSpectrum[m].real() - x[m].imag() * fSpectrum[m].imag();
+			Double_t im = x[m].real() * fSpectrum[m].imag() + x[m].imag() * fSpectrum[m].real();
+			x[m] = std::complex<Double_t>(re, im);
+		}
+		fft(x.data(), true);
+
+		for (Int_t t=0; t<step && i0 + t<nout; t++)
+			out[i0 + t] = T(x[nk - 1 + t].real());
+		for (Int_t t=0; t<step && i1 + t<nout; t++)
+			out[i1 + t] = T(x[nk - 1 + t].imag());
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Convolution.
+/// The extended signal and the FFT blocks are taken from the workspace
+/// if given.
+template <typename T>
+Int_t XboxConvolution::convolve(std::vector<T> &out, const std::vector<T> &f,
+		const std::vector<T> &kernel, XboxWorkspace *ws) const {
+
+	Int_t nf = f.size();
+	Int_t nk = kernel.size();
+	Int_t nout = nf + nk - 1 - fNl - fNr;
+
+	out.clear();
+	if (nk == 0)
+		return -1;
+	if (nf == 0 || nout <= 0)
+		return 0;
+
+	std::vector<T> plocal;
+	std::vector<T> &p = ws ? ws->get<T>(0) : plocal;
+	extend(p, f, nout);
+
+	out.resize(nout);
+	if (useFFT(nout)) {
+		std::vector<std::complex<Double_t>> xlocal;
+		overlapSave(out.data(), p, nout, ws ? ws->get<std::complex<Double_t>>(0) : xlocal);
+	}
+	else
+		direct(out.data(), p, kernel, nout);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Convolution of a signal.
+/// \param[out] out The convolved signal.
+/// \param[in] f The signal.
+/// \param[in] ws The workspace for the temporary buffers (optional).
+/// \return 0 on success or -1 if no kernel is set.
+Int_t XboxConvolution::apply(std::vector<Double_t> &out, const std::vector<Double_t> &f,
+		XboxWorkspace *ws) const {
+
+	return convolve(out, f, fKernel, ws);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Convolution of a signal in single precision.
+/// The direct convolution runs in single precision. The FFT convolution
+/// is carried out in double precision.
+/// \param[out] out The convolved signal.
+/// \param[in] f The signal.
+/// \param[in] ws The workspace for the temporary buffers (optional).
+/// \return 0 on success or -1 if no kernel is set.
+Int_t XboxConvolution::apply(std::vector<Float_t> &out, const std::vector<Float_t> &f,
+		XboxWorkspace *ws) const {
+
+	return convolve(out, f, fKernelF, ws);
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
@@ -0,0 +1,345 @@
+/*
+ * XboxReportQueue.cxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#include <cstdio>
+
+#include "XboxReportQueue.hxx"
+#include "XboxAnalyserEvalBase.hxx"
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Add a channel.
+/// Keeps a copy of the channel without the decoded samples, which are
+/// restored from the raw data when the report is rendered.
+/// \param[in] ch The evaluated channel.
+void XboxReportRecord::addChannel(const XBOX::XboxDAQChannel &ch) {
+
+	fChannels.push_back(ch);
+	fChannels.back().flushbuffer();
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+/// \param[in] capacity The maximum number of pending records.
+XboxReportQueue::XboxReportQueue(size_t capacity) :
+	fCapacity{capacity},
+	fBusy{false},
+	fStop{false},
+	fNSubmitted{0},
+	fNRendered{0},
+	fNDropped{0},
+	fNDroppedReported{0} {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+/// Discards the pending records and terminates the worker. The shared
+/// queue is destroyed at the end of the program, when the graphics
+/// needed for the rendering may already be gone.
+XboxReportQueue::~XboxReportQueue() {
+
+	size_t ndiscarded;
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+		ndiscarded = fQueue.size();
+		fQueue.clear();
+		fStop = true;
+	}
+	fCondPending.notify_all();
+
+	if (fWorker.joinable())
+		fWorker.join();
+
+	if (ndiscarded)
+		printf("WARNING: %zu pending report records discarded, "
+				"call XboxReportQueue::flush() before the end of the program\n",
+				ndiscarded);
+	reportDropped();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Shared queue.
+/// \return The queue used by the reports of all evaluators.
+XboxReportQueue& XboxReportQueue::instance() {
+
+	static XboxReportQueue queue;
+	return queue;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// \param[in] n The maximum number of pending records.
+void XboxReportQueue::setCapacity(size_t n) {
+
+	std::lock_guard<std::mutex> lock(fMutex);
+	fCapacity = n;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The maximum number of pending records.
+size_t XboxReportQueue::getCapacity() {
+
+	std::lock_guard<std::mutex> lock(fMutex);
+	return fCapacity;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Queue a record.
+/// Never waits for the worker. The worker thread is started with the
+/// first record. The first record dropped after the last report of the
+/// dropped records is reported right away.
+/// \param[in] rec The record to be rendered.
+/// \return True if the record was queued or false if it was dropped
+/// because the queue is full.
+Bool_t XboxReportQueue::push(XboxReportRecord &&rec) {
+
+	std::lock_guard<std::mutex> lock(fMutex);
+	if (fQueue.size() >= fCapacity) {
+		if (fNDropped++ == fNDroppedReported)
+			printf("WARNING: Report queue full (%zu records), dropping records\n",
+					fCapacity);
+		return false;
+	}
+
+	if (!fWorker.joinable())
+		fWorker = std::thread(&XboxReportQueue::run, this);
+
+	fQueue.push_back(std::move(rec));
+	fNSubmitted++;
+	fCondPending.notify_one();
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Flush.
+/// Waits until all queued records are rendered and reports the number
+/// of records dropped since the last flush. Must not be called from a
+/// rendering function.
+void XboxReportQueue::flush() {
+
+	{
+		std::unique_lock<std::mutex> lock(fMutex);
+		fCondIdle.wait(lock, [this] { return fQueue.empty() && !fBusy; });
+	}
+	reportDropped();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Stop.
+/// Renders the pending records and terminates the worker thread. A new
+/// worker is started with the next record.
+void XboxReportQueue::stop() {
+
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+		fStop = true;
+	}
+	fCondPending.notify_all();
+
+	if (fWorker.joinable())
+		fWorker.join();
+
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+		fStop = false;
+	}
+	reportDropped();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Worker.
+/// Renders the records in the order they were queued, one at a time
+/// under the report mutex. Terminates on stop() once the queue is empty.
+void XboxReportQueue::run() {
+
+	std::unique_lock<std::mutex> lock(fMutex);
+	while (true) {
+
+		fCondPending.wait(lock, [this] { return fStop || !fQueue.empty(); });
+		if (fQueue.empty())
+			break; // stop requested and nothing left to render
+
+		XboxReportRecord rec = std::move(fQueue.front());
+		fQueue.pop_front();
+		fBusy = true;
+		lock.unlock();
+
+		if (rec.fRender) {
+			std::lock_guard<std::mutex> rlock(XBOX::getReportMutex());
+			rec.fRender(rec);
+		}
+
+		lock.lock();
+		fBusy = false;
+		fNRendered++;
+		if (fQueue.empty())
+			fCondIdle.notify_all();
+	}
+	fCondIdle.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Report of the dropped records.
+/// Prints the number of records dropped since the last report.
+void XboxReportQueue::reportDropped() {
+
+	ULong64_t ndropped;
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+		ndropped = fNDropped - fNDroppedReported;
+		fNDroppedReported = fNDropped;
+	}
+
+	if (ndropped)
+		printf("WARNING: %llu report records dropped as the queue was full\n",
+				(unsigned long long) ndropped);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The number of queued records.
+ULong64_t XboxReportQueue::getNSubmitted() {
+
+	std::lock_guard<std::mutex> lock(fMutex);
+	return fNSubmitted;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The number of rendered records.
+ULong64_t XboxReportQueue::getNRendered() {
+
+	std::lock_guard<std::mutex> lock(fMutex);
+	return fNRendered;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The number of records dropped because the queue was full.
+ULong64_t XboxReportQueue::getNDropped() {
+
+	std::lock_guard<std::mutex> lock(fMutex);
+	return fNDropped;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+/// Reports every evaluation synchronously.
+XboxReportPolicy::XboxReportPolicy() :
+	fSampling{kSampleAll},
+	fNth{1},
+	fOutlierMin{0.},
+	fOutlierMax{0.},
+	fAsync{false},
+	fNEvaluations{0} {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Copy constructor.
+/// The copy continues the count of evaluations (e.g. the copies of an
+/// evaluator made by RDataFrame::Define).
+XboxReportPolicy::XboxReportPolicy(const XboxReportPolicy &other) :
+	fSampling{other.fSampling},
+	fNth{other.fNth},
+	fOutlierMin{other.fOutlierMin},
+	fOutlierMax{other.fOutlierMax},
+	fAsync{other.fAsync},
+	fNEvaluations{other.fNEvaluations.load()} {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Assignment.
+XboxReportPolicy& XboxReportPolicy::operator=(const XboxReportPolicy &other) {
+
+	fSampling = other.fSampling;
+	fNth = other.fNth;
+	fOutlierMin = other.fOutlierMin;
+	fOutlierMax = other.fOutlierMax;
+	fAsync = other.fAsync;
+	fNEvaluations = other.fNEvaluations.load();
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxReportPolicy::~XboxReportPolicy() {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Restarts the count of evaluations.
+/// \param[in] val The selection of the reported evaluations.
+/// \param[in] nth The interval for kSampleEveryNth.
+void XboxReportPolicy::setSampling(ESampling val, ULong64_t nth) {
+
+	fSampling = val;
+	fNth = nth ? nth : 1;
+	fNEvaluations = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Range of regular results for kSampleOutliers.
+/// \param[in] min The lower bound.
+/// \param[in] max The upper bound.
+void XboxReportPolicy::setOutlierRange(Double_t min, Double_t max) {
+
+	fOutlierMin = min;
+	fOutlierMax = max;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Selection.
+/// Counts the evaluation and decides whether it is reported.
+/// \param[in] result The result of the evaluation (-1 on failure).
+/// \return True if the evaluation is to be reported.
+Bool_t XboxReportPolicy::accept(Double_t result) const {
+
+	ULong64_t n = fNEvaluations++;
+
+	switch (fSampling) {
+	case kSampleEveryNth:
+		return (n % fNth) == 0;
+	case kSampleFailures:
+		return result == -1;
+	case kSampleOutliers:
+		return result == -1 || result < fOutlierMin || result > fOutlierMax;
+	default:
+		return true;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Dispatch.
+/// Queues the record for the background rendering or renders it right
+/// away under the report mutex.
+/// \param[in] rec The record of the evaluation.
+void XboxReportPolicy::submit(XboxReportRecord &&rec) const {
+
+	if (fAsync) {
+		XboxReportQueue::instance().push(std::move(rec));
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(XBOX::getReportMutex());
+	if (rec.fRender)
+		rec.fRender(rec);
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
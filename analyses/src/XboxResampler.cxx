@@ -0,0 +1,283 @@
+/*
+ * XboxResampler.cxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#include "XboxResampler.hxx"
+#include "XboxWorkspace.hxx"
+
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+static const Int_t kNPivots = 32;                      // number of tabulated pivots
+static const Double_t kPivotLimit = 2. - sqrt(3.);     // inverse pivot of the rows beyond the table
+
+////////////////////////////////////////////////////////////////////////
+/// Inverse pivots of the tridiagonal system.
+/// The interior rows of the natural spline on equidistant nodes read
+/// b[i-1] + 4 b[i] + b[i+1] = r[i]. The pivots of the elimination
+/// therefore do not depend on the signal and converge to 2 + sqrt(3)
+/// within machine precision after about 15 rows.
+/// \return The inverse pivots (row 1 to kNPivots-1).
+static const Double_t* getInversePivots() {
+
+	struct Pivots_t {
+		Double_t fVal[kNPivots];
+		Pivots_t() {
+			Double_t p = 4.;
+			fVal[0] = 0.;
+			for (Int_t i=1; i<kNPivots; i++) {
+				fVal[i] = 1. / p;
+				p = 4. - fVal[i];
+			}
+		}
+	};
+	static const Pivots_t pivots;
+	return pivots.fVal;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxResampler::XboxResampler() :
+	fX0{0.},
+	fH{0.},
+	fNNodes{0} {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+/// \param[in] x0 The position of the first node.
+/// \param[in] h The distance of the nodes.
+/// \param[in] nnodes The number of nodes.
+/// \param[in] xs The re-sampling points.
+XboxResampler::XboxResampler(Double_t x0, Double_t h, Int_t nnodes,
+		const std::vector<Double_t> &xs) {
+
+	setGrid(x0, h, nnodes, xs);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+/// \param[in] x0 The position of the first node.
+/// \param[in] h The distance of the nodes.
+/// \param[in] nnodes The number of nodes.
+/// \param[in] xmin The first re-sampling point.
+/// \param[in] xmax The last re-sampling point.
+/// \param[in] nsamples The number of equidistant re-sampling points.
+XboxResampler::XboxResampler(Double_t x0, Double_t h, Int_t nnodes,
+		Double_t xmin, Double_t xmax, Int_t nsamples) {
+
+	setGrid(x0, h, nnodes, xmin, xmax, nsamples);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxResampler::~XboxResampler() {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Locates the interval and the offset of each re-sampling point. The
+/// points need not be sorted.
+/// \param[in] x0 The position of the first node.
+/// \param[in] h The distance of the nodes.
+/// \param[in] nnodes The number of nodes.
+/// \param[in] xs The re-sampling points.
+void XboxResampler::setGrid(Double_t x0, Double_t h, Int_t nnodes,
+		const std::vector<Double_t> &xs) {
+
+	fX0 = x0;
+	fH = h;
+	fNNodes = (nnodes > 1 && h <= 0.) ? 0 : std::max(nnodes, 0);
+
+	fIndex.clear();
+	fOffset.clear();
+	if (fNNodes == 0)
+		return;
+
+	Int_t nlast = std::max(fNNodes - 2, 0); // last interval
+	Double_t umax = (fNNodes - 1) * h;
+	Double_t dh = fNNodes > 1 ? 1. / h : 0.;
+
+	fIndex.resize(xs.size());
+	fOffset.resize(xs.size());
+	for (size_t k=0; k<xs.size(); k++) {
+		Double_t u = std::min(std::max(xs[k] - x0, 0.), umax);
+		Int_t i = std::min(Int_t(u * dh), nlast);
+		fIndex[k] = i;
+		fOffset[k] = u - i * h;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter.
+/// Locates the interval and the offset of equidistant re-sampling points.
+/// \param[in] x0 The position of the first node.
+/// \param[in] h The distance of the nodes.
+/// \param[in] nnodes The number of nodes.
+/// \param[in] xmin The first re-sampling point.
+/// \param[in] xmax The last re-sampling point.
+/// \param[in] nsamples The number of equidistant re-sampling points.
+void XboxResampler::setGrid(Double_t x0, Double_t h, Int_t nnodes,
+		Double_t xmin, Double_t xmax, Int_t nsamples) {
+
+	std::vector<Double_t> xs(std::max(nsamples, 0));
+	Double_t hs = nsamples > 1 ? (xmax - xmin) / (nsamples - 1) : 0.;
+	for (Int_t k=0; k<nsamples; k++)
+		xs[k] = xmin + k * hs;
+
+	setGrid(x0, h, nnodes, xs);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Curvature of the spline.
+/// Solves the tridiagonal system of the natural spline for the half of
+/// the second derivative at the nodes (the coefficient b of
+/// XBOX::CubicSpline) with the tabulated pivots. The curvature depends
+/// on the nodes only, i.e. it can be re-used for any grid with the same
+/// number and distance of the nodes.
+/// \param[out] b The half of the second derivative at the nodes.
+/// \param[in] y The signal at the nodes.
+void XboxResampler::curvature(std::vector<Double_t> &b, const std::vector<Double_t> &y) const {
+
+	const Int_t n = fNNodes;
+	const Double_t *ip = getInversePivots();
+	const Double_t scale = 3. / (fH * fH);
+
+	b.assign(n, 0.);
+	if (n < 3)
+		return;
+
+	// forward elimination (rows beyond the table with the limit pivot)
+	const Int_t m = std::min(n - 1, kNPivots + 1);
+	b[1] = scale * (y[2] - 2. * y[1] + y[0]);
+	for (Int_t i=2; i<m; i++)
+		b[i] = scale * (y[i+1] - 2. * y[i] + y[i-1]) - ip[i-1] * b[i-1];
+	for (Int_t i=m; i<n-1; i++)
+		b[i] = scale * (y[i+1] - 2. * y[i] + y[i-1]) - kPivotLimit * b[i-1];
+
+	// back substitution
+	b[n-2] *= n - 2 < kNPivots ? ip[n-2] : kPivotLimit;
+	Int_t i = n - 3;
+	for (; i>=kNPivots; i--)
+		b[i] = (b[i] - b[i+1]) * kPivotLimit;
+	for (; i>0; i--)
+		b[i] = (b[i] - b[i+1]) * ip[i];
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Evaluation of the spline at the re-sampling points.
+/// The polynomial coefficients are formed from the curvature at both
+/// ends of the interval, so the loop has no branches.
+/// \param[out] ys The re-sampled signal.
+/// \param[in] y The signal at the nodes.
+/// \param[in] b The half of the second derivative at the nodes.
+void XboxResampler::evaluate(Double_t *ys, const std::vector<Double_t> &y,
+		const std::vector<Double_t> &b) const {
+
+	const Int_t ns = fIndex.size();
+	const Int_t *idx = fIndex.data();
+	const Double_t *off = fOffset.data();
+	const Double_t *py = y.data();
+	const Double_t *pb = b.data();
+	const Double_t dh = 1. / fH;
+	const Double_t h3 = fH / 3.;
+
+	for (Int_t k=0; k<ns; k++) {
+		const Int_t i = idx[k];
+		const Double_t u = off[k];
+		const Double_t a = (pb[i+1] - pb[i]) * dh / 3.;
+		const Double_t c = (py[i+1] - py[i]) * dh - h3 * (2. * pb[i] + pb[i+1]);
+		ys[k] = ((a * u + pb[i]) * u + c) * u + py[i];
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Re-sampling of a signal.
+/// \param[out] ys The re-sampled signal.
+/// \param[in] y The signal at the nodes.
+/// \param[in] ws The workspace for the curvature (optional).
+/// \return 0 on success or -1 if the signal does not match the nodes.
+Int_t XboxResampler::apply(std::vector<Double_t> &ys, const std::vector<Double_t> &y,
+		XboxWorkspace *ws) const {
+
+	ys.clear();
+	if (fNNodes == 0 || (Int_t)y.size() != fNNodes) {
+		printf("ERROR: Signal of %d points does not match the %d nodes of the re-sampling grid\n",
+				(Int_t)y.size(), fNNodes);
+		return -1;
+	}
+
+	if (fNNodes == 1) {
+		ys.assign(fIndex.size(), y.front());
+		return 0;
+	}
+
+	std::vector<Double_t> local;
+	std::vector<Double_t> &b = ws ? ws->get<Double_t>(0) : local;
+	curvature(b, y);
+	ys.resize(fIndex.size());
+	evaluate(ys.data(), y, b);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Re-sampling of a signal with a given curvature.
+/// Same as above, but the curvature was solved before by curvature(),
+/// e.g. once for a signal which is re-sampled on several grids.
+/// \param[out] ys The re-sampled signal.
+/// \param[in] y The signal at the nodes.
+/// \param[in] b The half of the second derivative at the nodes.
+/// \return 0 on success or -1 if the signal does not match the nodes.
+Int_t XboxResampler::apply(std::vector<Double_t> &ys, const std::vector<Double_t> &y,
+		const std::vector<Double_t> &b) const {
+
+	ys.clear();
+	if (fNNodes == 0 || (Int_t)y.size() != fNNodes || (Int_t)b.size() != fNNodes) {
+		printf("ERROR: Signal of %d points does not match the %d nodes of the re-sampling grid\n",
+				(Int_t)y.size(), fNNodes);
+		return -1;
+	}
+
+	if (fNNodes == 1) {
+		ys.assign(fIndex.size(), y.front());
+		return 0;
+	}
+
+	ys.resize(fIndex.size());
+	evaluate(ys.data(), y, b);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Re-sampling of several signals with the same timing.
+/// \param[out] ys The re-sampled signals.
+/// \param[in] y The signals at the nodes.
+/// \param[in] ws The workspace for the curvature (optional).
+/// \return 0 on success or -1 if any signal does not match the nodes.
+Int_t XboxResampler::apply(std::vector<std::vector<Double_t>> &ys,
+		const std::vector<std::vector<Double_t>> &y, XboxWorkspace *ws) const {
+
+	Int_t status = 0;
+	ys.resize(y.size());
+	for (size_t k=0; k<y.size(); k++) {
+		if (apply(ys[k], y[k], ws) < 0)
+			status = -1;
+	}
+	return status;
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
@@ -6,9 +6,14 @@
  */
 
 #include "XboxSignalFilter.hxx"
-#include "XboxCubicSpline.hxx"
+#include "XboxResampler.hxx"
 
 #include "Math/Math.h"
+#include "TString.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
 
 //#define EIGEN
 #ifdef EIGEN
@@ -33,7 +38,10 @@ XboxSignalFilter::XboxSignalFilter() :
 	fFilterOrder{3},
 	fFilterNl{7},
 	fFilterNr{7},
-	fDerivative{0} {
+	fDerivative{0},
+	fPrecision{XboxDAQChannel::kPrecDouble},
+	fBoundary{XboxConvolution::kNearest} {
+	resolvePlan();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -43,7 +51,10 @@ XboxSignalFilter::XboxSignalFilter(const EFilterType &filtertype, Int_t order, I
 	fFilterOrder{order},
 	fFilterNl{nl},
 	fFilterNr{nr},
-	fDerivative{0} {
+	fDerivative{0},
+	fPrecision{XboxDAQChannel::kPrecDouble},
+	fBoundary{XboxConvolution::kNearest} {
+	resolvePlan();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -60,6 +71,7 @@ void XboxSignalFilter::config(const EFilterType &filtertype, Int_t order, Int_t
 	fFilterOrder = order;
 	fFilterNl = nl;
 	fFilterNr = nr;
+	resolvePlan();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -67,6 +79,36 @@ void XboxSignalFilter::config(const EFilterType &filtertype, Int_t order, Int_t
 void XboxSignalFilter::setDerivative(Int_t val) {
 
 	fDerivative = val;
+	resolvePlan();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The configuration of the filter (e.g. part of a cache key).
+std::string XboxSignalFilter::getConfig() const {
+
+	return TString::Format("Filter(%d,%d,%d,%d;d=%d;p=%d;b=%d)", fFilterType,
+			fFilterOrder, fFilterNl, fFilterNr, fDerivative, fPrecision, fBoundary).Data();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The number of samples required beyond a time window to filter
+/// and re-sample the signal in the window (see evaluate()).
+Int_t XboxSignalFilter::getMargin() const {
+
+	return 2 * (std::max(fFilterNl, fFilterNr) + 1);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Comparison operator.
+/// \return Whether both filters yield the same result for any signal.
+Bool_t XboxSignalFilter::operator == (const XboxSignalFilter &other) const {
+
+	return fFilterType == other.fFilterType && fFilterOrder == other.fFilterOrder
+			&& fFilterNl == other.fFilterNl && fFilterNr == other.fFilterNr
+			&& fDerivative == other.fDerivative && fPrecision == other.fPrecision
+			&& fBoundary == other.fBoundary;
 }
 
 
@@ -143,119 +185,208 @@ std::vector<Double_t> XboxSignalFilter::savgol(Int_t m, Int_t nl, Int_t nr, Int_
 }
 
 ////////////////////////////////////////////////////////////////////////
-/// Convolution of two signals.
-std::vector<Double_t> XboxSignalFilter::conv(const std::vector<Double_t> &f,
-		const std::vector<Double_t> &kernel, Int_t nl, Int_t nr) const {
+/// Filter kernel.
+/// Sets up the convolution kernel of the configured filter (in reversed
+/// order) and the number of points to drop at both ends of the
+/// convolution.
+/// \param[out] kernel The kernel.
+/// \param[out] nl The number of points to drop at the beginning.
+/// \param[out] nr The number of points to drop at the end.
+/// \param[in] derivative The degree of the derivative.
+/// \param[in] dt The time resolution.
+/// \return 0 on success or -1 if the filter is the identity.
+Int_t XboxSignalFilter::getKernel(std::vector<Double_t> &kernel, Int_t &nl, Int_t &nr,
+		Int_t derivative, Double_t dt) const {
+
+	kernel.clear();
+	nl = fFilterNr;
+	nr = fFilterNl;
+
+	if (derivative == 1) {
+		Double_t dh = 1. / dt;
+		if(fFilterType == kNone){
+			kernel = {dh, 0, -dh};
+			nl = 1;
+			nr = 1;
+		}
+		else if(fFilterType == kMovingAverage){
+			kernel.assign(fFilterNl, dh);
+			kernel.push_back(0.);
+			for(Int_t i=0; i<fFilterNr; i++)
+				kernel.push_back(-dh);
+		}
+		else if(fFilterType == kSavitzkyGolay){
+			kernel = savgol(fFilterOrder, fFilterNl, fFilterNr, 1);
+			for(auto it=kernel.begin(); it != kernel.end(); ++it)
+				(*it) *= dh;
+			std::reverse(kernel.begin(), kernel.end());
+		}
+	}
+	else if (derivative == 2) {
+		Double_t dh = 1. / dt / dt;
+		if(fFilterType == kNone){
+			kernel = {dh, -2*dh, +dh};
+			nl = 1;
+			nr = 1;
+		}
+		else if(fFilterType == kMovingAverage){
+			kernel.assign(fFilterNl + fFilterNr + 1, dh);
+			kernel[fFilterNl] = -2*dh;
+		}
+		else if(fFilterType == kSavitzkyGolay){
+			kernel = savgol(fFilterOrder, fFilterNl, fFilterNr, 2);
+			for(auto it=kernel.begin(); it != kernel.end(); ++it)
+				(*it) *= dh;
+			std::reverse(kernel.begin(), kernel.end());
+		}
+	}
+	else {
+		if(fFilterType == kMovingAverage){
+			kernel.assign(fFilterNl + fFilterNr + 1, 1./(fFilterNl + fFilterNr + 1.));
+		}
+		else if(fFilterType == kSavitzkyGolay){
+			kernel = savgol(fFilterOrder, fFilterNl, fFilterNr, 0);
+			std::reverse(kernel.begin(), kernel.end());
+		}
+	}
 
-	std::vector<Double_t> conv;
-	conv.resize(f.size());
+	return kernel.empty() ? -1 : 0;
+}
 
-	Int_t nf = f.size();
-	Int_t nk = kernel.size();
-	Int_t nc = nf + nk - 1;
-	conv.resize(nc - nl - nr);
+////////////////////////////////////////////////////////////////////////
+/// Filter plan.
+/// Resolves the plan of the configured filter once per configuration
+/// (filter type, order, number of nodes, derivative and boundary). The
+/// kernels refer to a unit time resolution, the derivatives are scaled
+/// to the time resolution of the signal after the convolution (see
+/// scale()). The plans are shared by all filters of the same
+/// configuration through a process wide cache, so the kernel of a
+/// configuration is computed only once.
+void XboxSignalFilter::resolvePlan() {
+
+	typedef std::tuple<Int_t, Int_t, Int_t, Int_t, Int_t, Int_t> Key_t;
+	static std::map<Key_t, std::shared_ptr<const Plan_t>> cache;
+	static std::mutex mutex;
+	const size_t maxsize = 256; // bound for configurations varying at run time
+
+	Int_t derivative = (fDerivative == 1 || fDerivative == 2) ? fDerivative : 0;
+	Key_t key(fFilterType, fFilterOrder, fFilterNl, fFilterNr, derivative, fBoundary);
 
-	for(Int_t i=0; i<nc; i++)
 	{
-	    Int_t i1 = i;
-		Double_t tmp = 0.;
-	    for(Int_t j=0; j<nk; j++){
-	    	if(i1>=0 && i1<nf)
-	    		tmp += f[i1] * kernel[j];
-	    	i1--;
-	    }
-    	if(i>=nl && i<nc-nr)
-    		conv[i-nl] = tmp;
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = cache.find(key);
+		if (it != cache.end()) {
+			fPlan = it->second;
+			return;
+		}
 	}
-	return conv;
+
+	std::vector<Double_t> kernel;
+	Int_t nl;
+	Int_t nr;
+	getKernel(kernel, nl, nr, derivative, 1.);
+
+	std::shared_ptr<Plan_t> plan = std::make_shared<Plan_t>();
+	plan->fConv.setKernel(kernel, nl, nr, fBoundary);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (cache.size() >= maxsize)
+		cache.clear();
+	fPlan = cache.emplace(key, plan).first->second;
 }
 
 ////////////////////////////////////////////////////////////////////////
-/// Internal Filter function.
-/// Filters a signal given as a vector
-/// \param[in] vec input vector.
-/// \return The filered signal.
-std::vector<Double_t> XboxSignalFilter::filter (std::vector<Double_t> &vec) const {
+/// Scaling of a derivative.
+/// Scales a signal filtered with the kernel of unit time resolution to
+/// the time resolution of the signal.
+/// \param[in,out] res The filtered signal.
+/// \param[in] dt The time resolution.
+void XboxSignalFilter::scale(std::vector<Double_t> &res, Double_t dt) const {
+
+	Double_t dh = 1.;
+	if (fDerivative == 1)
+		dh = 1. / dt;
+	else if (fDerivative == 2)
+		dh = 1. / dt / dt;
+	else
+		return;
 
-	std::vector<Double_t> fvec;
-	if(fFilterType == kNone) {
-		fvec = vec;
-	}
-	else if(fFilterType == kMovingAverage){ // Moving average filter
-		std::vector<Double_t> kernel = std::vector<Double_t>(fFilterNl + fFilterNr +1, 1./(fFilterNl + fFilterNr +1.));
-		fvec = conv(vec, kernel, fFilterNr, fFilterNl);
-	}
-	else if(fFilterType == kSavitzkyGolay){ // Savitzky-Golay filter
-		std::vector<Double_t> kernel = savgol(fFilterOrder, fFilterNl, fFilterNr, 0);
-		std::reverse(kernel.begin(), kernel.end()); // reverse order of coefficients
-		fvec = conv(vec, kernel, fFilterNr, fFilterNl);
+	for (Double_t &val: res)
+		val *= dh;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Internal Filter function.
+/// Filters a signal (or its derivative) given as a vector.
+/// \param[out] res The filtered signal.
+/// \param[in] vec The input vector.
+/// \param[in] dt The time resolution.
+/// \param[in] ws The workspace for the temporary buffers (optional).
+/// \return 0 on success or -1 if the signal cannot be filtered.
+Int_t XboxSignalFilter::filter (std::vector<Double_t> &res, const std::vector<Double_t> &vec,
+		Double_t dt, XboxWorkspace *ws) const {
+
+	if (fPlan->fConv.isEmpty()) {
+		res.assign(vec.begin(), vec.end());
+		return 0;
 	}
 
-	return fvec;
+	Int_t status = fPlan->fConv.apply(res, vec, ws);
+	scale(res, dt);
+	return status;
 }
 
-
 ////////////////////////////////////////////////////////////////////////
 /// Internal Filter function.
-/// Filters the derivative of a signal given as a vector.
-/// \param[in] vec input vector.
-/// \param[in] dt time resolution.
-/// \return The filered signal.
-std::vector<Double_t> XboxSignalFilter::filterP1 (std::vector<Double_t> &vec, Double_t dt) const {
-
-	std::vector<Double_t> fvec;
-	Double_t dh = 1. / dt;
-	if(fFilterType == kNone){
-		std::vector<Double_t> kernel = {dh, 0, -dh};
-		fvec = conv(vec, kernel, 1, 1);
-	}
-	else if(fFilterType == kMovingAverage){ // Moving average filter
-		std::vector<Double_t> kernel(fFilterNl, dh);
-		kernel.push_back(0.);
-		for(Int_t i=0; i<fFilterNr; i++)
-			kernel.push_back(-dh);
-		fvec = conv(vec, kernel, fFilterNr, fFilterNl);
-	}
-	else if(fFilterType == kSavitzkyGolay){ // Savitzky-Golay filter
-		std::vector<Double_t> kernel = savgol(fFilterOrder, fFilterNl, fFilterNr, 1);
-		for(auto it=kernel.begin(); it != kernel.end(); ++it)
-			(*it) *= dh;
-		std::reverse(kernel.begin(), kernel.end()); // reverse order of coefficients
-		fvec = conv(vec, kernel, fFilterNr, fFilterNl);
+/// Filters a signal (or its derivative) in single precision. The signal
+/// and the kernel are convolved in float and the result is returned in
+/// double precision for the subsequent re-sampling.
+/// \param[out] res The filtered signal.
+/// \param[in] vec The input vector.
+/// \param[in] dt The time resolution.
+/// \param[in] ws The workspace for the temporary buffers (optional).
+/// \return 0 on success or -1 if the signal cannot be filtered.
+Int_t XboxSignalFilter::filterF (std::vector<Double_t> &res, const std::vector<Float_t> &vec,
+		Double_t dt, XboxWorkspace *ws) const {
+
+	if (fPlan->fConv.isEmpty()) {
+		res.assign(vec.begin(), vec.end());
+		return 0;
 	}
 
-	return fvec;
+	std::vector<Float_t> local;
+	std::vector<Float_t> &fvec = ws ? ws->get<Float_t>(0) : local;
+	Int_t status = fPlan->fConv.apply(fvec, vec, ws);
+	res.assign(fvec.begin(), fvec.end());
+	scale(res, dt);
+	return status;
 }
 
-
 ////////////////////////////////////////////////////////////////////////
 /// Internal Filter function.
-/// Filters the derivative of a signal given as a vector.
-/// \param[in] vec input vector.
-/// \param[in] dt time resolution.
+/// Reads the signal of a channel in the given time window and applies
+/// the predefined filter in the configured precision. In the raw mode
+/// the signal is filtered in single precision as the filter requires
+/// calibrated values.
+/// \param[in] ch a Xbox DAQ channel containing the signal.
+/// \param[in] tmin the lower limit of the time axis (-1: first sample).
+/// \param[in] tmax the upper limit of the time axis (-1: last sample).
 /// \return The filered signal.
-std::vector<Double_t> XboxSignalFilter::filterP2 (std::vector<Double_t> &vec, Double_t dt) const {
-
-	std::vector<Double_t> fvec;
-	Double_t dh = 1. / dt / dt;
-	if(fFilterType == kNone){
-		std::vector<Double_t> kernel = {dh, -2*dh, +dh};
-		fvec = conv(vec, kernel, 1, 1);
-	}
-	else if(fFilterType == kMovingAverage){ // Moving average filter
-		std::vector<Double_t> kernel(fFilterNl + fFilterNr + 1, dh);
-		kernel[fFilterNl] = -2*dh;
-		fvec = conv(vec, kernel, fFilterNr, fFilterNl);
-	}
-	else if(fFilterType == kSavitzkyGolay){ // Savitzky-Golay filter
-		std::vector<Double_t> kernel = savgol(fFilterOrder, fFilterNl, fFilterNr, 2);
-		for(auto it=kernel.begin(); it != kernel.end(); ++it)
-			(*it) *= dh;
-		std::reverse(kernel.begin(), kernel.end()); // reverse order of coefficients
-		fvec = conv(vec, kernel, fFilterNr, fFilterNl);
+std::vector<Double_t> XboxSignalFilter::apply (const XBOX::XboxDAQChannel &ch,
+		Double_t tmin, Double_t tmax) const {
+
+	std::vector<Double_t> res;
+	if (fPrecision != XboxDAQChannel::kPrecDouble) {
+		std::vector<Float_t> y;
+		ch.getSignal(y, tmin, tmax);
+		filterF(res, y, ch.getIncrement());
+		return res;
 	}
 
-	return fvec;
+	std::vector<Double_t> y;
+	ch.getSignal(y, tmin, tmax);
+	filter(res, y, ch.getIncrement());
+	return res;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -290,20 +421,13 @@ std::vector<Double_t> XboxSignalFilter::resample
 		(std::vector<Double_t> &x, std::vector<Double_t> &y,
 		Double_t lowerlimit, Double_t upperlimit, Int_t nsamples) const {
 
-	std::vector<Double_t> ys(nsamples);
+	std::vector<Double_t> ys;
+	if (x.empty())
+		return std::vector<Double_t>(nsamples, 0.);
 
-	XBOX::CubicSpline s(x, y);
-
-	Double_t h = (upperlimit - lowerlimit) / (nsamples-1);
-	Double_t xi = lowerlimit;
-	for(auto it=ys.begin(); it != ys.end(); ++it, xi+=h){
-		if(xi <= x.front())
-			*it = s(x.front());
-		else if(xi >= x.back())
-			*it = s(x.back());
-		else
-			*it = s(xi);
-	}
+	Double_t h = x.size() > 1 ? (x.back() - x.front()) / (x.size() - 1) : 1.;
+	XBOX::XboxResampler resampler(x.front(), h, x.size(), lowerlimit, upperlimit, nsamples);
+	resampler.apply(ys, y);
 	return ys;
 }
 
@@ -334,20 +458,15 @@ std::vector<Double_t> XboxSignalFilter::resample
 //}
 
 std::vector<Double_t> XboxSignalFilter::resample (std::vector<Double_t> &x,
-		std::vector<Double_t> &y, std::vector<Double_t> &xs) const {
+		std::vector<Double_t> &y, const std::vector<Double_t> &xs) const {
 
-	std::vector<Double_t> ys(xs.size());
-	XBOX::CubicSpline s(x, y);
-
-	for(size_t i=0; i<xs.size(); i++) {
-		if(xs[i] <= x.front())
-			ys[i] = s(x.front());
-		else if(xs[i] >= x.back())
-			ys[i] = s(x.back());
-		else
-			ys[i] = s(xs[i]);
-	}
+	std::vector<Double_t> ys;
+	if (x.empty())
+		return std::vector<Double_t>(xs.size(), 0.);
 
+	Double_t h = x.size() > 1 ? (x.back() - x.front()) / (x.size() - 1) : 1.;
+	XBOX::XboxResampler resampler(x.front(), h, x.size(), xs);
+	resampler.apply(ys, y);
 	return ys;
 }
 
@@ -357,15 +476,25 @@ std::vector<Double_t> XboxSignalFilter::resample (std::vector<Double_t> &x,
 /// Filters the signal given as vector in the argument list
 /// \param[in] signal.
 /// \return The filered signal.
-std::vector<Double_t> XboxSignalFilter::operator () (std::vector<Double_t> y) {
+std::vector<Double_t> XboxSignalFilter::operator () (std::vector<Double_t> y) const {
 
 	// apply predefined filter to the signal
-	if (fDerivative == 1)
-		return filterP1(y, 1.);
-	else if (fDerivative == 2)
-		return filterP2(y, 1.);
-	else
-		return filter(y);
+	std::vector<Double_t> res;
+	filter(res, y, 1.);
+	return res;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Filter function.
+/// Same as above but writes the filtered signal into the given buffer.
+/// \param[out] res The filtered signal.
+/// \param[in] y The signal.
+/// \param[in] ws The workspace for the temporary buffers (optional).
+/// \return 0 on success or -1 if the signal cannot be filtered.
+Int_t XboxSignalFilter::operator () (std::vector<Double_t> &res,
+		const std::vector<Double_t> &y, XboxWorkspace *ws) const {
+
+	return filter(res, y, 1., ws);
 }
 
 
@@ -374,22 +503,13 @@ std::vector<Double_t> XboxSignalFilter::operator () (std::vector<Double_t> y) {
 /// Filters the signal in the entire argument range without re-sampling.
 /// \param[in] ch Xbox DAQ channel containing the signal.
 /// \return The filered signal.
-std::vector<Double_t> XboxSignalFilter::operator () (XBOX::XboxDAQChannel &ch) {
+std::vector<Double_t> XboxSignalFilter::operator () (const XBOX::XboxDAQChannel &ch) const {
 
 	// flush any previously evaluated data of the channel
 //	ch.flushbuffer();
 
-	// get signal in the entire argument range
-	std::vector<Double_t> y;
-	y = ch.getSignal();
-
-	// apply predefined filter to the signal
-	if (fDerivative == 1)
-		return filterP1(y, ch.getIncrement());
-	else if (fDerivative == 2)
-		return filterP2(y, ch.getIncrement());
-	else
-		return filter(y);
+	// get signal in the entire argument range and apply predefined filter
+	return apply(ch, -1, -1);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -401,34 +521,28 @@ std::vector<Double_t> XboxSignalFilter::operator () (XBOX::XboxDAQChannel &ch) {
 /// \param[in] upperlimit the upper limit of the time axis.
 /// \return The filered signal.
 std::vector<Double_t> XboxSignalFilter::operator ()
-		(XBOX::XboxDAQChannel &ch, Double_t tmin, Double_t tmax) {
+		(const XBOX::XboxDAQChannel &ch, Double_t tmin, Double_t tmax) const {
 
 	// flush any previously evaluated data of the channel
 //	ch.flushbuffer();
 
-	// get signal in the predefined argument range
-	std::vector<Double_t> y = ch.getSignal(tmin, tmax);
-
-	// apply predefined filter to the signal
-	if (fDerivative == 1)
-		return filterP1(y, ch.getIncrement());
-	else if (fDerivative == 2)
-		return filterP2(y, ch.getIncrement());
-	else
-		return filter(y);
+	// get signal in the predefined argument range and apply predefined filter
+	return apply(ch, tmin, tmax);
 }
 
 ////////////////////////////////////////////////////////////////////////
 /// Filter function.
 /// Filters and re-sample the signal in a predefined argument range.
 /// To get the corresponding time axis use: ch.getTimeAxis(lowerlimit, upperlimit).
+/// Only the samples of the range extended by the filter support are
+/// read and filtered.
 /// \param[in] ch a Xbox DAQ channel containing the signal.
 /// \param[in] lowerlimit the lower limit of the time axis.
 /// \param[in] upperlimit the upper limit of the time axis.
 /// \param[in] nsamples the number of points to re-sample.
 /// \return The filered and re-sampled signal.
 std::vector<Double_t> XboxSignalFilter::operator ()
-		(XBOX::XboxDAQChannel &ch, Double_t tsmin, Double_t tsmax, Int_t nsamples) {
+		(const XBOX::XboxDAQChannel &ch, Double_t tsmin, Double_t tsmax, Int_t nsamples) const {
 
 	// flush any previously evaluated data of the channel
 //	ch.flushbuffer();
@@ -446,21 +560,14 @@ std::vector<Double_t> XboxSignalFilter::operator ()
 	tmax += dt * 2 * (fFilterNr + 1);
 	if (tmin < lbnd)
 		tmin = lbnd;
-	if (tmax < ubnd)
+	if (tmax > ubnd)
 		tmax = ubnd;
 
 	// get time axis and signal in the predefined argument range
 	std::vector<Double_t> t = ch.getTimeAxis(tmin, tmax);
-	std::vector<Double_t> y = ch.getSignal(tmin, tmax);
 
 	// apply predefined filter to the signal
-	std::vector<Double_t> yf;
-	if (fDerivative == 1)
-		yf = filterP1(y, ch.getIncrement());
-	else if (fDerivative == 2)
-		yf = filterP2(y, ch.getIncrement());
-	else
-		yf = filter(y);
+	std::vector<Double_t> yf = apply(ch, tmin, tmax);
 
 	// resample the signal in the predefined interval given by the bounds
 	std::vector<Double_t> yfs = resample(t, yf, tsmin, tsmax, nsamples);
@@ -471,11 +578,13 @@ std::vector<Double_t> XboxSignalFilter::operator ()
 /// Filter function.
 /// Filters and re-samples the signal for a predefined argument axis.
 /// The predefined time axis must be sorted in ascending direction.
+/// Only the samples of the axis range extended by the filter support
+/// are read and filtered.
 /// \param[in] ch a Xbox DAQ channel containing the signal.
 /// \param[in] xs a predefined time axis the signal is re-sampled on.
 /// \return The filered and re-sampled signal.
 std::vector<Double_t> XboxSignalFilter::operator ()
-		(XBOX::XboxDAQChannel &ch, std::vector<Double_t> &ts) {
+		(const XBOX::XboxDAQChannel &ch, const std::vector<Double_t> &ts) const {
 
 	// flush any previously evaluated data of the channel
 //	ch.flushbuffer();
@@ -493,26 +602,194 @@ std::vector<Double_t> XboxSignalFilter::operator ()
 	tmax += dt * 2 * (fFilterNr + 1);
 	if (tmin < lbnd)
 		tmin = lbnd;
-	if (tmax < ubnd)
+	if (tmax > ubnd)
 		tmax = ubnd;
 
 	std::vector<Double_t> t = ch.getTimeAxis(tmin, tmax);
-	std::vector<Double_t> y = ch.getSignal(tmin, tmax);
 
 	// apply predefined filter to the signal
-	std::vector<Double_t> yf;
-	if (fDerivative == 1)
-		yf = filterP1(y, ch.getIncrement());
-	else if (fDerivative == 2)
-		yf = filterP2(y, ch.getIncrement());
-	else
-		yf = filter(y);
+	std::vector<Double_t> yf = apply(ch, tmin, tmax);
 
 	// resample the signal in the predefined interval given by the bounds
 	std::vector<Double_t> yfs = resample(t, yf, ts);
 	return yfs;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Support of several filters.
+/// \param[in] filters the filters.
+/// \param[in] nfilters the number of filters.
+/// \param[out] nl the maximum number of nodes left from a data point.
+/// \param[out] nr the maximum number of nodes right from a data point.
+/// \param[out] bdouble whether any filter is evaluated in double precision.
+/// \param[out] bfloat whether any filter is evaluated in single precision.
+void XboxSignalFilter::getSupport (const XboxSignalFilter * const *filters, size_t nfilters,
+		Int_t &nl, Int_t &nr, Bool_t &bdouble, Bool_t &bfloat) {
+
+	nl = 0;
+	nr = 0;
+	bdouble = false;
+	bfloat = false;
+	for (size_t i=0; i<nfilters; i++) {
+		nl = std::max(nl, filters[i]->fFilterNl);
+		nr = std::max(nr, filters[i]->fFilterNr);
+		if (filters[i]->fPrecision == XboxDAQChannel::kPrecDouble)
+			bdouble = true;
+		else
+			bfloat = true;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Filtering and re-sampling of a signal window.
+/// Applies several filters to the same window of samples and re-samples
+/// all of them on the same time axis. The re-sampling grid is set up
+/// once for all filtered signals.
+/// \param[in] t0 the time of the first sample of the window.
+/// \param[in] h the distance of the samples on the re-sampling grid.
+/// \param[in] dt the sample increment of the channel.
+/// \param[in] y the samples in double precision (if required).
+/// \param[in] yF the samples in single precision (if required).
+/// \param[in] ts a predefined time axis the signals are re-sampled on.
+/// \param[in] filters the filters to be applied.
+/// \param[in] nfilters the number of filters.
+/// \param[out] res the filtered and re-sampled signals (one per filter).
+/// \param[in] ws the workspace.
+/// \return 0 on success or -1 if any re-sampling failed.
+Int_t XboxSignalFilter::filterAndResample (Double_t t0, Double_t h, Double_t dt,
+		const std::vector<Double_t> &y, const std::vector<Float_t> &yF,
+		const std::vector<Double_t> &ts, const XboxSignalFilter * const *filters,
+		size_t nfilters, std::vector<std::vector<Double_t>> &res, XboxWorkspace &ws) {
+
+	// the re-sampling grid is shared by all filtered signals
+	Int_t n = std::max(y.size(), yF.size());
+	XboxResampler &resampler = ws.getResampler();
+	resampler.setGrid(t0, h, n, ts);
+
+	// apply all filters to the same signal and re-sample the results
+	Int_t status = 0;
+	std::vector<Double_t> &yf = ws.get<Double_t>(0);
+	for (size_t i=0; i<nfilters; i++) {
+		const XboxSignalFilter *filter = filters[i];
+		if (filter->fPrecision != XboxDAQChannel::kPrecDouble)
+			filter->filterF(yf, yF, dt, &ws);
+		else
+			filter->filter(yf, y, dt, &ws);
+
+		if (resampler.apply(res[i], yf, &ws) < 0)
+			status = -1;
+	}
+
+	return status;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Fused filter function.
+/// Applies several filters (e.g. the signal and its first and second
+/// derivative) to the same channel and re-samples all of them on the
+/// same time axis. The signal is read and calibrated once for the
+/// window covering the support of all filters, and the re-sampling grid
+/// is set up once for all filtered signals. The channel is not
+/// modified, hence it can be evaluated by several threads at once. All
+/// temporary buffers are taken from the workspace, so that repeated
+/// evaluations with the same workspace do not allocate memory.
+/// \param[in] ch a Xbox DAQ channel containing the signal.
+/// \param[in] ts a predefined time axis the signals are re-sampled on.
+/// \param[in] filters the filters to be applied.
+/// \param[in] nfilters the number of filters.
+/// \param[out] res the filtered and re-sampled signals (one per filter).
+/// \param[in] ws the workspace.
+/// \return 0 on success or -1 if there is nothing to evaluate.
+Int_t XboxSignalFilter::evaluate (const XBOX::XboxDAQChannel &ch, const std::vector<Double_t> &ts,
+		const XboxSignalFilter * const *filters, size_t nfilters,
+		std::vector<std::vector<Double_t>> &res, XboxWorkspace &ws) {
+
+	// keep the buffers of the result for re-use by the caller
+	res.resize(nfilters);
+	for (std::vector<Double_t> &vec: res)
+		vec.clear();
+	if (nfilters == 0 || ts.empty())
+		return -1;
+
+	// window covering the support of all filters
+	Int_t nl;
+	Int_t nr;
+	Bool_t bdouble;
+	Bool_t bfloat;
+	getSupport(filters, nfilters, nl, nr, bdouble, bfloat);
+
+	Double_t lbnd = 0.; ///<Lower time axis bound.
+	Double_t ubnd = 0.; ///<Upper time axis bound.
+	Double_t dt = ch.getIncrement();
+	ch.getTimeAxisBounds(lbnd, ubnd);
+
+	Double_t tmin = ts.front() - dt * 2 * (nl + 1);
+	Double_t tmax = ts.back() + dt * 2 * (nr + 1);
+	if (tmin < lbnd)
+		tmin = lbnd;
+	if (tmax > ubnd)
+		tmax = ubnd;
+
+	XboxTimeAxis t = ch.viewTimeAxis(tmin, tmax);
+	if (t.empty()) {
+		for (std::vector<Double_t> &vec: res)
+			vec.assign(ts.size(), 0.);
+		return -1;
+	}
+
+	// read the signal once in each of the required precisions
+	std::vector<Double_t> &y = ws.get<Double_t>(0);
+	std::vector<Float_t> &yF = ws.get<Float_t>(0);
+	if (bdouble)
+		ch.getSignal(y, tmin, tmax);
+	if (bfloat)
+		ch.getSignal(yF, tmin, tmax);
+
+	Double_t h = t.size() > 1 ? (t.back() - t.front()) / (t.size() - 1) : 1.;
+	return filterAndResample(t.front(), h, dt, y, yF, ts, filters, nfilters, res, ws);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Fused filter function.
+/// Same as above for a list of filters.
+/// \param[in] ch a Xbox DAQ channel containing the signal.
+/// \param[in] ts a predefined time axis the signals are re-sampled on.
+/// \param[in] filters the filters to be applied.
+/// \param[out] res the filtered and re-sampled signals (one per filter).
+/// \param[in] ws the workspace (optional, a temporary one otherwise).
+/// \return 0 on success or -1 if there is nothing to evaluate.
+Int_t XboxSignalFilter::evaluate (const XBOX::XboxDAQChannel &ch, const std::vector<Double_t> &ts,
+		const std::vector<const XboxSignalFilter*> &filters,
+		std::vector<std::vector<Double_t>> &res, XboxWorkspace *ws) {
+
+	if (ws)
+		return evaluate(ch, ts, filters.data(), filters.size(), res, *ws);
+
+	XboxWorkspace local;
+	return evaluate(ch, ts, filters.data(), filters.size(), res, local);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Fused filter function.
+/// Same as above for filters given in braces, e.g. {&filt0, &filt1},
+/// which does not allocate memory.
+/// \param[in] ch a Xbox DAQ channel containing the signal.
+/// \param[in] ts a predefined time axis the signals are re-sampled on.
+/// \param[in] filters the filters to be applied.
+/// \param[out] res the filtered and re-sampled signals (one per filter).
+/// \param[in] ws the workspace (optional, a temporary one otherwise).
+/// \return 0 on success or -1 if there is nothing to evaluate.
+Int_t XboxSignalFilter::evaluate (const XBOX::XboxDAQChannel &ch, const std::vector<Double_t> &ts,
+		std::initializer_list<const XboxSignalFilter*> filters,
+		std::vector<std::vector<Double_t>> &res, XboxWorkspace *ws) {
+
+	if (ws)
+		return evaluate(ch, ts, filters.begin(), filters.size(), res, *ws);
+
+	XboxWorkspace local;
+	return evaluate(ch, ts, filters.begin(), filters.size(), res, local);
+}
+
 
 #ifndef XBOX_NO_NAMESPACE
 }
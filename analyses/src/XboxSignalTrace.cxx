@@ -0,0 +1,365 @@
+/*
+ * XboxSignalTrace.cxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#include "XboxSignalTrace.hxx"
+#include "XboxSignalFilter.hxx"
+#include "XboxWorkspace.hxx"
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxSignalTrace::XboxSignalTrace() :
+	fChannel{NULL},
+	fStartOffset{0.},
+	fIncrement{0.},
+	fNSamples{0},
+	fFirst{0} {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxSignalTrace::~XboxSignalTrace() {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Clear.
+/// Removes the samples but keeps the memory for the next event.
+void XboxSignalTrace::clear() {
+
+	fChannel = NULL;
+	fStartOffset = 0.;
+	fIncrement = 0.;
+	fNSamples = 0;
+	fFirst = 0;
+	fSignal.clear();
+	fSmooth.clear();
+	fCurvature.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Load.
+/// Calibrates the samples of the channel in the given time window once.
+/// The window should cover the windows of all evaluations plus the
+/// margin of the filters (see XBOX::XboxSignalFilter::getMargin()). The
+/// samples are smoothed on demand by smooth(). The channel is not
+/// modified.
+/// \param[in] ch The channel.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return 0 on success or -1 if the window has no samples.
+Int_t XboxSignalTrace::load(const XboxDAQChannel &ch, Double_t t0, Double_t t1) {
+
+	fChannel = &ch;
+	fStartOffset = ch.getStartOffset();
+	fIncrement = ch.getIncrement();
+	fNSamples = ch.getSamples();
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	fFirst = i0;
+
+	fSmooth.clear();
+	fCurvature.clear();
+	if (ch.getSignal(fSignal, t0, t1) <= 0) {
+		fFirst = 0;
+		return -1;
+	}
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Smoothing.
+/// Smoothes the decoded samples with the given filter in its precision
+/// and solves the curvature of the spline through the smoothed samples.
+/// Nothing is done if the samples are smoothed by an equal filter
+/// already, hence stages sharing the filter share the smoothed signal.
+/// \param[in] filter The smoothing filter.
+/// \param[in] ws The workspace for temporary buffers.
+/// \return 0 on success or -1 if there are no samples.
+Int_t XboxSignalTrace::smooth(const XboxSignalFilter &filter, XboxWorkspace &ws) {
+
+	if (!fSmooth.empty() && filter == fFilter)
+		return 0;
+
+	fSmooth.clear();
+	fCurvature.clear();
+	if (fSignal.empty())
+		return -1;
+
+	if (filter.fPrecision != XboxDAQChannel::kPrecDouble) {
+		std::vector<Float_t> &yF = ws.get<Float_t>(0);
+		yF.assign(fSignal.begin(), fSignal.end());
+		filter.filterF(fSmooth, yF, fIncrement, &ws);
+	}
+	else
+		filter.filter(fSmooth, fSignal, fIncrement, &ws);
+	fFilter = filter;
+
+	XboxTimeAxis t = viewDecoded();
+	Double_t h = t.size() > 1 ? (t.back() - t.front()) / (t.size() - 1) : 1.;
+	fResampler.setGrid(t.front(), h, t.size(), 0., 0., 0);
+	fResampler.curvature(fCurvature, fSmooth);
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Coverage of an index range.
+/// \return Whether the samples [i0, i1) of the record are decoded.
+Bool_t XboxSignalTrace::covers(Int_t i0, Int_t i1) const {
+
+	return i0 >= fFirst && i1 <= fFirst + (Int_t) fSignal.size();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Coverage of a time window.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return Whether the samples of the window are decoded.
+Bool_t XboxSignalTrace::covers(Double_t t0, Double_t t1) const {
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	return covers(i0, i1);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Time on the axis of the channel.
+/// Removes the shift of the time axis (the limit -1 is kept).
+Double_t XboxSignalTrace::toChannel(Double_t t) const {
+
+	if (t == -1)
+		return t;
+
+	return t - fStartOffset + fChannel->getStartOffset();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \param[out] t0 The time of the first sample.
+/// \param[out] t1 The time of the last sample.
+void XboxSignalTrace::getTimeAxisBounds(Double_t &t0, Double_t &t1) const {
+
+	t0 = fStartOffset;
+	t1 = fStartOffset + (fNSamples-1) * fIncrement;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Index range of a time window.
+/// Same as XBOX::XboxDAQChannel::getIndexRange() for the (shifted) time
+/// axis of the record.
+/// \param[out] i0 The first sample of the window.
+/// \param[out] i1 The sample behind the window.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return 0 on success or -1 if the limits are swapped.
+Int_t XboxSignalTrace::getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1) const {
+
+	return XboxDAQChannel::getIndexRange(i0, i1, t0, t1, fStartOffset,
+			fIncrement, fNSamples);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// View of the time axis.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return The time axis.
+XboxTimeAxis XboxSignalTrace::viewTimeAxis(Double_t t0, Double_t t1) const {
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	if (i1 <= i0)
+		return XboxTimeAxis();
+
+	return XboxTimeAxis(fStartOffset + i0*fIncrement, fIncrement, i1 - i0);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// View of the time axis of the decoded samples.
+XboxTimeAxis XboxSignalTrace::viewDecoded() const {
+
+	if (fSignal.empty())
+		return XboxTimeAxis();
+
+	return XboxTimeAxis(fStartOffset + fFirst*fIncrement, fIncrement, fSignal.size());
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Window statistics.
+/// Statistics of the calibrated samples in a time window (see
+/// XBOX::XboxDAQChannel::stats()). Windows not covered by the decoded
+/// samples are evaluated on the channel.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] mask Combination of EStatistics flags.
+/// \return The statistics of the window.
+XboxDAQChannel::Stats_t XboxSignalTrace::stats(Double_t t0, Double_t t1, UInt_t mask) const {
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	if (fChannel && !covers(i0, i1))
+		return fChannel->stats(toChannel(t0), toChannel(t1), mask);
+
+	Int_t n = (fNSamples > 0 && i1 > i0) ? i1 - i0 : 0;
+	return XboxDAQChannel::windowStats(fSignal.data() + (n ? i0 - fFirst : 0), n, mask, fIncrement);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Rising edge.
+/// Time at which the calibrated samples cross the threshold first (see
+/// XBOX::XboxDAQChannel::risingEdge()). Windows not covered by the
+/// decoded samples and precisions other than double are evaluated on
+/// the channel.
+/// \param[in] threshold The threshold relative to the span of the signal.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] prec The evaluation precision.
+/// \return The time of the rising edge (0 if there is no crossing).
+Double_t XboxSignalTrace::risingEdge(Double_t threshold, Double_t t0, Double_t t1,
+		XboxDAQChannel::EPrecision prec) const {
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	if (fChannel && (prec != XboxDAQChannel::kPrecDouble || !covers(i0, i1)))
+		return fChannel->risingEdge(threshold, toChannel(t0), toChannel(t1), prec);
+	if (fNSamples <= 0 || i1 <= i0)
+		return 0.;
+
+	Double_t idx = XboxDAQChannel::edgeIndex(fSignal.data() + i0 - fFirst, i1 - i0,
+			threshold, true);
+	return (idx < 0) ? 0. : (idx + i0) * fIncrement;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Falling edge.
+/// Time at which the calibrated samples cross the threshold last (see
+/// XBOX::XboxDAQChannel::fallingEdge() and risingEdge()).
+/// \param[in] threshold The threshold relative to the span of the signal.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] prec The evaluation precision.
+/// \return The time of the falling edge (0 if there is no crossing).
+Double_t XboxSignalTrace::fallingEdge(Double_t threshold, Double_t t0, Double_t t1,
+		XboxDAQChannel::EPrecision prec) const {
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	if (fChannel && (prec != XboxDAQChannel::kPrecDouble || !covers(i0, i1)))
+		return fChannel->fallingEdge(threshold, toChannel(t0), toChannel(t1), prec);
+	if (fNSamples <= 0 || i1 <= i0)
+		return 0.;
+
+	Double_t idx = XboxDAQChannel::edgeIndex(fSignal.data() + i0 - fFirst, i1 - i0,
+			threshold, false);
+	return (idx < 0) ? 0. : (idx + i0) * fIncrement;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Re-sampling of the smoothed signal.
+/// Evaluates the spline through the smoothed samples at the given time
+/// axis. Only the grid is set up, the curvature was solved by smooth().
+/// \param[out] ys The re-sampled signal.
+/// \param[in] ts The time axis the signal is re-sampled on.
+/// \return 0 on success or -1 if there is nothing to evaluate.
+Int_t XboxSignalTrace::resample(std::vector<Double_t> &ys, const std::vector<Double_t> &ts) {
+
+	XboxTimeAxis t = viewDecoded();
+	if (t.empty() || fSmooth.empty()) {
+		ys.assign(ts.size(), 0.);
+		return -1;
+	}
+
+	Double_t h = t.size() > 1 ? (t.back() - t.front()) / (t.size() - 1) : 1.;
+	fResampler.setGrid(t.front(), h, t.size(), ts);
+	return fResampler.apply(ys, fSmooth, fCurvature);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Fused filter function.
+/// Same as XBOX::XboxSignalFilter::evaluate() but the window covering
+/// the support of the filters is taken from the decoded samples instead
+/// of being read from the channel again.
+/// \param[in] ts a predefined time axis the signals are re-sampled on.
+/// \param[in] filters the filters to be applied.
+/// \param[out] res the filtered and re-sampled signals (one per filter).
+/// \param[in] ws the workspace.
+/// \return 0 on success or -1 if there is nothing to evaluate.
+Int_t XboxSignalTrace::evaluate(const std::vector<Double_t> &ts,
+		std::initializer_list<const XboxSignalFilter*> filters,
+		std::vector<std::vector<Double_t>> &res, XboxWorkspace &ws) const {
+
+	// keep the buffers of the result for re-use by the caller
+	res.resize(filters.size());
+	for (std::vector<Double_t> &vec: res)
+		vec.clear();
+	if (filters.size() == 0 || ts.empty())
+		return -1;
+
+	// window covering the support of all filters
+	Int_t nl;
+	Int_t nr;
+	Bool_t bdouble;
+	Bool_t bfloat;
+	XboxSignalFilter::getSupport(filters.begin(), filters.size(), nl, nr, bdouble, bfloat);
+
+	XboxTimeAxis td = viewDecoded();
+	if (td.empty()) {
+		for (std::vector<Double_t> &vec: res)
+			vec.assign(ts.size(), 0.);
+		return -1;
+	}
+
+	Double_t lbnd = td.front(); ///<Lower time axis bound.
+	Double_t ubnd = td.back(); ///<Upper time axis bound.
+	Double_t dt = fIncrement;
+
+	Double_t tmin = ts.front() - dt * 2 * (nl + 1);
+	Double_t tmax = ts.back() + dt * 2 * (nr + 1);
+	if (tmin < lbnd)
+		tmin = lbnd;
+	if (tmax > ubnd)
+		tmax = ubnd;
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, tmin, tmax);
+	if (i1 <= i0 || !covers(i0, i1)) {
+		for (std::vector<Double_t> &vec: res)
+			vec.assign(ts.size(), 0.);
+		return -1;
+	}
+
+	// copy the window in each of the required precisions
+	std::vector<Double_t> &y = ws.get<Double_t>(0);
+	std::vector<Float_t> &yF = ws.get<Float_t>(0);
+	if (bdouble)
+		y.assign(fSignal.begin() + i0 - fFirst, fSignal.begin() + i1 - fFirst);
+	if (bfloat)
+		yF.assign(fSignal.begin() + i0 - fFirst, fSignal.begin() + i1 - fFirst);
+
+	XboxTimeAxis t(fStartOffset + i0*fIncrement, fIncrement, i1 - i0);
+	Double_t h = t.size() > 1 ? (t.back() - t.front()) / (t.size() - 1) : 1.;
+	return XboxSignalFilter::filterAndResample(t.front(), h, dt, y, yF, ts,
+			filters.begin(), filters.size(), res, ws);
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
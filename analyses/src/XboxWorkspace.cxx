@@ -0,0 +1,83 @@
+/*
+ * XboxWorkspace.cxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#include "XboxWorkspace.hxx"
+
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxWorkspace::XboxWorkspace() :
+	fNAllocations{0} {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxWorkspace::~XboxWorkspace() {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Growth of the buffers.
+/// \param[in] pool The pool.
+/// \return The number of buffers handed out since the last reset which
+/// have grown in the meantime.
+template <typename T>
+ULong64_t XboxWorkspace::countGrowth(const Pool_t<T> &pool) const {
+
+	ULong64_t n = 0;
+	for (size_t i=0; i<pool.fNUsed; i++)
+		n += pool.fBuffers[i].capacity() != pool.fCapacity[i];
+	return n;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Release of all buffers of a pool.
+/// \param[in] pool The pool.
+template <typename T>
+void XboxWorkspace::release(Pool_t<T> &pool) {
+
+	fNAllocations += countGrowth(pool);
+	pool.fNUsed = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reset.
+/// Returns all buffers to the pools. To be called at the beginning of
+/// each event. The memory is kept for the next event.
+void XboxWorkspace::reset() {
+
+	release(fPoolD);
+	release(fPoolF);
+	release(fPoolC);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The number of allocations since the construction, i.e. the
+/// number of buffers created or grown.
+ULong64_t XboxWorkspace::getNAllocations() const {
+
+	return fNAllocations + countGrowth(fPoolD) + countGrowth(fPoolF)
+			+ countGrowth(fPoolC);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Getter.
+/// \return The number of buffers in the pools.
+size_t XboxWorkspace::getNBuffers() const {
+
+	return fPoolD.fBuffers.size() + fPoolF.fBuffers.size() + fPoolC.fBuffers.size();
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
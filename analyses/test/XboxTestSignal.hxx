@@ -0,0 +1,72 @@
+/*
+ * XboxTestSignal.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef _XBOXTESTSIGNAL_HXX_
+#define _XBOXTESTSIGNAL_HXX_
+
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxTestChannel.hxx"
+
+
+const Double_t kTestIncrement = 1e-9;   ///<Time resolution.
+const Int_t kTestRise = 1000;           ///<First sample of the rising edge.
+const Int_t kTestFall = 3000;           ///<First sample of the falling edge.
+
+enum ESignal { kPSI, kPEI, kPSR };
+
+
+////////////////////////////////////////////////////////////////////////
+/// Synthetic structure signal of the analysis tests.
+/// A rectangular pulse of 20000 counts with exponential edges and an
+/// offset of -5000 counts plus noise of 64 counts. The transmitted
+/// signal (kPEI) is delayed by 60 samples, the reflected signal (kPSR)
+/// is weak and rises after the breakdown. The pulse and the noise
+/// depend only on the sample index, so traces of different length with
+/// the same seed agree in their common samples.
+/// \param[in] type The incident, transmitted or reflected signal.
+/// \param[in] nsamples The length of the trace.
+/// \param[in] seed The seed of the noise.
+/// \param[in] shift The delay of the pulse in samples.
+/// \param[in] nbd The sample from which the pulse collapses (breakdown).
+inline XBOX::XboxDAQChannel createTestChannel(ESignal type, Int_t nsamples,
+		UInt_t seed, Int_t shift, Int_t nbd) {
+
+	std::vector<Short_t> raw(nsamples);
+	srand(seed);
+	for (Int_t i=0; i<nsamples; i++) {
+		Int_t k = i - shift - (type == kPEI ? 60 : 0);
+		Double_t p = 0.;
+		if (k > kTestRise && k < kTestFall)
+			p = 20000. * (1. - exp(-(k - kTestRise) / 15.));
+		if (k > kTestFall)
+			p = 20000. * exp(-(k - kTestFall) / 15.);
+
+		if (type == kPSR) {
+			// weak reflection rising after the breakdown
+			p *= 0.05;
+			if (nbd > 0 && k > nbd && k < kTestFall)
+				p += 12000. * (1. - exp(-(k - nbd) / 30.));
+		}
+		else if (nbd > 0 && k > nbd)
+			p *= exp(-(k - nbd) / 30.);
+
+		raw[i] = static_cast<Short_t>(p - 5000. + rand() % 64);
+	}
+
+	return createRawChannel(type == kPSI ? "PSI_amp" : (type == kPEI ? "PEI_amp" : "PSR_amp"),
+			raw, kTestIncrement, {1.5, 2e-3});
+}
+
+
+#endif /* _XBOXTESTSIGNAL_HXX_ */
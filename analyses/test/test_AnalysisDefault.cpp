@@ -7,20 +7,36 @@
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/RDFHelpers.hxx"
 
-#include "ROOT/TProcessExecutor.hxx"
-#include "ROOT/TThreadExecutor.hxx"
-#include "ROOT/TSeq.hxx"
-
 #include "XboxFileSystem.h"
 #include "XboxDAQChannel.hxx"
 #include "XboxAnalyserEvalBase.hxx"
-#include "XboxAnalyserEvalJitter.hxx"
 #include "XboxAnalyserEvalPulseShape.hxx"
-#include "XboxAnalyserEvalRisingEdge.hxx"
-#include "XboxAnalyserEvalDeviation.hxx"
+#include "XboxAnalyserEvalBreakdown.hxx"
+#include "XboxAnalyserResult.hxx"
 #include "XboxAnalyserEvalSignal.hxx"
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluators of the default analysis.
+/// The evaluators are configured once for all files. Their configuration is
+/// part of the cache key of the destination files.
+struct Evaluators_t {
+	XBOX::XboxAnalyserEvalPulseShape fPulseShape{0.01, 0.99, 0.9};
+	XBOX::XboxAnalyserEvalBreakdown fBreakdown;
+
+	Evaluators_t() {
+		fBreakdown.setPulseConfig(0.01, 0.99, 0.9);
+		fBreakdown.setJitterConfig(0.01, 0.3, 0.3, 0.001);
+		fBreakdown.setRiseConfig(0.01, 0.99, 0.6, 0.03);
+		fBreakdown.setDeflConfig(0.01, 0.99, 0.1, 0.02, 0.1);
+	}
+
+	std::string getConfig() const {
+		return fPulseShape.getConfig() + ";" + fBreakdown.getConfig();
+	}
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluation of pulse shape.
 /// The data evaluation is based on RDataFrame. All results of one event are
@@ -36,10 +52,11 @@
 /// \param[in] sDstKey The branch name under which the results are stored.
 /// \param[in] sSrcFilePath The source file path.
 /// \param[in] sSrcKey The branch name under from which the data are loaded.
+/// \param[in] eval The evaluators.
 /// \param[in] sfilter The filter string.
 void analysePulseShape(const std::string &dstFilePath, const std::string &dstTreeName,
 		const std::string &srcFilePath,  const std::string &srcTreeName,
-		const std::string &filter="1==1") {
+		Evaluators_t &eval, const std::string &filter="1==1") {
 
     // load data frame
     ROOT::RDataFrame df(srcTreeName.c_str(), srcFilePath.c_str(), {"PSI_amp"});
@@ -47,16 +64,13 @@ void analysePulseShape(const std::string &dstFilePath, const std::string &dstTre
     // filter breakdowns by time stamp, breakdown flags, signals, ...
     auto dfFilt = df.Filter(filter);
 
-    // evaluate normal pulse and breakdown events
-    XBOX::XboxAnalyserEvalPulseShape evalPulseSimple(0.01, 0.99, 0.9);
-
     auto dfEval = dfFilt
     					// index information
 						.Define("TimeStamp", "PSI_amp.getTimeStamp()")
 						.Define("PulseCount", "PSI_amp.getPulseCount()")
 
 						// evaluate pulse shape
-						.Define("buf_ChN0_PSI_amp", evalPulseSimple, {"PSI_amp"})
+						.Define("buf_ChN0_PSI_amp", eval.fPulseShape, {"PSI_amp"})
 
     					// remove signal data and take only meta data from channel
     					.Define("ChN0_PSI_amp", "buf_ChN0_PSI_amp.cloneMetaData()");
@@ -97,10 +111,12 @@ void analysePulseShape(const std::string &dstFilePath, const std::string &dstTre
 /// \param[in] srcFilePath The source file path.
 /// \param[in] srcTreeName1 First branch name under from which the data are loaded.
 /// \param[in] srcTreeName2 Second branch name under from which the data are loaded.
+/// \param[in] eval The evaluators.
 /// \param[in] filter The filter string.
 void analyseBreakdown(const std::string &dstFilePath, const std::string &dstTreeName,
         const std::string &srcFilePath,  const std::string &srcTreeName1,
-        const std::string &srcTreeName2, const std::string &filter="1==1") {
+        const std::string &srcTreeName2, Evaluators_t &eval,
+        const std::string &filter="1==1") {
 
     // create data frame
     TFile file(srcFilePath.c_str());
@@ -118,10 +134,20 @@ void analyseBreakdown(const std::string &dstFilePath, const std::string &dstTree
     auto dfFilt = df.Filter(filter);
 
     // evaluate normal pulse and breakdown events
-    XBOX::XboxAnalyserEvalPulseShape evalPulseShape90(0.01, 0.99, 0.9);
-    XBOX::XboxAnalyserEvalJitter evalJitter(0.01, 0.3, 0.3, 0.001);
-    XBOX::XboxAnalyserEvalRisingEdge evalRisingEdge(0.01, 0.99, 0.6, 0.03);
-    XBOX::XboxAnalyserEvalDeviation evalDeviation(0.01, 0.99, 0.1, 0.02, 0.1);
+    const XBOX::XboxAnalyserEvalPulseShape &evalPulseShape90 = eval.fPulseShape;
+    XBOX::XboxAnalyserEvalBreakdown &evalBreakdown = eval.fBreakdown;
+
+    // buffers for each processing slot (implicit multi-threading)
+    evalBreakdown.setNSlots(df.GetNSlots());
+
+    // jitter, rising edges and deviations of the structure signals in a
+    // single pass over the channels of both pulses
+    auto breakdown = [&evalBreakdown](UInt_t slot,
+    		const XBOX::XboxDAQChannel &b0psi, const XBOX::XboxDAQChannel &b1psi,
+    		const XBOX::XboxDAQChannel &b0pei, const XBOX::XboxDAQChannel &b1pei,
+    		const XBOX::XboxDAQChannel &b0psr, const XBOX::XboxDAQChannel &b1psr) {
+    	return evalBreakdown.evalSlot(slot, b0psi, b1psi, b0pei, b1pei, b0psr, b1psr);
+    };
 
     auto dfEval = dfFilt
 						// index information
@@ -146,22 +172,25 @@ void analyseBreakdown(const std::string &dstFilePath, const std::string &dstTree
 						.Define("ChB0_PEI_amp", "buf_ChB0_PEI_amp.cloneMetaData()")
 						.Define("ChB0_PSR_amp", "buf_ChB0_PSR_amp.cloneMetaData()")
 
+						// breakdown analysis of the structure signals
+						.DefineSlot("buf_Breakdown", breakdown, {"PSI_amp", "B1.PSI_amp",
+								"PEI_amp", "B1.PEI_amp", "PSR_amp", "B1.PSR_amp"})
+
 						// jitter of the structure signals
-						.Define("Jitter_PSI_amp", evalJitter, {"PSI_amp", "B1.PSI_amp"})
+						.Define("Jitter_PSI_amp", "buf_Breakdown.getJitter()")
 
 						// time where the rising edges start of the structure signals
-						.Define("RefTime_PSI_amp", evalRisingEdge, {"B1.PSI_amp"})
-						.Define("RefTime_PEI_amp", evalRisingEdge, {"B1.PEI_amp"})
-						.Define("RefTime_PSR_amp", evalRisingEdge, {"B1.PSR_amp"})
+						.Define("RefTime_PSI_amp", "buf_Breakdown.getXref()")
+						.Define("RefTime_PEI_amp", "buf_Breakdown.getTranXref()")
+						.Define("RefTime_PSR_amp", "buf_Breakdown.getReflXref()")
 
 						// time at which structure signals between start to deviate breakdown and previous event
-						.Define("DevTime_PSI_amp", evalDeviation, {"PSI_amp", "B1.PSI_amp", "Jitter_PSI_amp"})
-						.Define("DevTime_PEI_amp", evalDeviation, {"PEI_amp", "B1.PEI_amp", "Jitter_PSI_amp"})
-						.Define("DevTime_PSR_amp", evalDeviation, {"PSR_amp", "B1.PSR_amp", "Jitter_PSI_amp"})
+						.Define("DevTime_PSI_amp", "buf_Breakdown.getXdev()")
+						.Define("DevTime_PEI_amp", "buf_Breakdown.getTranXdev()")
+						.Define("DevTime_PSR_amp", "buf_Breakdown.getReflXdev()")
 
 						// breakdown location
-						.Define("BDTime",
-								"(DevTime_PSR_amp - RefTime_PSR_amp - DevTime_PEI_amp + RefTime_PEI_amp)/2");
+						.Define("BDTime", "buf_Breakdown.getBDTime()");
 
     // get number of entries which passed the filters
     auto pCnt = dfFilt.Count();
@@ -210,8 +239,9 @@ void analyseBreakdown(const std::string &dstFilePath, const std::string &dstTree
 int main(int argc, char* argv[]) {
 
 	gInterpreter->Declare("#include \"XboxDAQChannel.hxx\"");
+	gInterpreter->Declare("#include \"XboxAnalyserResult.hxx\"");
 
-//	ROOT::EnableImplicitMT(); // Tell ROOT you want to go parallel
+	ROOT::EnableImplicitMT(); // Tell ROOT you want to go parallel
 
 	std::string srcDir; // Directory of input files.
 	std::string dstDir; // Directory of output files.
@@ -221,7 +251,6 @@ int main(int argc, char* argv[]) {
 	std::string dstSuffix;
 
 	std::vector<std::string> srcExistingFilePaths; // list of existing files in a source directory
-	std::vector<std::string> dstExistingFilePaths; // list of existing files in a destination directory
 
 	std::string filtBDStruct; // Filter string. Defines the logic to select specific events.
 	std::string filtBDPCompr; // Filter string. Defines the logic to select specific events.
@@ -255,38 +284,11 @@ int main(int argc, char* argv[]) {
 	clock_t begin = clock();
 
 	srcExistingFilePaths = XBOX::getListOfFiles(srcDir + "*.root");
-	dstExistingFilePaths = XBOX::getListOfFiles(dstDir + "*" + dstSuffix + ".root");
-
-//	for (std::string filepath : srcExistingFilePaths) {
-//	    srcFilePath = filepath;
-//	    dstFilePath = dstDir + XBOX::getFileName(filepath);
-//	    dstFilePath.insert(dstFilePath.rfind('.'), dstSuffix);
-//
-//	    // skip if destination file exist already but overwrite last existing file in the destination folder
-//		if(!dstFilePath.empty()
-//				&& XBOX::accessFile(dstFilePath)
-//				&& dstFilePath.compare(dstExistingFilePaths.back())) {
-//			printf("INFO: File \'%s\' already accessible. Skip evaluation!\n", dstFilePath.c_str());
-//			continue;
-//		}
-//
-//	    printf("Process file: %s ...\n", srcFilePath.c_str());
-//	    TFile(dstFilePath.c_str(), "RECREATE"); // delete if file exists
-//	    analysePulseShape(dstFilePath, "N0Events", srcFilePath, "N0Events");
-//	    analyseBreakdown(dstFilePath, "BDStruct", srcFilePath, "B0Events",
-//	    		"B1Events", filtBDStruct);
-//	    analyseBreakdown(dstFilePath, "BDPCompr", srcFilePath, "B0Events",
-//	    		"B1Events", filtBDPCompr);
-//	}
-
-
-	// The number of workers
-	const UInt_t nThreads = 8U;
-
-	ROOT::EnableThreadSafety();
-
-
-	auto workItem = [srcExistingFilePaths, dstExistingFilePaths, dstDir](UInt_t workerID) {
+
+	// The events of each file are distributed over all cores by the
+	// implicit multi-threading of the data frames, hence the files are
+	// processed one after another.
+	auto workItem = [srcExistingFilePaths, dstDir](UInt_t workerID) {
 
 		std::string dstSuffix = "_Default";
 
@@ -312,29 +314,35 @@ int main(int argc, char* argv[]) {
 		std::string dstFilePath = dstDir + XBOX::getFileName(srcFilePath);
 		dstFilePath.insert(dstFilePath.rfind('.'), dstSuffix);
 
-		// skip if destination file exist already but overwrite last existing file in the destination folder
-		if(!dstFilePath.empty()
-				&& XBOX::accessFile(dstFilePath)
-				&& dstFilePath.compare(dstExistingFilePaths.back())) {
-			printf("INFO: File \'%s\' already accessible. Skip evaluation!\n", dstFilePath.c_str());
+		// cache key from the content of the source file, the evaluator
+		// configuration and the filters
+		Evaluators_t eval;
+		std::string config = "analyseDefault:3;" + eval.getConfig() + ";"
+				+ filtBDStruct + ";" + filtBDPCompr;
+		std::string cacheKey = XBOX::getCacheKey({srcFilePath}, config);
+
+		// skip if destination file is up to date. Stale files (changed source
+		// or configuration) and incomplete files are evaluated again.
+		if(XBOX::isCachedFile(dstFilePath, cacheKey)) {
+			printf("INFO: File \'%s\' is up to date. Skip evaluation!\n", dstFilePath.c_str());
 			return 0;
 		}
 
 		printf("Process file: %s ...\n", srcFilePath.c_str());
 	    TFile(dstFilePath.c_str(), "RECREATE"); // delete if file exists
-	    analysePulseShape(dstFilePath, "N0Events", srcFilePath, "N0Events");
+	    analysePulseShape(dstFilePath, "N0Events", srcFilePath, "N0Events", eval);
 	    analyseBreakdown(dstFilePath, "BDStruct", srcFilePath, "B0Events",
-	    		"B1Events", filtBDStruct);
+	    		"B1Events", eval, filtBDStruct);
 	    analyseBreakdown(dstFilePath, "BDPCompr", srcFilePath, "B0Events",
-	    		"B1Events", filtBDPCompr);
+	    		"B1Events", eval, filtBDPCompr);
+
+	    // mark the destination file as complete
+	    XBOX::writeCacheKey(dstFilePath, cacheKey);
 		return 0;
 	};
 
-	// Create the pool of threads
-	ROOT::TProcessExecutor pool(nThreads);
-
-	// Fill the pool with work
-	pool.Map(workItem, ROOT::TSeqI(srcExistingFilePaths.size()));
+	for (UInt_t i=0; i<srcExistingFilePaths.size(); i++)
+		workItem(i);
 
 	clock_t end = clock();
 	printf("Total elapsed time: %.3f\n", double(end - begin) / CLOCKS_PER_SEC);
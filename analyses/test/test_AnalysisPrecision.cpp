@@ -0,0 +1,183 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <string>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxSignalFilter.hxx"
+#include "XboxAnalyserEvalRisingEdge.hxx"
+#include "XboxAnalyserEvalJitter.hxx"
+#include "XboxAnalyserEvalDeviation.hxx"
+#include "XboxAlgorithms.h"
+#include "XboxTestChannel.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Synthetic channel.
+/// Creates a 16 bit channel with a noisy rf pulse envelope similar to
+/// the acquired signals of the Xbox DAQ. A breakdown collapses the
+/// pulse at the given sample.
+XBOX::XboxDAQChannel createChannel(const std::vector<Double_t> &coeffs,
+		UInt_t seed, Int_t ibd=-1) {
+
+	const Int_t nsamples = 800;
+	const Double_t dt = 1e-9;
+
+	srand(seed);
+	std::vector<Short_t> raw(nsamples);
+	for (Int_t i=0; i<nsamples; i++) {
+		Double_t p = 0.;
+		if (i > 200 && i < 600) {
+			p = 20000. * (1. - exp(-(i - 200) / 15.));
+			if (i >= 580)
+				p *= (600 - i) / 20.;
+			if (ibd > 0 && i >= ibd)
+				p *= exp(-(i - ibd) / 10.);
+		}
+		raw[i] = static_cast<Short_t>(p - 5000. + rand() % 64);
+	}
+
+	return createRawChannel("PSI_amp", raw, dt, coeffs);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Maximum deviation of two signals relative to the magnitude of the
+/// reference.
+Double_t relDeviation(const std::vector<Double_t> &yref, const std::vector<Double_t> &y) {
+
+	Double_t magn = 0.;
+	Double_t dev = 0.;
+	for (size_t i=0; i<yref.size() && i<y.size(); i++) {
+		magn = std::max(magn, fabs(yref[i]));
+		dev = std::max(dev, fabs(y[i] - yref[i]));
+	}
+	return magn > 0. ? dev / magn : dev;
+}
+
+
+int main(int argc, char** argv) {
+
+	const Int_t nevents = 200;
+	const Double_t tolEdge = 1e-2;  // deviation of edges in units of samples
+	const Double_t tolFilter = 1e-4; // relative deviation of filtered signals
+
+	const char *precname[] = {"double", "float", "raw"};
+	XBOX::XboxDAQChannel::EPrecision prec[] = {
+			XBOX::XboxDAQChannel::kPrecDouble,
+			XBOX::XboxDAQChannel::kPrecFloat,
+			XBOX::XboxDAQChannel::kPrecRaw};
+
+	// calibrations: linear, inverted linear, monotonic quadratic
+	std::vector<std::vector<Double_t>> calib = {
+			{1.5, 2e-3},
+			{0., -3e-3},
+			{0., 1e-3, 1e-9}};
+
+	Int_t status = EXIT_SUCCESS;
+	for (size_t ic=0; ic<calib.size(); ic++) {
+
+		Double_t devEdge[3] = {0., 0., 0.};
+		Double_t devFilter[3][3] = {{0., 0., 0.}, {0., 0., 0.}, {0., 0., 0.}}; // precision x derivative
+		Double_t devRise[3] = {0., 0., 0.};
+		Double_t devJitter[3] = {0., 0., 0.};
+		Double_t devDeviation[3] = {0., 0., 0.};
+		Double_t elapsed[3] = {0., 0., 0.};
+
+		for (Int_t iev=0; iev<nevents; iev++) {
+
+			XBOX::XboxDAQChannel ch = createChannel(calib[ic], iev);
+			XBOX::XboxDAQChannel chbd = createChannel(calib[ic], nevents + iev, 420 + iev % 100);
+			Double_t dt = ch.getIncrement();
+			std::vector<Double_t> ts = XBOX::linspace(1.8e-7, 2.6e-7, 512);
+
+			Double_t tr[3];
+			Double_t tf[3];
+			std::vector<Double_t> yf[3][3];
+			Double_t trise[3];
+			Double_t jitter[3];
+			Double_t tdev[3];
+
+			for (Int_t ip=0; ip<3; ip++) {
+
+				auto start = std::chrono::steady_clock::now();
+
+				tr[ip] = ch.risingEdge(0.5, -1, -1, prec[ip]);
+				tf[ip] = ch.fallingEdge(0.5, -1, -1, prec[ip]);
+
+				for (Int_t id=0; id<3; id++) {
+					XBOX::XboxSignalFilter filter(XBOX::XboxSignalFilter::kSavitzkyGolay, 3, 15, 15);
+					filter.setDerivative(id);
+					filter.setPrecision(prec[ip]);
+					yf[ip][id] = filter(ch, ts);
+				}
+
+				XBOX::XboxAnalyserEvalRisingEdge evalRise;
+				evalRise.setPrecision(prec[ip]);
+				trise[ip] = evalRise(ch);
+
+				XBOX::XboxAnalyserEvalJitter evalJitter;
+				evalJitter.setPrecision(prec[ip]);
+				jitter[ip] = evalJitter(chbd, ch);
+
+				XBOX::XboxAnalyserEvalDeviation evalDeviation;
+				evalDeviation.setPrecision(prec[ip]);
+				tdev[ip] = evalDeviation(chbd, ch, jitter[ip]);
+
+				auto stop = std::chrono::steady_clock::now();
+				elapsed[ip] += std::chrono::duration<Double_t>(stop - start).count();
+			}
+
+			for (Int_t ip=1; ip<3; ip++) {
+				devEdge[ip] = std::max(devEdge[ip], fabs(tr[ip] - tr[0]) / dt);
+				devEdge[ip] = std::max(devEdge[ip], fabs(tf[ip] - tf[0]) / dt);
+				devRise[ip] = std::max(devRise[ip], fabs(trise[ip] - trise[0]) / dt);
+				devJitter[ip] = std::max(devJitter[ip], fabs(jitter[ip] - jitter[0]) / dt);
+				devDeviation[ip] = std::max(devDeviation[ip], fabs(tdev[ip] - tdev[0]) / dt);
+				for (Int_t id=0; id<3; id++)
+					devFilter[ip][id] = std::max(devFilter[ip][id],
+							relDeviation(yf[0][id], yf[ip][id]));
+			}
+		}
+
+		printf("----------------------------------------------------\n");
+		printf("Calibration %lu (%lu coefficients), %d events\n",
+				ic, calib[ic].size(), nevents);
+		printf("----------------------------------------------------\n");
+		printf("%-8s %12s %12s %12s %12s %12s %12s %12s %10s\n", "mode",
+				"edge [dt]", "y", "y'", "y''", "rise [dt]", "jitter [dt]",
+				"dev [dt]", "time [s]");
+		for (Int_t ip=0; ip<3; ip++) {
+			printf("%-8s %12.3e %12.3e %12.3e %12.3e %12.3e %12.3e %12.3e %10.3f\n",
+					precname[ip], devEdge[ip], devFilter[ip][0], devFilter[ip][1],
+					devFilter[ip][2], devRise[ip], devJitter[ip], devDeviation[ip],
+					elapsed[ip]);
+
+			if (devEdge[ip] > tolEdge || devRise[ip] > tolEdge || devJitter[ip] > tolEdge
+					|| devDeviation[ip] > tolEdge || devFilter[ip][0] > tolFilter
+					|| devFilter[ip][1] > tolFilter || devFilter[ip][2] > tolFilter) {
+				printf("ERROR: Deviation of the %s evaluation exceeds the tolerance\n",
+						precname[ip]);
+				status = EXIT_FAILURE;
+			}
+		}
+	}
+
+	// meta data only (e.g. XboxAnalyserViewColumn): no samples to evaluate
+	XBOX::XboxDAQChannel meta = createChannel(calib[0], 0);
+	meta.setRawData(std::vector<Byte_t>());
+	for (Int_t ip=0; ip<3; ip++) {
+		if (meta.risingEdge(0.5, -1, -1, prec[ip]) != 0.
+				|| meta.fallingEdge(0.5, -1, -1, prec[ip]) != 0.) {
+			printf("ERROR: Edge of a channel without raw data in %s precision\n",
+					precname[ip]);
+			status = EXIT_FAILURE;
+		}
+	}
+
+	return status;
+}
@@ -0,0 +1,164 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxAnalyserResult.hxx"
+#include "XboxAnalyserEvalPulseShape.hxx"
+#include "XboxAnalyserEvalRisingEdge.hxx"
+#include "XboxAnalyserEvalJitter.hxx"
+#include "XboxAnalyserEvalDeviation.hxx"
+#include "XboxAnalyserEvalBreakdown.hxx"
+
+#include "XboxTestSignal.hxx"
+
+
+const Int_t nSamples = 5000;
+
+
+int main(int argc, char** argv) {
+
+	const Int_t nevents = 40;
+	const Double_t tol = 1e-12; // maximum deviation of the times (s)
+	const Double_t rtol = 1e-9; // maximum relative deviation of the pulse shape
+
+	Int_t status = EXIT_SUCCESS;
+
+	// breakdown pulse (B0) and previous pulse (B1) of each event
+	std::vector<XBOX::XboxDAQChannel> b0[3];
+	std::vector<XBOX::XboxDAQChannel> b1[3];
+	for (Int_t j=0; j<3; j++) {
+		for (Int_t i=0; i<nevents; i++) {
+			Int_t nbd = 1400 + 25 * i;
+			b0[j].push_back(createTestChannel(ESignal(j), nSamples, 6 * i + 2 * j + 1, i % 4, nbd));
+			b1[j].push_back(createTestChannel(ESignal(j), nSamples, 6 * i + 2 * j + 2, (i + 1) % 3, 0));
+		}
+	}
+
+	// chained evaluation as in analyseBreakdown (test_AnalysisDefault)
+	XBOX::XboxAnalyserEvalPulseShape evalPulseShape90(0.01, 0.99, 0.9);
+	XBOX::XboxAnalyserEvalJitter evalJitter(0.01, 0.3, 0.3, 0.001);
+	XBOX::XboxAnalyserEvalRisingEdge evalRisingEdge(0.01, 0.99, 0.6, 0.03);
+	XBOX::XboxAnalyserEvalDeviation evalDeviation(0.01, 0.99, 0.1, 0.02, 0.1);
+
+	std::vector<XBOX::XboxAnalyserResult> chained(nevents);
+	auto start = std::chrono::steady_clock::now();
+	for (Int_t i=0; i<nevents; i++) {
+
+		XBOX::XboxDAQChannel ps[2][3];
+		Double_t tref[3];
+		Double_t tdev[3];
+		for (Int_t j=0; j<3; j++) {
+			ps[0][j] = evalPulseShape90(b0[j][i]);
+			ps[1][j] = evalPulseShape90(b1[j][i]);
+		}
+		Double_t jitter = evalJitter(b0[kPSI][i], b1[kPSI][i]);
+		for (Int_t j=0; j<3; j++) {
+			tref[j] = evalRisingEdge(b1[j][i]);
+			tdev[j] = evalDeviation(b0[j][i], b1[j][i], jitter);
+		}
+
+		XBOX::XboxAnalyserResult &res = chained[i];
+		res.setRefXmin(ps[1][kPSI].getXmin());
+		res.setRefXmax(ps[1][kPSI].getXmax());
+		res.setRefYavg(ps[1][kPSI].getYmean());
+		res.setRefYpp(ps[1][kPSI].getYspan());
+		res.setXmin(ps[0][kPSI].getXmin());
+		res.setXmax(ps[0][kPSI].getXmax());
+		res.setYavg(ps[0][kPSI].getYmean());
+		res.setYpp(ps[0][kPSI].getYspan());
+		res.setJitter(jitter);
+		res.setXref(tref[kPSI]);
+		res.setXdev(tdev[kPSI]);
+		res.setTranXref(tref[kPEI]);
+		res.setTranXdev(tdev[kPEI]);
+		res.setReflXref(tref[kPSR]);
+		res.setReflXdev(tdev[kPSR]);
+		res.setBDTime((tdev[kPSR] - tref[kPSR] - tdev[kPEI] + tref[kPEI]) / 2);
+	}
+	auto stop = std::chrono::steady_clock::now();
+	Double_t tchained = std::chrono::duration<Double_t>(stop - start).count() / nevents;
+
+	// fused evaluation
+	XBOX::XboxAnalyserEvalBreakdown evalBreakdown;
+	evalBreakdown.setPulseConfig(0.01, 0.99, 0.9);
+	evalBreakdown.setJitterConfig(0.01, 0.3, 0.3, 0.001);
+	evalBreakdown.setRiseConfig(0.01, 0.99, 0.6, 0.03);
+	evalBreakdown.setDeflConfig(0.01, 0.99, 0.1, 0.02, 0.1);
+
+	std::vector<XBOX::XboxAnalyserResult> fused(nevents);
+	start = std::chrono::steady_clock::now();
+	for (Int_t i=0; i<nevents; i++)
+		fused[i] = evalBreakdown(b0[kPSI][i], b1[kPSI][i], b0[kPEI][i], b1[kPEI][i],
+				b0[kPSR][i], b1[kPSR][i]);
+	stop = std::chrono::steady_clock::now();
+	Double_t tfused = std::chrono::duration<Double_t>(stop - start).count() / nevents;
+
+	// compare both evaluations
+	Double_t maxdev = 0.;
+	Double_t maxrel = 0.;
+	Int_t nfail = 0;
+	for (Int_t i=0; i<nevents; i++) {
+
+		const XBOX::XboxAnalyserResult &r1 = chained[i];
+		const XBOX::XboxAnalyserResult &r2 = fused[i];
+
+		Double_t times[][2] = {
+				{r1.getJitter(), r2.getJitter()},
+				{r1.getXref(), r2.getXref()},
+				{r1.getXdev(), r2.getXdev()},
+				{r1.getTranXref(), r2.getTranXref()},
+				{r1.getTranXdev(), r2.getTranXdev()},
+				{r1.getReflXref(), r2.getReflXref()},
+				{r1.getReflXdev(), r2.getReflXdev()},
+				{r1.getBDTime(), r2.getBDTime()},
+				{r1.getRefXmin(), r2.getRefXmin()},
+				{r1.getRefXmax(), r2.getRefXmax()},
+				{r1.getXmin(), r2.getXmin()},
+				{r1.getXmax(), r2.getXmax()}};
+		Double_t values[][2] = {
+				{r1.getRefYavg(), r2.getRefYavg()},
+				{r1.getRefYpp(), r2.getRefYpp()},
+				{r1.getYavg(), r2.getYavg()},
+				{r1.getYpp(), r2.getYpp()}};
+
+		Bool_t bfail = false;
+		for (auto &t: times) {
+			Double_t dev = fabs(t[0] - t[1]);
+			if (dev > maxdev)
+				maxdev = dev;
+			if (dev > tol)
+				bfail = true;
+		}
+		for (auto &v: values) {
+			Double_t rel = fabs(v[0] - v[1]) / (fabs(v[0]) > 0. ? fabs(v[0]) : 1.);
+			if (rel > maxrel)
+				maxrel = rel;
+			if (rel > rtol)
+				bfail = true;
+		}
+		if (bfail) {
+			printf("Event %d: chained BDTime %e | fused BDTime %e\n", i,
+					r1.getBDTime(), r2.getBDTime());
+			nfail++;
+		}
+	}
+
+	printf("----------------------------------------------------\n");
+	printf("Events: %d | BDTime (first event): %e\n", nevents, fused[0].getBDTime());
+	printf("Maximum deviation: %e s (times) | %e (pulse shape)\n", maxdev, maxrel);
+	printf("Chained: %.1f us per event | Fused: %.1f us per event | Speedup: %.2f\n",
+			tchained * 1e6, tfused * 1e6, tchained / tfused);
+
+	if (nfail) {
+		printf("ERROR: %d events differ from the chained evaluation\n", nfail);
+		status = EXIT_FAILURE;
+	}
+
+	return status;
+}
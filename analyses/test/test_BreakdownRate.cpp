@@ -0,0 +1,176 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxAnalyserBreakdownRate.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Reference.
+/// Former implementation of XBOX::XboxAnalyserBreakdownRate::fromMovingWindow()
+/// (linear search of the nearest neighbour for each sampling point).
+void referenceMovingWindow(const std::vector<ULong64_t> &vPCnt, Int_t nsamples,
+		Double_t sigma, Int_t nsigma, std::vector<ULong64_t> &pcnt, std::vector<Double_t> &rate) {
+
+	size_t n = vPCnt.size();
+	pcnt.resize(nsamples);
+	rate.resize(nsamples);
+
+	ULong64_t pcntMin = *std::min_element(vPCnt.begin(), vPCnt.end());
+	ULong64_t pcntMax = *std::max_element(vPCnt.begin(), vPCnt.end());
+	ULong64_t pcntInc = (pcntMax - pcntMin) / nsamples;
+	ULong64_t pcntSig = (pcntMax - pcntMin) * sigma;
+	ULong64_t pcntCut = (pcntMax - pcntMin) * sigma * nsigma;
+	ULong64_t pcntVal = pcntMin;
+
+	for (Int_t ipnt=0; ipnt<nsamples; ipnt++) {
+
+		size_t idxNN=0;
+		ULong64_t pcntDist = 0;
+
+		if (vPCnt.back() < pcntVal) {
+			idxNN = n-1;
+			pcntDist = pcntVal - vPCnt[idxNN];
+		}
+		else {
+			for (size_t i=1; i < n; i++) {
+				if (pcntVal < vPCnt[i]) {
+					if ((vPCnt[i]-pcntVal) < (pcntVal-vPCnt[i-1]))
+						idxNN = i;
+					else
+						idxNN = i-1;
+					pcntDist = pcntVal - vPCnt[i];
+					break;
+				}
+			}
+		}
+
+		size_t nl=0;
+		ULong64_t lbnd = (vPCnt.front()+pcntCut < pcntVal) ? pcntVal-pcntCut : vPCnt.front();
+		while(nl+1 < idxNN && vPCnt[idxNN-nl-1] >= lbnd)
+			nl++;
+
+		std::vector<Double_t> f(nl+1, 0.);
+		std::vector<Double_t> w(nl+1, 1.);
+
+		if (pcntVal > vPCnt[idxNN]) {
+			w[0] = 1.;
+			f[0] = 1. / (pcntVal-vPCnt[idxNN]);
+		}
+		else {
+			w[0] = 0.;
+			f[0] = 0.;
+		}
+
+		for (size_t i=1; i<=nl; i++) {
+			if (pcntVal > vPCnt[idxNN-i]) {
+				w[i] = exp(-pow(pcntVal-pcntDist-vPCnt[idxNN-i], 2.) /
+						(2 * pow(pcntSig, 2)));
+				f[i] = 1. / (pcntVal - vPCnt[idxNN-i]) * i;
+			}
+			else {
+				f[i] = 0.;
+				w[i] = 0.;
+			}
+		}
+
+		Double_t rateVal=0.;
+		Double_t sum=0.;
+		for (size_t i=0; i<w.size(); i++) {
+			if (f[i] == 0.)
+				w[i] = 0.;
+			sum += w[i];
+			rateVal += w[i] * f[i];
+		}
+		rateVal /= sum;
+
+		pcnt[ipnt] = pcntVal;
+		rate[ipnt] = rateVal;
+		pcntVal += pcntInc;
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Synthetic history.
+/// Pulse counts of breakdowns with a rate decaying during conditioning.
+/// \param[in] n The number of breakdowns.
+std::vector<ULong64_t> createHistory(size_t n) {
+
+	std::mt19937_64 gen(12345);
+	std::vector<ULong64_t> pcnt(n);
+	ULong64_t val = 1000;
+	for (size_t i=0; i<n; i++) {
+		Double_t mean = 1e2 * (1. + 50. * i / n); // mean pulses between breakdowns
+		std::exponential_distribution<Double_t> dist(1. / mean);
+		val += 1 + (ULong64_t) dist(gen);
+		pcnt[i] = val;
+	}
+	return pcnt;
+}
+
+
+int main(int argc, char** argv) {
+
+	const Int_t nsamples = 1001;
+	const Double_t sigma = 0.02;
+	const Int_t nsigma = 3;
+	const Double_t tol = 1e-6; // maximum relative deviation
+
+	Int_t status = EXIT_SUCCESS;
+
+	printf("----------------------------------------------------\n");
+	printf("%10s %14s %14s %10s %14s\n", "Events", "Former [ms]", "Current [ms]",
+			"Speedup", "Max. rel. dev.");
+
+	for (size_t n: {1000, 10000, 100000}) {
+
+		std::vector<ULong64_t> vPCnt = createHistory(n);
+
+		std::vector<ULong64_t> pcnt1;
+		std::vector<Double_t> rate1;
+		auto start = std::chrono::steady_clock::now();
+		referenceMovingWindow(vPCnt, nsamples, sigma, nsigma, pcnt1, rate1);
+		auto stop = std::chrono::steady_clock::now();
+		Double_t t1 = std::chrono::duration<Double_t>(stop - start).count();
+
+		std::vector<ULong64_t> pcnt2;
+		std::vector<Double_t> rate2;
+		XBOX::XboxAnalyserBreakdownRate bdr(vPCnt);
+		bdr.setWeightFunction(XBOX::XboxAnalyserBreakdownRate::kGaussian, sigma, nsigma);
+		bdr.setSamples(nsamples);
+		start = std::chrono::steady_clock::now();
+		bdr.fromMovingWindow(pcnt2, rate2);
+		stop = std::chrono::steady_clock::now();
+		Double_t t2 = std::chrono::duration<Double_t>(stop - start).count();
+
+		Double_t maxrel = 0.;
+		Bool_t bmatch = (pcnt1 == pcnt2);
+		for (Int_t i=0; i<nsamples; i++) {
+			if (std::isnan(rate1[i]) != std::isnan(rate2[i])) {
+				bmatch = false;
+				continue;
+			}
+			if (std::isnan(rate1[i]))
+				continue;
+			Double_t rel = fabs(rate2[i] - rate1[i]) / (rate1[i] != 0. ? fabs(rate1[i]) : 1.);
+			maxrel = std::max(maxrel, rel);
+		}
+
+		printf("%10zu %14.3f %14.3f %10.1f %14.3e\n", n, t1 * 1e3, t2 * 1e3, t1 / t2, maxrel);
+
+		if (!bmatch || maxrel > tol) {
+			printf("ERROR: Breakdown rate differs from the former implementation\n");
+			status = EXIT_FAILURE;
+		}
+	}
+
+	return status;
+}
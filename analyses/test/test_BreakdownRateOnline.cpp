@@ -0,0 +1,212 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxAnalyserBreakdownRate.hxx"
+#include "XboxAnalyserBreakdownRateOnline.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Synthetic history.
+/// Pulse counts of breakdowns with a rate decaying during conditioning.
+/// \param[in] n The number of breakdowns.
+std::vector<ULong64_t> createHistory(size_t n) {
+
+	std::mt19937_64 gen(12345);
+	std::vector<ULong64_t> pcnt(n);
+	ULong64_t val = 1000;
+	for (size_t i=0; i<n; i++) {
+		Double_t mean = 1e2 * (1. + 50. * i / n); // mean pulses between breakdowns
+		std::exponential_distribution<Double_t> dist(1. / mean);
+		val += 1 + (ULong64_t) dist(gen);
+		pcnt[i] = val;
+	}
+	return pcnt;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Rates after an event.
+struct Rates {
+	Double_t step;
+	Double_t pcnt;
+	Double_t gauss;
+	ULong64_t nbins;
+
+	Bool_t operator==(const Rates &other) const {
+		return step == other.step && pcnt == other.pcnt
+				&& gauss == other.gauss && nbins == other.nbins;
+	}
+};
+
+Rates getRates(const XBOX::XboxAnalyserBreakdownRateOnline &bdr) {
+	return Rates{bdr.getRateStep(), bdr.getRatePCnt(), bdr.getRateGauss(), bdr.getNBins()};
+}
+
+
+int main(int argc, char** argv) {
+
+	const Int_t nstep = 10;
+	const ULong64_t pcntStep = 20000;
+	const ULong64_t width = 1000;
+	const Double_t sigma = 10000.;
+	const Int_t nsigma = 3;
+	const Double_t tol = 1e-12; // maximum relative deviation
+
+	Int_t status = EXIT_SUCCESS;
+
+	printf("----------------------------------------------------\n");
+	printf("%10s %14s %14s %14s %10s\n", "Events", "Batch [ms]", "Online [ns/ev]",
+			"Max. rel. dev.", "Bins");
+
+	// consistency with the batch evaluation and cost per event ..........
+	for (size_t n: {1000, 10000, 100000}) {
+
+		std::vector<ULong64_t> vPCnt = createHistory(n);
+
+		std::vector<ULong64_t> pcnt1;
+		std::vector<Double_t> rate1;
+		XBOX::XboxAnalyserBreakdownRate batch(vPCnt);
+		auto start = std::chrono::steady_clock::now();
+		batch.fromEquidistantStep(pcnt1, rate1, nstep);
+		auto stop = std::chrono::steady_clock::now();
+		Double_t t1 = std::chrono::duration<Double_t>(stop - start).count();
+
+		XBOX::XboxAnalyserBreakdownRateOnline online(nstep, pcntStep, width, sigma, nsigma);
+		std::vector<Double_t> rate2(n);
+		std::vector<Double_t> ratePCnt(n);
+		std::vector<ULong64_t> pcntPCnt(n);
+		start = std::chrono::steady_clock::now();
+		for (size_t i=0; i<n; i++) {
+			online.add(vPCnt[i]);
+			rate2[i] = online.getRateStep();
+			ratePCnt[i] = online.getRatePCnt();
+			pcntPCnt[i] = online.getPCntPCnt();
+		}
+		stop = std::chrono::steady_clock::now();
+		Double_t t2 = std::chrono::duration<Double_t>(stop - start).count();
+
+		Double_t maxrel = 0.;
+		for (size_t i=nstep; i<n; i++)
+			maxrel = std::max(maxrel, fabs(rate2[i] - rate1[i]) / rate1[i]);
+
+		// pulse count intervals: unlike fromEquidistantPCnt(), the event
+		// closing an interval is not skipped but opens the next interval
+		Int_t nintervals = 0;
+		size_t ibegin = 0; // first event of the open interval
+		for (size_t i=1; i<n; i++) {
+			Bool_t bclose = (vPCnt[i] >= vPCnt[ibegin] + pcntStep);
+			if (bclose != (pcntPCnt[i] != pcntPCnt[i-1])) {
+				printf("ERROR: Pulse count interval closed at the wrong event\n");
+				status = EXIT_FAILURE;
+				break;
+			}
+			if (!bclose)
+				continue;
+
+			Double_t rate = (Double_t) (i - ibegin) / (vPCnt[i] - vPCnt[ibegin]);
+			maxrel = std::max(maxrel, fabs(ratePCnt[i] - rate) / rate);
+			if (pcntPCnt[i] != vPCnt[i])
+				maxrel = 1.;
+			ibegin = i;
+			nintervals++;
+		}
+		if (!nintervals) {
+			printf("ERROR: No pulse count interval closed\n");
+			status = EXIT_FAILURE;
+		}
+
+		printf("%10zu %14.3f %14.1f %14.3e %10llu\n", n, t1 * 1e3, t2 / n * 1e9, maxrel,
+				(unsigned long long) online.getNBins());
+
+		if (maxrel > tol) {
+			printf("ERROR: Online rate differs from the batch evaluation\n");
+			status = EXIT_FAILURE;
+		}
+		if (online.getNBins() != (vPCnt.back() - vPCnt.front()) / width) {
+			printf("ERROR: Unexpected number of gaussian bins\n");
+			status = EXIT_FAILURE;
+		}
+	}
+
+	// stationary rate ...................................................
+	XBOX::XboxAnalyserBreakdownRateOnline stationary(nstep, pcntStep, width, sigma, nsigma);
+	for (ULong64_t p=100; p<=1000000; p+=100)
+		stationary.add(p);
+	Double_t rateRef = 1e-2;
+	printf("Stationary rate: %.6e (step) | %.6e (pcnt) | %.6e (gaussian)\n",
+			stationary.getRateStep(), stationary.getRatePCnt(), stationary.getRateGauss());
+	if (fabs(stationary.getRateStep() - rateRef) > tol
+			|| fabs(stationary.getRatePCnt() - rateRef) > tol
+			|| fabs(stationary.getRateGauss() - rateRef) > tol) {
+		printf("ERROR: Unexpected stationary rate\n");
+		status = EXIT_FAILURE;
+	}
+
+	// decay without events
+	stationary.advance(2000000);
+	if (stationary.getRateGauss() != 0. || stationary.getPCntGauss() > 2000000
+			|| stationary.getPCntGauss() + width <= 2000000) {
+		printf("ERROR: Gaussian rate does not decay without events\n");
+		status = EXIT_FAILURE;
+	}
+
+	// events out of order are rejected
+	if (stationary.add(500) != -1 || stationary.getNEvents() != 10000) {
+		printf("ERROR: Event out of order not rejected\n");
+		status = EXIT_FAILURE;
+	}
+
+	// the number of closed bins is clamped
+	ULong64_t nbins = stationary.getNBins();
+	ULong64_t pcntFar = 2000000 + (ULong64_t) 4 * kMaxInt * width;
+	if (stationary.advance(pcntFar) != kMaxInt
+			|| stationary.getNBins() != nbins + (ULong64_t) 4 * kMaxInt) {
+		printf("ERROR: Number of closed bins not clamped\n");
+		status = EXIT_FAILURE;
+	}
+
+	// checkpoint and restore ............................................
+	const char *filepath = "test_BreakdownRateOnline.root";
+	std::vector<ULong64_t> vPCnt = createHistory(10000);
+
+	XBOX::XboxAnalyserBreakdownRateOnline uninterrupted(nstep, pcntStep, width, sigma, nsigma);
+	XBOX::XboxAnalyserBreakdownRateOnline interrupted(nstep, pcntStep, width, sigma, nsigma);
+	XBOX::XboxAnalyserBreakdownRateOnline restored;
+
+	std::vector<Rates> rates1, rates2;
+	for (size_t i=0; i<vPCnt.size(); i++) {
+		uninterrupted.add(vPCnt[i]);
+		rates1.push_back(getRates(uninterrupted));
+	}
+	for (size_t i=0; i<vPCnt.size()/2; i++) {
+		interrupted.add(vPCnt[i]);
+		rates2.push_back(getRates(interrupted));
+	}
+	if (interrupted.checkpoint(filepath, "bdr") || restored.restore(filepath, "bdr")) {
+		printf("ERROR: Checkpoint failed\n");
+		return EXIT_FAILURE;
+	}
+	for (size_t i=vPCnt.size()/2; i<vPCnt.size(); i++) {
+		restored.add(vPCnt[i]);
+		rates2.push_back(getRates(restored));
+	}
+	remove(filepath);
+
+	Bool_t bmatch = (rates1 == rates2);
+	printf("Restored: %llu events | %s\n", (unsigned long long) restored.getNEvents(),
+			bmatch ? "identical to the uninterrupted evaluation" : "deviates");
+	if (!bmatch || restored.getNEvents() != vPCnt.size()) {
+		printf("ERROR: Restored evaluation differs from the uninterrupted evaluation\n");
+		status = EXIT_FAILURE;
+	}
+
+	return status;
+}
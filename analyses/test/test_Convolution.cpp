@@ -0,0 +1,146 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxConvolution.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Reference convolution.
+/// Evaluates the full convolution term by term with the signal extended
+/// beyond its bounds and drops the first nl and the last nr points.
+std::vector<Double_t> refConvolution(const std::vector<Double_t> &f,
+		const std::vector<Double_t> &kernel, Int_t nl, Int_t nr, Bool_t nearest) {
+
+	Int_t nf = f.size();
+	Int_t nk = kernel.size();
+	std::vector<Double_t> res;
+	for (Int_t i=nl; i<nf+nk-1-nr; i++) {
+		Double_t sum = 0.;
+		for (Int_t j=0; j<nk; j++) {
+			Int_t k = i - j;
+			Double_t val = 0.;
+			if (k < 0)
+				val = nearest ? f.front() : 0.;
+			else if (k >= nf)
+				val = nearest ? f.back() : 0.;
+			else
+				val = f[k];
+			sum += val * kernel[j];
+		}
+		res.push_back(sum);
+	}
+	return res;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Execution time of a convolution in microseconds.
+Double_t timeConvolution(const XBOX::XboxConvolution &conv, const std::vector<Double_t> &f,
+		Int_t nrep) {
+
+	std::vector<Double_t> res;
+	auto start = std::chrono::steady_clock::now();
+	for (Int_t irep=0; irep<nrep; irep++)
+		conv.apply(res, f);
+	auto stop = std::chrono::steady_clock::now();
+	return std::chrono::duration<Double_t>(stop - start).count() / nrep * 1e6;
+}
+
+
+int main(int argc, char** argv) {
+
+	const Double_t tol = 1e-12;  // deviation relative to the magnitude of the result
+	const Double_t tolF = 1e-5;  // same for single precision
+
+	XBOX::XboxConvolution::EMethod method[] = {
+			XBOX::XboxConvolution::kDirect,
+			XBOX::XboxConvolution::kFFT,
+			XBOX::XboxConvolution::kAuto};
+	XBOX::XboxConvolution::EBoundary boundary[] = {
+			XBOX::XboxConvolution::kZero,
+			XBOX::XboxConvolution::kNearest};
+
+	// accuracy of all methods and boundary conditions
+	Int_t status = EXIT_SUCCESS;
+	Double_t dev = 0.;
+	Double_t devF = 0.;
+	srand(1);
+	for (Int_t itrial=0; itrial<200; itrial++) {
+
+		Int_t nf = 1 + rand() % 1000;
+		Int_t nk = 1 + rand() % 200;
+		Int_t nl = rand() % nk;
+		Int_t nr = nk - 1 - nl;
+		if (itrial % 4 == 0) { // other than "same" mode
+			nl = rand() % (nk + 1);
+			nr = rand() % (nk + 1);
+		}
+
+		std::vector<Double_t> f(nf);
+		std::vector<Double_t> kernel(nk);
+		for (Double_t &val: f)
+			val = rand() % 1000 - 300.;
+		for (Double_t &val: kernel)
+			val = (rand() % 100 - 50.) / 50.;
+		std::vector<Float_t> fF(f.begin(), f.end());
+
+		for (Int_t ib=0; ib<2; ib++) {
+			std::vector<Double_t> ref = refConvolution(f, kernel, nl, nr, ib == 1);
+			Double_t magn = 1.;
+			for (Double_t val: ref)
+				magn = std::max(magn, fabs(val));
+
+			for (Int_t im=0; im<3; im++) {
+				XBOX::XboxConvolution conv(kernel, nl, nr, boundary[ib], method[im]);
+				std::vector<Double_t> res;
+				std::vector<Float_t> resF;
+				conv.apply(res, f);
+				conv.apply(resF, fF);
+
+				if (res.size() != ref.size() || resF.size() != ref.size()) {
+					printf("ERROR: Wrong length of the convolution (nf=%d, nk=%d, nl=%d, nr=%d)\n",
+							nf, nk, nl, nr);
+					return EXIT_FAILURE;
+				}
+				for (size_t i=0; i<ref.size(); i++) {
+					dev = std::max(dev, fabs(res[i] - ref[i]) / magn);
+					devF = std::max(devF, fabs(resF[i] - ref[i]) / magn);
+				}
+			}
+		}
+	}
+
+	printf("----------------------------------------------------\n");
+	printf("Maximum relative deviation: %.3e (double), %.3e (float)\n", dev, devF);
+	if (dev > tol || devF > tolF) {
+		printf("ERROR: Deviation of the convolution exceeds the tolerance\n");
+		status = EXIT_FAILURE;
+	}
+
+	// execution time vs kernel length
+	printf("----------------------------------------------------\n");
+	printf("%8s %8s %12s %12s %12s\n", "samples", "kernel", "direct [us]", "fft [us]", "auto [us]");
+	for (Int_t nf: {800, 8000}) {
+		std::vector<Double_t> f(nf);
+		for (Double_t &val: f)
+			val = rand() % 1000;
+
+		for (Int_t nk: {7, 15, 31, 63, 127, 255, 511}) {
+			std::vector<Double_t> kernel(nk, 1. / nk); // moving average
+			Int_t nrep = 2000000 / nf / nk + 10;
+			Double_t elapsed[3];
+			for (Int_t im=0; im<3; im++) {
+				XBOX::XboxConvolution conv(kernel, nk/2, nk/2, XBOX::XboxConvolution::kNearest, method[im]);
+				elapsed[im] = timeConvolution(conv, f, nrep);
+			}
+			printf("%8d %8d %12.2f %12.2f %12.2f\n", nf, nk, elapsed[0], elapsed[1], elapsed[2]);
+		}
+	}
+
+	return status;
+}
@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxAnalyserEvalPulseShape.hxx"
+#include "XboxAnalyserEvalRisingEdge.hxx"
+#include "XboxAnalyserEvalJitter.hxx"
+#include "XboxAnalyserEvalDeviation.hxx"
+
+#include "XboxTestSignal.hxx"
+
+
+const Int_t nSamples = 5000;
+
+
+int main(int argc, char** argv) {
+
+	const UInt_t nslots = std::max(std::thread::hardware_concurrency(), 2U);
+	const Int_t nevents = 400;
+
+	Int_t status = EXIT_SUCCESS;
+
+	// events of a breakdown (B0) and the previous pulse (B1)
+	std::vector<XBOX::XboxDAQChannel> b0(nevents);
+	std::vector<XBOX::XboxDAQChannel> b1(nevents);
+	for (Int_t i=0; i<nevents; i++) {
+		b0[i] = createTestChannel(kPSI, nSamples, 2 * i + 1, i % 5, 1500 + 3 * i);
+		b1[i] = createTestChannel(kPSI, nSamples, 2 * i + 2, i % 7, 0);
+	}
+
+	XBOX::XboxAnalyserEvalPulseShape evalPulse(0.01, 0.99, 0.9);
+	XBOX::XboxAnalyserEvalRisingEdge evalEdge(0.1, 0.8, 0.6, 0.04);
+	XBOX::XboxAnalyserEvalJitter evalJitter;
+	evalJitter.config(0.1, 0.8, 0.5, 0.02);
+	XBOX::XboxAnalyserEvalDeviation evalDev;
+	evalDev.config(0.1, 0.8, 0.1, 0.02, 0.04);
+
+	// serial reference
+	std::vector<Double_t> ref(4 * nevents);
+	auto start = std::chrono::steady_clock::now();
+	for (Int_t i=0; i<nevents; i++) {
+		ref[4*i] = evalPulse(b0[i]).getXmax();
+		ref[4*i+1] = evalEdge(b1[i]);
+		ref[4*i+2] = evalJitter(b0[i], b1[i]);
+		ref[4*i+3] = evalDev(b0[i], b1[i], ref[4*i+2]);
+	}
+	auto stop = std::chrono::steady_clock::now();
+	Double_t tserial = std::chrono::duration<Double_t>(stop - start).count();
+
+	// the events are distributed round robin over the slots, each thread
+	// evaluates its own subset of the channels with the shared evaluators
+	// but in the scratch buffers of its slot; the results must match the
+	// serial evaluation exactly
+	evalEdge.setNSlots(nslots);
+	evalJitter.setNSlots(nslots);
+	evalDev.setNSlots(nslots);
+
+	std::vector<Double_t> res(4 * nevents);
+	std::vector<std::thread> threads;
+	start = std::chrono::steady_clock::now();
+	for (UInt_t slot=0; slot<nslots; slot++) {
+		threads.emplace_back([&, slot]() {
+			for (Int_t i=slot; i<nevents; i+=nslots) {
+				res[4*i] = evalPulse(b0[i]).getXmax();
+				res[4*i+1] = evalEdge.evalSlot(slot, b1[i]);
+				res[4*i+2] = evalJitter.evalSlot(slot, b0[i], b1[i]);
+				res[4*i+3] = evalDev.evalSlot(slot, b0[i], b1[i], res[4*i+2]);
+			}
+		});
+	}
+	for (std::thread &thread: threads)
+		thread.join();
+	stop = std::chrono::steady_clock::now();
+	Double_t tparallel = std::chrono::duration<Double_t>(stop - start).count();
+
+	Int_t nerr = 0;
+	for (Int_t i=0; i<4*nevents; i++)
+		nerr += res[i] != ref[i];
+
+	// the input channels must not be modified by the evaluation
+	for (Int_t i=0; i<nevents; i++)
+		nerr += b1[i].getStartOffset() != 0.;
+
+	printf("----------------------------------------------------\n");
+	printf("Slots: %u | Events: %d\n", nslots, nevents);
+	printf("Serial: %.3f s | Parallel: %.3f s\n", tserial, tparallel);
+	printf("Deviations from the serial evaluation: %d\n", nerr);
+	if (nerr) {
+		printf("ERROR: Evaluation in parallel slots differs from the serial one\n");
+		status = EXIT_FAILURE;
+	}
+
+	return status;
+}
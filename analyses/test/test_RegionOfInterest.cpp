@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxAnalyserEvalRisingEdge.hxx"
+#include "XboxAnalyserEvalJitter.hxx"
+#include "XboxAnalyserEvalDeviation.hxx"
+
+#include "XboxTestSignal.hxx"
+
+
+int main(int argc, char** argv) {
+
+	// windows of a fixed number of samples, i.e. relative to the trace length
+	const Int_t nWmin = 500;
+	const Int_t nWmax = 4000;
+	const Int_t nProx = 200;
+	const Int_t nrep = 200;
+
+	Int_t status = EXIT_SUCCESS;
+	Double_t tref[3] = {0., 0., 0.};
+
+	printf("----------------------------------------------------\n");
+	printf("%10s %16s %16s %16s\n", "samples", "edge [us]", "jitter [us]", "deviation [us]");
+	for (Int_t nsamples: {5000, 50000, 500000}) {
+
+		XBOX::XboxDAQChannel ch = createTestChannel(kPSI, nsamples, 1, 0, 0);
+		XBOX::XboxDAQChannel chPrev = createTestChannel(kPSI, nsamples, 1, 3, 0);
+		XBOX::XboxDAQChannel chBD = createTestChannel(kPSI, nsamples, 1, 0, 2000);
+
+		Double_t w = 1. / (nsamples - 1);
+		XBOX::XboxAnalyserEvalRisingEdge evalEdge(nWmin * w, nWmax * w, 0.6, nProx * w);
+		XBOX::XboxAnalyserEvalJitter evalJitter;
+		evalJitter.config(nWmin * w, nWmax * w, 0.5, 100 * w);
+		XBOX::XboxAnalyserEvalDeviation evalDev;
+		evalDev.config(nWmin * w, nWmax * w, 0.1, 0.02, nProx * w);
+
+		Double_t res[3];
+		Double_t elapsed[3];
+
+		auto start = std::chrono::steady_clock::now();
+		for (Int_t irep=0; irep<nrep; irep++)
+			res[0] = evalEdge(ch);
+		auto stop = std::chrono::steady_clock::now();
+		elapsed[0] = std::chrono::duration<Double_t>(stop - start).count() / nrep * 1e6;
+
+		start = std::chrono::steady_clock::now();
+		for (Int_t irep=0; irep<nrep; irep++)
+			res[1] = evalJitter(chPrev, ch);
+		stop = std::chrono::steady_clock::now();
+		elapsed[1] = std::chrono::duration<Double_t>(stop - start).count() / nrep * 1e6;
+
+		start = std::chrono::steady_clock::now();
+		for (Int_t irep=0; irep<nrep; irep++)
+			res[2] = evalDev(chBD, ch, 0.);
+		stop = std::chrono::steady_clock::now();
+		elapsed[2] = std::chrono::duration<Double_t>(stop - start).count() / nrep * 1e6;
+
+		printf("%10d %16.2f %16.2f %16.2f\n", nsamples, elapsed[0], elapsed[1], elapsed[2]);
+
+		// the results must not depend on the samples outside the windows
+		for (Int_t k=0; k<3; k++) {
+			if (nsamples == 5000)
+				tref[k] = res[k];
+			else if (fabs(res[k] - tref[k]) > 2 * kTestIncrement) {
+				printf("ERROR: Result %d depends on the trace length (%e vs %e)\n",
+						k, res[k], tref[k]);
+				status = EXIT_FAILURE;
+			}
+		}
+	}
+
+	printf("----------------------------------------------------\n");
+	printf("Rising edge: %e | Jitter: %e | Deviation: %e\n", tref[0], tref[1], tref[2]);
+
+	return status;
+}
@@ -0,0 +1,107 @@
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxReportQueue.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Number of evaluations selected by a policy.
+/// \param[in] policy The report policy.
+/// \param[in] results The results of the evaluations.
+Int_t countAccepted(const XBOX::XboxReportPolicy &policy, const std::vector<Double_t> &results) {
+
+	Int_t n = 0;
+	for (Double_t res: results)
+		n += policy.accept(res);
+	return n;
+}
+
+
+int main(int argc, char** argv) {
+
+	Int_t status = EXIT_SUCCESS;
+
+	// sampling policies ...............................................
+	std::vector<Double_t> results(100);
+	for (Int_t i=0; i<100; i++)
+		results[i] = (i % 25 == 0) ? -1. : 1e-6 + (i % 10) * 1e-8;
+
+	XBOX::XboxReportPolicy policy;
+	Int_t nall = countAccepted(policy, results);
+	policy.setSampling(XBOX::XboxReportPolicy::kSampleEveryNth, 10);
+	Int_t nnth = countAccepted(policy, results);
+	policy.setSampling(XBOX::XboxReportPolicy::kSampleFailures);
+	Int_t nfail = countAccepted(policy, results);
+	policy.setSampling(XBOX::XboxReportPolicy::kSampleOutliers);
+	policy.setOutlierRange(1e-6, 1.075e-6);
+	Int_t nout = countAccepted(policy, results);
+
+	printf("----------------------------------------------------\n");
+	printf("Selected: %d (all) | %d (every 10th) | %d (failures) | %d (outliers)\n",
+			nall, nnth, nfail, nout);
+
+	// 4 failures and the results 1.08e-6 and 1.09e-6 in each ten
+	if (nall != 100 || nnth != 10 || nfail != 4 || nout != 4 + 20) {
+		printf("ERROR: Unexpected selection of the report policies\n");
+		status = EXIT_FAILURE;
+	}
+
+	// background rendering with a bounded queue .......................
+	const Int_t nrecords = 40;
+	const Int_t trender = 5; // rendering time in ms
+
+	XBOX::XboxReportQueue &queue = XBOX::XboxReportQueue::instance();
+	queue.setCapacity(8);
+
+	std::atomic<Int_t> nrendered(0);
+	XBOX::XboxReportPolicy async;
+	async.setAsync(true);
+
+	auto start = std::chrono::steady_clock::now();
+	for (Int_t i=0; i<nrecords; i++) {
+		XBOX::XboxReportRecord rec;
+		rec.fResults.push_back(i);
+		rec.fRender = [&nrendered, trender](XBOX::XboxReportRecord &rec) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(trender));
+			nrendered++;
+		};
+		async.submit(std::move(rec));
+	}
+	auto stop = std::chrono::steady_clock::now();
+	Double_t tsubmit = std::chrono::duration<Double_t>(stop - start).count();
+
+	queue.flush();
+
+	printf("Submitted: %d records in %.3f ms | Rendered: %d | Dropped: %llu\n",
+			nrecords, tsubmit * 1e3, (Int_t) nrendered,
+			(unsigned long long) queue.getNDropped());
+
+	if (queue.getNRendered() + queue.getNDropped() != (ULong64_t) nrecords
+			|| nrendered != (Int_t) queue.getNRendered()) {
+		printf("ERROR: Records got lost in the report queue\n");
+		status = EXIT_FAILURE;
+	}
+	if (tsubmit * 1e3 > 0.5 * nrecords * trender) {
+		printf("ERROR: The submission waits for the rendering\n");
+		status = EXIT_FAILURE;
+	}
+
+	// synchronous rendering (default) .................................
+	XBOX::XboxReportPolicy sync;
+	Int_t nsync = 0;
+	XBOX::XboxReportRecord rec;
+	rec.fRender = [&nsync](XBOX::XboxReportRecord &rec) { nsync++; };
+	sync.submit(std::move(rec));
+	if (sync.isAsync() || nsync != 1) {
+		printf("ERROR: Synchronous report not rendered\n");
+		status = EXIT_FAILURE;
+	}
+
+	return status;
+}
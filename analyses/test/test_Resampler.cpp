@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxCubicSpline.hxx"
+#include "XboxResampler.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Reference re-sampling.
+/// Constructs a cubic spline through the nodes and evaluates it point
+/// by point. Points outside the nodes take the value of the nearest node.
+std::vector<Double_t> refResample(const std::vector<Double_t> &x,
+		const std::vector<Double_t> &y, const std::vector<Double_t> &xs) {
+
+	XBOX::CubicSpline s(x, y);
+	std::vector<Double_t> ys(xs.size());
+	for (size_t i=0; i<xs.size(); i++) {
+		if (xs[i] <= x.front())
+			ys[i] = s(x.front());
+		else if (xs[i] >= x.back())
+			ys[i] = s(x.back());
+		else
+			ys[i] = s(xs[i]);
+	}
+	return ys;
+}
+
+
+int main(int argc, char** argv) {
+
+	const Double_t tol = 1e-10; // deviation relative to the magnitude of the signal
+	const Double_t x0 = 1.5e-6; // time axis similar to the DAQ channels
+	const Double_t h = 1.25e-9;
+
+	// accuracy compared to the cubic spline
+	Int_t status = EXIT_SUCCESS;
+	Double_t dev = 0.;
+	srand(1);
+	for (Int_t itrial=0; itrial<200; itrial++) {
+
+		Int_t n = 3 + rand() % 2000;
+		Int_t ns = 1 + rand() % 1000;
+
+		std::vector<Double_t> x(n);
+		std::vector<Double_t> y(n);
+		for (Int_t i=0; i<n; i++) {
+			x[i] = x0 + i * h;
+			y[i] = sin(0.05 * i) + (rand() % 1000 - 500.) / 5000.;
+		}
+
+		// points in random order including some outside the nodes
+		std::vector<Double_t> xs(ns);
+		for (Double_t &val: xs)
+			val = x0 + (rand() % 10000 / 9000. - 0.05) * (n - 1) * h;
+
+		std::vector<Double_t> ref = refResample(x, y, xs);
+		std::vector<Double_t> res;
+		XBOX::XboxResampler resampler(x0, h, n, xs);
+		resampler.apply(res, y);
+
+		if (res.size() != ref.size()) {
+			printf("ERROR: Wrong length of the re-sampled signal (n=%d, ns=%d)\n", n, ns);
+			return EXIT_FAILURE;
+		}
+		for (size_t i=0; i<ref.size(); i++)
+			dev = std::max(dev, fabs(res[i] - ref[i]) / 1.2);
+	}
+
+	// few nodes (linear and constant interpolation)
+	std::vector<Double_t> res;
+	XBOX::XboxResampler(x0, h, 2, {x0 - h, x0 + 0.25 * h, x0 + 2 * h}).apply(res, {1., 3.});
+	if (res.size() != 3 || res[0] != 1. || fabs(res[1] - 1.5) > tol || res[2] != 3.) {
+		printf("ERROR: Wrong linear interpolation between two nodes\n");
+		status = EXIT_FAILURE;
+	}
+	XBOX::XboxResampler(x0, h, 1, {x0 - h, x0 + h}).apply(res, {2.});
+	if (res.size() != 2 || res[0] != 2. || res[1] != 2.) {
+		printf("ERROR: Wrong interpolation of a single node\n");
+		status = EXIT_FAILURE;
+	}
+
+	printf("----------------------------------------------------\n");
+	printf("Maximum relative deviation: %.3e\n", dev);
+	if (dev > tol) {
+		printf("ERROR: Deviation of the re-sampled signal exceeds the tolerance\n");
+		status = EXIT_FAILURE;
+	}
+
+	// execution time of the spline and the re-sampling engine
+	printf("----------------------------------------------------\n");
+	printf("%8s %8s %12s %12s %12s\n", "nodes", "samples", "spline [us]", "grid [us]", "apply [us]");
+	for (Int_t n: {800, 8000}) {
+		std::vector<Double_t> x(n);
+		std::vector<Double_t> y(n);
+		for (Int_t i=0; i<n; i++) {
+			x[i] = x0 + i * h;
+			y[i] = sin(0.05 * i);
+		}
+
+		for (Int_t ns: {100, 1000, 10000}) {
+			std::vector<Double_t> xs(ns);
+			for (Int_t i=0; i<ns; i++)
+				xs[i] = x0 + (i + 0.5) * (n - 1) * h / ns;
+
+			Int_t nrep = 2000000 / (n + ns) + 10;
+			Double_t elapsed[3];
+
+			auto start = std::chrono::steady_clock::now();
+			for (Int_t irep=0; irep<nrep; irep++)
+				refResample(x, y, xs);
+			auto stop = std::chrono::steady_clock::now();
+			elapsed[0] = std::chrono::duration<Double_t>(stop - start).count() / nrep * 1e6;
+
+			XBOX::XboxResampler resampler;
+			start = std::chrono::steady_clock::now();
+			for (Int_t irep=0; irep<nrep; irep++)
+				resampler.setGrid(x0, h, n, xs);
+			stop = std::chrono::steady_clock::now();
+			elapsed[1] = std::chrono::duration<Double_t>(stop - start).count() / nrep * 1e6;
+
+			start = std::chrono::steady_clock::now();
+			for (Int_t irep=0; irep<nrep; irep++)
+				resampler.apply(res, y);
+			stop = std::chrono::steady_clock::now();
+			elapsed[2] = std::chrono::duration<Double_t>(stop - start).count() / nrep * 1e6;
+
+			printf("%8d %8d %12.2f %12.2f %12.2f\n", n, ns, elapsed[0], elapsed[1], elapsed[2]);
+		}
+	}
+
+	return status;
+}
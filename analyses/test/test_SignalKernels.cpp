@@ -0,0 +1,176 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxSignalKernels.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Reference threshold crossing (sample by sample).
+Int_t refFirstCrossing(const std::vector<Double_t> &y, Int_t i0, Int_t i1, Double_t level) {
+
+	for (Int_t i=i0+1; i<i1; i++) {
+		if ((y[i] < level) != (y[i0] < level))
+			return i;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reference run of samples above the level (window by window, O(n*k)).
+Int_t refFirstRun(const std::vector<Double_t> &y, Int_t i0, Int_t i1, Double_t level, Int_t k) {
+
+	for (Int_t i=i0; i+k<=i1; i++) {
+		Int_t nw = 0;
+		for (Int_t j=0; j<k; j++) {
+			if (fabs(y[i+j]) > level)
+				nw++;
+		}
+		if (nw == k)
+			return i;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reference run of samples below the level scanned backward.
+Int_t refLastRun(const std::vector<Double_t> &y, Int_t i0, Int_t i1, Double_t level, Int_t k) {
+
+	for (Int_t i=i1-1; i-k+1>=i0; i--) {
+		Int_t nw = 0;
+		for (Int_t j=0; j<k; j++) {
+			if (fabs(y[i-j]) < level)
+				nw++;
+		}
+		if (nw == k)
+			return i;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reference root search.
+Int_t refNextRoot(const std::vector<Double_t> &y, Int_t i0, Int_t i1, Bool_t rising) {
+
+	for (Int_t i=i0; i<i1-1; i++) {
+		if (rising && y[i] < 0 && y[i+1] > 0)
+			return i;
+		if (!rising && y[i] > 0 && y[i+1] < 0)
+			return i;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reference argument of the maximum.
+Int_t refArgMax(const std::vector<Double_t> &y, Int_t i0, Int_t i1) {
+
+	Int_t imax = i0;
+	for (Int_t i=i0; i<i1; i++) {
+		if (y[i] > y[imax])
+			imax = i;
+	}
+	return imax;
+}
+
+
+int main(int argc, char** argv) {
+
+	Int_t status = EXIT_SUCCESS;
+	Int_t nerr = 0;
+
+	// agreement with the references on random signals and ranges
+	srand(1);
+	for (Int_t itrial=0; itrial<2000; itrial++) {
+
+		Int_t n = 2 + rand() % 300;
+		std::vector<Double_t> y(n);
+		for (Double_t &val: y)
+			val = (rand() % 200 - 100) / 10.;
+
+		Int_t i0 = rand() % n;
+		Int_t i1 = i0 + 1 + rand() % (n - i0);
+		Double_t level = (rand() % 200 - 100) / 10. + 0.05;
+		Int_t k = 1 + rand() % 8;
+		Bool_t rising = rand() % 2;
+
+		nerr += XBOX::firstCrossing(y.data(), i0, i1, level) != refFirstCrossing(y, i0, i1, level);
+		nerr += XBOX::firstRun(y.data(), i0, i1, fabs(level), k, true, true) !=
+				refFirstRun(y, i0, i1, fabs(level), k);
+		nerr += XBOX::lastRun(y.data(), i0, i1, fabs(level), k, false, true) !=
+				refLastRun(y, i0, i1, fabs(level), k);
+		nerr += XBOX::nextRoot(y.data(), i0, i1, rising) != refNextRoot(y, i0, i1, rising);
+		nerr += XBOX::argMax(y.data(), i0, i1) != refArgMax(y, i0, i1);
+
+		// the last crossing is the first one of the reversed range
+		std::vector<Double_t> yr(y.rbegin(), y.rend());
+		Int_t ilast = XBOX::lastCrossing(y.data(), i0, i1, level);
+		Int_t iref = refFirstCrossing(yr, n - i1, n - i0, level);
+		nerr += ilast != (iref < 0 ? -1 : n - 1 - iref);
+	}
+
+	// integer samples as stored in the raw data of the channels
+	std::vector<Short_t> raw = {-5, -3, -1, 2, 4, 7, 3, -2};
+	nerr += XBOX::firstCrossing(raw.data(), 0, raw.size(), 0.) != 3;
+	nerr += XBOX::lastCrossing(raw.data(), 0, raw.size(), 0.) != 6;
+	nerr += XBOX::argMax(raw.data(), 0, raw.size()) != 5;
+	nerr += XBOX::argMax(raw.data(), 0, 0) != -1;
+
+	printf("----------------------------------------------------\n");
+	printf("Deviations from the reference: %d\n", nerr);
+	if (nerr) {
+		printf("ERROR: Signal kernels do not agree with the reference\n");
+		status = EXIT_FAILURE;
+	}
+
+	// execution time of the windowed search and the run kernel
+	printf("----------------------------------------------------\n");
+	printf("%10s %6s %16s %16s %16s\n", "samples", "window", "reference [us]", "run [us]", "crossing [us]");
+	for (Int_t n: {10000, 100000}) {
+
+		// noise below the threshold followed by the pulse
+		std::vector<Double_t> y(n);
+		for (Int_t i=0; i<n; i++)
+			y[i] = i < n - 100 ? (rand() % 100) / 100. * (i % 7 ? 0.5 : 1.5) : 2.;
+
+		for (Int_t k: {10, 100}) {
+
+			Int_t nrep = 20000000 / (n * k) + 10;
+			Int_t res[3];
+			Double_t elapsed[3];
+
+			auto start = std::chrono::steady_clock::now();
+			for (Int_t irep=0; irep<nrep; irep++)
+				res[0] = refFirstRun(y, 0, n, 1., k);
+			auto stop = std::chrono::steady_clock::now();
+			elapsed[0] = std::chrono::duration<Double_t>(stop - start).count() / nrep * 1e6;
+
+			nrep = 20000000 / n + 10;
+			start = std::chrono::steady_clock::now();
+			for (Int_t irep=0; irep<nrep; irep++)
+				res[1] = XBOX::firstRun(y.data(), 0, n, 1., k, true, true);
+			stop = std::chrono::steady_clock::now();
+			elapsed[1] = std::chrono::duration<Double_t>(stop - start).count() / nrep * 1e6;
+
+			start = std::chrono::steady_clock::now();
+			for (Int_t irep=0; irep<nrep; irep++)
+				res[2] = XBOX::firstCrossing(y.data(), 0, n, 1.75);
+			stop = std::chrono::steady_clock::now();
+			elapsed[2] = std::chrono::duration<Double_t>(stop - start).count() / nrep * 1e6;
+
+			printf("%10d %6d %16.2f %16.2f %16.2f\n", n, k, elapsed[0], elapsed[1], elapsed[2]);
+
+			if (res[0] != res[1] || res[2] != n - 100) {
+				printf("ERROR: Wrong position of the pulse\n");
+				status = EXIT_FAILURE;
+			}
+		}
+	}
+
+	return status;
+}
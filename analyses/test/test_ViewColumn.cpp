@@ -0,0 +1,127 @@
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <vector>
+
+// root
+#include "Rtypes.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TTimeStamp.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxAnalyserViewColumn.hxx"
+#include "XboxTestChannel.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Synthetic channel.
+/// \param[in] i The number of the event.
+/// \param[in] nbytes The size of the raw data.
+XBOX::XboxDAQChannel createChannel(Int_t i, size_t nbytes) {
+
+	std::vector<Byte_t> raw(nbytes);
+	for (size_t k=0; k<nbytes; k++)
+		raw[k] = (Byte_t) (i + k);
+
+	XBOX::XboxDAQChannel ch = createRawChannel("PSI_amp", raw);
+	ch.setXboxVersion(3);
+	ch.setTimeStamp(TTimeStamp((time_t) (1500000000 + 60 * i), 1000 * i));
+	ch.setPulseCount(1000ULL * i);
+	ch.setBreakdownFlag(i % 7 == 0);
+	ch.setXmin(1e-6 + 1e-9 * (i % 10));
+	ch.setXmax(1.2e-6 + 1e-9 * (i % 13));
+	ch.setYmean(4e7 + 1e3 * i);
+
+	return ch;
+}
+
+
+int main(int argc, char** argv) {
+
+	std::vector<std::string> filepaths = {"test_ViewColumn0.root", "test_ViewColumn1.root"};
+	const Int_t nevents = 2000;
+	const Int_t nfile = nevents / 2; // events per file
+	const size_t nbytes = 20000;
+
+	Int_t status = EXIT_SUCCESS;
+
+	// split (default) and unsplit channel branches in two files .........
+	for (Int_t j=0; j<2; j++) {
+		TFile file(filepaths[j].c_str(), "RECREATE");
+		TTree tree("Events", "Events");
+		XBOX::XboxDAQChannel ch;
+		XBOX::XboxDAQChannel *pch = &ch;
+		tree.Branch("PSI_amp", &pch, 32000, 99);
+		tree.Branch("PSR_amp", &pch, 32000, 0);
+		for (Int_t i=j*nfile; i<(j+1)*nfile; i++) {
+			ch = createChannel(i, nbytes);
+			tree.Fill();
+		}
+		tree.Write();
+	}
+
+	printf("----------------------------------------------------\n");
+	printf("%10s %12s %12s\n", "Column", "Read [ms]", "Events");
+
+	for (const char *colName: {"PSI_amp", "PSR_amp"}) {
+
+		XBOX::XboxAnalyserViewColumn col;
+		auto start = std::chrono::steady_clock::now();
+		Int_t res = col.read(filepaths, "Events", colName);
+		auto stop = std::chrono::steady_clock::now();
+		Double_t t = std::chrono::duration<Double_t>(stop - start).count();
+
+		printf("%10s %12.3f %12zu\n", colName, t * 1e3, col.size());
+
+		if (res || col.size() != (size_t) nevents || col.fXboxVersion != 3) {
+			printf("ERROR: Column %s not read\n", colName);
+			status = EXIT_FAILURE;
+			continue;
+		}
+
+		// meta data
+		Bool_t bmatch = true;
+		for (Int_t i=0; i<nevents; i++) {
+			XBOX::XboxDAQChannel ref = createChannel(i, 0);
+			bmatch &= col.fFile[i] == i / nfile;
+			bmatch &= col.fEntry[i] == i % nfile;
+			bmatch &= col.fTimeStamp[i] == ref.getTimeStamp();
+			bmatch &= col.fPulseCount[i] == ref.getPulseCount();
+			bmatch &= col.fBreakdownFlag[i] == ref.getBreakdownFlag();
+			bmatch &= col.fXmin[i] == ref.getXmin();
+			bmatch &= col.fXmax[i] == ref.getXmax();
+			bmatch &= col.fYmean[i] == ref.getYmean();
+		}
+		if (!bmatch) {
+			printf("ERROR: Meta data of column %s differ\n", colName);
+			status = EXIT_FAILURE;
+		}
+
+		// waveform on demand from its file, also after reordering the events
+		std::vector<size_t> order(nevents);
+		for (Int_t i=0; i<nevents; i++)
+			order[i] = nevents - 1 - i;
+		col.permute(order);
+
+		XBOX::XboxDAQChannel ch;
+		XBOX::XboxDAQChannel ref = createChannel(nevents - 1 - 42, nbytes);
+		XBOX::XboxDAQChannel ch2;
+		if (col.readChannel(42, ch) || ch.getPulseCount() != ref.getPulseCount()
+				|| ch.getRawData() != ref.getRawData()) {
+			printf("ERROR: Waveform of column %s not read on demand\n", colName);
+			status = EXIT_FAILURE;
+		}
+		if (col.readChannel(nevents, ch2) != -1) {
+			printf("ERROR: Event out of range read\n");
+			status = EXIT_FAILURE;
+		}
+	}
+
+	for (auto &s: filepaths)
+		remove(s.c_str());
+
+	return status;
+}
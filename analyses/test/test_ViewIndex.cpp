@@ -0,0 +1,168 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "Rtypes.h"
+#include "TTimeStamp.h"
+
+// xbox
+#include "XboxAnalyserViewIndex.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Synthetic events.
+/// Time stamps and pulse counts of events in the order a multi-threaded
+/// RDataFrame returns them (sorted in chunks, chunks shuffled).
+/// \param[in] n The number of events.
+void createEvents(size_t n, std::vector<TTimeStamp> &time, std::vector<ULong64_t> &pcnt) {
+
+	std::mt19937_64 gen(12345);
+	std::exponential_distribution<Double_t> dist(1. / 30.); // mean seconds between events
+
+	time.resize(n);
+	pcnt.resize(n);
+	Double_t t = 1.5e9;
+	for (size_t i=0; i<n; i++) {
+		t += dist(gen);
+		time[i] = TTimeStamp((time_t) t, (Int_t) ((t - floor(t)) * 1e9));
+		pcnt[i] = (ULong64_t) ((t - 1.5e9) * 50.); // 50 Hz repetition rate
+	}
+
+	const size_t nchunk = 1000;
+	std::vector<size_t> chunks((n + nchunk - 1) / nchunk);
+	for (size_t i=0; i<chunks.size(); i++)
+		chunks[i] = i;
+	std::shuffle(chunks.begin(), chunks.end(), gen);
+
+	std::vector<TTimeStamp> time0(time);
+	std::vector<ULong64_t> pcnt0(pcnt);
+	size_t k = 0;
+	for (size_t c: chunks) {
+		for (size_t i=c*nchunk; i<std::min(n, (c+1)*nchunk); i++, k++) {
+			time[k] = time0[i];
+			pcnt[k] = pcnt0[i];
+		}
+	}
+}
+
+
+int main(int argc, char** argv) {
+
+	const size_t nqueries = 1000;
+
+	Int_t status = EXIT_SUCCESS;
+
+	printf("----------------------------------------------------\n");
+	printf("%10s %12s %14s %14s %10s\n", "Events", "Build [ms]", "Linear [ms]",
+			"Index [ms]", "Speedup");
+
+	for (size_t n: {1000, 10000, 100000}) {
+
+		std::vector<TTimeStamp> vTime;
+		std::vector<ULong64_t> vPCnt;
+		createEvents(n, vTime, vPCnt);
+
+		auto start = std::chrono::steady_clock::now();
+		XBOX::XboxAnalyserViewIndex index(vTime, vPCnt);
+		auto stop = std::chrono::steady_clock::now();
+		Double_t tbuild = std::chrono::duration<Double_t>(stop - start).count();
+
+		// queries of 1% of the events spread over the history (positions
+		// in the sorted order)
+		std::mt19937_64 gen(n);
+		std::uniform_int_distribution<size_t> dist(0, n-1);
+		std::vector<std::pair<size_t, size_t>> queries(nqueries);
+		for (auto &q: queries) {
+			q.first = dist(gen);
+			q.second = std::min(n-1, q.first + n / 100);
+		}
+
+		// linear scans (former selection)
+		Bool_t bmatch = true;
+		std::vector<std::vector<size_t>> sel1(nqueries), sel2(nqueries);
+		start = std::chrono::steady_clock::now();
+		for (size_t iq=0; iq<nqueries; iq++) {
+			ULong64_t pmin = index.getPCnt(queries[iq].first);
+			ULong64_t pmax = index.getPCnt(queries[iq].second);
+			for (size_t i=0; i<n; i++) {
+				if (vPCnt[i] >= pmin && vPCnt[i] <= pmax)
+					sel1[iq].push_back(i);
+			}
+		}
+		stop = std::chrono::steady_clock::now();
+		Double_t tlinear = std::chrono::duration<Double_t>(stop - start).count();
+
+		// binary search
+		start = std::chrono::steady_clock::now();
+		for (size_t iq=0; iq<nqueries; iq++)
+			sel2[iq] = index.selectPCnt(index.getPCnt(queries[iq].first),
+					index.getPCnt(queries[iq].second));
+		stop = std::chrono::steady_clock::now();
+		Double_t tindex = std::chrono::duration<Double_t>(stop - start).count();
+
+		printf("%10zu %12.3f %14.3f %14.3f %10.1f\n", n, tbuild * 1e3, tlinear * 1e3,
+				tindex * 1e3, tlinear / tindex);
+
+		// same events, selection in order of the pulse count
+		for (size_t iq=0; iq<nqueries; iq++) {
+			for (size_t k=1; k<sel2[iq].size(); k++)
+				bmatch &= vPCnt[sel2[iq][k-1]] <= vPCnt[sel2[iq][k]];
+			std::sort(sel2[iq].begin(), sel2[iq].end());
+			bmatch &= (sel1[iq] == sel2[iq]);
+		}
+
+		// time periods
+		for (size_t iq=0; iq<nqueries && bmatch; iq+=10) {
+			const TTimeStamp &begin = index.getTime(queries[iq].first);
+			const TTimeStamp &end = index.getTime(queries[iq].second);
+			std::vector<size_t> ref;
+			for (size_t i=0; i<n; i++) {
+				if (!(vTime[i] < begin) && !(end < vTime[i]))
+					ref.push_back(i);
+			}
+			std::vector<size_t> sel = index.selectTime(begin, end);
+			std::sort(sel.begin(), sel.end());
+			bmatch &= (ref == sel);
+		}
+
+		// nearest neighbours
+		for (size_t iq=0; iq<nqueries && bmatch; iq+=10) {
+			ULong64_t pcnt = vPCnt[queries[iq].first] + 7;
+			size_t ref = 0;
+			for (size_t i=1; i<n; i++) {
+				ULong64_t d0 = std::max(vPCnt[ref], pcnt) - std::min(vPCnt[ref], pcnt);
+				ULong64_t d1 = std::max(vPCnt[i], pcnt) - std::min(vPCnt[i], pcnt);
+				if (d1 < d0 || (d1 == d0 && vPCnt[i] < vPCnt[ref]))
+					ref = i;
+			}
+			Long64_t idx = index.nearestPCnt(pcnt);
+			bmatch &= (idx >= 0 && vPCnt[idx] == vPCnt[ref]);
+
+			TTimeStamp t(vTime[queries[iq].first].GetSec() + 1, 0);
+			Long64_t idxTime = index.nearestTime(t);
+			Double_t dmin = 1e99;
+			for (size_t i=0; i<n; i++)
+				dmin = std::min(dmin, fabs(vTime[i].AsDouble() - t.AsDouble()));
+			bmatch &= (idxTime >= 0 && fabs(vTime[idxTime].AsDouble() - t.AsDouble()) <= dmin);
+		}
+
+		if (!bmatch) {
+			printf("ERROR: Selection differs from the linear search\n");
+			status = EXIT_FAILURE;
+		}
+	}
+
+	// empty index
+	XBOX::XboxAnalyserViewIndex empty;
+	if (empty.nearestTime(TTimeStamp((time_t) 0, 0)) != -1 || empty.nearestPCnt(0) != -1
+			|| !empty.selectPCnt(0, 100).empty()) {
+		printf("ERROR: Unexpected result of an empty index\n");
+		status = EXIT_FAILURE;
+	}
+
+	return status;
+}
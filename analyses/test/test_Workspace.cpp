@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <new>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxAnalyserEvalRisingEdge.hxx"
+#include "XboxAnalyserEvalJitter.hxx"
+#include "XboxAnalyserEvalDeviation.hxx"
+
+#include "XboxTestSignal.hxx"
+
+
+const Int_t nSamples = 5000;
+
+// number of heap allocations of the process
+static ULong64_t gNAllocations = 0;
+
+void* operator new(size_t size) {
+
+	gNAllocations++;
+	void *ptr = malloc(size ? size : 1);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+	free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	free(ptr);
+}
+
+
+int main(int argc, char** argv) {
+
+	const Int_t nevents = 200;
+	const Int_t nwarmup = 20;
+
+	Int_t status = EXIT_SUCCESS;
+
+	std::vector<XBOX::XboxDAQChannel> b0(nevents);
+	std::vector<XBOX::XboxDAQChannel> b1(nevents);
+	for (Int_t i=0; i<nevents; i++) {
+		b0[i] = createTestChannel(kPSI, nSamples, 2 * i + 1, i % 5, 1500 + 3 * i);
+		b1[i] = createTestChannel(kPSI, nSamples, 2 * i + 2, i % 7, 0);
+	}
+
+	XBOX::XboxAnalyserEvalRisingEdge evalEdge(0.1, 0.8, 0.6, 0.04);
+	XBOX::XboxAnalyserEvalJitter evalJitter;
+	evalJitter.config(0.1, 0.8, 0.5, 0.02);
+	XBOX::XboxAnalyserEvalDeviation evalDev;
+	evalDev.config(0.1, 0.8, 0.1, 0.02, 0.04);
+
+	evalEdge.setNSlots(1);
+	evalJitter.setNSlots(1);
+	evalDev.setNSlots(1);
+
+	// the first events set up the workspaces and the filter plans
+	Double_t sum = 0.;
+	ULong64_t nalloc0 = gNAllocations;
+	auto start = std::chrono::steady_clock::now();
+	for (Int_t i=0; i<nwarmup; i++) {
+		Double_t jitter = evalJitter.evalSlot(0, b0[i], b1[i]);
+		sum += evalEdge.evalSlot(0, b1[i]) + jitter + evalDev.evalSlot(0, b0[i], b1[i], jitter);
+		sum += evalEdge(b1[i]) + evalJitter(b0[i], b1[i]) + evalDev(b0[i], b1[i], jitter);
+	}
+	auto stop = std::chrono::steady_clock::now();
+	Double_t twarmup = std::chrono::duration<Double_t>(stop - start).count() / nwarmup;
+	ULong64_t nalloc1 = gNAllocations;
+
+	ULong64_t nws = evalEdge.getNAllocations() + evalJitter.getNAllocations()
+			+ evalDev.getNAllocations();
+
+	// steady state: no heap allocation at all
+	start = std::chrono::steady_clock::now();
+	for (Int_t i=nwarmup; i<nevents; i++) {
+		Double_t jitter = evalJitter.evalSlot(0, b0[i], b1[i]);
+		sum += evalEdge.evalSlot(0, b1[i]) + jitter + evalDev.evalSlot(0, b0[i], b1[i], jitter);
+		sum += evalEdge(b1[i]) + evalJitter(b0[i], b1[i]) + evalDev(b0[i], b1[i], jitter);
+	}
+	stop = std::chrono::steady_clock::now();
+	Double_t tsteady = std::chrono::duration<Double_t>(stop - start).count() / (nevents - nwarmup);
+	ULong64_t nalloc2 = gNAllocations;
+
+	ULong64_t nwsSteady = evalEdge.getNAllocations() + evalJitter.getNAllocations()
+			+ evalDev.getNAllocations() - nws;
+
+	printf("----------------------------------------------------\n");
+	printf("Events: %d | Sum: %e\n", nevents, sum);
+	printf("Warm-up: %llu allocations | %.1f us per event\n",
+			(unsigned long long) (nalloc1 - nalloc0), twarmup * 1e6);
+	printf("Steady state: %llu allocations (workspace: %llu) | %.1f us per event\n",
+			(unsigned long long) (nalloc2 - nalloc1), (unsigned long long) nwsSteady,
+			tsteady * 1e6);
+
+	if (nalloc2 != nalloc1 || nwsSteady) {
+		printf("ERROR: Evaluation allocates memory in the steady state\n");
+		status = EXIT_FAILURE;
+	}
+
+	return status;
+}
@@ -93,13 +93,13 @@ QXboxFileConverter::QXboxFileConverter(QWidget *parent)
 	fFormatHDF5Rdp->setEnabled(false); // disable HDF5 functionality
 	fSplitChk = new QCheckBox("Split", this);
 	fSplitChk->setCheckState(Qt::Checked);
-//	fAppendChk = new QCheckBox("Append", this);
-//	fAppendChk->setCheckState(Qt::Unchecked);
+	fAppendChk = new QCheckBox("Append", this);
+	fAppendChk->setCheckState(Qt::Unchecked);
 
 	hbox_format->addWidget(fFormatROOTRdp, 0, Qt::AlignLeft);
 	hbox_format->addWidget(fFormatHDF5Rdp, 1);
 	hbox_format->addWidget(fSplitChk, 0, Qt::AlignRight);
-//	hbox_format->addWidget(fAppendChk, 0, Qt::AlignRight);
+	hbox_format->addWidget(fAppendChk, 0, Qt::AlignRight);
 	vbox->addLayout(hbox_format);
 
 	fOutputFileEdt = new QLineEdit(this);
@@ -283,6 +283,9 @@ void QXboxFileConverter::onConvert() {
 	QString targetPrefix = QFileInfo(fOutputFileEdt->text()).completeBaseName();
 	QDate date = fDateBeginDtp->date();
 
+	// append only events which have not yet been converted
+	const Char_t *mode = (fAppendChk->checkState() == Qt::Checked) ? "UPDATE" : "RECREATE";
+
 	fConvertBtn->setEnabled(false);
 
 	if (fSplitChk->checkState() == Qt::Checked) {
@@ -299,7 +302,7 @@ void QXboxFileConverter::onConvert() {
 
 			QString targetFilePath = targetDir.filePath(
 					targetPrefix + "_" + date.toString("yyyyMMdd") + ".root");
-			converter.write(targetFilePath.toStdString(), "RECREATE");
+			converter.write(targetFilePath.toStdString(), mode);
 
 			date = date.addDays(1);
 		}
@@ -319,7 +322,7 @@ void QXboxFileConverter::onConvert() {
 			date = date.addDays(1);
 		}
 		QString targetFilePath = targetDir.filePath(targetPrefix + ".root");
-		converter.write(targetFilePath.toStdString(), "RECREATE");
+		converter.write(targetFilePath.toStdString(), mode);
 	}
 
 	info = "DONE\n";
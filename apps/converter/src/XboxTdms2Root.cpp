@@ -1,5 +1,6 @@
 #include <iostream>
 #include <ctime>
+#include <cstdlib>
 
 #include "XboxFileConverter.hxx"
 
@@ -14,8 +15,18 @@ void replaceExt(std::string& s, const std::string& newExt) {
 
 int main(int argc, char* argv[]) {
 
-	if (argc != 2) {
-		printf("Usage: xboxtdms2root file\n");
+	// optional update flag: append only new events to an existing output file
+	const Char_t *mode = "RECREATE";
+	if (argc > 1 && std::string(argv[1]) == "-u") {
+		mode = "UPDATE";
+		argc--;
+		argv++;
+	}
+
+	if (argc < 2 || argc > 3) {
+		printf("Usage: xboxtdms2root [-u] file [depth]\n");
+		printf("  -u:    update an existing output file with new events only\n");
+		printf("  depth: number of events stored before a breakdown (default 1)\n");
 		return 1;
 	}
 
@@ -24,9 +35,11 @@ int main(int argc, char* argv[]) {
 
 	XBOX::XboxFileConverter converter;
 	converter.addFile(filepath);
+	if (argc == 3)
+		converter.setHistoryDepth(atoi(argv[2]));
 
 	replaceExt(filepath, "root");
-	converter.write(filepath);
+	converter.write(filepath, mode);
 	clock_t end = clock();
 
 	printf("Total elapsed time: %.3f\n", double(end - begin) / CLOCKS_PER_SEC);
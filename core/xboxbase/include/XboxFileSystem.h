@@ -7,12 +7,15 @@
 #include <fstream>
 #include <iostream>
 #include <ctime>
+#include <vector>
+#include <algorithm>
 
 #include "Rtypes.h"
 #include "TCollection.h"
 #include "TRegexp.h"
 #include "TSystemFile.h"
 #include "TSystemDirectory.h"
+#include "TString.h"
 
 #ifndef XBOX_NO_NAMESPACE
 namespace XBOX {
@@ -76,6 +79,98 @@ inline std::vector<std::string> getListOfFiles(const std::string &filePathGlob)
     return vListOfFiles;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Hash operation.
+/// FNV-1a hash of a byte sequence.
+/// \param[in] data The byte sequence.
+/// \param[in] size The number of bytes.
+/// \param[in] seed The initial hash value to chain several sequences.
+inline ULong64_t hashBytes(const Char_t *data, size_t size,
+        ULong64_t seed=14695981039346656037ULL) {
+    ULong64_t hash = seed;
+    for (size_t i=0; i<size; i++) {
+        hash ^= (UChar_t)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hash operation.
+/// FNV-1a hash of a string, e.g. of a configuration.
+inline ULong64_t hashString(const std::string &str,
+        ULong64_t seed=14695981039346656037ULL) {
+    return hashBytes(str.data(), str.size(), seed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// File operation.
+/// Get a content fingerprint of a file. The fingerprint is based on the file
+/// identity (inode and modification time), the file size and a hash over a
+/// fixed number of blocks sampled evenly over the file (including the first
+/// and the last block). Hence, its cost does not scale with the file size,
+/// while an edit outside the sampled blocks still changes the modification
+/// time. With nblocks <= 0 the whole content is hashed instead, e.g. for
+/// files copied without preserving their modification time.
+/// \param[in] name The file path.
+/// \param[in] nblocks The number of sampled blocks (<= 0: whole content).
+/// \param[in] blocksize The size of a sampled block in bytes.
+/// \return The fingerprint or 0 if the file is not accessible.
+inline ULong64_t getFileFingerprint(const std::string &name,
+        Int_t nblocks=16, Int_t blocksize=4096) {
+
+    struct stat st;
+    if (stat(name.c_str(), &st) != 0)
+        return 0;
+
+    std::ifstream file(name.c_str(), std::ios::binary);
+    if (!file.good())
+        return 0;
+
+    ULong64_t size = st.st_size;
+    ULong64_t hash = hashBytes((const Char_t*)&size, sizeof(size));
+
+    std::vector<Char_t> buffer(blocksize);
+
+    // whole content
+    if (nblocks <= 0) {
+        while (file.read(buffer.data(), blocksize) || file.gcount() > 0)
+            hash = hashBytes(buffer.data(), file.gcount(), hash);
+        return hash;
+    }
+
+    // file identity
+#ifdef __APPLE__
+    Long64_t mtime[] = {(Long64_t)st.st_mtimespec.tv_sec, (Long64_t)st.st_mtimespec.tv_nsec};
+#else
+    Long64_t mtime[] = {(Long64_t)st.st_mtim.tv_sec, (Long64_t)st.st_mtim.tv_nsec};
+#endif
+    ULong64_t inode = st.st_ino;
+    hash = hashBytes((const Char_t*)mtime, sizeof(mtime), hash);
+    hash = hashBytes((const Char_t*)&inode, sizeof(inode), hash);
+
+    // sampled blocks
+    ULong64_t stride = (nblocks > 1 && size > (ULong64_t)blocksize)
+            ? (size - blocksize) / (nblocks - 1) : 0;
+    for (Int_t i=0; i<nblocks; i++) {
+        ULong64_t pos = i * stride;
+        file.clear();
+        file.seekg(pos, std::ios::beg);
+        file.read(buffer.data(), blocksize);
+        hash = hashBytes(buffer.data(), file.gcount(), hash);
+        if (!stride)
+            break;
+    }
+    return hash;
+}
+
+// cache operations (the cache key is stored in the ROOT file)
+std::string readCacheKey(const std::string &name);
+bool writeCacheKey(const std::string &name, const std::string &key);
+std::string getCacheKey(const std::vector<std::string> &inputs,
+        const std::string &config);
+bool isCachedFile(const std::string &name, const std::string &key);
+
 #ifndef XBOX_NO_NAMESPACE
 }
 #endif
@@ -0,0 +1,72 @@
+#include "XboxFileSystem.h"
+
+#include "TFile.h"
+#include "TNamed.h"
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cache operation.
+/// Read the cache key stored in a ROOT file.
+/// \param[in] name The file path.
+/// \return The cache key or an empty string if none is available.
+std::string readCacheKey(const std::string &name) {
+    if (!accessFile(name))
+        return "";
+
+    TFile file(name.c_str(), "READ");
+    if (file.IsZombie())
+        return "";
+
+    TNamed *obj = (TNamed*) file.Get("CacheKey");
+    std::string key = obj ? obj->GetTitle() : "";
+    delete obj;
+    return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cache operation.
+/// Store a cache key in a ROOT file. The key is used to decide whether the
+/// file is up to date with respect to its inputs and configuration.
+/// \param[in] name The file path.
+/// \param[in] key The cache key.
+bool writeCacheKey(const std::string &name, const std::string &key) {
+    TFile file(name.c_str(), "UPDATE");
+    if (file.IsZombie())
+        return false;
+
+    TNamed obj("CacheKey", key.c_str());
+    obj.Write(0, TObject::kOverwrite);
+    file.Close();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cache operation.
+/// Build a cache key from a list of input files and a configuration string.
+/// \param[in] inputs The input file paths.
+/// \param[in] config The configuration (converter or evaluator settings).
+std::string getCacheKey(const std::vector<std::string> &inputs,
+        const std::string &config) {
+    ULong64_t hash = hashString(config);
+    for (const std::string &input : inputs) {
+        ULong64_t fp = getFileFingerprint(input);
+        hash = hashBytes((const Char_t*)&fp, sizeof(fp), hash);
+    }
+    return TString::Format("%016llx", hash).Data();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cache operation.
+/// Check whether a ROOT file is up to date with respect to a cache key.
+/// Missing or stale files are reported as not up to date.
+bool isCachedFile(const std::string &name, const std::string &key) {
+    return !key.empty() && (readCacheKey(name) == key);
+}
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
@@ -0,0 +1,109 @@
+/*
+ * XboxChannelBatch.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef __XBOXCHANNELBATCH_HXX_
+#define __XBOXCHANNELBATCH_HXX_
+
+#include <vector>
+
+#include "Rtypes.h"
+#include "TTimeStamp.h"
+
+#include "XboxDAQChannel.hxx"
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Batch of events of one channel.
+/// The samples of K events are stored in a single samples x events
+/// matrix (sample-major, i.e. the values of all events at the same
+/// sample are contiguous) together with arrays of the event metadata
+/// (structure of arrays). Operations run over all events at once, so
+/// the inner loops run over contiguous memory and vectorise.
+/// All events of a batch share the number of samples, the increment
+/// and the calibration. Time windows refer to the time axis of the
+/// first event.
+/// The samples are stored uncalibrated. The batch operations require a
+/// calibrated batch (see calibrate()), after which no further events
+/// can be added.
+class XboxChannelBatch {
+
+private:
+	std::string           fChannelName;               ///<Channel name.
+	Int_t                 fNSamples;                  ///<Number of samples per event.
+	Int_t                 fNEvents;                   ///<Number of events.
+	Int_t                 fCapacity;                  ///<Allocated number of events (row stride).
+	Double_t              fIncrement;                 ///<Sample increment.
+
+	Int_t                 fScaleType;                 ///<Scale type of the calibration.
+	std::vector<Double_t> fScaleCoeffs;               ///<Scale coefficients of the calibration.
+	Bool_t                fCalibrated;                ///<Samples are calibrated.
+
+	std::vector<Double_t> fData;                      ///<Samples (fNSamples x fCapacity).
+
+	std::vector<TTimeStamp> fTimeStamp;               ///<Time stamps.
+	std::vector<ULong64_t> fPulseCount;               ///<Pulse counts.
+	std::vector<Int_t>    fLogType;                   ///<Log types.
+	std::vector<Int_t>    fBreakdownFlag;             ///<Breakdown flags.
+	std::vector<Double_t> fStartOffset;               ///<Start offsets of the time axes.
+
+	void                  grow(Int_t capacity);
+	Bool_t                checkCalibrated() const;
+	Int_t                 getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1) const;
+
+public:
+	XboxChannelBatch();
+	XboxChannelBatch(Int_t capacity);
+	~XboxChannelBatch();
+
+	void                  init();
+	void                  clear();
+	void                  reset();
+
+	Int_t                 add(XboxDAQChannel &ch);
+
+	Bool_t                isEmpty() const { return fNEvents == 0; }
+	Bool_t                isCalibrated() const { return fCalibrated; }
+	std::string           getChannelName() const { return fChannelName; }
+	Int_t                 getEvents() const { return fNEvents; }
+	Int_t                 getSamples() const { return fNSamples; }
+	Double_t              getIncrement() const { return fIncrement; }
+
+	Double_t              at(Int_t i, Int_t k) const { return fData[(size_t)i * fCapacity + k]; }
+	const Double_t*       row(Int_t i) const { return &fData[(size_t)i * fCapacity]; }
+	Int_t                 getSignal(std::vector<Double_t> &y, Int_t k) const;
+
+	const std::vector<TTimeStamp>& getTimeStamps() const { return fTimeStamp; }
+	const std::vector<ULong64_t>& getPulseCounts() const { return fPulseCount; }
+	const std::vector<Int_t>& getLogTypes() const { return fLogType; }
+	const std::vector<Int_t>& getBreakdownFlags() const { return fBreakdownFlag; }
+	const std::vector<Double_t>& getStartOffsets() const { return fStartOffset; }
+
+	// batch operations
+	void                  calibrate();
+	Int_t                 stats(std::vector<XboxDAQChannel::Stats_t> &res,
+			Double_t t0=-1, Double_t t1=-1, UInt_t mask=XboxDAQChannel::kStatAll) const;
+	Int_t                 crossing(std::vector<Double_t> &t, const std::vector<Double_t> &level,
+			Bool_t rising, Double_t t0=-1, Double_t t1=-1) const;
+	Int_t                 risingEdge(std::vector<Double_t> &t, Double_t threshold=0.9,
+			Double_t t0=-1, Double_t t1=-1) const;
+	Int_t                 fallingEdge(std::vector<Double_t> &t, Double_t threshold=0.9,
+			Double_t t0=-1, Double_t t1=-1) const;
+	Int_t                 averagePulse(std::vector<Double_t> &avg) const;
+	Int_t                 deviation(std::vector<Double_t> &dev, const std::vector<Double_t> &ref,
+			Double_t t0=-1, Double_t t1=-1) const;
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* __XBOXCHANNELBATCH_HXX_ */
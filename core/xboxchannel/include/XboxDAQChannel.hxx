@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <string>
 #include <vector>
+#include <utility>
 #include <map>
 #include <ctime>
 
@@ -35,6 +36,8 @@
 #include "TMap.h"
 
 #include "XboxDataType.hxx"
+#include "XboxDAQChannelDescriptor.hxx"
+#include "XboxDataSpan.hxx"
 
 #ifndef XBOX_NO_NAMESPACE
 namespace XBOX {
@@ -43,9 +46,40 @@ namespace XBOX {
 
 class XboxDAQChannel : public TObject  {
 
+public:
+	enum EStatistics {
+		kStatMin    = 1 << 0,                         ///<Minimum.
+		kStatMax    = 1 << 1,                         ///<Maximum.
+		kStatMagn   = 1 << 2,                         ///<Maximum of the absolute value.
+		kStatSum    = 1 << 3,                         ///<Sum.
+		kStatMean   = 1 << 4,                         ///<Mean value.
+		kStatStdDev = 1 << 5,                         ///<Standard deviation.
+		kStatInteg  = 1 << 6,                         ///<Integral.
+		kStatSpan   = 1 << 7,                         ///<Peak to peak value.
+		kStatAll    = (1 << 8) - 1
+	};                                                ///<Window statistics.
+
+	struct Stats_t {
+		Double_t          fMin;
+		Double_t          fMax;
+		Double_t          fMagn;
+		Double_t          fSum;
+		Double_t          fMean;
+		Double_t          fStdDev;
+		Double_t          fInteg;
+		Double_t          fSpan;
+		Int_t             fSamples;                   ///<Number of samples in the window.
+	};                                                ///<Results of the window statistics.
+
+	enum EPrecision {
+		kPrecDouble,                                  ///<Calibrated samples in double precision.
+		kPrecFloat,                                   ///<Calibrated samples in single precision.
+		kPrecRaw                                      ///<Raw integer samples (monotonic calibration only).
+	};                                                ///<Evaluation precision.
+
 protected:
 
-	std::string           fChannelName;               ///<NI_ChannelName
+	XboxDAQChannelDescriptorRef fDescriptor;          ///<Shared per-run meta data (name, units, calibration, data type)
 	Int_t                 fXboxVersion;               ///<Version of Xbox
 
 	TTimeStamp            fTimeStamp;                 ///<Timestamp // @suppress("Type cannot be resolved")
@@ -66,19 +100,12 @@ protected:
 	Double_t              fIncrement;                 ///<wf_increment
 	Int_t                 fNSamples;                   ///<wf_samples
 
-	std::string           fXLabel;                    ///<wf_xname;
-	std::string           fXUnit;                     ///<wf_xunit_string
-	std::string           fYUnit;                     ///<unit_string
-	std::string           fYUnitDescription;          ///<NI_UnitDescription
-
 	// Scale type: -1 - None, 0 - logarithmic, 1 - Polynomial
 	Int_t                 fScaleType;                 ///<Scale_Type
-	std::string           fScaleUnit;                 ///<Scale_Unit;
-	std::vector<Double_t> fScaleCoeffs;               ///<Scale_Coeffs;
 
-	XboxDataType          fDataType;                  ///<Data type
 	std::vector<Byte_t>   fRawData;                   ///<Raw Data
 	std::vector<Double_t> fData;                      ///<!Interpreted data
+	Int_t                 fDataOffset;                ///<!Index of the first interpreted sample
 
 	// analysis
 	Double_t              fXmin;                      ///<Marker of rising edge
@@ -94,13 +121,21 @@ protected:
 
 	Bool_t                fAutoRefresh;               ///<!automatic refresh before reading data
 	void                  viewData(vector<Double_t> &data);
-	Int_t                 getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1);
+	void                  interpret(Int_t i0, Int_t i1);
+	const Double_t*       viewWindow(Int_t i0, Int_t i1) const;
+	Double_t              edge(Double_t threshold, Double_t t0, Double_t t1,
+			Bool_t rising, EPrecision prec) const;
 
 public:
 	
 	XboxDAQChannel();
+	XboxDAQChannel(const XboxDAQChannel &other) = default;
+	XboxDAQChannel(XboxDAQChannel &&other) = default;  // moves the raw data
 	virtual ~XboxDAQChannel();
 
+	XboxDAQChannel&       operator=(const XboxDAQChannel &other) = default;
+	XboxDAQChannel&       operator=(XboxDAQChannel &&other) = default;
+
 	void                  init();
 	void                  clear();
 	void                  flushbuffer();
@@ -120,26 +155,48 @@ public:
 
 
 	std::vector<Double_t> getSignal(Double_t t0=-1, Double_t t1=-1);
-	std::vector<Double_t> getTimeAxis(Double_t t0=-1, Double_t t1=-1);
+	Int_t                 getSignal(std::vector<Double_t> &data, Double_t t0=-1, Double_t t1=-1) const;
+	Int_t                 getSignal(std::vector<Float_t> &data, Double_t t0=-1, Double_t t1=-1) const;
+	std::vector<Double_t> getTimeAxis(Double_t t0=-1, Double_t t1=-1) const;
 	void                  getTimeAxisBounds(Double_t &t0, Double_t &t1) const;
+	Int_t                 getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1) const;
+	static Int_t          getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1,
+			Double_t offset, Double_t increment, Int_t nsamples);
+
+	// non-copying views (valid until the channel data are modified or flushed)
+	XboxDataSpan<const Double_t> viewSignal(Double_t t0=-1, Double_t t1=-1);
+	XboxTimeAxis          viewTimeAxis(Double_t t0=-1, Double_t t1=-1) const;
+	XboxDataSpan<const Byte_t> viewRawData() const { return XboxDataSpan<const Byte_t>(fRawData.data(), fRawData.size()); }
 
 
 //	Double_t              getPulseHeight(Double_t threshold=0.9);
 //	Double_t              getPulseWidth(Double_t threshold=0.9);
-	Double_t              min(Double_t t0=-1, Double_t t1=-1);
-	Double_t              max(Double_t t0=-1, Double_t t1=-1);
-	Double_t              magn(Double_t t0=-1, Double_t t1=-1);
-	Double_t              span(Double_t t0=-1, Double_t t1=-1);
-	Double_t              sum(Double_t t0=-1, Double_t t1=-1);
-	Double_t              mean(Double_t t0=-1, Double_t t1=-1);
-	Double_t              stddev(Double_t t0=-1, Double_t t1=-1);
+	Double_t              min(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              max(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              magn(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              span(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              sum(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              mean(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              stddev(Double_t t0=-1, Double_t t1=-1) const;
 	Double_t              median(Double_t t0=-1, Double_t t1=-1);
-	Double_t              integ(Double_t t0=-1, Double_t t1=-1);
+	Double_t              integ(Double_t t0=-1, Double_t t1=-1) const;
 
-	Double_t              risingEdge(Double_t threshold=0.9, Double_t t0=-1, Double_t t1=-1);
-	Double_t              fallingEdge(Double_t threshold=0.9, Double_t t0=-1, Double_t t1=-1);
+	// re-entrant evaluation (reads but never fills the internal buffer)
+	Stats_t               stats(Double_t t0=-1, Double_t t1=-1, UInt_t mask=kStatAll) const;
+	Double_t              risingEdge(Double_t threshold=0.9, Double_t t0=-1, Double_t t1=-1,
+			EPrecision prec=kPrecDouble) const;
+	Double_t              fallingEdge(Double_t threshold=0.9, Double_t t0=-1, Double_t t1=-1,
+			EPrecision prec=kPrecDouble) const;
 
-	std::string           getChannelName() const { return fChannelName; }
+	// evaluation of calibrated samples (e.g. decoded once per event)
+	static Stats_t        windowStats(const Double_t *y, Int_t n, UInt_t mask, Double_t dt);
+	static Double_t       edgeIndex(const Double_t *y, Int_t n, Double_t threshold, Bool_t rising);
+
+	// calibration
+	Bool_t                isMonotonic() const;
+	Int_t                 getRawLevel(Double_t y, Double_t &r) const;
+
+	std::string           getChannelName() const { return fDescriptor->fChannelName; }
 	Int_t                 getXboxVersion() const { return fXboxVersion; }
 
 	TTimeStamp            getTimeStamp() const { return fTimeStamp; } // @suppress("Type cannot be resolved")
@@ -160,17 +217,17 @@ public:
 	Double_t              getIncrement() const { return fIncrement; }
 	Int_t                 getSamples() const { return fNSamples; }
 
-	std::string           getXLabel() const { return fXLabel; }
-	std::string           getXUnit() const { return fXUnit; }
-	std::string           getYUnit() const { return fYUnit; }
-	std::string           getYUnitDescription() const { return fYUnitDescription; }
+	std::string           getXLabel() const { return fDescriptor->fXLabel; }
+	std::string           getXUnit() const { return fDescriptor->fXUnit; }
+	std::string           getYUnit() const { return fDescriptor->fYUnit; }
+	std::string           getYUnitDescription() const { return fDescriptor->fYUnitDescription; }
 
 	Int_t                 getScaleType() const { return fScaleType; }
-	std::string           getScaleUnit() const { return fScaleUnit; }
-	std::vector<Double_t> getScaleCoeffs() const { return fScaleCoeffs; }
+	std::string           getScaleUnit() const { return fDescriptor->fScaleUnit; }
+	const std::vector<Double_t>& getScaleCoeffs() const { return fDescriptor->fScaleCoeffs; }
 	
-	XboxDataType          getDataType() const { return fDataType; }
-	std::vector<Byte_t>   getRawData() const { return fRawData; }
+	XboxDataType          getDataType() const { return fDescriptor->fDataType; }
+	const std::vector<Byte_t>& getRawData() const { return fRawData; }
 
 	Double_t              getXmin() const { return fXmin; }
 	Double_t              getXmax() const { return fXmax; }
@@ -183,11 +240,15 @@ public:
 	Double_t              getYspan() const { return fYspan; }
 
 
+	const XboxDAQChannelDescriptor& getDescriptor() const { return fDescriptor.get(); }
+
 	XboxDAQChannel        cloneMetaData() const;
 
 
-	void                  setChannelName(const std::string &name) { fChannelName = name; };
-	void                  setChannelName(const Char_t* name) { fChannelName = name; }
+	void                  setDescriptor(const XboxDAQChannelDescriptor &desc) { fDescriptor.set(desc); }
+
+	void                  setChannelName(const std::string &name);
+	void                  setChannelName(const Char_t* name) { setChannelName(std::string(name)); }
 	void                  setXboxVersion(Int_t version) { fXboxVersion = version; };
 
 	void                  setTimeStamp(const TTimeStamp &ts) { fTimeStamp = ts; }
@@ -207,18 +268,20 @@ public:
 	void                  setIncrement(Double_t val) { fIncrement = val; }
 	void                  setSamples(Int_t val) { fNSamples = val; }
 
-	void                  setXLabel(const std::string &sval) { fXLabel = sval; }
-	void                  setXUnit(const std::string &sval) { fXUnit = sval; }
-	void                  setYUnit(const std::string &sval) { fYUnit = sval; }
-	void                  setYUnitDescription(const std::string &sval) { fYUnitDescription = sval; }
+	void                  setXLabel(const std::string &sval);
+	void                  setXUnit(const std::string &sval);
+	void                  setYUnit(const std::string &sval);
+	void                  setYUnitDescription(const std::string &sval);
 
 	void                  setScaleType(Int_t val) { fScaleType = val; }
-	void                  setScaleUnit(const std::string &sval) { fScaleUnit = sval; }
-	void                  setScaleCoeffs(const std::vector<Double_t> &val) { fScaleCoeffs = val; }
+	void                  setScaleUnit(const std::string &sval);
+	void                  setScaleCoeffs(const std::vector<Double_t> &val);
 
-	void                  setDataType(XboxDataType dtype) { fDataType = dtype; }
-	void                  setDataTypeId(UInt_t id) { fDataType = XboxDataType(id); }
+	void                  setDataType(XboxDataType dtype);
+	void                  setDataTypeId(UInt_t id) { setDataType(XboxDataType(id)); }
 	void                  setRawData(const std::vector<Byte_t> &val) { fRawData = val; }
+	void                  setRawData(std::vector<Byte_t> &&val) { fRawData = std::move(val); }
+	void                  setRawData(const Byte_t *data, size_t size) { fRawData.assign(data, data + size); }
 
 
 	void                  setXmin(Double_t val) { fXmin = val; }
@@ -234,7 +297,7 @@ public:
 
 	void                  setAutoRefresh(Bool_t flag) {	fAutoRefresh = flag; }
 
-	ClassDef(XboxDAQChannel,1);	// Xbox Data Acquisition Channel class 
+	ClassDef(XboxDAQChannel,2);	// Xbox Data Acquisition Channel class 
 };
 
 #ifndef XBOX_NO_NAMESPACE
@@ -0,0 +1,138 @@
+/*
+ * XboxDAQChannelDescriptor.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef __XBOXDAQCHANNELDESCRIPTOR_HXX_
+#define __XBOXDAQCHANNELDESCRIPTOR_HXX_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Rtypes.h"
+#include "TNamed.h"
+
+#include "XboxDataType.hxx"
+
+class TBuffer;
+class TCollection;
+class TFile;
+class TFileMergeInfo;
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Per-run description of a channel.
+/// Collects the meta data of a channel which do not change from pulse
+/// to pulse (name, axis labels, units, calibration and data type).
+/// Descriptors are interned: equal descriptors are stored only once in
+/// a process wide pool and shared by all events of a channel. The pool
+/// is reference counted, a descriptor is released together with the
+/// last event referring to it.
+class XboxDAQChannelDescriptor {
+
+public:
+	std::string           fChannelName;               ///<NI_ChannelName
+	std::string           fXLabel;                    ///<wf_xname;
+	std::string           fXUnit;                     ///<wf_xunit_string
+	std::string           fYUnit;                     ///<unit_string
+	std::string           fYUnitDescription;          ///<NI_UnitDescription
+	std::string           fScaleUnit;                 ///<Scale_Unit;
+	std::vector<Double_t> fScaleCoeffs;               ///<Scale_Coeffs;
+	XboxDataType          fDataType;                  ///<Data type
+
+	Bool_t                operator < (const XboxDAQChannelDescriptor& rhs) const;
+	Bool_t                operator == (const XboxDAQChannelDescriptor& rhs) const;
+
+	ULong64_t             getKey() const;
+
+	static std::shared_ptr<const XboxDAQChannelDescriptor> intern(const XboxDAQChannelDescriptor &desc);
+	static std::shared_ptr<const XboxDAQChannelDescriptor> getDefault();
+	static size_t         getPoolSize();
+
+	ClassDefNV(XboxDAQChannelDescriptor,1);	// Per-run description of a channel
+};
+
+
+////////////////////////////////////////////////////////////////////////
+/// Table of the channel descriptors of a file.
+/// Each distinct descriptor is written once per file under the key
+/// "ChannelDescriptors" and the events refer to it by its content key
+/// (see XboxDAQChannelDescriptor::getKey()). The keys do not depend on
+/// the file, hence merging files (hadd, TFileMerger, TBufferMerger)
+/// only has to unite their tables (see Merge()). The table is kept in
+/// memory together with the file (list of objects of the file) and is
+/// written again whenever a descriptor is added.
+class XboxDAQChannelDescriptorTable : public TNamed {
+
+private:
+	std::vector<XboxDAQChannelDescriptor> fDescriptors; ///<Distinct descriptors of the file.
+	std::vector<std::shared_ptr<const XboxDAQChannelDescriptor>> fInterned; ///<!Interned descriptors in the order of the table.
+	std::map<ULong64_t, Int_t> fIndex;                  ///<!Indices of the descriptors by content key.
+
+	Bool_t                insert(const std::shared_ptr<const XboxDAQChannelDescriptor> &desc);
+	void                  resolve();
+
+	static XboxDAQChannelDescriptorTable* findTable(TFile *file);
+
+public:
+	XboxDAQChannelDescriptorTable();
+	virtual ~XboxDAQChannelDescriptorTable();
+
+	size_t                size() const { return fDescriptors.size(); }
+
+	Long64_t              Merge(TCollection *list);
+	Long64_t              Merge(TCollection *list, TFileMergeInfo *info);
+
+	static Bool_t         add(TFile *file, const std::shared_ptr<const XboxDAQChannelDescriptor> &desc);
+	static std::shared_ptr<const XboxDAQChannelDescriptor> getDescriptor(TFile *file, ULong64_t key);
+	static std::shared_ptr<const XboxDAQChannelDescriptor> getDescriptorAt(TFile *file, Int_t idx);
+	static XboxDAQChannelDescriptorTable* getTable(TFile *file);
+
+	ClassDef(XboxDAQChannelDescriptorTable,1);	// Channel descriptors of a file
+};
+
+
+////////////////////////////////////////////////////////////////////////
+/// Reference to an interned channel descriptor.
+/// Holds a single shared pointer to the descriptor. Assigning a
+/// descriptor interns it. If the event is written to a file, only the
+/// content key of the descriptor is streamed and the descriptor is added
+/// to the table of the file (see XboxDAQChannelDescriptorTable).
+/// Otherwise (e.g. in-memory buffers) the descriptor is streamed by
+/// value.
+class XboxDAQChannelDescriptorRef {
+
+private:
+	std::shared_ptr<const XboxDAQChannelDescriptor> fDescriptor; ///<!Interned descriptor.
+
+public:
+	XboxDAQChannelDescriptorRef() : fDescriptor(XboxDAQChannelDescriptor::getDefault()) {}
+	XboxDAQChannelDescriptorRef(const XboxDAQChannelDescriptor &desc)
+		: fDescriptor(XboxDAQChannelDescriptor::intern(desc)) {}
+
+	void                  set(const XboxDAQChannelDescriptor &desc) { fDescriptor = XboxDAQChannelDescriptor::intern(desc); }
+	const XboxDAQChannelDescriptor& get() const { return *fDescriptor; }
+
+	const XboxDAQChannelDescriptor& operator * () const { return *fDescriptor; }
+	const XboxDAQChannelDescriptor* operator -> () const { return fDescriptor.get(); }
+
+	Bool_t                operator == (const XboxDAQChannelDescriptorRef& rhs) const { return fDescriptor == rhs.fDescriptor; }
+	Bool_t                operator != (const XboxDAQChannelDescriptorRef& rhs) const { return fDescriptor != rhs.fDescriptor; }
+
+	ClassDefNV(XboxDAQChannelDescriptorRef,3);	// Reference to a shared channel descriptor
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* __XBOXDAQCHANNELDESCRIPTOR_HXX_ */
@@ -0,0 +1,80 @@
+/*
+ * XboxDAQChannelIndex.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef __XBOXDAQCHANNELINDEX_HXX_
+#define __XBOXDAQCHANNELINDEX_HXX_
+
+#include <vector>
+
+#include "Rtypes.h"
+
+#include "XboxDAQChannel.hxx"
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Query index of a channel signal.
+/// After a preprocessing of O(n) (prefix sums) and O(n log n) (sparse
+/// table for the extrema) the window statistics of a channel are
+/// evaluated in O(1) for arbitrary time windows. This pays off if the
+/// same signal is queried for many different windows (e.g. sliding
+/// windows or scans over the pulse position).
+/// The index keeps a copy of the time axis parameters of the channel
+/// at build time and must be rebuilt if the channel data change.
+class XboxDAQChannelIndex {
+
+private:
+	Double_t              fStartOffset;               ///<Start offset of the time axis.
+	Double_t              fIncrement;                 ///<Sample increment.
+	Int_t                 fNSamples;                  ///<Number of samples.
+
+	Double_t              fShift;                     ///<Shift of the samples (mean) for the squared sums.
+	std::vector<Double_t> fSum;                       ///<Prefix sums of the shifted samples.
+	std::vector<Double_t> fSum2;                      ///<Prefix sums of the squared shifted samples.
+
+	Bool_t                fExtrema;                   ///<Extrema are indexed.
+	std::vector<std::vector<Double_t>> fMin;          ///<Sparse table of minima (level k covers 2^k samples).
+	std::vector<std::vector<Double_t>> fMax;          ///<Sparse table of maxima (level k covers 2^k samples).
+
+	void                  getRange(Double_t &min, Double_t &max, Int_t i0, Int_t i1) const;
+
+public:
+	XboxDAQChannelIndex();
+	XboxDAQChannelIndex(XboxDAQChannel &ch, Bool_t extrema=true);
+	~XboxDAQChannelIndex();
+
+	void                  init();
+	void                  clear();
+	void                  reset();
+
+	void                  build(XboxDAQChannel &ch, Bool_t extrema=true);
+
+	Bool_t                isEmpty() const { return fNSamples == 0; }
+	Int_t                 getSamples() const { return fNSamples; }
+	Int_t                 getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1) const;
+
+	Double_t              min(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              max(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              magn(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              span(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              sum(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              mean(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              stddev(Double_t t0=-1, Double_t t1=-1) const;
+	Double_t              integ(Double_t t0=-1, Double_t t1=-1) const;
+	XboxDAQChannel::Stats_t stats(Double_t t0=-1, Double_t t1=-1,
+			UInt_t mask=XboxDAQChannel::kStatAll) const;
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* __XBOXDAQCHANNELINDEX_HXX_ */
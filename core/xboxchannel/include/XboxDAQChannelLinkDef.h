@@ -15,9 +15,31 @@
 
 
 #ifndef XBOX_NO_NAMESPACE
+#pragma link C++ class XBOX::XboxDAQChannelDescriptor+;
+#pragma link C++ class std::vector<XBOX::XboxDAQChannelDescriptor>+;
+#pragma link C++ class XBOX::XboxDAQChannelDescriptorTable+;
+#pragma link C++ class XBOX::XboxDAQChannelDescriptorRef-;
 #pragma link C++ class XBOX::XboxDAQChannel+;
 #else
+#pragma link C++ class XboxDAQChannelDescriptor+;
+#pragma link C++ class std::vector<XboxDAQChannelDescriptor>+;
+#pragma link C++ class XboxDAQChannelDescriptorTable+;
+#pragma link C++ class XboxDAQChannelDescriptorRef-;
 #pragma link C++ class XboxDAQChannel+;
 #endif
 
+// Schema evolution: version 1 stored the per-run meta data as members
+// of the channel. They are collected into the shared descriptor.
+#ifndef XBOX_NO_NAMESPACE
+#pragma read sourceClass="XBOX::XboxDAQChannel" targetClass="XBOX::XboxDAQChannel" version="[1]" \
+	source="std::string fChannelName; std::string fXLabel; std::string fXUnit; std::string fYUnit; std::string fYUnitDescription; std::string fScaleUnit; std::vector<Double_t> fScaleCoeffs; XBOX::XboxDataType fDataType" \
+	target="fDescriptor" include="XboxDAQChannelDescriptor.hxx" \
+	code="{ XBOX::XboxDAQChannelDescriptor desc; desc.fChannelName = onfile.fChannelName; desc.fXLabel = onfile.fXLabel; desc.fXUnit = onfile.fXUnit; desc.fYUnit = onfile.fYUnit; desc.fYUnitDescription = onfile.fYUnitDescription; desc.fScaleUnit = onfile.fScaleUnit; desc.fScaleCoeffs = onfile.fScaleCoeffs; desc.fDataType = onfile.fDataType; fDescriptor.set(desc); }"
+#else
+#pragma read sourceClass="XboxDAQChannel" targetClass="XboxDAQChannel" version="[1]" \
+	source="std::string fChannelName; std::string fXLabel; std::string fXUnit; std::string fYUnit; std::string fYUnitDescription; std::string fScaleUnit; std::vector<Double_t> fScaleCoeffs; XboxDataType fDataType" \
+	target="fDescriptor" include="XboxDAQChannelDescriptor.hxx" \
+	code="{ XboxDAQChannelDescriptor desc; desc.fChannelName = onfile.fChannelName; desc.fXLabel = onfile.fXLabel; desc.fXUnit = onfile.fXUnit; desc.fYUnit = onfile.fYUnit; desc.fYUnitDescription = onfile.fYUnitDescription; desc.fScaleUnit = onfile.fScaleUnit; desc.fScaleCoeffs = onfile.fScaleCoeffs; desc.fDataType = onfile.fDataType; fDescriptor.set(desc); }"
+#endif
+
 #endif
@@ -0,0 +1,72 @@
+/*
+ * XboxDAQChannelPyramid.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef __XBOXDAQCHANNELPYRAMID_HXX_
+#define __XBOXDAQCHANNELPYRAMID_HXX_
+
+#include <vector>
+
+#include "Rtypes.h"
+
+#include "XboxDAQChannel.hxx"
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Multi-resolution min/max pyramid of a channel signal.
+/// Level k holds the minimum and maximum of consecutive blocks of 2^k
+/// samples (level 0 being the signal itself). A query for a time window
+/// and a given number of pixels picks the coarsest level which still
+/// resolves the pixels and returns one min/max pair per pixel. Hence,
+/// plots at any zoom level are generated in O(pixels) without losing
+/// narrow peaks (e.g. breakdown spikes).
+/// The pyramid keeps a copy of the time axis parameters of the channel
+/// at build time and must be rebuilt if the channel data change.
+class XboxDAQChannelPyramid {
+
+private:
+	Double_t              fStartOffset;               ///<Start offset of the time axis.
+	Double_t              fIncrement;                 ///<Sample increment.
+	Int_t                 fNSamples;                  ///<Number of samples.
+
+	std::vector<std::vector<Double_t>> fMin;          ///<Block minima per level.
+	std::vector<std::vector<Double_t>> fMax;          ///<Block maxima per level (level 0 aliases fMin[0]).
+
+	Int_t                 getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1) const;
+
+public:
+	XboxDAQChannelPyramid();
+	XboxDAQChannelPyramid(XboxDAQChannel &ch);
+	~XboxDAQChannelPyramid();
+
+	void                  init();
+	void                  clear();
+	void                  reset();
+
+	void                  build(XboxDAQChannel &ch);
+
+	Bool_t                isEmpty() const { return fNSamples == 0; }
+	Int_t                 getSamples() const { return fNSamples; }
+	Int_t                 getLevels() const { return fMin.size(); }
+
+	Int_t                 getEnvelope(std::vector<Double_t> &t,
+			std::vector<Double_t> &ymin, std::vector<Double_t> &ymax,
+			Double_t t0, Double_t t1, Int_t npixels) const;
+	Int_t                 getPolyline(std::vector<Double_t> &x,
+			std::vector<Double_t> &y, Double_t t0, Double_t t1,
+			Int_t npixels) const;
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* __XBOXDAQCHANNELPYRAMID_HXX_ */
@@ -0,0 +1,134 @@
+/*
+ * XboxDataSpan.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef __XBOXDATASPAN_HXX_
+#define __XBOXDATASPAN_HXX_
+
+#include <cstddef>
+#include <iterator>
+
+#include "Rtypes.h"
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Non-owning view of a contiguous sequence.
+/// A span refers to data owned by another object (e.g. the buffer of a
+/// XboxDAQChannel). It is cheap to copy and does not allocate memory.
+/// The span becomes invalid as soon as the owner modifies or releases
+/// its buffer.
+template <typename T>
+class XboxDataSpan {
+
+private:
+	T                    *fData;                      ///<First element.
+	size_t                fSize;                      ///<Number of elements.
+
+public:
+	typedef T             value_type;
+	typedef T*            iterator;
+	typedef const T*      const_iterator;
+
+	XboxDataSpan() : fData(NULL), fSize(0) {}
+	XboxDataSpan(T *data, size_t size) : fData(data), fSize(size) {}
+
+	T*                    data() const { return fData; }
+	size_t                size() const { return fSize; }
+	Bool_t                empty() const { return fSize == 0; }
+
+	iterator              begin() const { return fData; }
+	iterator              end() const { return fData + fSize; }
+
+	T&                    operator [] (size_t i) const { return fData[i]; }
+	T&                    front() const { return fData[0]; }
+	T&                    back() const { return fData[fSize-1]; }
+
+	////////////////////////////////////////////////////////////////////////
+	/// Sub view.
+	/// \param[in] offset The index of the first element.
+	/// \param[in] count The number of elements (clipped to the end).
+	XboxDataSpan<T>       subspan(size_t offset, size_t count) const {
+		if (offset > fSize)
+			offset = fSize;
+		if (count > fSize - offset)
+			count = fSize - offset;
+		return XboxDataSpan<T>(fData + offset, count);
+	}
+};
+
+
+////////////////////////////////////////////////////////////////////////
+/// Generator of an equidistant time axis.
+/// Provides the time values of a channel window on request without
+/// materialising the axis in memory. The i-th value is given by
+/// t0 + i * dt.
+class XboxTimeAxis {
+
+private:
+	Double_t              fStart;                     ///<First time value.
+	Double_t              fIncrement;                 ///<Sample increment.
+	size_t                fSize;                      ///<Number of samples.
+
+public:
+	class const_iterator {
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef Double_t                        value_type;
+		typedef std::ptrdiff_t                  difference_type;
+		typedef const Double_t*                 pointer;
+		typedef Double_t                        reference;
+	private:
+		const XboxTimeAxis   *fAxis;
+		std::ptrdiff_t        fIndex;
+	public:
+		const_iterator() : fAxis(NULL), fIndex(0) {}
+		const_iterator(const XboxTimeAxis *axis, std::ptrdiff_t i) : fAxis(axis), fIndex(i) {}
+
+		Double_t              operator * () const { return (*fAxis)[fIndex]; }
+		Double_t              operator [] (std::ptrdiff_t n) const { return (*fAxis)[fIndex + n]; }
+		const_iterator&       operator ++ () { ++fIndex; return *this; }
+		const_iterator        operator ++ (int) { const_iterator it(*this); ++fIndex; return it; }
+		const_iterator&       operator -- () { --fIndex; return *this; }
+		const_iterator        operator -- (int) { const_iterator it(*this); --fIndex; return it; }
+		const_iterator&       operator += (std::ptrdiff_t n) { fIndex += n; return *this; }
+		const_iterator&       operator -= (std::ptrdiff_t n) { fIndex -= n; return *this; }
+		const_iterator        operator + (std::ptrdiff_t n) const { return const_iterator(fAxis, fIndex + n); }
+		const_iterator        operator - (std::ptrdiff_t n) const { return const_iterator(fAxis, fIndex - n); }
+		std::ptrdiff_t        operator - (const const_iterator &rhs) const { return fIndex - rhs.fIndex; }
+		Bool_t                operator == (const const_iterator &rhs) const { return fIndex == rhs.fIndex; }
+		Bool_t                operator != (const const_iterator &rhs) const { return fIndex != rhs.fIndex; }
+		Bool_t                operator < (const const_iterator &rhs) const { return fIndex < rhs.fIndex; }
+		Bool_t                operator > (const const_iterator &rhs) const { return fIndex > rhs.fIndex; }
+		Bool_t                operator <= (const const_iterator &rhs) const { return fIndex <= rhs.fIndex; }
+		Bool_t                operator >= (const const_iterator &rhs) const { return fIndex >= rhs.fIndex; }
+	};
+
+	XboxTimeAxis() : fStart(0.), fIncrement(0.), fSize(0) {}
+	XboxTimeAxis(Double_t t0, Double_t dt, size_t size) : fStart(t0), fIncrement(dt), fSize(size) {}
+
+	Double_t              getStart() const { return fStart; }
+	Double_t              getIncrement() const { return fIncrement; }
+	size_t                size() const { return fSize; }
+	Bool_t                empty() const { return fSize == 0; }
+
+	Double_t              operator [] (std::ptrdiff_t i) const { return fStart + i * fIncrement; }
+	Double_t              front() const { return fStart; }
+	Double_t              back() const { return (*this)[fSize-1]; }
+
+	const_iterator        begin() const { return const_iterator(this, 0); }
+	const_iterator        end() const { return const_iterator(this, fSize); }
+};
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* __XBOXDATASPAN_HXX_ */
@@ -0,0 +1,237 @@
+/*
+ * XboxSignalKernels.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef __XBOXSIGNALKERNELS_HXX_
+#define __XBOXSIGNALKERNELS_HXX_
+
+#include <cmath>
+#include <algorithm>
+
+#include "Rtypes.h"
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Search kernels for sampled signals.
+/// The kernels scan the samples [i0, i1) of a signal given by a pointer,
+/// so they apply to vectors, spans of the channel buffer and raw integer
+/// samples alike. All return the index of the sample found or -1.
+/// Scans for a single event are carried out in blocks of
+/// kSignalKernelBlock samples whose conditions are combined without
+/// branches, so the compiler vectorises the block. Only the block
+/// containing the event is searched sample by sample.
+
+static const Int_t kSignalKernelBlock = 8;          ///<Number of samples tested at once.
+
+
+////////////////////////////////////////////////////////////////////////
+/// First threshold crossing.
+/// Finds the first sample which lies on the other side of the level than
+/// the first sample of the range. A sample equal to the level counts as
+/// above.
+/// \param[in] y The signal.
+/// \param[in] i0 The first sample of the range.
+/// \param[in] i1 The sample behind the range.
+/// \param[in] level The absolute level.
+/// \return The index behind the crossing or -1 if there is none.
+template <typename T>
+inline Int_t firstCrossing(const T *y, Int_t i0, Int_t i1, Double_t level)
+{
+	if (i1 - i0 < 2)
+		return -1;
+
+	const Bool_t below = y[i0] < level;
+	Int_t i = i0 + 1;
+	for (; i + kSignalKernelBlock <= i1; i += kSignalKernelBlock) {
+		Int_t found = 0;
+		for (Int_t b=0; b<kSignalKernelBlock; b++)
+			found |= (y[i+b] < level) != below;
+		if (found)
+			break;
+	}
+	for (; i < i1; i++) {
+		if ((y[i] < level) != below)
+			return i;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Last threshold crossing.
+/// Finds the last sample which lies on the other side of the level than
+/// the last sample of the range. A sample equal to the level counts as
+/// above.
+/// \param[in] y The signal.
+/// \param[in] i0 The first sample of the range.
+/// \param[in] i1 The sample behind the range.
+/// \param[in] level The absolute level.
+/// \return The index before the crossing or -1 if there is none.
+template <typename T>
+inline Int_t lastCrossing(const T *y, Int_t i0, Int_t i1, Double_t level)
+{
+	if (i1 - i0 < 2)
+		return -1;
+
+	const Bool_t below = y[i1-1] < level;
+	Int_t i = i1 - 2;
+	for (; i - kSignalKernelBlock + 1 >= i0; i -= kSignalKernelBlock) {
+		Int_t found = 0;
+		for (Int_t b=0; b<kSignalKernelBlock; b++)
+			found |= (y[i-b] < level) != below;
+		if (found)
+			break;
+	}
+	for (; i >= i0; i--) {
+		if ((y[i] < level) != below)
+			return i;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// First run of samples beyond a threshold.
+/// Finds the first k consecutive samples above (or below) the level in
+/// a single pass by counting the length of the current run.
+/// \param[in] y The signal.
+/// \param[in] i0 The first sample of the range.
+/// \param[in] i1 The sample behind the range.
+/// \param[in] level The absolute level.
+/// \param[in] k The number of consecutive samples.
+/// \param[in] above Samples above (true) or below (false) the level.
+/// \param[in] absolute Compare the magnitude of the samples.
+/// \return The first sample of the run or -1 if there is none.
+template <typename T>
+inline Int_t firstRun(const T *y, Int_t i0, Int_t i1, Double_t level, Int_t k,
+		Bool_t above, Bool_t absolute=false)
+{
+	k = std::max(k, 1);
+	Int_t count = 0;
+	for (Int_t i=i0; i<i1; i++) {
+		Double_t val = absolute ? fabs(Double_t(y[i])) : Double_t(y[i]);
+		if (above ? val > level : val < level) {
+			if (++count == k)
+				return i - k + 1;
+		}
+		else
+			count = 0;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Last run of samples beyond a threshold.
+/// Same as firstRun() but scans the range backward.
+/// \param[in] y The signal.
+/// \param[in] i0 The first sample of the range.
+/// \param[in] i1 The sample behind the range.
+/// \param[in] level The absolute level.
+/// \param[in] k The number of consecutive samples.
+/// \param[in] above Samples above (true) or below (false) the level.
+/// \param[in] absolute Compare the magnitude of the samples.
+/// \return The last sample of the run or -1 if there is none.
+template <typename T>
+inline Int_t lastRun(const T *y, Int_t i0, Int_t i1, Double_t level, Int_t k,
+		Bool_t above, Bool_t absolute=false)
+{
+	k = std::max(k, 1);
+	Int_t count = 0;
+	for (Int_t i=i1-1; i>=i0; i--) {
+		Double_t val = absolute ? fabs(Double_t(y[i])) : Double_t(y[i]);
+		if (above ? val > level : val < level) {
+			if (++count == k)
+				return i + k - 1;
+		}
+		else
+			count = 0;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Next root.
+/// Finds the first strict sign change of the given direction, i.e. two
+/// neighbouring samples y[i] < 0 < y[i+1] (rising) or y[i] > 0 > y[i+1]
+/// (falling). Samples equal to zero do not count as a root.
+/// \param[in] y The signal.
+/// \param[in] i0 The first sample of the range.
+/// \param[in] i1 The sample behind the range.
+/// \param[in] rising The direction of the sign change.
+/// \return The index before the root or -1 if there is none.
+template <typename T>
+inline Int_t nextRoot(const T *y, Int_t i0, Int_t i1, Bool_t rising)
+{
+	const T zero = T(0);
+	for (Int_t i=i0; i+1<i1; i++) {
+		if (rising ? (y[i] < zero && y[i+1] > zero) : (y[i] > zero && y[i+1] < zero))
+			return i;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Previous root.
+/// Same as nextRoot() but scans the range backward.
+/// \param[in] y The signal.
+/// \param[in] i0 The first sample of the range.
+/// \param[in] i1 The sample behind the range.
+/// \param[in] rising The direction of the sign change.
+/// \return The index behind the root or -1 if there is none.
+template <typename T>
+inline Int_t prevRoot(const T *y, Int_t i0, Int_t i1, Bool_t rising)
+{
+	const T zero = T(0);
+	for (Int_t i=i1-1; i>i0; i--) {
+		if (rising ? (y[i-1] < zero && y[i] > zero) : (y[i-1] > zero && y[i] < zero))
+			return i;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Argument of the maximum.
+/// The maximum is reduced in kSignalKernelBlock independent lanes and
+/// its first occurrence is located afterwards.
+/// \param[in] y The signal.
+/// \param[in] i0 The first sample of the range.
+/// \param[in] i1 The sample behind the range.
+/// \return The index of the first maximum or -1 if the range is empty.
+template <typename T>
+inline Int_t argMax(const T *y, Int_t i0, Int_t i1)
+{
+	if (i1 <= i0)
+		return -1;
+
+	T lane[kSignalKernelBlock];
+	std::fill(lane, lane + kSignalKernelBlock, y[i0]);
+
+	Int_t i = i0;
+	for (; i + kSignalKernelBlock <= i1; i += kSignalKernelBlock) {
+		for (Int_t b=0; b<kSignalKernelBlock; b++)
+			lane[b] = (y[i+b] > lane[b]) ? y[i+b] : lane[b];
+	}
+	T max = lane[0];
+	for (Int_t b=1; b<kSignalKernelBlock; b++)
+		max = (lane[b] > max) ? lane[b] : max;
+	for (; i < i1; i++)
+		max = (y[i] > max) ? y[i] : max;
+
+	for (i=i0; i<i1; i++) {
+		if (y[i] == max)
+			return i;
+	}
+	return i0;
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
+
+#endif /* __XBOXSIGNALKERNELS_HXX_ */
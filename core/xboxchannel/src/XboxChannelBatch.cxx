@@ -0,0 +1,470 @@
+#include "XboxChannelBatch.hxx"
+
+#include <cmath>
+#include <algorithm>
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Copy of raw samples into a column of the matrix.
+template <typename S>
+static void fillColumn(Double_t *data, const S *raw, Int_t nsamples,
+		Int_t stride, Int_t k)
+{
+	for (Int_t i=0; i < nsamples; i++)
+		data[(size_t)i * stride + k] = raw[i];
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxChannelBatch::XboxChannelBatch() {
+	init();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+/// \param[in] capacity The number of events to allocate memory for.
+XboxChannelBatch::XboxChannelBatch(Int_t capacity) {
+	init();
+	fCapacity = capacity > 0 ? capacity : 16;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxChannelBatch::~XboxChannelBatch() {
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Default Settings.
+void XboxChannelBatch::init() {
+	fChannelName = "";
+	fNSamples = 0;
+	fNEvents = 0;
+	fCapacity = 16;
+	fIncrement = 0.;
+	fScaleType = -1;
+	fCalibrated = false;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Clear.
+void XboxChannelBatch::clear() {
+	fScaleCoeffs.clear();
+	fData.clear();
+	fTimeStamp.clear();
+	fPulseCount.clear();
+	fLogType.clear();
+	fBreakdownFlag.clear();
+	fStartOffset.clear();
+	fNEvents = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reset.
+void XboxChannelBatch::reset() {
+	clear();
+	init();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Re-allocation of the matrix.
+/// \param[in] capacity The new number of events (row stride).
+void XboxChannelBatch::grow(Int_t capacity) {
+
+	std::vector<Double_t> data((size_t)fNSamples * capacity, 0.);
+	for (Int_t i=0; i < fNSamples && fNEvents > 0; i++)
+		std::copy(fData.begin() + (size_t)i * fCapacity,
+				fData.begin() + (size_t)i * fCapacity + fNEvents,
+				data.begin() + (size_t)i * capacity);
+
+	fData.swap(data);
+	fCapacity = capacity;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Index range of a time window.
+/// Follows the convention of XboxDAQChannel::getIndexRange and refers
+/// to the time axis of the first event.
+Int_t XboxChannelBatch::getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1) const
+{
+	Double_t offset = fStartOffset.empty() ? 0. : fStartOffset.front();
+	return XboxDAQChannel::getIndexRange(i0, i1, t0, t1, offset, fIncrement, fNSamples);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Checks whether the batch is calibrated.
+/// \return True if the samples are calibrated, otherwise an error is
+/// printed.
+Bool_t XboxChannelBatch::checkCalibrated() const {
+
+	if (!fCalibrated)
+		printf("ERROR: Batch of channel %s is not calibrated\n", fChannelName.c_str());
+	return fCalibrated;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Adds an event.
+/// Copies the raw samples of the channel into the next column of the
+/// matrix (uncalibrated) and appends the metadata. The first event
+/// defines the number of samples, the increment and the calibration.
+/// \param[in] ch The channel.
+/// \return The index of the event or -1 in case of an error.
+Int_t XboxChannelBatch::add(XboxDAQChannel &ch) {
+
+	if (fNEvents == 0) {
+		fChannelName = ch.getChannelName();
+		fNSamples = ch.getSamples();
+		fIncrement = ch.getIncrement();
+		fScaleType = ch.getScaleType();
+		fScaleCoeffs = ch.getScaleCoeffs();
+		fCalibrated = false;
+		fData.assign((size_t)fNSamples * fCapacity, 0.);
+	}
+	else if (ch.getSamples() != fNSamples || ch.getIncrement() != fIncrement) {
+		printf("ERROR: Time axis of channel %s does not match the batch\n",
+				ch.getChannelName().c_str());
+		return -1;
+	}
+	else if (ch.getScaleType() != fScaleType || ch.getScaleCoeffs() != fScaleCoeffs) {
+		printf("ERROR: Calibration of channel %s does not match the batch\n",
+				ch.getChannelName().c_str());
+		return -1;
+	}
+	else if (fCalibrated) {
+		printf("ERROR: Cannot add channel %s to a calibrated batch\n",
+				ch.getChannelName().c_str());
+		return -1;
+	}
+
+	XboxDataType type = ch.getDataType();
+	XboxDataSpan<const Byte_t> raw = ch.viewRawData();
+	if (raw.size() < fNSamples * type.getSize()) {
+		printf("ERROR: Insufficient raw data in channel %s\n",
+				ch.getChannelName().c_str());
+		return -1;
+	}
+
+	if (fNEvents == fCapacity)
+		grow(2 * fCapacity);
+
+	Int_t k = fNEvents;
+	if (type == XboxDataType::NATIVE_INT8)
+		fillColumn(fData.data(), reinterpret_cast<const Char_t *>(raw.data()), fNSamples, fCapacity, k);
+	else if (type == XboxDataType::NATIVE_INT16)
+		fillColumn(fData.data(), reinterpret_cast<const Short_t *>(raw.data()), fNSamples, fCapacity, k);
+	else if (type == XboxDataType::NATIVE_DOUBLE)
+		fillColumn(fData.data(), reinterpret_cast<const Double_t *>(raw.data()), fNSamples, fCapacity, k);
+	else {
+		printf("ERROR: Unsupported data type of channel %s\n",
+				ch.getChannelName().c_str());
+		return -1;
+	}
+
+	fTimeStamp.push_back(ch.getTimeStamp());
+	fPulseCount.push_back(ch.getPulseCount());
+	fLogType.push_back(ch.getLogType());
+	fBreakdownFlag.push_back(ch.getBreakdownFlag());
+	fStartOffset.push_back(ch.getStartOffset());
+
+	return fNEvents++;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Signal of an event.
+/// \param[out] y The samples of the event.
+/// \param[in] k The index of the event.
+/// \return The number of samples or -1 in case of an error.
+Int_t XboxChannelBatch::getSignal(std::vector<Double_t> &y, Int_t k) const {
+
+	y.clear();
+	if (k < 0 || k >= fNEvents)
+		return -1;
+
+	y.resize(fNSamples);
+	for (Int_t i=0; i < fNSamples; i++)
+		y[i] = fData[(size_t)i * fCapacity + k];
+	return fNSamples;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Calibration.
+/// Applies the polynomial scale coefficients to all samples of all
+/// events in a single pass.
+void XboxChannelBatch::calibrate() {
+
+	if (fCalibrated)
+		return;
+	fCalibrated = true;
+
+	if (fScaleCoeffs.empty() || fScaleType != 1)
+		return;
+
+	std::vector<Double_t> c(fScaleCoeffs.rbegin(), fScaleCoeffs.rend()); // highest order first
+	for (Int_t i=0; i < fNSamples; i++) {
+		Double_t *x = &fData[(size_t)i * fCapacity];
+		for (Int_t k=0; k < fNEvents; k++) {
+			Double_t p = 0.;   // Horner's method to evaluate polynomial
+			for (size_t j=0; j < c.size(); j++)
+				p = p*x[k] + c[j];
+			x[k] = p;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Window statistics of all events.
+/// Same results as XboxDAQChannel::stats for each event. The sums for
+/// the standard deviation are shifted by the first sample of the window.
+/// \param[out] res The statistics per event.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] mask Combination of XboxDAQChannel::EStatistics flags.
+/// \return The number of events or -1 in case of an empty window or an
+/// uncalibrated batch.
+Int_t XboxChannelBatch::stats(std::vector<XboxDAQChannel::Stats_t> &res,
+		Double_t t0, Double_t t1, UInt_t mask) const {
+
+	XboxDAQChannel::Stats_t zero = {0., 0., 0., 0., 0., 0., 0., 0., 0};
+	res.assign(fNEvents, zero);
+	if (!checkCalibrated())
+		return -1;
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	if (!fNEvents || i1 <= i0)
+		return -1;
+
+	Int_t n = i1 - i0;
+	const Double_t *shift = row(i0);
+
+	std::vector<Double_t> vmin(shift, shift + fNEvents);
+	std::vector<Double_t> vmax(shift, shift + fNEvents);
+	std::vector<Double_t> vsum(fNEvents, 0.);
+	std::vector<Double_t> vsum2(fNEvents, 0.);
+
+	Bool_t bext = mask & (XboxDAQChannel::kStatMin | XboxDAQChannel::kStatMax
+			| XboxDAQChannel::kStatMagn | XboxDAQChannel::kStatSpan);
+	Bool_t bsum2 = mask & XboxDAQChannel::kStatStdDev;
+
+	for (Int_t i=i0; i < i1; i++) {
+		const Double_t *x = row(i);
+		if (bext) {
+			for (Int_t k=0; k < fNEvents; k++) {
+				vmin[k] = std::min(vmin[k], x[k]);
+				vmax[k] = std::max(vmax[k], x[k]);
+			}
+		}
+		if (bsum2) {
+			for (Int_t k=0; k < fNEvents; k++) {
+				Double_t d = x[k] - shift[k];
+				vsum[k] += d;
+				vsum2[k] += d*d;
+			}
+		}
+		else {
+			for (Int_t k=0; k < fNEvents; k++)
+				vsum[k] += x[k] - shift[k];
+		}
+	}
+
+	for (Int_t k=0; k < fNEvents; k++) {
+		XboxDAQChannel::Stats_t &r = res[k];
+		Double_t sum = vsum[k] + n * shift[k];
+
+		r.fSamples = n;
+		if (mask & XboxDAQChannel::kStatMin)
+			r.fMin = vmin[k];
+		if (mask & XboxDAQChannel::kStatMax)
+			r.fMax = vmax[k];
+		if (mask & XboxDAQChannel::kStatMagn)
+			r.fMagn = std::max(fabs(vmin[k]), fabs(vmax[k]));
+		if (mask & XboxDAQChannel::kStatSpan)
+			r.fSpan = fabs(vmax[k] - vmin[k]);
+		if (mask & XboxDAQChannel::kStatSum)
+			r.fSum = sum;
+		if (mask & XboxDAQChannel::kStatMean)
+			r.fMean = sum / n;
+		if (mask & XboxDAQChannel::kStatInteg)
+			r.fInteg = sum * fIncrement;
+		if (bsum2) {
+			Double_t var = (vsum2[k] - vsum[k]*vsum[k]/n) / n;
+			r.fStdDev = (var > 0.) ? sqrt(var) : 0.;
+		}
+	}
+
+	return fNEvents;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Threshold crossing of all events.
+/// Searches the first (rising) or last (falling) crossing of an absolute
+/// level for each event. The scan stops as soon as all events crossed.
+/// The times follow the convention of XboxDAQChannel::risingEdge
+/// (sample index times increment, 0 if there is no crossing).
+/// \param[out] t The times of the crossings.
+/// \param[in] level The levels per event.
+/// \param[in] rising Search direction (true: first crossing).
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return The number of events with a crossing or -1 in case of an error.
+Int_t XboxChannelBatch::crossing(std::vector<Double_t> &t, const std::vector<Double_t> &level,
+		Bool_t rising, Double_t t0, Double_t t1) const {
+
+	t.assign(fNEvents, 0.);
+	if (!checkCalibrated())
+		return -1;
+	if ((Int_t)level.size() != fNEvents) {
+		printf("ERROR: Number of levels does not match the number of events\n");
+		return -1;
+	}
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	if (!fNEvents || i1 - i0 < 2)
+		return 0;
+
+	std::vector<Double_t> idx(fNEvents, -1.);
+	Int_t nfound = 0;
+
+	Int_t ibegin = rising ? i0 + 1 : i1 - 2;
+	Int_t iend = rising ? i1 : i0 - 1;
+	Int_t istep = rising ? 1 : -1;
+	for (Int_t i=ibegin; i != iend && nfound < fNEvents; i+=istep) {
+		const Double_t *x0 = rising ? row(i-1) : row(i);
+		const Double_t *x1 = rising ? row(i) : row(i+1);
+		for (Int_t k=0; k < fNEvents; k++) {
+			Double_t d0 = x0[k] - level[k];
+			Double_t d1 = x1[k] - level[k];
+			if (idx[k] < 0 && (d0 < 0) != (d1 < 0)) {
+				idx[k] = rising ? i - d1 / (d1 - d0) : i + d0 / (d0 - d1);
+				nfound++;
+			}
+		}
+	}
+
+	for (Int_t k=0; k < fNEvents; k++)
+		if (idx[k] >= 0)
+			t[k] = idx[k] * fIncrement;
+
+	return nfound;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Rising edge of all events.
+/// \param[out] t The times of the rising edges.
+/// \param[in] threshold The threshold relative to the span of each event.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return The number of events with a crossing or -1 in case of an error.
+Int_t XboxChannelBatch::risingEdge(std::vector<Double_t> &t, Double_t threshold,
+		Double_t t0, Double_t t1) const {
+
+	t.assign(fNEvents, 0.);
+	if (!checkCalibrated())
+		return -1;
+
+	std::vector<XboxDAQChannel::Stats_t> st;
+	stats(st, t0, t1, XboxDAQChannel::kStatMin | XboxDAQChannel::kStatMax);
+
+	std::vector<Double_t> level(fNEvents);
+	for (Int_t k=0; k < fNEvents; k++)
+		level[k] = threshold * (st[k].fMax - st[k].fMin) + st[k].fMin;
+
+	return crossing(t, level, true, t0, t1);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Falling edge of all events.
+/// \param[out] t The times of the falling edges.
+/// \param[in] threshold The threshold relative to the span of each event.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return The number of events with a crossing or -1 in case of an error.
+Int_t XboxChannelBatch::fallingEdge(std::vector<Double_t> &t, Double_t threshold,
+		Double_t t0, Double_t t1) const {
+
+	t.assign(fNEvents, 0.);
+	if (!checkCalibrated())
+		return -1;
+
+	std::vector<XboxDAQChannel::Stats_t> st;
+	stats(st, t0, t1, XboxDAQChannel::kStatMin | XboxDAQChannel::kStatMax);
+
+	std::vector<Double_t> level(fNEvents);
+	for (Int_t k=0; k < fNEvents; k++)
+		level[k] = threshold * (st[k].fMax - st[k].fMin) + st[k].fMin;
+
+	return crossing(t, level, false, t0, t1);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Average pulse.
+/// \param[out] avg The mean over all events for each sample.
+/// \return The number of samples or -1 if the batch is empty or not
+/// calibrated.
+Int_t XboxChannelBatch::averagePulse(std::vector<Double_t> &avg) const {
+
+	avg.assign(fNSamples, 0.);
+	if (!fNEvents || !checkCalibrated())
+		return -1;
+
+	for (Int_t i=0; i < fNSamples; i++) {
+		const Double_t *x = row(i);
+		Double_t sum = 0.;
+		for (Int_t k=0; k < fNEvents; k++)
+			sum += x[k];
+		avg[i] = sum / fNEvents;
+	}
+	return fNSamples;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Deviation from a reference.
+/// Root mean square deviation of each event from a reference signal
+/// (e.g. the average pulse) in a time window.
+/// \param[out] dev The deviation per event.
+/// \param[in] ref The reference signal (one value per sample).
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return The number of events or -1 in case of an error.
+Int_t XboxChannelBatch::deviation(std::vector<Double_t> &dev, const std::vector<Double_t> &ref,
+		Double_t t0, Double_t t1) const {
+
+	dev.assign(fNEvents, 0.);
+	if (!checkCalibrated())
+		return -1;
+	if ((Int_t)ref.size() != fNSamples) {
+		printf("ERROR: Size of the reference does not match the number of samples\n");
+		return -1;
+	}
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	if (!fNEvents || i1 <= i0)
+		return -1;
+
+	for (Int_t i=i0; i < i1; i++) {
+		const Double_t *x = row(i);
+		for (Int_t k=0; k < fNEvents; k++) {
+			Double_t d = x[k] - ref[i];
+			dev[k] += d*d;
+		}
+	}
+
+	for (Int_t k=0; k < fNEvents; k++)
+		dev[k] = sqrt(dev[k] / (i1 - i0));
+
+	return fNEvents;
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
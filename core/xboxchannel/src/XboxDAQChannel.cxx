@@ -1,8 +1,10 @@
 #include "XboxDAQChannel.hxx"
+#include "XboxSignalKernels.hxx"
 
 #include "Rtypes.h"
 
 #include <cstring>
+#include <cmath>
 #include <stdlib.h>
 #include <errno.h>
 #include <limits.h>
@@ -25,21 +27,22 @@ XboxDAQChannel::XboxDAQChannel() {
 
 
 XboxDAQChannel::~XboxDAQChannel() {
-	clear();
 }
 
 
 void XboxDAQChannel::clear() {
 	fData.clear();
-	fScaleCoeffs.clear();
+	fDataOffset = 0;
 	fRawData.clear();
+	if (!fDescriptor->fScaleCoeffs.empty())
+		setScaleCoeffs(std::vector<Double_t>());
 }
 
 
 void XboxDAQChannel::init() {
 
+	fDescriptor = XboxDAQChannelDescriptorRef();
 	fXboxVersion = 0;
-	fChannelName = "";
 
 	fTimeStamp.Set(0, 0, 0, 0, 0, 0, 0, true, 0);
 
@@ -59,13 +62,7 @@ void XboxDAQChannel::init() {
 	fIncrement = 0.;
 	fNSamples = 0;
 
-	fXLabel = "";
-	fXUnit = "";
-	fYUnit = "";
-	fYUnitDescription = "";
-
 	fScaleType = -1;
-	fScaleUnit = "";
 
 	// analysis
 	fXmin = -1;
@@ -79,6 +76,7 @@ void XboxDAQChannel::init() {
 	fYspan = -1;
 
 	// data viewing
+	fDataOffset = 0;
 	fAutoRefresh = true;
 }
 
@@ -86,8 +84,8 @@ XboxDAQChannel XboxDAQChannel::cloneMetaData() const {
 
 	XboxDAQChannel ch;
 
+	ch.fDescriptor = fDescriptor;
 	ch.fXboxVersion = fXboxVersion;
-	ch.fChannelName = fChannelName;
 
 	ch.fTimeStamp = fTimeStamp;
 
@@ -107,13 +105,7 @@ XboxDAQChannel XboxDAQChannel::cloneMetaData() const {
 	ch.fIncrement = fIncrement;
 	ch.fNSamples = fNSamples;
 
-	ch.fXLabel = fXLabel;
-	ch.fXUnit = fXUnit;
-	ch.fYUnit = fYUnit;
-	ch.fYUnitDescription = fYUnitDescription;
-
 	ch.fScaleType = fScaleType;
-	ch.fScaleUnit = fScaleUnit;
 
 	// analysis
 	ch.fXmin = fXmin;
@@ -130,10 +122,64 @@ XboxDAQChannel XboxDAQChannel::cloneMetaData() const {
 }
 
 
+////////////////////////////////////////////////////////////////////////
+/// Setters of the per-run meta data.
+/// The descriptor is shared between events; a modification interns a
+/// modified copy (the previous one is released with its last event).
+/// To set several fields at once, prefer setDescriptor().
+void XboxDAQChannel::setChannelName(const std::string &name) {
+	XboxDAQChannelDescriptor desc(*fDescriptor);
+	desc.fChannelName = name;
+	fDescriptor.set(desc);
+}
+
+void XboxDAQChannel::setXLabel(const std::string &sval) {
+	XboxDAQChannelDescriptor desc(*fDescriptor);
+	desc.fXLabel = sval;
+	fDescriptor.set(desc);
+}
+
+void XboxDAQChannel::setXUnit(const std::string &sval) {
+	XboxDAQChannelDescriptor desc(*fDescriptor);
+	desc.fXUnit = sval;
+	fDescriptor.set(desc);
+}
+
+void XboxDAQChannel::setYUnit(const std::string &sval) {
+	XboxDAQChannelDescriptor desc(*fDescriptor);
+	desc.fYUnit = sval;
+	fDescriptor.set(desc);
+}
+
+void XboxDAQChannel::setYUnitDescription(const std::string &sval) {
+	XboxDAQChannelDescriptor desc(*fDescriptor);
+	desc.fYUnitDescription = sval;
+	fDescriptor.set(desc);
+}
+
+void XboxDAQChannel::setScaleUnit(const std::string &sval) {
+	XboxDAQChannelDescriptor desc(*fDescriptor);
+	desc.fScaleUnit = sval;
+	fDescriptor.set(desc);
+}
+
+void XboxDAQChannel::setScaleCoeffs(const std::vector<Double_t> &val) {
+	XboxDAQChannelDescriptor desc(*fDescriptor);
+	desc.fScaleCoeffs = val;
+	fDescriptor.set(desc);
+}
+
+void XboxDAQChannel::setDataType(XboxDataType dtype) {
+	XboxDAQChannelDescriptor desc(*fDescriptor);
+	desc.fDataType = dtype;
+	fDescriptor.set(desc);
+}
+
+
 void XboxDAQChannel::reset()
 {
-	clear();
 	init();
+	clear();
 }
 
 
@@ -144,6 +190,7 @@ Int_t XboxDAQChannel::isEmpty(){
 
 void XboxDAQChannel::flushbuffer() {
 	fData.clear();
+	fDataOffset = 0;
 }
 
 
@@ -153,24 +200,24 @@ void XboxDAQChannel::viewData(vector<Double_t> &data){
 
 	data.clear();
 
-	if (fDataType == XboxDataType::NATIVE_INT8) {
+	if (fDescriptor->fDataType == XboxDataType::NATIVE_INT8) {
 		Char_t * pBuffer;
 		pBuffer = reinterpret_cast<Char_t *>(pRawBuffer);
 		data.insert(data.end(), pBuffer, pBuffer + fNSamples);
 	}
-	else if (fDataType == XboxDataType::NATIVE_INT16) {
+	else if (fDescriptor->fDataType == XboxDataType::NATIVE_INT16) {
 		Short_t * pBuffer;
 		pBuffer = reinterpret_cast<Short_t *>(pRawBuffer);
 		data.insert(data.end(), pBuffer, pBuffer + fNSamples);
 	}
-	else if (fDataType == XboxDataType::NATIVE_DOUBLE) {
+	else if (fDescriptor->fDataType == XboxDataType::NATIVE_DOUBLE) {
 		Double_t * pBuffer;
 		pBuffer = reinterpret_cast<Double_t *>(pRawBuffer);
 		data.insert(data.end(), pBuffer, pBuffer + fNSamples);
 	}
 
     // calibrate data by scale coefficients
-	if(fScaleCoeffs.empty())
+	if(fDescriptor->fScaleCoeffs.empty())
 		return;
 
 	if(fScaleType == 0) {  // logarithmic coefficients TODO
@@ -180,7 +227,7 @@ void XboxDAQChannel::viewData(vector<Double_t> &data){
 	else if(fScaleType == 1) {  // polynomial coefficients
 		for (auto itval = data.begin(); itval != data.end(); ++itval){
 			Double_t p = 0.;   // Horner's method to evaluate polynomial
-			for (auto itcoeff = fScaleCoeffs.rbegin(); itcoeff != fScaleCoeffs.rend(); ++itcoeff)
+			for (auto itcoeff = getScaleCoeffs().rbegin(); itcoeff != getScaleCoeffs().rend(); ++itcoeff)
 				p = p*(*itval) + (*itcoeff);
 			(*itval) = p;
 		}
@@ -189,11 +236,138 @@ void XboxDAQChannel::viewData(vector<Double_t> &data){
 }
 
 
+////////////////////////////////////////////////////////////////////////
+/// Calibration polynomial.
+/// Evaluates the scale polynomial by Horner's method (identity if no
+/// polynomial coefficients are given).
+static Double_t polyval(const std::vector<Double_t> &coeffs, Int_t scaletype, Double_t x)
+{
+	if (coeffs.empty() || scaletype != 1)
+		return x;
+
+	Double_t p = 0.;
+	for (auto itcoeff = coeffs.rbegin(); itcoeff != coeffs.rend(); ++itcoeff)
+		p = p*x + (*itcoeff);
+	return p;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Value range of the integer raw data types.
+/// \return 0 on success or -1 if the data type is not supported.
+static Int_t getRawBounds(const XboxDataType &type, Double_t &rmin, Double_t &rmax)
+{
+	if (type == XboxDataType::NATIVE_INT8) {
+		rmin = SCHAR_MIN;
+		rmax = SCHAR_MAX;
+	}
+	else if (type == XboxDataType::NATIVE_INT16) {
+		rmin = SHRT_MIN;
+		rmax = SHRT_MAX;
+	}
+	else
+		return -1;
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Calibration of raw samples.
+/// Converts the raw samples [i0, i1) to the type T and applies the
+/// polynomial scale coefficients in the precision of T.
+template <typename T, typename S>
+static void calibrate(std::vector<T> &data, const S *raw, Int_t i0, Int_t i1,
+		const std::vector<Double_t> &coeffs, Int_t scaletype)
+{
+	data.assign(raw + i0, raw + i1);
+	if (coeffs.empty() || scaletype != 1)
+		return;
+
+	const Int_t nc = coeffs.size();
+	for (auto itval = data.begin(); itval != data.end(); ++itval) {
+		T p = 0;
+		for (Int_t k=nc-1; k>=0; k--) // highest order first
+			p = p*(*itval) + T(coeffs[k]);
+		(*itval) = p;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Buffer of the current thread.
+/// Temporary buffer for the calibrated signal of the const evaluations
+/// (stats(), edges). Each thread re-uses its own buffer, so repeated
+/// evaluations allocate no memory once the buffer covers the window.
+template <typename T>
+static std::vector<T>& getThreadBuffer()
+{
+	static thread_local std::vector<T> buffer;
+	return buffer;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Calibration of a range of raw samples.
+/// Dispatches calibrate() on the data type of the raw buffer. The result
+/// is empty if the data type is not supported.
+template <typename T>
+static void calibrateRange(std::vector<T> &data, const std::vector<Byte_t> &raw,
+		const XboxDataType &type, Int_t i0, Int_t i1,
+		const std::vector<Double_t> &coeffs, Int_t scaletype)
+{
+	data.clear();
+	const Byte_t *pRawBuffer = raw.data();
+	if (type == XboxDataType::NATIVE_INT8)
+		calibrate(data, reinterpret_cast<const Char_t *>(pRawBuffer), i0, i1,
+				coeffs, scaletype);
+	else if (type == XboxDataType::NATIVE_INT16)
+		calibrate(data, reinterpret_cast<const Short_t *>(pRawBuffer), i0, i1,
+				coeffs, scaletype);
+	else if (type == XboxDataType::NATIVE_DOUBLE)
+		calibrate(data, reinterpret_cast<const Double_t *>(pRawBuffer), i0, i1,
+				coeffs, scaletype);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Interpretation of a sample range.
+/// Extends the internal signal buffer so that it covers the samples
+/// [i0, i1). Only samples not interpreted yet are calibrated, hence
+/// the cost of an access is proportional to its time window rather than
+/// to the length of the trace. In the auto refresh mode the buffer is
+/// re-interpreted on each access.
+/// \param[in] i0 The index of the first sample.
+/// \param[in] i1 The index behind the last sample.
+void XboxDAQChannel::interpret(Int_t i0, Int_t i1)
+{
+	if (fAutoRefresh)
+		fData.clear();
+
+	if (fData.empty()) {
+		calibrateRange(fData, fRawData, fDescriptor->fDataType, i0, i1,
+				fDescriptor->fScaleCoeffs, fScaleType);
+		fDataOffset = i0;
+		return;
+	}
+
+	Int_t j0 = fDataOffset;
+	Int_t j1 = fDataOffset + fData.size();
+	if (i0 < j0) {
+		std::vector<Double_t> head;
+		calibrateRange(head, fRawData, fDescriptor->fDataType, i0, j0,
+				fDescriptor->fScaleCoeffs, fScaleType);
+		fData.insert(fData.begin(), head.begin(), head.end());
+		fDataOffset = i0;
+	}
+	if (i1 > j1) {
+		std::vector<Double_t> tail;
+		calibrateRange(tail, fRawData, fDescriptor->fDataType, j1, i1,
+				fDescriptor->fScaleCoeffs, fScaleType);
+		fData.insert(fData.end(), tail.begin(), tail.end());
+	}
+}
+
+
 void XboxDAQChannel::print(){
 
 	printf("----------------------------------------------------\n");
 	printf("fXboxVersion           : %u\n", fXboxVersion);
-	printf("fChannelName           : %s\n", fChannelName.c_str());
+	printf("fChannelName           : %s\n", fDescriptor->fChannelName.c_str());
 
 	printf("fTimestamp             : %s\n", fTimeStamp.AsString());
 	printf("fLogType               : %d\n", fLogType);
@@ -213,10 +387,10 @@ void XboxDAQChannel::print(){
 	printf("fIncrement             : %e\n", fIncrement);
 	printf("fNSamples               : %u\n", fNSamples);
 
-	printf("fXLabel                : %s\n", fXLabel.c_str());
-	printf("fXUnit                 : %s\n", fXUnit.c_str());
-	printf("fYUnit                 : %s\n", fYUnit.c_str());
-	printf("fYUnitDescription      : %s\n", fYUnitDescription.c_str());
+	printf("fXLabel                : %s\n", fDescriptor->fXLabel.c_str());
+	printf("fXUnit                 : %s\n", fDescriptor->fXUnit.c_str());
+	printf("fYUnit                 : %s\n", fDescriptor->fYUnit.c_str());
+	printf("fYUnitDescription      : %s\n", fDescriptor->fYUnitDescription.c_str());
 
 	// Scale type: -1 - None, 0 - logarithmic, 1 - Polynomial
 	if(fScaleType == 0)
@@ -225,14 +399,14 @@ void XboxDAQChannel::print(){
 		printf("fScaleType             : Polynomial\n");
 	else
 		printf("fScaleType             : None\n");
-	printf("fScaleUnit             : %s\n", fScaleUnit.c_str());
+	printf("fScaleUnit             : %s\n", fDescriptor->fScaleUnit.c_str());
 	printf("fScaleCoeffs           :");
-	for (Double_t val: fScaleCoeffs)
+	for (Double_t val: fDescriptor->fScaleCoeffs)
 			printf(" %f", val);
 	printf("\n");
-	printf("fDataType id           : %u\n", fDataType.getId());
-	printf("fDataType size         : %zu\n", fDataType.getSize());
-	printf("fDataType alias        : %s\n", fDataType.getAlias().c_str());
+	printf("fDataType id           : %u\n", fDescriptor->fDataType.getId());
+	printf("fDataType size         : %zu\n", fDescriptor->fDataType.getSize());
+	printf("fDataType alias        : %s\n", fDescriptor->fDataType.getAlias().c_str());
 	if(fRawData.empty())
 		printf("fRawData               : EMPTY\n");
 	else
@@ -278,53 +452,52 @@ Bool_t XboxDAQChannel::operator > (const XboxDAQChannel& rhs) const {
 //}
 
 
-Int_t XboxDAQChannel::getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1)
+Int_t XboxDAQChannel::getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1) const
+{
+	return getIndexRange(i0, i1, t0, t1, fStartOffset, fIncrement, fNSamples);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Index range of a time window.
+/// Shared by all containers with an equidistant time axis.
+/// \param[out] i0 The first sample of the window.
+/// \param[out] i1 The sample behind the window.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] offset The time of the first sample.
+/// \param[in] increment The sample increment.
+/// \param[in] nsamples The number of samples.
+/// \return 0 on success or -1 if the limits are swapped (full range).
+Int_t XboxDAQChannel::getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1,
+		Double_t offset, Double_t increment, Int_t nsamples)
 {
 	if(t0 > t1){
 		i0 = 0;
-		i1 = fNSamples;
+		i1 = nsamples;
 		return -1;
 	}
 
-	if(t0 == -1 || t0 < fStartOffset)
+	if(t0 == -1 || t0 < offset)
 		i0 = 0;
-	else if(t0 > fStartOffset + (fNSamples-1) * fIncrement)
-		i0 = fNSamples - 1;
+	else if(t0 > offset + (nsamples-1) * increment)
+		i0 = nsamples - 1;
 	else
-		i0 = (t0 - fStartOffset) / fIncrement;
+		i0 = (t0 - offset) / increment;
 
-	if(t1 == -1 || t1 > fStartOffset + (fNSamples-1) * fIncrement)
-		i1 = fNSamples;
-	else if(t1 < fStartOffset)
+	if(t1 == -1 || t1 > offset + (nsamples-1) * increment)
+		i1 = nsamples;
+	else if(t1 < offset)
 		i1 = 1;
 	else
-		i1 = (t1 - fStartOffset) / fIncrement + 1;
+		i1 = (t1 - offset) / increment + 1;
 
 	return 0;
 }
 
-std::vector<Double_t> XboxDAQChannel::getTimeAxis(Double_t t0, Double_t t1)
+std::vector<Double_t> XboxDAQChannel::getTimeAxis(Double_t t0, Double_t t1) const
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
-
-	Int_t i0;
-	Int_t i1;
-	getIndexRange(i0, i1, t0, t1);
-
-//	printf("nsamples %e\n", (t1 - t0) / fIncrement + 1);
-//	printf("t0 %e\n", t0);
-//	printf("t1 %e\n", t1);
-//	printf("i0 %d\n", i0);
-//	printf("i1 %d\n", i1);
-
-	std::vector<Double_t> t(i1-i0);
-	Double_t val = fStartOffset + i0*fIncrement;
-	for (auto it = t.begin(); it != t.end(); ++it){
-		*it = val;
-		val += fIncrement;
-	}
-	return t;
+	XboxTimeAxis axis = viewTimeAxis(t0, t1);
+	return std::vector<Double_t>(axis.begin(), axis.end());
 }
 
 void XboxDAQChannel::getTimeAxisBounds(Double_t &t0, Double_t &t1) const
@@ -335,227 +508,528 @@ void XboxDAQChannel::getTimeAxisBounds(Double_t &t0, Double_t &t1) const
 
 std::vector<Double_t> XboxDAQChannel::getSignal(Double_t t0, Double_t t1)
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
-
-	Int_t i0;
-	Int_t i1;
-	getIndexRange(i0, i1, t0, t1);
-	std::vector<Double_t> vect(i1-i0);
-	std::copy(fData.begin() + i0, fData.begin() + i1, vect.begin());
-	return vect;
+	XboxDataSpan<const Double_t> y = viewSignal(t0, t1);
+	return std::vector<Double_t>(y.begin(), y.end());
 }
 
-Double_t XboxDAQChannel::min(Double_t t0, Double_t t1)
+////////////////////////////////////////////////////////////////////////
+/// Signal in double precision.
+/// Interprets and calibrates the raw samples of the given time window
+/// into the given buffer. The internal buffer is neither used nor
+/// filled, hence the channel can be read concurrently.
+/// \param[out] data The calibrated signal.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return The number of samples.
+Int_t XboxDAQChannel::getSignal(std::vector<Double_t> &data, Double_t t0, Double_t t1) const
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
+	data.clear();
 
 	Int_t i0;
 	Int_t i1;
 	getIndexRange(i0, i1, t0, t1);
-	Double_t val = *std::min_element(fData.begin() + i0, fData.begin() + i1);
-	return val;
+	if (fRawData.empty() || i1 <= i0)
+		return 0;
+
+	calibrateRange(data, fRawData, fDescriptor->fDataType, i0, i1,
+			fDescriptor->fScaleCoeffs, fScaleType);
+	return data.size();
 }
 
-Double_t XboxDAQChannel::max(Double_t t0, Double_t t1)
+////////////////////////////////////////////////////////////////////////
+/// Signal in single precision.
+/// Interprets and calibrates the raw samples of the given time window
+/// directly in single precision. The internal double buffer is neither
+/// used nor filled.
+/// \param[out] data The calibrated signal.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return The number of samples.
+Int_t XboxDAQChannel::getSignal(std::vector<Float_t> &data, Double_t t0, Double_t t1) const
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
+	data.clear();
 
 	Int_t i0;
 	Int_t i1;
 	getIndexRange(i0, i1, t0, t1);
-	Double_t val = *std::max_element(fData.begin() + i0, fData.begin() + i1);
-	return val;
-}
+	if (fRawData.empty() || i1 <= i0)
+		return 0;
 
+	calibrateRange(data, fRawData, fDescriptor->fDataType, i0, i1,
+			fDescriptor->fScaleCoeffs, fScaleType);
+	return data.size();
+}
 
-Double_t XboxDAQChannel::magn(Double_t t0, Double_t t1)
+////////////////////////////////////////////////////////////////////////
+/// View of the calibrated signal.
+/// Returns a read-only view of the internal signal buffer in the given
+/// time window without copying. Only the samples of the window are
+/// interpreted. The view is valid until the buffer is flushed or
+/// re-interpreted (e.g. by the next access in the auto refresh mode or
+/// by an access outside the samples interpreted so far).
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return The view of the signal.
+XboxDataSpan<const Double_t> XboxDAQChannel::viewSignal(Double_t t0, Double_t t1)
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
-
 	Int_t i0;
 	Int_t i1;
 	getIndexRange(i0, i1, t0, t1);
+	if (fRawData.empty() || i1 <= i0)
+		return XboxDataSpan<const Double_t>();
 
-	Double_t val = fabs(fData[i0]);
-	for(Int_t i=i0+1; i < i1; i++){
+	interpret(i0, i1);
+	if (fData.empty())
+		return XboxDataSpan<const Double_t>();
 
-		Double_t tmp = fabs(fData[i]);
-		if (tmp > val)
-			val = tmp;
-	}
-	return val;
+	return XboxDataSpan<const Double_t>(fData.data() + i0 - fDataOffset, i1 - i0);
 }
 
-Double_t XboxDAQChannel::span(Double_t t0, Double_t t1)
+////////////////////////////////////////////////////////////////////////
+/// Calibrated samples of an index range.
+/// Common input of the const evaluations. Reads the internal signal
+/// buffer if it is kept (no auto refresh) and already covers the range,
+/// otherwise the range is calibrated into the buffer of the current
+/// thread. The internal buffer is never filled, hence the channel can
+/// be evaluated concurrently.
+/// \param[in] i0 The index of the first sample.
+/// \param[in] i1 The index behind the last sample.
+/// \return The samples or NULL if the data type is not supported.
+const Double_t* XboxDAQChannel::viewWindow(Int_t i0, Int_t i1) const
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
+	if (!fAutoRefresh && i0 >= fDataOffset
+			&& i1 <= fDataOffset + (Int_t) fData.size())
+		return fData.data() + i0 - fDataOffset;
+
+	std::vector<Double_t> &y = getThreadBuffer<Double_t>();
+	calibrateRange(y, fRawData, fDescriptor->fDataType, i0, i1,
+			fDescriptor->fScaleCoeffs, fScaleType);
+	return y.empty() ? NULL : y.data();
+}
 
+////////////////////////////////////////////////////////////////////////
+/// View of the time axis.
+/// Returns a generator of the time axis in the given time window. The
+/// time values are computed on access and are not stored.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \return The time axis.
+XboxTimeAxis XboxDAQChannel::viewTimeAxis(Double_t t0, Double_t t1) const
+{
 	Int_t i0;
 	Int_t i1;
 	getIndexRange(i0, i1, t0, t1);
+	if (i1 <= i0)
+		return XboxTimeAxis();
 
-	Double_t min = fData[i0];
-	Double_t max = fData[i0];
-	for(Int_t i=i0+1; i < i1; i++){
+	return XboxTimeAxis(fStartOffset + i0*fIncrement, fIncrement, i1 - i0);
+}
 
-		Double_t mintmp = fData[i];
-		Double_t maxtmp = fData[i];
-		if (mintmp < min)
-			min = mintmp;
-		if (maxtmp > max)
-			max = maxtmp;
-	}
-//	Double_t min = *std::min_element(fData.begin() + i0, fData.begin() + i1);
-//	Double_t max = *std::max_element(fData.begin() + i0, fData.begin() + i1);
+Double_t XboxDAQChannel::min(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, kStatMin).fMin;
+}
 
-	return fabs(max-min);
+Double_t XboxDAQChannel::max(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, kStatMax).fMax;
 }
 
 
-Double_t XboxDAQChannel::mean(Double_t t0, Double_t t1)
+Double_t XboxDAQChannel::magn(Double_t t0, Double_t t1) const
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
+	return stats(t0, t1, kStatMagn).fMagn;
+}
 
-	Int_t i0;
-	Int_t i1;
-	getIndexRange(i0, i1, t0, t1);
-	Double_t val = std::accumulate(fData.begin() + i0, fData.begin() + i1, 0.);
-	return val / (i1 - i0);
+Double_t XboxDAQChannel::span(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, kStatSpan).fSpan;
 }
 
-Double_t XboxDAQChannel::stddev(Double_t t0, Double_t t1)
+
+Double_t XboxDAQChannel::mean(Double_t t0, Double_t t1) const
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
+	return stats(t0, t1, kStatMean).fMean;
+}
 
-	Int_t i0;
-	Int_t i1;
-	getIndexRange(i0, i1, t0, t1);
+Double_t XboxDAQChannel::stddev(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, kStatStdDev).fStdDev;
+}
 
-	Double_t sum = 0; // sum
-	Double_t sum2 = 0; // sum of the squares
-	for(Int_t i=i0; i < i1; i++){
-		sum += fData[i];
-		sum2 += fData[i]*fData[i];
+////////////////////////////////////////////////////////////////////////
+/// Median of the signal in a time window.
+/// The selection is performed on a scratch copy of the window, hence
+/// the internal signal buffer keeps its order.
+Double_t XboxDAQChannel::median(Double_t t0, Double_t t1)
+{
+	XboxDataSpan<const Double_t> y = viewSignal(t0, t1);
+	if (y.empty())
+		return 0.;
+
+	std::vector<Double_t> scratch(y.begin(), y.end());
+	const auto median_it = scratch.begin() + scratch.size() / 2;
+	std::nth_element(scratch.begin(), median_it, scratch.end());
+
+	if (scratch.size() % 2 == 0) {
+		// lower median is the largest element left of the upper median
+		Double_t e1 = *std::max_element(scratch.begin(), median_it);
+		return (e1 + *median_it) / 2;
 	}
+	else
+		return *median_it;
+}
 
-	return sqrt((sum2 - sum*sum) / (i1-i0));
+Double_t XboxDAQChannel::sum(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, kStatSum).fSum;
 }
 
-Double_t XboxDAQChannel::median(Double_t t0, Double_t t1)
+Double_t XboxDAQChannel::integ(Double_t t0, Double_t t1) const
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
+	return stats(t0, t1, kStatInteg).fInteg;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Statistics of a sample window.
+/// Evaluates the requested subset of statistics in a single pass over
+/// the samples. Statistics not requested by the mask are set to zero.
+/// \param[in] py The samples.
+/// \param[in] n The number of samples.
+/// \param[in] mask Combination of EStatistics flags.
+/// \param[in] dt The sampling interval.
+/// \return The statistics of the window.
+XboxDAQChannel::Stats_t XboxDAQChannel::windowStats(const Double_t *py, Int_t n, UInt_t mask,
+		Double_t dt)
+{
+	XboxDAQChannel::Stats_t res = {0., 0., 0., 0., 0., 0., 0., 0., 0};
+	res.fSamples = n;
+	if (!n)
+		return res;
+
+	Bool_t bext = mask & (XboxDAQChannel::kStatMin | XboxDAQChannel::kStatMax
+			| XboxDAQChannel::kStatMagn | XboxDAQChannel::kStatSpan);
+	Bool_t bsum = mask & (XboxDAQChannel::kStatSum | XboxDAQChannel::kStatMean
+			| XboxDAQChannel::kStatInteg | XboxDAQChannel::kStatStdDev);
+	Bool_t bsum2 = mask & XboxDAQChannel::kStatStdDev;
+
+	Double_t min = py[0];
+	Double_t max = py[0];
+	Double_t sum = 0.;
+	Double_t sum2 = 0.;
+
+	// separate loops for the combinations to keep them vectorisable
+	if (bsum2) {
+		// shifted by the first sample to reduce the cancellation error
+		const Double_t k = py[0];
+		for (Int_t i=0; i < n; i++) {
+			Double_t val = py[i];
+			Double_t d = val - k;
+			min = (val < min) ? val : min;
+			max = (val > max) ? val : max;
+			sum += d;
+			sum2 += d*d;
+		}
+		Double_t var = (sum2 - sum*sum/n) / n;
+		res.fStdDev = (var > 0.) ? sqrt(var) : 0.;
+		sum += n * k;
+	}
+	else if (bsum && bext) {
+		for (Int_t i=0; i < n; i++) {
+			Double_t val = py[i];
+			min = (val < min) ? val : min;
+			max = (val > max) ? val : max;
+			sum += val;
+		}
+	}
+	else if (bsum) {
+		for (Int_t i=0; i < n; i++)
+			sum += py[i];
+	}
+	else {
+		for (Int_t i=0; i < n; i++) {
+			Double_t val = py[i];
+			min = (val < min) ? val : min;
+			max = (val > max) ? val : max;
+		}
+	}
 
+	if (mask & XboxDAQChannel::kStatMin)
+		res.fMin = min;
+	if (mask & XboxDAQChannel::kStatMax)
+		res.fMax = max;
+	if (mask & XboxDAQChannel::kStatMagn)
+		res.fMagn = (fabs(min) > fabs(max)) ? fabs(min) : fabs(max);
+	if (mask & XboxDAQChannel::kStatSpan)
+		res.fSpan = fabs(max - min);
+	if (mask & XboxDAQChannel::kStatSum)
+		res.fSum = sum;
+	if (mask & XboxDAQChannel::kStatMean)
+		res.fMean = sum / n;
+	if (mask & XboxDAQChannel::kStatInteg)
+		res.fInteg = sum * dt;
+
+	return res;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Window statistics.
+/// Evaluates the requested subset of statistics of the signal in a
+/// time window in a single pass over the data. Statistics not
+/// requested by the mask are set to zero. The channel is not modified
+/// (see viewWindow()), hence it can be evaluated concurrently.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] mask Combination of EStatistics flags.
+/// \return The statistics of the window.
+XboxDAQChannel::Stats_t XboxDAQChannel::stats(Double_t t0, Double_t t1, UInt_t mask) const
+{
 	Int_t i0;
 	Int_t i1;
 	getIndexRange(i0, i1, t0, t1);
+	if (fRawData.empty() || i1 <= i0)
+		return windowStats(NULL, 0, mask, fIncrement);
 
-	if ((i1-i0) % 2 == 0) {
-	    const auto median_it1 = fData.begin() + i0 + (i1 - i0) / 2 - 1;
-	    const auto median_it2 = fData.begin() + i0 + (i1 - i0) / 2;
-
-	    std::nth_element(fData.begin() + i0, median_it1 , fData.begin() + i1);
-	    const auto e1 = *median_it1;
-
-	    std::nth_element(fData.begin() + i0, median_it2 , fData.begin() + i1);
-	    const auto e2 = *median_it2;
+	const Double_t *y = viewWindow(i0, i1);
+	return windowStats(y, y ? i1 - i0 : 0, mask, fIncrement);
+}
 
-	    return (e1 + e2) / 2;
 
-	} else {
-	    const auto median_it = fData.begin() + i0 + (i1 - i0) / 2;
-	    std::nth_element(fData.begin() + i0, median_it , fData.begin() + i1);
-	    return *median_it;
+////////////////////////////////////////////////////////////////////////
+/// Threshold crossing.
+/// Scans the samples [i0, i1) for the first (rising) or the last
+/// (falling) crossing of the level. A sample which hits the level
+/// exactly counts as above, so that the crossing is not missed when
+/// the rounding differs between the precisions.
+/// \return The interpolated index of the crossing or -1 if not found.
+template <typename T>
+static Double_t crossing(const T *y, Int_t i0, Int_t i1, Double_t level, Bool_t rising)
+{
+	if (rising) {
+		Int_t i = firstCrossing(y, i0, i1, level);
+		if (i < 0)
+			return -1;
+		Double_t d0 = y[i-1] - level;
+		Double_t d1 = y[i] - level;
+		return i - d1 / (d1 - d0);
+	}
+	else {
+		Int_t i = lastCrossing(y, i0, i1, level);
+		if (i < 0)
+			return -1;
+		Double_t d0 = y[i] - level;
+		Double_t d1 = y[i+1] - level;
+		return i + d0 / (d0 - d1);
 	}
 }
 
-Double_t XboxDAQChannel::sum(Double_t t0, Double_t t1)
+////////////////////////////////////////////////////////////////////////
+/// Threshold crossing in the raw integer domain.
+/// The relative threshold is converted into an absolute level of the
+/// calibrated signal and mapped back onto the raw scale. Neither a
+/// calibrated nor a double buffer is required.
+/// \return The interpolated index of the crossing or -1 if not found.
+template <typename S>
+static Double_t crossingRaw(const XboxDAQChannel &ch, const S *raw,
+		Int_t i0, Int_t i1, Double_t threshold, Bool_t rising)
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
+	S rmin = *std::min_element(raw + i0, raw + i1);
+	S rmax = *std::max_element(raw + i0, raw + i1);
 
-	Int_t i0;
-	Int_t i1;
-	getIndexRange(i0, i1, t0, t1);
-	Double_t val = std::accumulate(fData.begin() + i0, fData.begin() + i1, 0.);
-	return val;
+	Double_t ya = polyval(ch.getScaleCoeffs(), ch.getScaleType(), rmin);
+	Double_t yb = polyval(ch.getScaleCoeffs(), ch.getScaleType(), rmax);
+	Double_t ymin = std::min(ya, yb);
+	Double_t ymax = std::max(ya, yb);
+
+	Double_t level = 0.;
+	if (ch.getRawLevel(threshold * (ymax - ymin) + ymin, level))
+		return -1;
+
+	return crossing(raw, i0, i1, level, rising);
 }
 
-Double_t XboxDAQChannel::integ(Double_t t0, Double_t t1)
+////////////////////////////////////////////////////////////////////////
+/// Threshold crossing relative to the span of the samples.
+/// \return The interpolated index of the crossing or -1 if not found.
+template <typename T>
+static Double_t crossingRel(const T *y, Int_t n, Double_t threshold, Bool_t rising)
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
+	T max = *std::max_element(y, y + n);
+	T min = *std::min_element(y, y + n);
+	T threshold_abs = threshold * (max - min) + min;
 
-	Int_t i0;
-	Int_t i1;
-	getIndexRange(i0, i1, t0, t1);
-	Double_t val = std::accumulate(fData.begin() + i0, fData.begin() + i1, 0.);
-	return val * fIncrement;
+	return crossing(y, 0, n, threshold_abs, rising);
 }
 
-
-Double_t XboxDAQChannel::risingEdge(Double_t threshold, Double_t t0, Double_t t1)
+////////////////////////////////////////////////////////////////////////
+/// Edge of calibrated samples.
+/// Same threshold crossing as risingEdge() and fallingEdge() but for
+/// samples which are already calibrated, e.g. decoded once per event.
+/// \param[in] y The samples.
+/// \param[in] n The number of samples.
+/// \param[in] threshold The threshold relative to the span of the samples.
+/// \param[in] rising The first (rising) or the last (falling) crossing.
+/// \return The interpolated index of the crossing or -1 if not found.
+Double_t XboxDAQChannel::edgeIndex(const Double_t *y, Int_t n, Double_t threshold, Bool_t rising)
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
+	if (n <= 0)
+		return -1;
+
+	return crossingRel(y, n, threshold, rising);
+}
 
+////////////////////////////////////////////////////////////////////////
+/// Edge detection.
+/// Common implementation of risingEdge and fallingEdge for the different
+/// precisions. In the raw mode the evaluation falls back to the double
+/// precision if the data type is not an integer or the calibration is
+/// not monotonic. The channel is not modified (see viewWindow()).
+Double_t XboxDAQChannel::edge(Double_t threshold, Double_t t0, Double_t t1,
+		Bool_t rising, EPrecision prec) const
+{
 	Int_t i0;
 	Int_t i1;
 	getIndexRange(i0, i1, t0, t1);
-	Double_t val=0;
+	if (fRawData.empty() || i1 <= i0)
+		return 0.;
+
+	Double_t idx = -1;
+	Bool_t bint = fDescriptor->fDataType == XboxDataType::NATIVE_INT8
+			|| fDescriptor->fDataType == XboxDataType::NATIVE_INT16;
+
+	if (prec == kPrecRaw && bint && isMonotonic()) {
+		const Byte_t *pRawBuffer = fRawData.data();
+		if (fDescriptor->fDataType == XboxDataType::NATIVE_INT8)
+			idx = crossingRaw(*this, reinterpret_cast<const Char_t *>(pRawBuffer),
+					i0, i1, threshold, rising);
+		else
+			idx = crossingRaw(*this, reinterpret_cast<const Short_t *>(pRawBuffer),
+					i0, i1, threshold, rising);
+	}
+	else if (prec == kPrecFloat) {
+		std::vector<Float_t> &y = getThreadBuffer<Float_t>();
+		Int_t n = getSignal(y, t0, t1);
+		if (n <= 0)
+			return 0.;
+
+		idx = crossingRel(y.data(), n, threshold, rising);
+		if (idx >= 0)
+			idx += i0;
+	}
+	else {
+		const Double_t *y = viewWindow(i0, i1);
+		if (!y)
+			return 0.;
+
+		idx = crossingRel(y, i1 - i0, threshold, rising);
+		if (idx >= 0)
+			idx += i0;
+	}
 
-	Double_t max =  (*std::max_element(fData.begin() + i0, fData.begin() + i1));
-	Double_t min =  (*std::min_element(fData.begin() + i0, fData.begin() + i1));
-	Double_t threshold_abs = threshold * (max - min) + min;
+	return (idx < 0) ? 0. : idx * fIncrement;
+}
 
-	for(Int_t i=i0+1; i < i1; i++){
-		if((fData[i]-threshold_abs)*(fData[i-1]-threshold_abs) < 0){
-			val = double(i - (fData[i] - threshold_abs) / (fData[i] - fData[i-1])) * fIncrement;
-			break;
-		}
-	}
+////////////////////////////////////////////////////////////////////////
+/// Rising edge.
+/// Time at which the signal crosses the threshold first.
+/// \param[in] threshold The threshold relative to the span of the signal.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] prec The evaluation precision.
+/// \return The time of the rising edge (0 if there is no crossing).
+Double_t XboxDAQChannel::risingEdge(Double_t threshold, Double_t t0, Double_t t1,
+		EPrecision prec) const
+{
+	return edge(threshold, t0, t1, true, prec);
+}
 
-//	for (auto  it = fData.begin(); it != fData.end(); ++it){
-//		if(*it > thval){
-//			auto i = std::distance(fData.begin(), it);
-//			tr = double(i - (*it - thval) / (*it - *(it-1))) * fIncrement;
-//			break;
-//		}
-//	}
-	return val;
+////////////////////////////////////////////////////////////////////////
+/// Falling edge.
+/// Time at which the signal crosses the threshold last.
+/// \param[in] threshold The threshold relative to the span of the signal.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] prec The evaluation precision.
+/// \return The time of the falling edge (0 if there is no crossing).
+Double_t XboxDAQChannel::fallingEdge(Double_t threshold, Double_t t0, Double_t t1,
+		EPrecision prec) const
+{
+	return edge(threshold, t0, t1, false, prec);
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Monotonic calibration.
+/// Checks whether the scale polynomial is strictly monotonic over the
+/// value range of the raw data type. This is the case for linear
+/// polynomials and for quadratic ones whose vertex lies outside the
+/// range of an 8 or 16 bit integer type. Thresholds can then be applied
+/// to the raw samples directly.
+/// \return True if the calibration is monotonic.
+Bool_t XboxDAQChannel::isMonotonic() const
+{
+	const std::vector<Double_t> &coeffs = fDescriptor->fScaleCoeffs;
+	if (coeffs.empty() || fScaleType != 1)
+		return true;
+
+	Int_t deg = coeffs.size() - 1;
+	while (deg > 0 && coeffs[deg] == 0.)
+		deg--;
+
+	if (deg == 1)
+		return true;
+	if (deg != 2)
+		return false;
+
+	Double_t rmin;
+	Double_t rmax;
+	if (getRawBounds(fDescriptor->fDataType, rmin, rmax))
+		return false;
+
+	Double_t vertex = -coeffs[1] / (2 * coeffs[2]);
+	return vertex <= rmin || vertex >= rmax;
+}
 
-Double_t XboxDAQChannel::fallingEdge(Double_t threshold, Double_t t0, Double_t t1)
+////////////////////////////////////////////////////////////////////////
+/// Inverse calibration.
+/// Maps a value of the calibrated signal onto the raw scale.
+/// \param[in] y The calibrated value.
+/// \param[out] r The corresponding raw value.
+/// \return 0 on success or -1 if the calibration is not invertible.
+Int_t XboxDAQChannel::getRawLevel(Double_t y, Double_t &r) const
 {
-	if(!fData.size() || fAutoRefresh)
-		viewData(fData);
+	if (!isMonotonic())
+		return -1;
 
-	Int_t i0;
-	Int_t i1;
-	getIndexRange(i0, i1, t0, t1);
-	Double_t val=0;
+	const std::vector<Double_t> &coeffs = fDescriptor->fScaleCoeffs;
+	if (coeffs.empty() || fScaleType != 1) {
+		r = y;
+		return 0;
+	}
 
-	Double_t max =  (*std::max_element(fData.begin() + i0, fData.begin() + i1));
-	Double_t min =  (*std::min_element(fData.begin() + i0, fData.begin() + i1));
-	Double_t threshold_abs = threshold * (max - min) + min;
+	Double_t c0 = coeffs[0];
+	Double_t c1 = coeffs.size() > 1 ? coeffs[1] : 0.;
+	Double_t c2 = coeffs.size() > 2 ? coeffs[2] : 0.;
 
-	for(Int_t i=i1-2; i >= i0; i--){
-		if((fData[i]-threshold_abs)*(fData[i+1]-threshold_abs) < 0){
-			val = double(i + (fData[i] - threshold_abs) / (fData[i] - fData[i+1])) * fIncrement;
-			break;
-		}
+	if (c2 == 0.) {
+		r = (y - c0) / c1;
+		return 0;
 	}
-	return val;
+
+	// quadratic: take the root on the branch covering the raw range
+	Double_t disc = c1*c1 - 4*c2*(c0 - y);
+	if (disc < 0)
+		disc = 0;
+
+	Double_t rmin;
+	Double_t rmax;
+	getRawBounds(fDescriptor->fDataType, rmin, rmax);
+	Double_t vertex = -c1 / (2*c2);
+	Double_t sq = sqrt(disc) / (2*fabs(c2));
+	r = (vertex <= rmin) ? vertex + sq : vertex - sq;
+	return 0;
 }
 
+
 //Double_t TDAQChannel::getPulseHeight(Double_t threshold)
 //{
 //	if(!fData.size())
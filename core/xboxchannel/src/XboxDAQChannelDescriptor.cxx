@@ -0,0 +1,471 @@
+#include "XboxDAQChannelDescriptor.hxx"
+
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+
+#include "TBuffer.h"
+#include "TCollection.h"
+#include "TFile.h"
+#include "TString.h"
+
+#include "XboxFileSystem.h"
+
+#ifndef XBOX_NO_NAMESPACE
+ClassImp(XBOX::XboxDAQChannelDescriptor);
+ClassImp(XBOX::XboxDAQChannelDescriptorTable);
+ClassImp(XBOX::XboxDAQChannelDescriptorRef);
+namespace XBOX {
+#else
+ClassImp(XboxDAQChannelDescriptor);
+ClassImp(XboxDAQChannelDescriptorTable);
+ClassImp(XboxDAQChannelDescriptorRef);
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Pool of interned descriptors.
+/// Maps the interned descriptors (compared by value) to weak references.
+/// The pool and its mutex are never destroyed, since descriptors held by
+/// static objects are released after the static destruction.
+struct DescriptorLess_t {
+	Bool_t operator () (const XboxDAQChannelDescriptor *lhs, const XboxDAQChannelDescriptor *rhs) const {
+		return *lhs < *rhs;
+	}
+};
+
+typedef std::map<const XboxDAQChannelDescriptor*,
+		std::weak_ptr<const XboxDAQChannelDescriptor>, DescriptorLess_t> DescriptorPool_t;
+
+static DescriptorPool_t& getPool()
+{
+	static DescriptorPool_t *pool = new DescriptorPool_t;
+	return *pool;
+}
+
+static std::mutex& getPoolMutex()
+{
+	static std::mutex *mutex = new std::mutex;
+	return *mutex;
+}
+
+static std::mutex& getTableMutex()
+{
+	static std::mutex *mutex = new std::mutex;
+	return *mutex;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Release of an interned descriptor.
+/// Called with the last reference. The entry of the pool is removed
+/// unless it has been replaced by an equal descriptor meanwhile.
+static void release(const XboxDAQChannelDescriptor *desc)
+{
+	{
+		std::lock_guard<std::mutex> lock(getPoolMutex());
+		DescriptorPool_t &pool = getPool();
+		auto it = pool.find(desc);
+		if (it != pool.end() && it->first == desc)
+			pool.erase(it);
+	}
+	delete desc;
+}
+
+
+Bool_t XboxDAQChannelDescriptor::operator < (const XboxDAQChannelDescriptor& rhs) const {
+	UInt_t id = fDataType.getId();
+	UInt_t rhsid = rhs.fDataType.getId();
+	return std::tie(fChannelName, fXLabel, fXUnit, fYUnit, fYUnitDescription,
+			fScaleUnit, fScaleCoeffs, id)
+			< std::tie(rhs.fChannelName, rhs.fXLabel, rhs.fXUnit, rhs.fYUnit,
+			rhs.fYUnitDescription, rhs.fScaleUnit, rhs.fScaleCoeffs, rhsid);
+}
+
+
+Bool_t XboxDAQChannelDescriptor::operator == (const XboxDAQChannelDescriptor& rhs) const {
+	return !(*this < rhs) && !(rhs < *this);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Hash of a value.
+/// Hashes the bytes of the value from the least significant one, i.e.
+/// independent of the byte order of the machine.
+static ULong64_t hashValue(ULong64_t val, ULong64_t key) {
+
+	Char_t bytes[8];
+	for (Int_t i=0; i<8; i++)
+		bytes[i] = (val >> (8 * i)) & 0xff;
+	return hashBytes(bytes, sizeof(bytes), key);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Content key.
+/// FNV-1a hash over all fields (strings with their length). Equal
+/// descriptors have equal keys in every process and file. The key 0 is
+/// reserved for descriptors streamed by value.
+/// \return The key of the descriptor.
+ULong64_t XboxDAQChannelDescriptor::getKey() const {
+
+	ULong64_t key = 14695981039346656037ULL;
+	for (const std::string *str: {&fChannelName, &fXLabel, &fXUnit, &fYUnit,
+			&fYUnitDescription, &fScaleUnit}) {
+		key = hashValue(str->size(), key);
+		key = hashBytes(str->data(), str->size(), key);
+	}
+
+	key = hashValue(fScaleCoeffs.size(), key);
+	for (Double_t coeff: fScaleCoeffs) {
+		ULong64_t bits;
+		memcpy(&bits, &coeff, sizeof(bits));
+		key = hashValue(bits, key);
+	}
+
+	return hashValue(fDataType.getId(), key);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Interning of a descriptor.
+/// Looks up an equal descriptor in the pool and inserts a copy if none
+/// exists yet. Thread-safe.
+/// \param[in] desc Descriptor to be interned.
+/// \return Shared pointer to the interned descriptor.
+std::shared_ptr<const XboxDAQChannelDescriptor> XboxDAQChannelDescriptor::intern(
+		const XboxDAQChannelDescriptor &desc) {
+
+	std::lock_guard<std::mutex> lock(getPoolMutex());
+	DescriptorPool_t &pool = getPool();
+
+	auto it = pool.find(&desc);
+	if (it != pool.end()) {
+		std::shared_ptr<const XboxDAQChannelDescriptor> res = it->second.lock();
+		if (res)
+			return res;
+		pool.erase(it); // released right now
+	}
+
+	std::shared_ptr<const XboxDAQChannelDescriptor> res(
+			new XboxDAQChannelDescriptor(desc), release);
+	pool.emplace(res.get(), res);
+	return res;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Default descriptor.
+/// \return Shared pointer to the empty descriptor.
+std::shared_ptr<const XboxDAQChannelDescriptor> XboxDAQChannelDescriptor::getDefault() {
+	static std::shared_ptr<const XboxDAQChannelDescriptor> desc = intern(XboxDAQChannelDescriptor());
+	return desc;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Number of distinct descriptors in the pool.
+size_t XboxDAQChannelDescriptor::getPoolSize() {
+	std::lock_guard<std::mutex> lock(getPoolMutex());
+	return getPool().size();
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxDAQChannelDescriptorTable::XboxDAQChannelDescriptorTable()
+	: TNamed("ChannelDescriptors", "Channel descriptors of the events.") {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxDAQChannelDescriptorTable::~XboxDAQChannelDescriptorTable() {
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Adds an interned descriptor to the table.
+/// \param[in] desc The interned descriptor.
+/// \return False if the key of the descriptor is reserved or taken by a
+/// different descriptor, true otherwise.
+Bool_t XboxDAQChannelDescriptorTable::insert(
+		const std::shared_ptr<const XboxDAQChannelDescriptor> &desc) {
+
+	ULong64_t key = desc->getKey();
+	if (key == 0)
+		return false;
+
+	auto it = fIndex.find(key);
+	if (it != fIndex.end()) {
+		if (*fInterned[it->second] == *desc)
+			return true;
+		printf("ERROR: Channel descriptors %s and %s share the key %016llx\n",
+				fInterned[it->second]->fChannelName.c_str(), desc->fChannelName.c_str(), key);
+		return false;
+	}
+
+	fIndex.emplace(key, fInterned.size());
+	fDescriptors.push_back(*desc);
+	fInterned.push_back(desc);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Interns the descriptors read from a file.
+void XboxDAQChannelDescriptorTable::resolve() {
+
+	std::vector<XboxDAQChannelDescriptor> descriptors;
+	descriptors.swap(fDescriptors);
+	fInterned.clear();
+	fIndex.clear();
+	for (const XboxDAQChannelDescriptor &desc: descriptors)
+		insert(XboxDAQChannelDescriptor::intern(desc));
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Merge.
+/// Unites the descriptors of the tables of the merged files (called by
+/// hadd, TFileMerger and TBufferMerger). The events keep referring to
+/// their descriptors by the content keys.
+/// \param[in] list The tables to be added.
+/// \return The number of descriptors of the merged table.
+Long64_t XboxDAQChannelDescriptorTable::Merge(TCollection *list) {
+
+	resolve();
+	if (!list)
+		return size();
+
+	TIter next(list);
+	while (TObject *obj = next()) {
+		XboxDAQChannelDescriptorTable *table = dynamic_cast<XboxDAQChannelDescriptorTable*>(obj);
+		if (!table) {
+			printf("ERROR: Cannot merge object %s with the channel descriptors\n", obj->GetName());
+			return -1;
+		}
+		for (const XboxDAQChannelDescriptor &desc: table->fDescriptors)
+			insert(XboxDAQChannelDescriptor::intern(desc));
+	}
+	return size();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Merge.
+/// Same as above (interface of TFileMerger).
+Long64_t XboxDAQChannelDescriptorTable::Merge(TCollection *list, TFileMergeInfo *) {
+	return Merge(list);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Table of a file.
+/// Looks up the table in the list of objects of the file. If not yet
+/// present, the table is read from the file (or created) and added to
+/// the list, i.e. it is owned by the file. The caller synchronizes.
+/// \param[in] file The file.
+/// \return The table.
+XboxDAQChannelDescriptorTable* XboxDAQChannelDescriptorTable::findTable(TFile *file) {
+
+	XboxDAQChannelDescriptorTable *table = dynamic_cast<XboxDAQChannelDescriptorTable*>(
+			file->GetList()->FindObject("ChannelDescriptors"));
+	if (table)
+		return table;
+
+	file->GetObject("ChannelDescriptors", table);
+	if (!table)
+		table = new XboxDAQChannelDescriptorTable();
+	table->resolve();
+	file->GetList()->Add(table);
+
+	return table;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Table of a file.
+/// \param[in] file The file.
+/// \return The table or a null pointer if there is no file.
+XboxDAQChannelDescriptorTable* XboxDAQChannelDescriptorTable::getTable(TFile *file) {
+
+	if (!file)
+		return nullptr;
+
+	std::lock_guard<std::mutex> lock(getTableMutex());
+	return findTable(file);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Adds a descriptor to the table of a file.
+/// Writes the table to the file if the descriptor is not yet contained.
+/// Thread-safe.
+/// \param[in] file The file which is written.
+/// \param[in] desc The interned descriptor.
+/// \return True if the events may refer to the descriptor by its key,
+/// false if the file is not writable or the key is not unique (the
+/// descriptor is then streamed by value).
+Bool_t XboxDAQChannelDescriptorTable::add(TFile *file,
+		const std::shared_ptr<const XboxDAQChannelDescriptor> &desc) {
+
+	if (!file || !file->IsWritable())
+		return false;
+
+	std::lock_guard<std::mutex> lock(getTableMutex());
+	XboxDAQChannelDescriptorTable *table = findTable(file);
+
+	size_t n = table->size();
+	if (!table->insert(desc))
+		return false;
+
+	if (table->size() > n)
+		file->WriteTObject(table, table->GetName(), "WriteDelete");
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Unresolved reference.
+/// The events cannot be decoded without their descriptor (data type,
+/// calibration), hence reading is aborted.
+static void unresolved(TFile *file, const TString &ref) {
+
+	TString msg = TString::Format("Channel descriptor %s not found in file %s",
+			ref.Data(), file ? file->GetName() : "(none)");
+	printf("ERROR: %s\n", msg.Data());
+	throw std::runtime_error(msg.Data());
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Descriptor of the table of a file.
+/// Thread-safe.
+/// \param[in] file The file which is read.
+/// \param[in] key The content key of the descriptor.
+/// \return The interned descriptor. Throws std::runtime_error if the
+/// table of the file does not contain the key.
+std::shared_ptr<const XboxDAQChannelDescriptor> XboxDAQChannelDescriptorTable::getDescriptor(
+		TFile *file, ULong64_t key) {
+
+	std::lock_guard<std::mutex> lock(getTableMutex());
+	XboxDAQChannelDescriptorTable *table = file ? findTable(file) : nullptr;
+
+	if (table) {
+		auto it = table->fIndex.find(key);
+		if (it != table->fIndex.end())
+			return table->fInterned[it->second];
+	}
+
+	unresolved(file, TString::Format("%016llx", key));
+	return XboxDAQChannelDescriptor::getDefault();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Descriptor of the table of a file by position.
+/// Events of version 2 refer to the position of the descriptor in the
+/// table, which holds only for files which have not been merged.
+/// Thread-safe.
+/// \param[in] file The file which is read.
+/// \param[in] idx The position of the descriptor.
+/// \return The interned descriptor. Throws std::runtime_error if the
+/// position is not found.
+std::shared_ptr<const XboxDAQChannelDescriptor> XboxDAQChannelDescriptorTable::getDescriptorAt(
+		TFile *file, Int_t idx) {
+
+	std::lock_guard<std::mutex> lock(getTableMutex());
+	XboxDAQChannelDescriptorTable *table = file ? findTable(file) : nullptr;
+
+	if (table && idx >= 0 && idx < (Int_t) table->fInterned.size())
+		return table->fInterned[idx];
+
+	unresolved(file, TString::Format("#%d", idx));
+	return XboxDAQChannelDescriptor::getDefault();
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Reads a descriptor by value.
+static void readDescriptor(TBuffer &R__b, XboxDAQChannelDescriptor &desc) {
+
+	R__b.ReadStdString(&desc.fChannelName);
+	R__b.ReadStdString(&desc.fXLabel);
+	R__b.ReadStdString(&desc.fXUnit);
+	R__b.ReadStdString(&desc.fYUnit);
+	R__b.ReadStdString(&desc.fYUnitDescription);
+	R__b.ReadStdString(&desc.fScaleUnit);
+
+	Int_t ncoeffs;
+	R__b >> ncoeffs;
+	desc.fScaleCoeffs.resize(ncoeffs);
+	if (ncoeffs > 0)
+		R__b.ReadFastArray(desc.fScaleCoeffs.data(), ncoeffs);
+
+	UInt_t id;
+	R__b >> id;
+	desc.fDataType = XboxDataType(id);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Writes a descriptor by value.
+static void writeDescriptor(TBuffer &R__b, const XboxDAQChannelDescriptor &desc) {
+
+	R__b.WriteStdString(&desc.fChannelName);
+	R__b.WriteStdString(&desc.fXLabel);
+	R__b.WriteStdString(&desc.fXUnit);
+	R__b.WriteStdString(&desc.fYUnit);
+	R__b.WriteStdString(&desc.fYUnitDescription);
+	R__b.WriteStdString(&desc.fScaleUnit);
+
+	Int_t ncoeffs = desc.fScaleCoeffs.size();
+	R__b << ncoeffs;
+	if (ncoeffs > 0)
+		R__b.WriteFastArray(desc.fScaleCoeffs.data(), ncoeffs);
+
+	R__b << desc.fDataType.getId();
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Stream an object of class XboxDAQChannelDescriptorRef.
+/// Writes the content key of the descriptor, which is added to the table
+/// of the file, or 0 followed by the descriptor by value if the buffer
+/// does not belong to a file. Version 2 wrote the position in the table
+/// instead of the key (-1 for by value), version 1 always wrote the
+/// descriptor by value.
+void XboxDAQChannelDescriptorRef::Streamer(TBuffer &R__b) {
+
+	UInt_t R__s, R__c;
+	if (R__b.IsReading()) {
+		Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+		TFile *file = dynamic_cast<TFile*>(R__b.GetParent());
+
+		ULong64_t key = 0;
+		Int_t idx = -1;
+		if (R__v > 2)
+			R__b >> key;
+		else if (R__v > 1)
+			R__b >> idx;
+
+		if (key != 0)
+			fDescriptor = XboxDAQChannelDescriptorTable::getDescriptor(file, key);
+		else if (idx >= 0)
+			fDescriptor = XboxDAQChannelDescriptorTable::getDescriptorAt(file, idx);
+		else {
+			XboxDAQChannelDescriptor desc;
+			readDescriptor(R__b, desc);
+			fDescriptor = XboxDAQChannelDescriptor::intern(desc);
+		}
+
+		R__b.CheckByteCount(R__s, R__c, XboxDAQChannelDescriptorRef::Class());
+	}
+	else {
+		R__c = R__b.WriteVersion(XboxDAQChannelDescriptorRef::Class(), kTRUE);
+
+		ULong64_t key = 0;
+		if (XboxDAQChannelDescriptorTable::add(dynamic_cast<TFile*>(R__b.GetParent()), fDescriptor))
+			key = fDescriptor->getKey();
+		R__b << key;
+		if (key == 0)
+			writeDescriptor(R__b, *fDescriptor);
+
+		R__b.SetByteCount(R__c, kTRUE);
+	}
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
@@ -0,0 +1,259 @@
+#include "XboxDAQChannelIndex.hxx"
+
+#include <cmath>
+#include <algorithm>
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxDAQChannelIndex::XboxDAQChannelIndex() {
+	init();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+/// Builds the index for the signal of a channel.
+/// \param[in] ch The channel.
+/// \param[in] extrema Flag whether the extrema are indexed.
+XboxDAQChannelIndex::XboxDAQChannelIndex(XboxDAQChannel &ch, Bool_t extrema) {
+	init();
+	build(ch, extrema);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxDAQChannelIndex::~XboxDAQChannelIndex() {
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Default Settings.
+void XboxDAQChannelIndex::init() {
+	fStartOffset = 0.;
+	fIncrement = 0.;
+	fNSamples = 0;
+	fShift = 0.;
+	fExtrema = false;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Clear.
+void XboxDAQChannelIndex::clear() {
+	fSum.clear();
+	fSum2.clear();
+	fMin.clear();
+	fMax.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reset.
+void XboxDAQChannelIndex::reset() {
+	clear();
+	init();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Builds the index.
+/// The prefix sums are accumulated with compensated (Kahan) summation,
+/// each stored prefix includes the running compensation. The squared
+/// sums refer to the samples shifted by their mean to avoid cancellation
+/// in the variance.
+/// \param[in] ch The channel.
+/// \param[in] extrema Flag whether the extrema are indexed (sparse table).
+void XboxDAQChannelIndex::build(XboxDAQChannel &ch, Bool_t extrema) {
+
+	reset();
+
+	XboxDataSpan<const Double_t> y = ch.viewSignal();
+	Int_t n = y.size();
+
+	fStartOffset = ch.getStartOffset();
+	fIncrement = ch.getIncrement();
+	fNSamples = n;
+	fExtrema = extrema;
+	if (!n)
+		return;
+
+	// shift ...........................................................
+	Double_t shift = 0.;
+	for (Int_t i=0; i < n; i++)
+		shift += y[i];
+	fShift = shift / n;
+
+	// compensated prefix sums .........................................
+	fSum.resize(n + 1);
+	fSum2.resize(n + 1);
+	fSum[0] = 0.;
+	fSum2[0] = 0.;
+
+	Double_t s = 0., cs = 0.; // sum and compensation
+	Double_t s2 = 0., cs2 = 0.; // squared sum and compensation
+	for (Int_t i=0; i < n; i++) {
+		Double_t d = y[i] - fShift;
+
+		Double_t v = d - cs;
+		Double_t t = s + v;
+		cs = (t - s) - v;
+		s = t;
+
+		Double_t v2 = d*d - cs2;
+		Double_t t2 = s2 + v2;
+		cs2 = (t2 - s2) - v2;
+		s2 = t2;
+
+		fSum[i+1] = s - cs;
+		fSum2[i+1] = s2 - cs2;
+	}
+
+	// sparse table of the extrema .....................................
+	if (!extrema)
+		return;
+
+	Int_t nlevel = 1;
+	while ((1 << nlevel) <= n)
+		nlevel++;
+
+	fMin.resize(nlevel);
+	fMax.resize(nlevel);
+	fMin[0].assign(y.begin(), y.end());
+	fMax[0].assign(y.begin(), y.end());
+	for (Int_t k=1; k < nlevel; k++) {
+		Int_t len = n - (1 << k) + 1;
+		Int_t half = 1 << (k-1);
+		fMin[k].resize(len);
+		fMax[k].resize(len);
+		for (Int_t i=0; i < len; i++) {
+			fMin[k][i] = std::min(fMin[k-1][i], fMin[k-1][i+half]);
+			fMax[k][i] = std::max(fMax[k-1][i], fMax[k-1][i+half]);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Index range of a time window.
+/// Follows the convention of XboxDAQChannel::getIndexRange.
+Int_t XboxDAQChannelIndex::getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1) const
+{
+	return XboxDAQChannel::getIndexRange(i0, i1, t0, t1, fStartOffset,
+			fIncrement, fNSamples);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Extrema of the index range [i0, i1) from two overlapping blocks.
+void XboxDAQChannelIndex::getRange(Double_t &min, Double_t &max, Int_t i0, Int_t i1) const
+{
+	Int_t len = i1 - i0;
+	Int_t k = 0;
+	while ((2 << k) <= len)
+		k++;
+
+	Int_t j = i1 - (1 << k);
+	min = std::min(fMin[k][i0], fMin[k][j]);
+	max = std::max(fMax[k][i0], fMax[k][j]);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Window statistics.
+/// Evaluates the statistics of a time window in O(1). If the extrema
+/// are not indexed min, max, magn and span are set to zero.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] mask Combination of XboxDAQChannel::EStatistics flags.
+/// \return The statistics of the window.
+XboxDAQChannel::Stats_t XboxDAQChannelIndex::stats(Double_t t0, Double_t t1, UInt_t mask) const
+{
+	XboxDAQChannel::Stats_t res = {0., 0., 0., 0., 0., 0., 0., 0., 0};
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	if (!fNSamples || i1 <= i0)
+		return res;
+
+	Int_t n = i1 - i0;
+	res.fSamples = n;
+
+	// moments from the prefix sums
+	Double_t s = fSum[i1] - fSum[i0];
+	Double_t s2 = fSum2[i1] - fSum2[i0];
+	Double_t sum = s + n * fShift;
+
+	if (mask & XboxDAQChannel::kStatSum)
+		res.fSum = sum;
+	if (mask & XboxDAQChannel::kStatMean)
+		res.fMean = sum / n;
+	if (mask & XboxDAQChannel::kStatInteg)
+		res.fInteg = sum * fIncrement;
+	if (mask & XboxDAQChannel::kStatStdDev) {
+		Double_t var = (s2 - s*s/n) / n;
+		res.fStdDev = (var > 0.) ? sqrt(var) : 0.;
+	}
+
+	// extrema from the sparse table
+	if (fExtrema && (mask & (XboxDAQChannel::kStatMin | XboxDAQChannel::kStatMax
+			| XboxDAQChannel::kStatMagn | XboxDAQChannel::kStatSpan))) {
+		Double_t min;
+		Double_t max;
+		getRange(min, max, i0, i1);
+
+		if (mask & XboxDAQChannel::kStatMin)
+			res.fMin = min;
+		if (mask & XboxDAQChannel::kStatMax)
+			res.fMax = max;
+		if (mask & XboxDAQChannel::kStatMagn)
+			res.fMagn = (fabs(min) > fabs(max)) ? fabs(min) : fabs(max);
+		if (mask & XboxDAQChannel::kStatSpan)
+			res.fSpan = fabs(max - min);
+	}
+
+	return res;
+}
+
+Double_t XboxDAQChannelIndex::min(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, XboxDAQChannel::kStatMin).fMin;
+}
+
+Double_t XboxDAQChannelIndex::max(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, XboxDAQChannel::kStatMax).fMax;
+}
+
+Double_t XboxDAQChannelIndex::magn(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, XboxDAQChannel::kStatMagn).fMagn;
+}
+
+Double_t XboxDAQChannelIndex::span(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, XboxDAQChannel::kStatSpan).fSpan;
+}
+
+Double_t XboxDAQChannelIndex::sum(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, XboxDAQChannel::kStatSum).fSum;
+}
+
+Double_t XboxDAQChannelIndex::mean(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, XboxDAQChannel::kStatMean).fMean;
+}
+
+Double_t XboxDAQChannelIndex::stddev(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, XboxDAQChannel::kStatStdDev).fStdDev;
+}
+
+Double_t XboxDAQChannelIndex::integ(Double_t t0, Double_t t1) const
+{
+	return stats(t0, t1, XboxDAQChannel::kStatInteg).fInteg;
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
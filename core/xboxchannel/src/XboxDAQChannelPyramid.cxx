@@ -0,0 +1,229 @@
+#include "XboxDAQChannelPyramid.hxx"
+
+#include <algorithm>
+
+#ifndef XBOX_NO_NAMESPACE
+namespace XBOX {
+#endif
+
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+XboxDAQChannelPyramid::XboxDAQChannelPyramid() {
+	init();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor.
+/// Builds the pyramid for the signal of a channel.
+/// \param[in] ch The channel.
+XboxDAQChannelPyramid::XboxDAQChannelPyramid(XboxDAQChannel &ch) {
+	init();
+	build(ch);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+XboxDAQChannelPyramid::~XboxDAQChannelPyramid() {
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Default Settings.
+void XboxDAQChannelPyramid::init() {
+	fStartOffset = 0.;
+	fIncrement = 0.;
+	fNSamples = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Clear.
+void XboxDAQChannelPyramid::clear() {
+	fMin.clear();
+	fMax.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reset.
+void XboxDAQChannelPyramid::reset() {
+	clear();
+	init();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Builds the pyramid.
+/// Each level halves the number of blocks of the previous one. An odd
+/// block at the end of a level is carried over unchanged. The total
+/// memory amounts to about twice the signal.
+/// \param[in] ch The channel.
+void XboxDAQChannelPyramid::build(XboxDAQChannel &ch) {
+
+	reset();
+
+	XboxDataSpan<const Double_t> y = ch.viewSignal();
+	Int_t n = y.size();
+
+	fStartOffset = ch.getStartOffset();
+	fIncrement = ch.getIncrement();
+	fNSamples = n;
+	if (!n)
+		return;
+
+	// level 0 (the signal itself, the maxima are taken from fMin[0])
+	fMin.push_back(std::vector<Double_t>(y.begin(), y.end()));
+	fMax.push_back(std::vector<Double_t>());
+
+	// coarser levels
+	for (Int_t k=1; fMin[k-1].size() > 1; k++) {
+
+		const std::vector<Double_t> &pmin = fMin[k-1];
+		const std::vector<Double_t> &pmax = (k == 1) ? fMin[0] : fMax[k-1];
+		size_t plen = pmin.size();
+		size_t len = (plen + 1) / 2;
+
+		std::vector<Double_t> vmin(len);
+		std::vector<Double_t> vmax(len);
+		for (size_t i=0; i < plen / 2; i++) {
+			vmin[i] = std::min(pmin[2*i], pmin[2*i+1]);
+			vmax[i] = std::max(pmax[2*i], pmax[2*i+1]);
+		}
+		if (plen % 2) {
+			vmin[len-1] = pmin[plen-1];
+			vmax[len-1] = pmax[plen-1];
+		}
+
+		fMin.push_back(std::move(vmin));
+		fMax.push_back(std::move(vmax));
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Index range of a time window.
+/// Follows the convention of XboxDAQChannel::getIndexRange.
+Int_t XboxDAQChannelPyramid::getIndexRange(Int_t &i0, Int_t &i1, Double_t t0, Double_t t1) const
+{
+	return XboxDAQChannel::getIndexRange(i0, i1, t0, t1, fStartOffset,
+			fIncrement, fNSamples);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Min/max envelope of a time window.
+/// The window is divided into npixels columns. For each column the time
+/// at its centre as well as the minimum and maximum of the signal are
+/// returned. Columns are evaluated at the coarsest level whose blocks
+/// do not exceed the column width, so that a column spans at most a
+/// few blocks. If the window contains less samples than pixels, the
+/// samples are returned directly (with equal min and max).
+/// \param[out] t The time values.
+/// \param[out] ymin The minima.
+/// \param[out] ymax The maxima.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] npixels The number of pixel columns.
+/// \return The number of points or -1 in case of an error.
+Int_t XboxDAQChannelPyramid::getEnvelope(std::vector<Double_t> &t,
+		std::vector<Double_t> &ymin, std::vector<Double_t> &ymax,
+		Double_t t0, Double_t t1, Int_t npixels) const
+{
+	t.clear();
+	ymin.clear();
+	ymax.clear();
+
+	if (npixels < 1) {
+		printf("ERROR: Invalid number of pixels (%d)\n", npixels);
+		return -1;
+	}
+
+	Int_t i0;
+	Int_t i1;
+	getIndexRange(i0, i1, t0, t1);
+	if (!fNSamples || i1 <= i0)
+		return 0;
+
+	Int_t n = i1 - i0;
+
+	// full resolution
+	if (n <= npixels) {
+		t.resize(n);
+		ymin.assign(fMin[0].begin() + i0, fMin[0].begin() + i1);
+		ymax = ymin;
+		for (Int_t i=0; i < n; i++)
+			t[i] = fStartOffset + (i0 + i) * fIncrement;
+		return n;
+	}
+
+	// coarsest level with blocks not wider than a column
+	Int_t k = 0;
+	while (k + 1 < (Int_t)fMin.size() && (2LL << k) * npixels <= n)
+		k++;
+
+	const std::vector<Double_t> &vmin = fMin[k];
+	const std::vector<Double_t> &vmax = (k == 0) ? fMin[0] : fMax[k];
+
+	t.resize(npixels);
+	ymin.resize(npixels);
+	ymax.resize(npixels);
+	for (Int_t p=0; p < npixels; p++) {
+		Long64_t a = i0 + (Long64_t)n * p / npixels;
+		Long64_t e = i0 + (Long64_t)n * (p + 1) / npixels; // exclusive
+
+		Long64_t b0 = a >> k;
+		Long64_t b1 = (e - 1) >> k;
+		Double_t lo = vmin[b0];
+		Double_t hi = vmax[b0];
+		for (Long64_t b=b0+1; b <= b1; b++) {
+			lo = std::min(lo, vmin[b]);
+			hi = std::max(hi, vmax[b]);
+		}
+
+		t[p] = fStartOffset + 0.5 * (a + e - 1) * fIncrement;
+		ymin[p] = lo;
+		ymax[p] = hi;
+	}
+	return npixels;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Polyline of a time window.
+/// Converts the min/max envelope into a sequence of points which can be
+/// passed directly to a graph (e.g. TGraph). Each column contributes
+/// its minimum and maximum as a vertical segment, so that peaks remain
+/// visible at any zoom level.
+/// \param[out] x The time values.
+/// \param[out] y The signal values.
+/// \param[in] t0 The lower limit of the time window (-1: first sample).
+/// \param[in] t1 The upper limit of the time window (-1: last sample).
+/// \param[in] npixels The number of pixel columns.
+/// \return The number of points or -1 in case of an error.
+Int_t XboxDAQChannelPyramid::getPolyline(std::vector<Double_t> &x,
+		std::vector<Double_t> &y, Double_t t0, Double_t t1,
+		Int_t npixels) const
+{
+	std::vector<Double_t> t;
+	std::vector<Double_t> ymin;
+	std::vector<Double_t> ymax;
+
+	x.clear();
+	y.clear();
+
+	Int_t n = getEnvelope(t, ymin, ymax, t0, t1, npixels);
+	if (n < 0)
+		return -1;
+
+	x.reserve(2*n);
+	y.reserve(2*n);
+	for (Int_t i=0; i < n; i++) {
+		x.push_back(t[i]);
+		y.push_back(ymin[i]);
+		if (ymax[i] != ymin[i]) {
+			x.push_back(t[i]);
+			y.push_back(ymax[i]);
+		}
+	}
+	return x.size();
+}
+
+
+#ifndef XBOX_NO_NAMESPACE
+}
+#endif
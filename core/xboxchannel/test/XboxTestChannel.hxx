@@ -0,0 +1,57 @@
+/*
+ * XboxTestChannel.hxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: kpapke
+ */
+
+#ifndef _XBOXTESTCHANNEL_HXX_
+#define _XBOXTESTCHANNEL_HXX_
+
+#include <string>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxDataType.hxx"
+#include "XboxDAQChannel.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Data type of the raw samples of a test channel.
+inline XBOX::XboxDataType getTestDataType(const UChar_t*) { return XBOX::XboxDataType::NATIVE_UINT8; }
+inline XBOX::XboxDataType getTestDataType(const Short_t*) { return XBOX::XboxDataType::NATIVE_INT16; }
+inline XBOX::XboxDataType getTestDataType(const Double_t*) { return XBOX::XboxDataType::NATIVE_DOUBLE; }
+
+////////////////////////////////////////////////////////////////////////
+/// Channel of the tests.
+/// Stores the raw samples with their data type and the time axis (first
+/// sample at t=0). The channel is calibrated with a polynomial (scale
+/// type 1) if coefficients are given, otherwise the raw samples are the
+/// signal.
+/// \param[in] name The name of the channel.
+/// \param[in] raw The raw samples.
+/// \param[in] increment The sample increment.
+/// \param[in] coeffs The coefficients of the calibration (optional).
+template <typename T>
+inline XBOX::XboxDAQChannel createRawChannel(const std::string &name,
+		const std::vector<T> &raw, Double_t increment=1e-9,
+		const std::vector<Double_t> &coeffs={}) {
+
+	XBOX::XboxDAQChannel ch;
+	ch.setChannelName(name);
+	ch.setDataType(getTestDataType(raw.data()));
+	ch.setRawData(reinterpret_cast<const Byte_t*>(raw.data()), raw.size() * sizeof(T));
+	ch.setSamples(raw.size());
+	ch.setIncrement(increment);
+	ch.setStartOffset(0.);
+	if (!coeffs.empty()) {
+		ch.setScaleType(1);
+		ch.setScaleCoeffs(coeffs);
+	}
+	return ch;
+}
+
+
+#endif /* _XBOXTESTCHANNEL_HXX_ */
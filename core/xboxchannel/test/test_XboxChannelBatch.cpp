@@ -0,0 +1,118 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxChannelBatch.hxx"
+#include "XboxTestChannel.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Synthetic pulse.
+/// \param[in] nsamples The number of samples.
+/// \param[in] shift The delay of the pulse in samples.
+XBOX::XboxDAQChannel createChannel(Int_t nsamples, Int_t shift) {
+
+	std::vector<Short_t> raw(nsamples);
+	for (Int_t i=0; i<nsamples; i++) {
+		Int_t k = i - shift;
+		Double_t p = 0.;
+		if (k > 1000 && k < 3000)
+			p = 20000. * (1. - exp(-(k - 1000) / 15.));
+		if (k > 3000)
+			p = 20000. * exp(-(k - 3000) / 15.);
+		raw[i] = static_cast<Short_t>(p - 5000. + rand() % 64);
+	}
+
+	return createRawChannel("PSI_amp", raw, 1e-9, {1.5, 2e-3});
+}
+
+
+int main(int argc, char** argv) {
+
+	const Int_t nsamples = 4000;
+	const Int_t nevents = 100;
+	const Double_t t0 = 500e-9;
+	const Double_t t1 = 3500e-9;
+
+	Int_t status = EXIT_SUCCESS;
+
+	srand(1);
+	std::vector<XBOX::XboxDAQChannel> channels;
+	XBOX::XboxChannelBatch batch(16);
+	for (Int_t k=0; k<nevents; k++) {
+		channels.push_back(createChannel(nsamples, k % 50));
+		if (batch.add(channels.back()) != k) {
+			printf("ERROR: Cannot add event %d to the batch\n", k);
+			return EXIT_FAILURE;
+		}
+	}
+
+	// uncalibrated batch
+	std::vector<XBOX::XboxDAQChannel::Stats_t> res;
+	if (batch.stats(res, t0, t1) != -1) {
+		printf("ERROR: Statistics of an uncalibrated batch evaluated\n");
+		status = EXIT_FAILURE;
+	}
+
+	batch.calibrate();
+	if (batch.add(channels.front()) != -1) {
+		printf("ERROR: Event added to a calibrated batch\n");
+		status = EXIT_FAILURE;
+	}
+
+	// comparison with the evaluation per channel
+	std::vector<Double_t> rise, fall, avg, dev;
+	Bool_t bstats = batch.stats(res, t0, t1) == nevents;
+	Bool_t bedge = batch.risingEdge(rise, 0.5, t0, t1) == nevents;
+	bedge &= batch.fallingEdge(fall, 0.5, t0, t1) == nevents;
+	Bool_t bavg = batch.averagePulse(avg) == nsamples;
+
+	std::vector<Double_t> ref(nsamples, 0.);
+	for (Int_t k=0; k<nevents; k++) {
+		std::vector<Double_t> y;
+		channels[k].getSignal(y);
+		for (Int_t i=0; i<nsamples; i++)
+			ref[i] += y[i] / nevents;
+	}
+	for (Int_t i=0; i<nsamples; i++)
+		bavg &= fabs(avg[i] - ref[i]) < 1e-9;
+
+	Bool_t bdev = batch.deviation(dev, avg, t0, t1) == nevents;
+
+	for (Int_t k=0; k<nevents; k++) {
+		const XBOX::XboxDAQChannel &ch = channels[k];
+		XBOX::XboxDAQChannel::Stats_t st = ch.stats(t0, t1);
+		bstats &= res[k].fSamples == st.fSamples;
+		bstats &= res[k].fMin == st.fMin && res[k].fMax == st.fMax;
+		bstats &= fabs(res[k].fMean - st.fMean) < 1e-9;
+		bstats &= fabs(res[k].fStdDev - st.fStdDev) < 1e-9;
+
+		bedge &= fabs(rise[k] - ch.risingEdge(0.5, t0, t1)) < 1e-15;
+		bedge &= fabs(fall[k] - ch.fallingEdge(0.5, t0, t1)) < 1e-15;
+
+		std::vector<Double_t> y;
+		ch.getSignal(y);
+		Int_t i0, i1;
+		ch.getIndexRange(i0, i1, t0, t1);
+		Double_t d2 = 0.;
+		for (Int_t i=i0; i<i1; i++)
+			d2 += (y[i] - avg[i]) * (y[i] - avg[i]);
+		bdev &= fabs(dev[k] - sqrt(d2 / (i1 - i0))) < 1e-9;
+	}
+
+	printf("Batch of %d events: stats %s, edges %s, average %s, deviation %s\n",
+			batch.getEvents(), bstats ? "ok" : "failed", bedge ? "ok" : "failed",
+			bavg ? "ok" : "failed", bdev ? "ok" : "failed");
+
+	if (!bstats || !bedge || !bavg || !bdev) {
+		printf("ERROR: Batch operations differ from the evaluation per channel\n");
+		status = EXIT_FAILURE;
+	}
+
+	return status;
+}
@@ -0,0 +1,199 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// root
+#include "Rtypes.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TString.h"
+#include "TSystem.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxDAQChannelDescriptor.hxx"
+#include "XboxTestChannel.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Synthetic channel.
+/// \param[in] name The name of the channel.
+/// \param[in] i The number of the event.
+/// \param[in] unit The unit of the signal (distinguishes the descriptors
+///            of different runs).
+XBOX::XboxDAQChannel createChannel(const char *name, Int_t i, const char *unit="W") {
+
+	std::vector<Short_t> raw(64);
+	for (size_t k=0; k<raw.size(); k++)
+		raw[k] = i + k;
+
+	XBOX::XboxDAQChannel ch = createRawChannel(name, raw, 1e-9, {1.5, 2e-3});
+	ch.setXLabel("Time");
+	ch.setXUnit("s");
+	ch.setYUnit(unit);
+	ch.setYUnitDescription("Power");
+	ch.setScaleUnit("W");
+	ch.setPulseCount(1000ULL * i);
+	return ch;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Compares the meta data and the waveform of two channels.
+Bool_t isEqual(const XBOX::XboxDAQChannel &ch, const XBOX::XboxDAQChannel &ref) {
+	return ch.getDescriptor() == ref.getDescriptor()
+			&& ch.getPulseCount() == ref.getPulseCount()
+			&& ch.getScaleType() == ref.getScaleType()
+			&& ch.getRawData() == ref.getRawData();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Writes the events of a file.
+/// \param[in] filepath The file.
+/// \param[in] nevents The number of events.
+/// \param[in] unit The unit of the signals.
+void writeEvents(const char *filepath, Int_t nevents, const char *unit) {
+
+	TFile file(filepath, "RECREATE");
+	TTree tree("Events", "Events");
+	XBOX::XboxDAQChannel ch1;
+	XBOX::XboxDAQChannel ch2;
+	XBOX::XboxDAQChannel *pch1 = &ch1;
+	XBOX::XboxDAQChannel *pch2 = &ch2;
+	tree.Branch("PSI_amp", &pch1, 32000, 99);
+	tree.Branch("PSR_amp", &pch2, 32000, 0);
+	for (Int_t i=0; i<nevents; i++) {
+		ch1 = createChannel("PSI_amp", i, unit);
+		ch2 = createChannel("PSR_amp", i, unit);
+		tree.Fill();
+	}
+	tree.Write();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Reads the events of a file.
+/// Checks the events against the synthetic channels and whether all
+/// events of a channel share a single descriptor. A merged file holds
+/// the events of each source file (unit) one after another.
+/// \param[in] filepath The file.
+/// \param[in] nevents The number of events per unit.
+/// \param[in] units The units of the signals of the source files.
+Int_t readEvents(const char *filepath, Int_t nevents,
+		const std::vector<std::string> &units={"W"}) {
+
+	TFile file(filepath, "READ");
+	TTree *tree = nullptr;
+	file.GetObject("Events", tree);
+	if (!tree || tree->GetEntries() != nevents * (Long64_t) units.size()) {
+		printf("ERROR: Cannot read the events of file %s\n", filepath);
+		return -1;
+	}
+
+	Int_t status = 0;
+	for (const char *name: {"PSI_amp", "PSR_amp"}) {
+		XBOX::XboxDAQChannel ch;
+		XBOX::XboxDAQChannel *pch = &ch;
+		tree->SetBranchAddress(name, &pch);
+
+		const XBOX::XboxDAQChannelDescriptor *desc = nullptr;
+		Bool_t bmatch = true;
+		Bool_t bshared = true;
+		for (Int_t i=0; i<nevents * (Int_t) units.size(); i++) {
+			tree->GetEntry(i);
+			bmatch &= isEqual(ch, createChannel(name, i % nevents, units[i / nevents].c_str()));
+			if (i % nevents > 0)
+				bshared &= (&ch.getDescriptor() == desc);
+			desc = &ch.getDescriptor();
+		}
+		tree->ResetBranchAddresses();
+
+		printf("%-40s %8s: %s\n", filepath, name, (bmatch && bshared) ? "ok" : "failed");
+		if (!bmatch || !bshared) {
+			printf("ERROR: Channel %s of file %s differs\n", name, filepath);
+			status = -1;
+		}
+	}
+	return status;
+}
+
+
+int main(int argc, char** argv) {
+
+	const char *filepath = "test_XboxDAQChannelDescriptor.root";
+	const char *filepathRun = "test_XboxDAQChannelDescriptorRun.root";
+	const char *filepathMerged = "test_XboxDAQChannelDescriptorMerged.root";
+	const char *filepathV1 = "test_XboxDAQChannelV1.root"; // see writeXboxDAQChannelV1.C
+	const Int_t nevents = 100;
+
+	Int_t status = EXIT_SUCCESS;
+
+	// reference counting: intermediate descriptors of the setters and
+	// descriptors of destroyed channels are released
+	XBOX::XboxDAQChannelDescriptor::getDefault(); // kept for the lifetime of the process
+	size_t npool = XBOX::XboxDAQChannelDescriptor::getPoolSize();
+	{
+		XBOX::XboxDAQChannel ch1 = createChannel("PSI_amp", 0);
+		XBOX::XboxDAQChannel ch2 = createChannel("PSI_amp", 1);
+		if (XBOX::XboxDAQChannelDescriptor::getPoolSize() != npool + 1
+				|| !(ch1.getDescriptor() == ch2.getDescriptor())
+				|| &ch1.getDescriptor() != &ch2.getDescriptor()) {
+			printf("ERROR: Descriptors are not shared\n");
+			status = EXIT_FAILURE;
+		}
+
+		ch2.clear();
+		if (!ch2.getScaleCoeffs().empty() || ch1.getScaleCoeffs().empty()) {
+			printf("ERROR: Scale coefficients not reset by clear()\n");
+			status = EXIT_FAILURE;
+		}
+	}
+	if (XBOX::XboxDAQChannelDescriptor::getPoolSize() != npool) {
+		printf("ERROR: Descriptors not released (%zu instead of %zu)\n",
+				XBOX::XboxDAQChannelDescriptor::getPoolSize(), npool);
+		status = EXIT_FAILURE;
+	}
+
+	// current version: one table of descriptors per file
+	writeEvents(filepath, nevents, "W");
+	{
+		TFile file(filepath, "READ");
+		XBOX::XboxDAQChannelDescriptorTable *table =
+				XBOX::XboxDAQChannelDescriptorTable::getTable(&file);
+		if (!table || table->size() != 2) {
+			printf("ERROR: Unexpected table of descriptors in file %s\n", filepath);
+			status = EXIT_FAILURE;
+		}
+	}
+	if (readEvents(filepath, nevents))
+		status = EXIT_FAILURE;
+
+	// merged files: the tables of both runs are united, the events keep
+	// referring to their own descriptors
+	writeEvents(filepathRun, nevents, "kW");
+	if (gSystem->Exec(TString::Format("hadd -f %s %s %s", filepathMerged,
+			filepath, filepathRun).Data())) {
+		printf("ERROR: Cannot merge the files %s and %s\n", filepath, filepathRun);
+		status = EXIT_FAILURE;
+	}
+	{
+		TFile file(filepathMerged, "READ");
+		XBOX::XboxDAQChannelDescriptorTable *table =
+				XBOX::XboxDAQChannelDescriptorTable::getTable(&file);
+		if (!table || table->size() != 4) {
+			printf("ERROR: Unexpected table of descriptors in file %s\n", filepathMerged);
+			status = EXIT_FAILURE;
+		}
+	}
+	if (readEvents(filepathMerged, nevents, {"W", "kW"}))
+		status = EXIT_FAILURE;
+
+	// version 1: meta data stored per event (schema evolution)
+	if (readEvents(filepathV1, nevents))
+		status = EXIT_FAILURE;
+
+	remove(filepath);
+	remove(filepathRun);
+	remove(filepathMerged);
+
+	return status;
+}
@@ -0,0 +1,104 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxDAQChannelIndex.hxx"
+#include "XboxTestChannel.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Synthetic channel.
+/// Noisy sine on top of a large offset (double precision samples).
+/// \param[in] nsamples The number of samples.
+/// \param[in] offset The offset of the signal.
+XBOX::XboxDAQChannel createChannel(Int_t nsamples, Double_t offset, std::vector<Double_t> &y) {
+
+	std::mt19937_64 gen(12345);
+	std::normal_distribution<Double_t> noise(0., 0.1);
+
+	y.resize(nsamples);
+	for (Int_t i=0; i<nsamples; i++)
+		y[i] = offset + sin(2. * M_PI * i / 500.) + noise(gen);
+
+	return createRawChannel("PSI_amp", y);
+}
+
+
+int main(int argc, char** argv) {
+
+	const Int_t nsamples = 100000;
+	const Int_t nqueries = 2000;
+
+	Int_t status = EXIT_SUCCESS;
+
+	for (Double_t offset: {0., 1e6}) {
+
+		std::vector<Double_t> y;
+		XBOX::XboxDAQChannel ch = createChannel(nsamples, offset, y);
+		XBOX::XboxDAQChannelIndex index(ch);
+
+		std::mt19937_64 gen(1);
+		std::uniform_int_distribution<Int_t> dist(0, nsamples-1);
+
+		Double_t devMean = 0.;    // maximum deviation from the exact value
+		Double_t devStdDev = 0.;
+		Bool_t bmatch = true;
+		for (Int_t iq=0; iq<nqueries; iq++) {
+			Int_t i0 = dist(gen);
+			Int_t i1 = dist(gen);
+			if (i0 > i1)
+				std::swap(i0, i1);
+			Double_t t0 = i0 * 1e-9;
+			Double_t t1 = i1 * 1e-9;
+
+			XBOX::XboxDAQChannel::Stats_t ref = ch.stats(t0, t1);
+			XBOX::XboxDAQChannel::Stats_t res = index.stats(t0, t1);
+
+			// same window and extrema
+			bmatch &= (res.fSamples == ref.fSamples);
+			bmatch &= (res.fMin == ref.fMin && res.fMax == ref.fMax);
+			bmatch &= (res.fMagn == ref.fMagn && res.fSpan == ref.fSpan);
+
+			// exact moments in extended precision
+			Int_t j0, j1;
+			ch.getIndexRange(j0, j1, t0, t1);
+			LongDouble_t s = 0., s2 = 0.;
+			for (Int_t i=j0; i<j1; i++)
+				s += y[i];
+			LongDouble_t mean = s / (j1 - j0);
+			for (Int_t i=j0; i<j1; i++)
+				s2 += (y[i] - mean) * (y[i] - mean);
+			LongDouble_t stddev = sqrtl(s2 / (j1 - j0));
+
+			devMean = std::max(devMean, (Double_t) fabsl(res.fMean - mean));
+			devStdDev = std::max(devStdDev, (Double_t) fabsl(res.fStdDev - stddev));
+		}
+
+		printf("Offset %8.1e: max. deviation %.3e (mean) | %.3e (stddev)\n",
+				offset, devMean, devStdDev);
+
+		if (!bmatch) {
+			printf("ERROR: Window or extrema differ from the channel statistics\n");
+			status = EXIT_FAILURE;
+		}
+		if (devMean > 1e-9 * (1. + offset) || devStdDev > 1e-9) {
+			printf("ERROR: Moments deviate from the exact values\n");
+			status = EXIT_FAILURE;
+		}
+	}
+
+	// empty index
+	XBOX::XboxDAQChannelIndex empty;
+	if (empty.stats().fSamples != 0) {
+		printf("ERROR: Unexpected statistics of an empty index\n");
+		status = EXIT_FAILURE;
+	}
+
+	return status;
+}
@@ -0,0 +1,107 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Rtypes.h"
+
+// xbox
+#include "XboxDAQChannel.hxx"
+#include "XboxDAQChannelPyramid.hxx"
+#include "XboxTestChannel.hxx"
+
+
+////////////////////////////////////////////////////////////////////////
+/// Synthetic channel.
+/// Noisy pulse with a single sample spike (breakdown).
+/// \param[in] nsamples The number of samples.
+/// \param[in] ispike The index of the spike.
+XBOX::XboxDAQChannel createChannel(Int_t nsamples, Int_t ispike, std::vector<Double_t> &y) {
+
+	std::mt19937_64 gen(12345);
+	std::normal_distribution<Double_t> noise(0., 0.1);
+
+	y.resize(nsamples);
+	for (Int_t i=0; i<nsamples; i++)
+		y[i] = ((i > nsamples/4 && i < 3*nsamples/4) ? 1. : 0.) + noise(gen);
+	y[ispike] = 10.;
+
+	return createRawChannel("PSI_amp", y);
+}
+
+
+int main(int argc, char** argv) {
+
+	const Int_t nsamples = 100003;
+	const Int_t ispike = 54321;
+
+	Int_t status = EXIT_SUCCESS;
+
+	std::vector<Double_t> y;
+	XBOX::XboxDAQChannel ch = createChannel(nsamples, ispike, y);
+	XBOX::XboxDAQChannelPyramid pyramid(ch);
+
+	// zoom levels: full trace and windows around the spike
+	std::vector<std::pair<Double_t, Double_t>> windows = {
+		{-1, -1}, {10e-6, 90e-6}, {50e-6, 60e-6}, {54.2e-6, 54.4e-6}};
+
+	for (auto &w: windows) {
+		for (Int_t npixels: {100, 333, 1000}) {
+
+			std::vector<Double_t> t, ymin, ymax;
+			Int_t n = pyramid.getEnvelope(t, ymin, ymax, w.first, w.second, npixels);
+
+			Int_t i0, i1;
+			ch.getIndexRange(i0, i1, w.first, w.second);
+			Int_t len = i1 - i0;
+			if (n != std::min(len, npixels)) {
+				printf("ERROR: Unexpected number of columns (%d)\n", n);
+				status = EXIT_FAILURE;
+				continue;
+			}
+
+			// each column covers its samples and at most one column width
+			// in addition on either side
+			Bool_t bcover = true;
+			Bool_t bspike = false;
+			for (Int_t p=0; p<n; p++) {
+				Long64_t a = i0 + (Long64_t)len * p / n;
+				Long64_t e = i0 + (Long64_t)len * (p + 1) / n;
+				Long64_t w0 = std::max((Long64_t)0, a - (e - a));
+				Long64_t w1 = std::min((Long64_t)nsamples, e + (e - a));
+
+				Double_t lo = *std::min_element(y.begin() + a, y.begin() + e);
+				Double_t hi = *std::max_element(y.begin() + a, y.begin() + e);
+				Double_t wlo = *std::min_element(y.begin() + w0, y.begin() + w1);
+				Double_t whi = *std::max_element(y.begin() + w0, y.begin() + w1);
+
+				bcover &= (ymin[p] <= lo && ymin[p] >= wlo);
+				bcover &= (ymax[p] >= hi && ymax[p] <= whi);
+				bspike |= (ymax[p] == 10.);
+			}
+
+			printf("Window [%8.2e, %8.2e] %5d pixels: %5d columns\n",
+					w.first, w.second, npixels, n);
+
+			if (!bcover) {
+				printf("ERROR: Envelope does not match the samples\n");
+				status = EXIT_FAILURE;
+			}
+			if (!bspike) {
+				printf("ERROR: Spike lost in the envelope\n");
+				status = EXIT_FAILURE;
+			}
+		}
+	}
+
+	// polyline
+	std::vector<Double_t> x, yp;
+	if (pyramid.getPolyline(x, yp, -1, -1, 500) < 500 || x.size() != yp.size()) {
+		printf("ERROR: Invalid polyline\n");
+		status = EXIT_FAILURE;
+	}
+
+	return status;
+}
@@ -29,7 +29,11 @@ private:
 
 	std::vector<std::string> fChannelNames;
 	Int_t                 fXboxVersion;
+	Int_t                 fHistoryDepth; // number of events before a breakdown which are stored (B1...BN)
 	Bool_t                fVerbose;
+	Bool_t                fUseCache; // skip the conversion if the output is up to date
+
+	std::string           getCacheKey() const;
 
 public:
 	XboxFileConverter();
@@ -47,10 +51,13 @@ public:
 
 	size_t                getFileCount() const { return fInFiles.size(); }
 	Int_t                 getXboxVersion() const { return fXboxVersion; }
+	Int_t                 getHistoryDepth() const { return fHistoryDepth; }
 	Long64_t              getChannelCount() const { return fChannelNames.size(); }
 	std::vector<std::string> getChannelNames() const { return fChannelNames; }
 
 	void                  setVerbose(Bool_t bval) { fVerbose = bval; }
+	void                  setHistoryDepth(Int_t depth);
+	void                  setUseCache(Bool_t bval) { fUseCache = bval; }
 	void                  addFile(const Char_t *filename);
 	void                  addFile(const std::string &filename){ addFile(filename.c_str()); }
 
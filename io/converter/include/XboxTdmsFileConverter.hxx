@@ -55,6 +55,8 @@ private:
 
 	Long64_t              fEntryCount;                  ///<Number of entries (tdms groups)
 	Long64_t              fEntry;                     ///<Current entry of the input file
+	ULong64_t             fFileSize;                  ///<Size of the input file at the time it was loaded
+	ULong64_t             fEndOffset;                 ///<Offset after the last completely loaded segment
 
 	Int_t                 fXboxVersion;
 	std::vector<std::string> fXboxChannelNames;
@@ -65,7 +67,8 @@ private:
 	Int_t                 readVersion(void);
 	std::vector<std::string> readChannelList(const std::string &filename, const Int_t nseg=10);
 
-	Int_t                 convertChannel(XboxDAQChannel &channel, const TDMS::TdmsChannel &tdmschannel, Bool_t bdata = true);
+	Int_t                 convertChannel(XboxDAQChannel &channel, const std::string &name,
+			const TDMS::TdmsChannel &tdmschannel, Bool_t bdata = true);
 
 	// sub converter functions
 	Int_t                 convertStrToTs(TTimeStamp &ts, const Char_t *stime); // convert string to ROOT time stamp
@@ -101,7 +104,7 @@ public:
 	void                  init();
 
 	void                  clearEntryList();
-	void                  loadEntryList();
+	void                  loadEntryList(ULong64_t offset=0, Bool_t completeOnly=false);
 	EEntryStatus          restartEntryLoop();
 	EEntryStatus          setEntry(Long64_t entry);
 	Bool_t                nextEntry();
@@ -111,6 +114,8 @@ public:
 	Int_t                 getXboxVersion() const { return fXboxVersion; }
 	ULong64_t             getChannelCount() const;
 	ULong64_t             getEntryCount() const { return fEntryCount; };
+	ULong64_t             getFileSize() const { return fFileSize; }
+	ULong64_t             getEndOffset() const { return fEndOffset; }
 	std::vector<std::string> getChannelNames() const;
 
 	void                  setFile(const Char_t *filename);
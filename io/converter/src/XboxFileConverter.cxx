@@ -7,12 +7,15 @@
 
 #include <fstream>
 #include <ctime>
+#include <algorithm>
 
 #include "TFile.h"
 #include "TTree.h"
+#include "TString.h"
 
 #include "Tdms.h"
 
+#include "XboxFileSystem.h"
 #include "XboxDataType.hxx"
 #include "XboxDAQChannel.hxx"
 #include "XboxTdmsFileConverter.hxx"
@@ -60,7 +63,28 @@ XboxFileConverter::~XboxFileConverter()
 void XboxFileConverter::init()
 {
 	fXboxVersion = 0;
+	fHistoryDepth = 1;
 	fVerbose = true;
+	fUseCache = true;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Setter for the history depth.
+/// Defines how many events before a breakdown are stored. For a depth N
+/// the trees B1Events...BNEvents are written, where BkEvents contains
+/// the k-th valid event before the breakdown whatever its fLogType. The
+/// DAQ labels only the event right before the breakdown (fLogType=1),
+/// deeper events are normal pulses or earlier breakdowns. The history
+/// reaches across the input files. The memory used during the
+/// conversion is bounded by (N+1) times the number of channels.
+/// \param[in] depth The number of events before the breakdown (>= 1).
+void XboxFileConverter::setHistoryDepth(Int_t depth)
+{
+	if (depth < 1) {
+		printf("ERROR: Invalid history depth %d. Depth must be at least 1.\n", depth);
+		return;
+	}
+	fHistoryDepth = depth;
 }
 
 void XboxFileConverter::clear()
@@ -112,107 +136,286 @@ void XboxFileConverter::addFile(const Char_t *filename)
 }
 
 
+////////////////////////////////////////////////////////////////////////
+/// Cache key of the conversion.
+/// Combines the content fingerprints of the input files with the
+/// converter configuration. An output file holding the same key is up
+/// to date and does not need to be converted again.
+std::string XboxFileConverter::getCacheKey() const
+{
+	std::string config = TString::Format("XboxFileConverter:2;version=%d;depth=%d;",
+			fXboxVersion, fHistoryDepth).Data();
+	for (const std::string &name : fChannelNames)
+		config += name + ";";
+	return XBOX::getCacheKey(fInFiles, config);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Provides an event tree of the output file.
+/// An existing tree (update mode) is connected to the channel set,
+/// otherwise a new tree is created.
+/// \param[in] file The output file.
+/// \param[in] name The name of the tree.
+/// \param[in] title The title of a newly created tree.
+/// \param[in] channelnames The names of the channels (branches).
+/// \param[in] channelset The channel references used to fill the tree.
+/// \return The tree or NULL if an existing tree does not match.
+static TTree* openEventTree(TFile &file, const Char_t *name, const Char_t *title,
+		const std::vector<std::string> &channelnames,
+		std::vector<XboxDAQChannel*> &channelset)
+{
+	TTree *tree = (TTree*)file.Get(name);
+	if (tree) {
+		for (size_t i=0; i < channelnames.size(); i++) {
+			if (!tree->GetBranch(channelnames[i].c_str())) {
+				printf("ERROR: Channel \"%s\" not found in existing tree \"%s\".\n",
+						channelnames[i].c_str(), name);
+				return NULL;
+			}
+			tree->SetBranchAddress(channelnames[i].c_str(), &channelset[i]);
+		}
+	}
+	else {
+		tree = new TTree(name, title);
+		for (size_t i=0; i < channelnames.size(); i++)
+			tree->Branch(channelnames[i].c_str(), &channelset[i], 16000, 99);
+	}
+	return tree;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+/// Converts the input files and writes the events to a ROOT file.
+/// Normal events are stored in the tree N0Events, breakdown events in
+/// B0Events and the events before a breakdown in B1Events...BNEvents.
+/// For each input file a checkpoint (file name, file size, offset
+/// after the last converted segment) is added to the tree
+/// ConversionLog. In the mode "UPDATE" the checkpoints of a previous
+/// conversion are used to append only new events. Files which did not
+/// grow are skipped and growing files are continued from the last
+/// converted segment. A trailing segment which is still being written
+/// is left for the next update. In other modes the input files are
+/// converted completely, the checkpoint of a file stays in front of a
+/// trailing segment which was incomplete. An existing output file
+/// without checkpoints cannot be updated.
+/// If the cache is enabled a file which is recreated from unchanged
+/// inputs and configuration is skipped (see getCacheKey()).
+/// Note: Continuing a file assumes that each tdms segment carries its
+/// own meta data, which is the case for the xbox event files. The
+/// history of a breakdown does not reach across the checkpoint.
+/// \param[in] filename The output file name.
+/// \param[in] mode The file mode ("RECREATE", "UPDATE", ...).
+/// \return 0 on success, -1 otherwise.
 Int_t XboxFileConverter::write(const Char_t* filename, const Char_t* mode){
 
 	if (fInFiles.empty())
 		return -1;
 
 	Long64_t nchannel = fChannelNames.size();
+	Int_t ndepth = fHistoryDepth;
+	Int_t nslot = ndepth + 1; // history and current event
 
 	if (fVerbose) {
 		printf("----------------------------------------------------\n");
 		printf("Start conversion for %zu input file(s)\n", fInFiles.size());
 		printf("Xbox Version: %d\n", fXboxVersion);
 		printf("Maximum number of channels: %lld\n", nchannel);
+		printf("History depth: %d\n", ndepth);
+	}
+
+	// skip the conversion if the output is up to date
+	Bool_t bupdate = TString(mode).EqualTo("UPDATE", TString::kIgnoreCase);
+	std::string cachekey = fUseCache ? getCacheKey() : "";
+	if (!bupdate && XBOX::isCachedFile(filename, cachekey)) {
+		if (fVerbose) {
+			printf("Output file %s is up to date. Skip conversion.\n", filename);
+			printf("----------------------------------------------------\n");
+		}
+		return 0;
 	}
 
-	// define set of xbox daq channels
-	std::vector<XboxDAQChannel> channelsetN0; // N0 cache
-	std::vector<XboxDAQChannel> channelsetB0; // B0 cache
-	std::vector<XboxDAQChannel> channelsetB1; // B1 cache
-//	std::vector<XboxDAQChannel> channelsetB2; // B2 cache
-	channelsetN0.resize(nchannel);
-	channelsetB0.resize(nchannel);
-	channelsetB1.resize(nchannel);
-//	channelsetB2.resize(nchannel);
-
-	// configure root output file
+	// ring buffer of converted channel sets (current event and its history)
+	std::vector<std::vector<XboxDAQChannel>> ringChannelSet(nslot);
+	std::vector<Int_t> ringLogType(nslot, 999);
+	Long64_t nvalid = 0; // number of valid events in the ring buffer so far
+	for (Int_t k=0; k < nslot; k++)
+		ringChannelSet[k].resize(nchannel);
+
+	// the trees refer to the channel sets in the ring buffer by pointers
+	// which are redirected right before filling to avoid any copy
+	std::vector<XboxDAQChannel*> channelsetN0(nchannel); // N0 references
+	std::vector<std::vector<XboxDAQChannel*>> channelsetBk(nslot); // B0...BN references
+	for (Long64_t i=0; i < nchannel; i++)
+		channelsetN0[i] = &ringChannelSet[0][i];
+	for (Int_t k=0; k < nslot; k++) {
+		channelsetBk[k].resize(nchannel);
+		for (Long64_t i=0; i < nchannel; i++)
+			channelsetBk[k][i] = &ringChannelSet[k][i];
+	}
+
+	// configure root output file (trees are owned by the file)
 	TFile fileChannelSet(filename, mode);
-	TTree trN0Events("N0Events", "Normal events (fLogType=-1).");
-	TTree trB0Events("B0Events", "Breakdown events (fLogType=0).");
-	TTree trB1Events("B1Events", "1st event before the breakdown events (fLogType=1).");
-//	TTree trB2Events("B2Events", "2nd event before the breakdown events (fLogType=2).");
+	if (fileChannelSet.IsZombie()) {
+		printf("ERROR: Could not open output file \"%s\".\n", filename);
+		return -1;
+	}
+
+	// files from a conversion without checkpoints would be converted again
+	if (bupdate && fileChannelSet.Get("N0Events") && !fileChannelSet.Get("ConversionLog")) {
+		printf("ERROR: Output file \"%s\" has no conversion log. Use the mode "
+				"\"RECREATE\" instead.\n", filename);
+		fileChannelSet.Close();
+		return -1;
+	}
+
+	TTree *trN0Events = openEventTree(fileChannelSet, "N0Events",
+			"Normal events (fLogType=-1).", fChannelNames, channelsetN0);
+	std::vector<TTree*> trBkEvents(nslot);
+	trBkEvents[0] = openEventTree(fileChannelSet, "B0Events",
+			"Breakdown events (fLogType=0).", fChannelNames, channelsetBk[0]);
+	for (Int_t k=1; k < nslot; k++)
+		trBkEvents[k] = openEventTree(fileChannelSet, TString::Format("B%dEvents", k),
+				k == 1 ? TString("1st event before the breakdown events (fLogType=1).")
+						: TString::Format("%d. event before the breakdown events.", k),
+				fChannelNames, channelsetBk[k]);
+
+	if (!trN0Events || std::count(trBkEvents.begin(), trBkEvents.end(), (TTree*)NULL)) {
+		fileChannelSet.Close();
+		return -1;
+	}
+
+	// the breakdown trees are matched by entry number (friend trees)
+	for (Int_t k=1; k < nslot; k++) {
+		if (trBkEvents[k]->GetEntries() != trBkEvents[0]->GetEntries()) {
+			printf("ERROR: History depth does not match the existing file \"%s\".\n", filename);
+			fileChannelSet.Close();
+			return -1;
+		}
+	}
 
 	for (Long64_t i=0; i < nchannel; i++){
-		trN0Events.Branch(fChannelNames[i].c_str(), &channelsetN0[i], 16000, 99);
-		trB0Events.Branch(fChannelNames[i].c_str(), &channelsetB0[i], 16000, 99);
-		trB1Events.Branch(fChannelNames[i].c_str(), &channelsetB1[i], 16000, 99);
-//		trB2Events.Branch(fChannelNames[i].c_str(), &channelsetB2[i], 16000, 99);
 //		if (fVerbose)
 			printf("Channel %lld: %s\n", i, fChannelNames[i].c_str());
 	}
 
+	// checkpoints of the converted input files
+	std::string cpFileName;
+	std::string *pcpFileName = &cpFileName;
+	ULong64_t cpFileSize = 0;
+	ULong64_t cpOffset = 0;
+	Long64_t cpEntries = 0;
+	std::map<std::string, ULong64_t> checkpoints; // offset per input file
+
+	TTree *trConversionLog = (TTree*)fileChannelSet.Get("ConversionLog");
+	if (trConversionLog) {
+		trConversionLog->SetBranchAddress("FileName", &pcpFileName);
+		trConversionLog->SetBranchAddress("FileSize", &cpFileSize);
+		trConversionLog->SetBranchAddress("Offset", &cpOffset);
+		trConversionLog->SetBranchAddress("Entries", &cpEntries);
+		for (Long64_t i=0; i < trConversionLog->GetEntries(); i++) {
+			trConversionLog->GetEntry(i);
+			checkpoints[cpFileName] = cpOffset; // latest checkpoint wins
+		}
+	}
+	else {
+		trConversionLog = new TTree("ConversionLog", "Checkpoints of the converted input files.");
+		trConversionLog->Branch("FileName", &pcpFileName);
+		trConversionLog->Branch("FileSize", &cpFileSize, "FileSize/l");
+		trConversionLog->Branch("Offset", &cpOffset, "Offset/l");
+		trConversionLog->Branch("Entries", &cpEntries, "Entries/L");
+	}
+
 
 
 	for(std::string infile: fInFiles){
+
+		// continue from the last checkpoint in update mode
+		std::string key = XBOX::getFileName(infile);
+		ULong64_t offset = 0;
+		if (bupdate && checkpoints.count(key))
+			offset = checkpoints[key];
+
 		XBOX::XboxTdmsFileConverter tdmsconverter(infile);
-		tdmsconverter.loadEntryList();
+		tdmsconverter.loadEntryList(offset, bupdate);
+
+		if (bupdate && tdmsconverter.getEndOffset() <= offset) {
+			if (fVerbose)
+				printf("Skip file %s: no new events.\n", infile.c_str());
+			continue;
+		}
 
 		if (fVerbose)
 			printf("Process file %s: %lld events ...\n",
 					infile.c_str(), tdmsconverter.getEntryCount());
 
-
-		Int_t bufLogType[] = {-1, -1, -1}; // stores the fLogType of the last 3 events in a ring buffer
-		Int_t ievent = 0;
+		Long64_t ievent = 0;
 		while (tdmsconverter.nextEntry()){
 
-			// read test-wise first channel to get fLogType and to check whether the channel is empty
-			XboxDAQChannel ch;
-			tdmsconverter.convertCurrentEntry(fChannelNames[0], ch);
+			// the ring buffer holds valid events only, the slot of an
+			// invalid event is reused by the next one
+			Int_t islot = nvalid % nslot;
+			std::vector<XboxDAQChannel> &channelset = ringChannelSet[islot];
 
-			bufLogType[ievent % 3] = ch.getLogType();
-			if(!ch.isEmpty()) {
+			// read first channel to get fLogType and to check whether the
+			// channel is empty. The channel is converted in place and is
+			// not decoded again.
+			tdmsconverter.convertCurrentEntry(fChannelNames[0], channelset[0]);
 
-				if (bufLogType[ievent % 3] == 2
-						&& bufLogType[(ievent+2) % 3] == 1) { // convert data into B2 cache
-					printf("+++ %s\n", ch.getTimeStamp().AsString());
-				}
+			Int_t logtype = channelset[0].getLogType();
 
-				if (bufLogType[ievent % 3] == 2) { // convert data into B2 cache
+			if(!channelset[0].isEmpty() && logtype >= -1 && logtype != 999) {
 
-//					for (UInt_t i=0; i < nchannel; i++)
-//						tdmsconverter.convertCurrentEntry(fChannelNames[i], channelsetB2[i]);
-				}
-				else if (bufLogType[ievent % 3] == 1 ) {
-//						&& bufLogType[(ievent+2) % 3] == 2) { // convert data into B2 cache
+				// convert remaining channels of the current event
+				for (Long64_t i=1; i < nchannel; i++)
+					tdmsconverter.convertCurrentEntry(fChannelNames[i], channelset[i]);
+				ringLogType[islot] = logtype;
 
-					for (UInt_t i=0; i < nchannel; i++)
-						tdmsconverter.convertCurrentEntry(fChannelNames[i], channelsetB1[i]);
-				}
-				else if (bufLogType[ievent % 3] == 0
-						&& bufLogType[(ievent+2) % 3] == 1) {
-//						&& bufLogType[(ievent+1) % 3] == 2) { // convert data into B0 cache
-
-							for (UInt_t i=0; i < nchannel; i++)
-								tdmsconverter.convertCurrentEntry(fChannelNames[i], channelsetB0[i]);
-							trB0Events.Fill();
-							trB1Events.Fill();
-//							trB2Events.Fill();
+				if (logtype == -1) { // normal event
+					for (Long64_t i=0; i < nchannel; i++)
+						channelsetN0[i] = &channelset[i];
+					trN0Events->Fill();
 				}
-				else if (bufLogType[ievent % 3] == -1) { // convert data into N0 cache
-
-					for (UInt_t i=0; i < nchannel; i++)
-						tdmsconverter.convertCurrentEntry(fChannelNames[i], channelsetN0[i]);
-					trN0Events.Fill();
+				else if (logtype == 0) { // breakdown confirmed
+
+					// require the complete history B1...BN in the ring buffer,
+					// the event right before has to be labelled as such
+					Bool_t bvalid = (nvalid >= ndepth)
+							&& ringLogType[(nvalid - 1) % nslot] == 1;
+
+					if (bvalid) {
+						for (Int_t k=0; k <= ndepth; k++) {
+							Int_t jslot = (nvalid - k) % nslot;
+							for (Long64_t i=0; i < nchannel; i++)
+								channelsetBk[k][i] = &ringChannelSet[jslot][i];
+							trBkEvents[k]->Fill();
+						}
+					}
+					else if (fVerbose)
+						printf("WARNING: Incomplete history for breakdown at %s. "
+								"Skip event.\n", channelset[0].getTimeStamp().AsString());
 				}
+				nvalid++;
 			}
 			ievent++;
 		}
+
+		// record checkpoint of the current input file
+		cpFileName = key;
+		cpFileSize = tdmsconverter.getFileSize();
+		cpOffset = tdmsconverter.getEndOffset();
+		cpEntries = ievent;
+		trConversionLog->Fill();
 	}
-	fileChannelSet.Write();
+	// the cache key describes a complete conversion of the current inputs,
+	// a key from a previous conversion is no longer valid after an update
+	if (bupdate)
+		fileChannelSet.Delete("CacheKey;*");
+	fileChannelSet.Write(0, TObject::kOverwrite);
 	fileChannelSet.Close();
 
+	if (!bupdate && !cachekey.empty())
+		XBOX::writeCacheKey(filename, cachekey);
+
 	if (fVerbose) {
 		printf("Conversion finished. All data have been written to %s.\n", filename);
 		printf("----------------------------------------------------\n");
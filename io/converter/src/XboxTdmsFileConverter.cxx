@@ -52,27 +52,42 @@ void XboxTdmsFileConverter::setFile(const Char_t *filename) {
 }
 
 void XboxTdmsFileConverter::XboxTdmsFileConverter::init() {
+	fTdmsFile = NULL;
+	fTdmsGroup = NULL;
 	fEntry = -1;
 	fEntryCount = 0;
+	fFileSize = 0;
+	fEndOffset = 0;
 	fXboxVersion = 0;
 }
 
 void XboxTdmsFileConverter::clearEntryList() {
-	if (fEntryCount)
+	if (fTdmsFile)
 		delete fTdmsFile;
+	fTdmsFile = NULL;
+	fTdmsGroup = NULL;
 	fEntryCount = 0;
 	fEntry = -1;
 }
 
-void XboxTdmsFileConverter::loadEntryList() {
+////////////////////////////////////////////////////////////////////////
+/// Loads the entries (tdms groups) of the input file.
+/// \param[in] offset The segment offset at which reading starts. Used to
+///            continue a previous conversion of a growing file.
+/// \param[in] completeOnly Skips a trailing segment which is not yet
+///            written completely. It is loaded by the next call.
+void XboxTdmsFileConverter::loadEntryList(ULong64_t offset, Bool_t completeOnly) {
 	clearEntryList();
 
 	if (!isValidXboxVersion())
 		return;
 
 	fTdmsFile = new TDMS::TdmsFile(fFileName);
-	fTdmsFile->read();
+	fTdmsFile->setCompleteSegmentsOnly(completeOnly);
+	fTdmsFile->read(-1, offset);
 
+	fFileSize = fTdmsFile->getFileSize();
+	fEndOffset = fTdmsFile->getEndOffset();
 	fEntryCount = fTdmsFile->getGroupCount();
 	//printf("Number of Events: %lld\n", fNEntries);
 	restartEntryLoop();
@@ -613,7 +628,6 @@ Int_t XboxTdmsFileConverter::convertCurrentEntry(const std::string &name,
 		return -1;
 	}
 
-	channel.setChannelName(name);
 	channel.setXboxVersion(fXboxVersion);
 
 	std::string groupname = fTdmsGroup->getName();
@@ -622,7 +636,7 @@ Int_t XboxTdmsFileConverter::convertCurrentEntry(const std::string &name,
 	TDMS::TdmsChannel *tdmschannel = fTdmsGroup->getChannel(
 			"/'" + tdmsname + "'");
 
-	return convertChannel(channel, *tdmschannel, mask);
+	return convertChannel(channel, name, *tdmschannel, mask);
 
 //	if (fXboxVersion == kXbox1) {
 //
@@ -125,7 +125,7 @@ std::vector<XboxTdmsFileConverter::Dict_t> XboxTdmsFileConverter::fgXboxChannelM
 };
 
 
-Int_t XboxTdmsFileConverter::convertChannel(XboxDAQChannel &channel,
+Int_t XboxTdmsFileConverter::convertChannel(XboxDAQChannel &channel, const std::string &name,
 		const TDMS::TdmsChannel &tdmschannel, Bool_t bdata) {
 
 	// retrieve names of tdms channel and group used for reading specific properties
@@ -182,14 +182,19 @@ Int_t XboxTdmsFileConverter::convertChannel(XboxDAQChannel &channel,
 	if (!convertStrToNum(ival, tdmschannel.getProperty("wf_samples")))
 		channel.setSamples(ival);
 
+	// the per-run meta data are collected in a descriptor which is
+	// assigned (and interned) once at the end
+	XboxDAQChannelDescriptor desc;
+	desc.fChannelName = name;
+
 	// XLabel (Type: std::string)
-	channel.setXLabel(tdmschannel.getProperty("wf_xname"));
+	desc.fXLabel = tdmschannel.getProperty("wf_xname");
 	// XUnit (Type: std::string)
-	channel.setXUnit(tdmschannel.getProperty("wf_xunit_string"));
+	desc.fXUnit = tdmschannel.getProperty("wf_xunit_string");
 	// YUnit (Type: std::string)
-	channel.setYUnit(tdmschannel.getProperty("unit_string"));
+	desc.fYUnit = tdmschannel.getProperty("unit_string");
 	// YUnitDescription (Type: std::string)
-	channel.setYUnitDescription(tdmschannel.getProperty("NI_UnitDescription"));
+	desc.fYUnitDescription = tdmschannel.getProperty("NI_UnitDescription");
 
 	// Scale_Type (Type: Int_t). ID to define scale type (REDEFINED).
 	std::string sscaletype = tdmschannel.getProperty("Scale_Type");
@@ -201,7 +206,7 @@ Int_t XboxTdmsFileConverter::convertChannel(XboxDAQChannel &channel,
 		channel.setScaleType(-1); // no scaling
 
 	// ScaleUnit (Type: std::string)
-	channel.setScaleUnit(tdmschannel.getProperty("Scale_Unit"));
+	desc.fScaleUnit = tdmschannel.getProperty("Scale_Unit");
 
 	// ScaleCoeffs (Type: std::vector<Double_t>). Array of scaling values. (REDEFINED)
 	std::vector<Double_t> coeffs;
@@ -227,16 +232,22 @@ Int_t XboxTdmsFileConverter::convertChannel(XboxDAQChannel &channel,
 				break;
 		}
 	}
-	channel.setScaleCoeffs(coeffs);
+	desc.fScaleCoeffs = std::move(coeffs);
 
 	// setDataType (Type: XBOX::XboxDataType). Type of data array to be reinterpreted from binary data
 	XBOX::XboxDataType dtype;
 	if (!convertDataType(dtype, tdmschannel.getDataType()))
-		channel.setDataType(dtype);
+		desc.fDataType = dtype;
+
+	channel.setDescriptor(desc);
 
-	// fill data array in binary format if bdata flag is set
-	if (bdata)
-		channel.setRawData(tdmschannel.getRawDataVector());
+	// fill data array in binary format if bdata flag is set. The raw data
+	// are borrowed from the tdms channel and copied once into the buffer
+	// of the target channel which keeps its capacity between events.
+	if (bdata) {
+		const std::vector<Byte_t> &rawdata = tdmschannel.getRawDataVector();
+		channel.setRawData(rawdata.data(), rawdata.size());
+	}
 
 	// xbox specific conversion ...............................
 	if (fXboxVersion == kXbox1) {
@@ -145,7 +145,7 @@ Int_t XboxH5File::addDataSet(const string &groupename, XboxDAQChannel &channel)
 	H5::DataSet dataset(fFile->createDataSet(path, datatype, *dataspace));
 
 	// Write the data to the dataset using default memory space, file space, and transfer properties.
-	std::vector<Byte_t> data = channel.getRawData();
+	const std::vector<Byte_t> &data = channel.getRawData(); // no copy
 //	std::vector<Double_t> data2 = channel.getData();
 
 //	fActiveDataSet->write(&data[0], datatype, H5::DataSpace::ALL, H5::DataSpace::ALL);
@@ -180,7 +180,7 @@ Int_t XboxH5File::addDataSet(const string &groupename, XboxDAQChannel &channel)
 	addAttribute(dataset, "ScaleType", channel.getScaleType());
 	addStringAttribute(dataset, "ScaleUnit", channel.getScaleUnit());
 
-	std::vector<Double_t> coeffs = channel.getScaleCoeffs();
+	const std::vector<Double_t> &coeffs = channel.getScaleCoeffs();
 
 	if(coeffs.empty()){
 		Double_t dummy = 0;
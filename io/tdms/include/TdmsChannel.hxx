@@ -63,7 +63,7 @@ public:
 	UInt_t                getDimension() const {return fDimension;}
 	ULong64_t             getValuesCount() const {return fNValues;}
 
-	std::vector<Byte_t>   getRawDataVector() const {return fRawDataVector;}
+	const std::vector<Byte_t>& getRawDataVector() const {return fRawDataVector;}
 	std::vector<Double_t> getDataVector() {return fDataVector;}
 	std::vector<Double_t> getImaginaryDataVector() {return fImagDataVector;}
 	std::vector<std::string>  getStringVector() {return fStringVector;}
@@ -91,6 +91,7 @@ public:
 
 private:
 	void                  readStrings();
+	void                  appendRawValues(UInt_t bytecount);
 
 	const std::string     fName;
 	TdmsIfstream&         fFile;
@@ -32,6 +32,8 @@ protected:
 	TdmsGroupSet_t        fGroupSet;
 	TdmsObject           *fPrevObject;
 	ULong64_t             fFileSize;
+	ULong64_t             fEndOffset;         // offset after the last completely read segment
+	Bool_t                fCompleteOnly;      // skip a trailing segment which is not written completely
 	Bool_t                fVerbose=false;
 
 	// leadin attributes
@@ -52,6 +54,7 @@ protected:
 	std::map<std::string, std::string> fProperties;
 
 	ULong64_t             readSegment(Bool_t *atEnd);
+	Long64_t              peekSegmentEnd();
 	void                  readRawData(ULong64_t total_chunk_size);
 	void                  readLeadIn();
 	void                  readMetaData();
@@ -74,11 +77,13 @@ public:
 	void                  reset();
 	void                  clear();
 	Int_t                 isOpen(){return fFile->is_open();}
-	void                  read(Int_t nsegmax=-1);
+	void                  read(Int_t nsegmax=-1, ULong64_t offset=0);
+	void                  setCompleteSegmentsOnly(Bool_t bval) {fCompleteOnly = bval;}
 	void                  setFile(const Char_t *filename);
 	void                  setFile(const std::string &filename) {setFile(filename.c_str());};
 
 	ULong64_t             getFileSize() const {return fFileSize;}
+	ULong64_t             getEndOffset() const {return fEndOffset;}
 	TdmsGroup*            getGroup(UInt_t) const;
 	TdmsGroup*            getGroup(const std::string &) const;
 	UInt_t                getGroupCount() const {return fGroupSet.size();}
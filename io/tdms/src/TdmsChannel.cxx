@@ -180,31 +180,29 @@ void TdmsChannel::readStrings()
 	}
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Reads a block of raw values from the file directly into the end of
+/// the raw data vector. No intermediate buffer is used.
+/// \param[in] bytecount The number of bytes to read.
+void TdmsChannel::appendRawValues(UInt_t bytecount)
+{
+	if (!bytecount)
+		return;
+
+	size_t pos = fRawDataVector.size();
+	fRawDataVector.resize(pos + bytecount);
+	fFile.readArray(&fRawDataVector[pos], bytecount);
+}
+
 //void TChannel::readValues(UInt_t itype, Bool_t verbose)
 void TdmsChannel::readValues(TdmsDataType dtype)
 {
 
 	if(dtype == TdmsDataType::NATIVE_BOOL) {
-		Byte_t * rawbuffer;
-//			Bool_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(Bool_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<Bool_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(Bool_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_INT8) {
-		Byte_t * rawbuffer;
-//			Char_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(Char_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<Char_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(Char_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_INT16) {
 //		Byte_t * rawbuffer;
@@ -217,142 +215,44 @@ void TdmsChannel::readValues(TdmsDataType dtype)
 ////			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
 //		delete[] rawbuffer;
 
-		UInt_t bytecount = fNValues * sizeof(Short_t);
 		fRawDataVector.clear();
-		fRawDataVector.resize(bytecount);
-		fFile.readArray(&fRawDataVector[0], bytecount);
+		appendRawValues(fNValues * sizeof(Short_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_INT32) {
-		Byte_t * rawbuffer;
-//			Int_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(Int_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<Int_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(Int_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_INT64) {
-		Byte_t * rawbuffer;
-//			Long64_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(Long64_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<Long64_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(Long64_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_UINT8) {
-		Byte_t * rawbuffer;
-//			UChar_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(UChar_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<UChar_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(UChar_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_UINT16) {
-		Byte_t * rawbuffer;
-//			UShort_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(UShort_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<UShort_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(UShort_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_UINT32) {
-		Byte_t * rawbuffer;
-//			UInt_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(UInt_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<UInt_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(UInt_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_UINT64) {
-		Byte_t * rawbuffer;
-//			ULong64_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(ULong64_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<ULong64_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(ULong64_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_FLOAT) {
-		Byte_t * rawbuffer;
-//			Float_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(Float_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<Float_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(Float_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_FLOATWITHUNIT) {
-		Byte_t * rawbuffer;
-//			Float_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(Float_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<Float_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(Float_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_DOUBLE) {
-		Byte_t * rawbuffer;
-//			Double_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(Double_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<Double_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(Double_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_DOUBLEWITHUNIT) {
-		Byte_t * rawbuffer;
-//			Double_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(Double_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<Double_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(Double_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_LDOUBLE) {
-		Byte_t * rawbuffer;
-//			LongDouble_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(LongDouble_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<LongDouble_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(LongDouble_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_LDOUBLEWITHUNIT) {
-		Byte_t * rawbuffer;
-//			LongDouble_t * buffer;
-		UInt_t bytecount = fNValues * sizeof(LongDouble_t);
-		rawbuffer = new Byte_t[bytecount];
-		fFile.readArray(rawbuffer, bytecount);
-//			buffer = reinterpret_cast<LongDouble_t *>(rawbuffer);
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), buffer, buffer + fNValues);
-		delete[] rawbuffer;
+		appendRawValues(fNValues * sizeof(LongDouble_t));
 	}
 	else if(dtype == TdmsDataType::NATIVE_STRING) {
 		//string values are read in readRawData function directly
@@ -370,46 +270,10 @@ void TdmsChannel::readValues(TdmsDataType dtype)
 //			TODO: add Byte stream for fRawDataVector
 	}
 	else if(dtype == TdmsDataType::NATIVE_COMPLEXFLOAT) {
-		Byte_t * rawbuffer;
-//			Float_t * buffer;
-//			Float_t * real;
-//			Float_t * imag;
-		UInt_t bytecount = fNValues * sizeof(Float_t);
-
-		rawbuffer = new Byte_t[2 * bytecount];
-//			real = new Float_t[fNValues];
-//			imag = new Float_t[fNValues];
-
-		fFile.readArray(rawbuffer, 2 * bytecount);
-//			buffer = reinterpret_cast<Float_t *>(rawbuffer);
-//			for (UInt_t i = 0; i < fNValues; ++i){
-//				real[i] = buffer[2*i];
-//				imag[i] = buffer[2*i+1];
-//			}
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), real, real + fNValues);
-//			fImagDataVector.insert(fDataVector.end(), imag, imag + fNValues);
+		appendRawValues(2 * fNValues * sizeof(Float_t)); // interleaved real and imaginary part
 	}
 	else if(dtype == TdmsDataType::NATIVE_COMPLEXDOUBLE) {
-		Byte_t * rawbuffer;
-//			Double_t * buffer;
-//			Double_t * real;
-//			Double_t * imag;
-		UInt_t bytecount = fNValues * sizeof(Double_t);
-
-		rawbuffer = new Byte_t[2 * bytecount];
-//			real = new Double_t[fNValues];
-//			imag = new Double_t[fNValues];
-
-		fFile.readArray(rawbuffer, 2 * bytecount);
-//			buffer = reinterpret_cast<Double_t *>(rawbuffer);
-//			for (UInt_t i = 0; i < fNValues; ++i){
-//				real[i] = buffer[2*i];
-//				imag[i] = buffer[2*i+1];
-//			}
-		fRawDataVector.insert(fRawDataVector.end(), rawbuffer, rawbuffer + bytecount);
-//			fDataVector.insert(fDataVector.end(), real, real + fNValues);
-//			fImagDataVector.insert(fDataVector.end(), imag, imag + fNValues);
+		appendRawValues(2 * fNValues * sizeof(Double_t)); // interleaved real and imaginary part
 	}
 	else
 		printf(" (unknown type = %zu)\n", dtype.getId());
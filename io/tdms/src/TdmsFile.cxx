@@ -39,6 +39,8 @@ void TdmsFile::init()
 {
 	fPrevObject = NULL;
 	fFileSize = 0;
+	fEndOffset = 0;
+	fCompleteOnly = false;
 	fFlagHasMetaData = false;
 	fFlagHasObjectList = false;
 	fFlagHasRawData = false;
@@ -83,26 +85,47 @@ void TdmsFile::setFile(const Char_t *filename)
 }
 
 
-void TdmsFile::read(Int_t nsegmax)
+void TdmsFile::read(Int_t nsegmax, ULong64_t offset)
 {
 	if(!fFile->is_open())
 		return;
 
+	Bool_t completeOnly = fCompleteOnly;
 	reset();
+	fCompleteOnly = completeOnly;
+	fFile->clear();
 	fFile->seekg(0, std::ios::end);
 	fFileSize = fFile->tellg();
 	if (fVerbose)
 		printf("File size is: %d bytes (0x%X).\n", (UInt_t)fFileSize, (UInt_t)fFileSize);
 
-	fFile->seekg(0, std::ios::beg);
+	// start reading at the given segment offset (e.g. from a previous conversion)
+	if (offset > fFileSize)
+		offset = fFileSize;
+	fEndOffset = offset;
+	fFile->seekg(offset, std::ios::beg);
 
 	int nseg = 0;
 	ULong64_t nextSegmentOffset = 0;
 	Bool_t atEnd = false;
 
-	while (fFile->tellg() < (UInt_t)fFileSize){
+	while (fFile->tellg() < (Long64_t)fFileSize){
+
+		// stop in front of a segment which is still being written
+		Bool_t complete = peekSegmentEnd() <= (Long64_t)fFileSize;
+		if (fCompleteOnly && !complete) {
+			if (fVerbose)
+				printf("\tSegment at 0x%X is incomplete. Stop reading.\n", (UInt_t)fFile->tellg());
+			atEnd = true;
+			break;
+		}
+
+		// an incomplete segment is read, but the end offset stays in front
+		// of it to continue there once the segment is written completely
 		nextSegmentOffset = readSegment(&atEnd);
 		nseg++;
+		if (complete && nextSegmentOffset <= fFileSize)
+			fEndOffset = nextSegmentOffset;
 
 		if (fVerbose){
 			printf("\nPOS after segment %d: 0x%X\n", nseg, (UInt_t)fFile->tellg());
@@ -135,6 +158,46 @@ void TdmsFile::read(Int_t nsegmax)
 
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Determines the end of the segment at the current position without
+/// moving the file pointer.
+/// \return The absolute offset after the segment, kMaxLong64 if the
+///         lead in or the segment length is not yet written or -1 if the
+///         lead in is not valid.
+Long64_t TdmsFile::peekSegmentEnd()
+{
+	const Long64_t leadInSize = 28;
+	Long64_t pos = fFile->tellg();
+
+	// the lead in itself is still being written
+	if (pos + leadInSize > (Long64_t)fFileSize)
+		return kMaxLong64;
+
+	Char_t buffer[4];
+	UInt_t tocMask = 0;
+	UInt_t versionNumber = 0;
+	Long64_t nextSegmentOffset = -1;
+	ULong64_t dataOffset = 0;
+
+	fFile->read(buffer, 4);
+	fFile->read(reinterpret_cast<Char_t *>(&tocMask), sizeof(tocMask));
+	fFile->read(reinterpret_cast<Char_t *>(&versionNumber), sizeof(versionNumber));
+	fFile->read(reinterpret_cast<Char_t *>(&nextSegmentOffset), sizeof(nextSegmentOffset));
+	fFile->read(reinterpret_cast<Char_t *>(&dataOffset), sizeof(dataOffset));
+
+	Bool_t valid = fFile->good() && (std::string(buffer, 4).compare("TDSm") == 0);
+	Long64_t posAfterLeadIn = fFile->tellg();
+
+	fFile->clear();
+	fFile->seekg(pos, std::ios::beg);
+
+	if (!valid)
+		return -1;
+	if (nextSegmentOffset == -1)
+		return kMaxLong64;
+	return posAfterLeadIn + nextSegmentOffset;
+}
+
 ULong64_t TdmsFile::readSegment(Bool_t *atEnd)
 {
 	readLeadIn();